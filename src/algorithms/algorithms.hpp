@@ -33,6 +33,7 @@
 #include <algorithms/bfs.hpp>
 #include <algorithms/cluster.hpp>
 #include <algorithms/cluster_louvain.hpp>
+#include <algorithms/connected_components.hpp>
 #include <algorithms/k_truss.hpp>
 #include <algorithms/maxflow.hpp>
 #include <algorithms/metrics.hpp>
@@ -30,9 +30,159 @@
 #include <iostream>
 #include <functional>
 #include <memory>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <limits>
 
 #include <graphblas/graphblas.hpp>
 
+//****************************************************************************
+namespace
+{
+    /// Structure of a graph in compressed row form for the BC engine (the
+    /// stored values are not used).
+    using BCGraph = grb::CsrMatrix<bool>;
+
+    //************************************************************************
+    /**
+     * Per-thread state for single source BC contributions (Brandes).  The
+     * BFS levels are kept as consecutive slices of one visit order list, so
+     * a traversal needs O(n) words however deep it goes, and only the
+     * vertices actually reached are reset afterwards.
+     */
+    template <typename RealT>
+    struct BCWorkspace
+    {
+        static constexpr grb::IndexType UNVISITED =
+            std::numeric_limits<grb::IndexType>::max();
+
+        std::vector<grb::IndexType> depth;
+        std::vector<RealT>          num_sp;
+        std::vector<RealT>          delta;
+        std::vector<grb::IndexType> order;       ///< visit order
+        std::vector<grb::IndexType> level_ptr;   ///< level d is order[ptr[d]..ptr[d+1])
+
+        explicit BCWorkspace(grb::IndexType n)
+            : depth(n, UNVISITED),
+              num_sp(n, static_cast<RealT>(0)),
+              delta(n, static_cast<RealT>(0))
+        {
+            order.reserve(n);
+        }
+
+        /// bc[v] += delta_src(v) for every v != src
+        void accumulate(BCGraph const &g, grb::IndexType src,
+                        std::vector<RealT> &bc)
+        {
+            auto const &row_ptr(g.rowPointers());
+            auto const &col_idx(g.colIndices());
+
+            order.clear();
+            level_ptr.assign(1, 0);
+
+            depth[src]  = 0;
+            num_sp[src] = static_cast<RealT>(1);
+            order.push_back(src);
+
+            // forward phase: count shortest paths level by level
+            for (grb::IndexType d = 0; level_ptr.back() < order.size(); ++d)
+            {
+                grb::IndexType first(level_ptr.back());
+                grb::IndexType last(order.size());
+                level_ptr.push_back(last);
+
+                for (grb::IndexType k = first; k < last; ++k)
+                {
+                    grb::IndexType u(order[k]);
+                    for (grb::IndexType p = row_ptr[u]; p < row_ptr[u + 1]; ++p)
+                    {
+                        grb::IndexType v(col_idx[p]);
+                        if (depth[v] == UNVISITED)
+                        {
+                            depth[v] = d + 1;
+                            order.push_back(v);
+                        }
+                        if (depth[v] == d + 1)
+                        {
+                            num_sp[v] += num_sp[u];
+                        }
+                    }
+                }
+            }
+
+            // backward phase: deepest level first
+            for (grb::IndexType k = order.size(); k-- > 0; )
+            {
+                grb::IndexType u(order[k]);
+                RealT sum(0);
+                for (grb::IndexType p = row_ptr[u]; p < row_ptr[u + 1]; ++p)
+                {
+                    grb::IndexType v(col_idx[p]);
+                    if (depth[v] == depth[u] + 1)
+                    {
+                        sum += (static_cast<RealT>(1) + delta[v])/num_sp[v];
+                    }
+                }
+                delta[u] = num_sp[u]*sum;
+                if (u != src) bc[u] += delta[u];
+            }
+
+            for (auto v : order)
+            {
+                depth[v]  = UNVISITED;
+                num_sp[v] = static_cast<RealT>(0);
+                delta[v]  = static_cast<RealT>(0);
+            }
+        }
+    };
+
+    //************************************************************************
+    /// Sum the contributions of all sources, batch_size sources per task.
+    /// Batches run concurrently when compiled with OpenMP.
+    template <typename RealT>
+    std::vector<RealT> bc_from_sources(BCGraph                   const &g,
+                                       grb::IndexArrayType       const &sources,
+                                       grb::IndexType                   batch_size)
+    {
+        grb::IndexType n(g.nrows());
+        grb::IndexType num_sources(sources.size());
+        grb::IndexType num_batches((num_sources + batch_size - 1)/batch_size);
+        std::vector<RealT> bc(n, static_cast<RealT>(0));
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            BCWorkspace<RealT> ws(n);
+            std::vector<RealT> bc_local(n, static_cast<RealT>(0));
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+            for (grb::IndexType b = 0; b < num_batches; ++b)
+            {
+                grb::IndexType last(std::min(num_sources, (b + 1)*batch_size));
+                for (grb::IndexType k = b*batch_size; k < last; ++k)
+                {
+                    ws.accumulate(g, sources[k], bc_local);
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            for (grb::IndexType v = 0; v < n; ++v)
+            {
+                bc[v] += bc_local[v];
+            }
+        }
+
+        return bc;
+    }
+}
+
 //****************************************************************************
 
 
@@ -53,7 +203,6 @@ namespace algorithms
      * @todo This version extracts source neighbors for the first frontier
      *       It precomputes 1 ./ Nsp
      *       It DOES NOT use transpose(A) in the BFS phase
-     *       *It LIMITS the number of BFS traversals to 10 iterations
      *
      * The betweenness centrality of a vertex measures the number of
      * times a vertex acts as a bridge along the shortest path between two
@@ -124,9 +273,8 @@ namespace algorithms
         std::vector<std::unique_ptr<grb::Matrix<bool>>> Sigmas;
         int32_t d = 0;
 
-        // For testing purpose we only allow 10 iterations so it doesn't
-        // get into an infinite loop
-        while (Frontier.nvals() > 0 && d < 10)
+        // Terminates: the !NumSP mask drops every vertex already reached
+        while (Frontier.nvals() > 0)
         {
             GRB_BC_LOG("------- BFS iteration " << d << " --------");
 
@@ -1296,4 +1444,94 @@ namespace algorithms
         return score;
     }
 
+    //************************************************************************
+    /**
+     * @brief Compute the vertex betweenness centrality contributions from a
+     *        set of source vertices, processing batches of sources in
+     *        parallel.
+     *
+     * Each source is one Brandes traversal over a compressed row copy of
+     * the graph's structure; the BFS levels are stored as slices of a
+     * single visit order list, so memory is O(n) per thread regardless of
+     * the depth of the search (there is no depth limit).  Batches of
+     * batch_size sources are distributed over the threads when compiled
+     * with OpenMP.
+     *
+     * @param[in]  A           The graph (unweighted; only the structure is
+     *                         used).
+     * @param[in]  s           The source vertices.
+     * @param[in]  batch_size  The number of sources handled per task.
+     *
+     * @return The betweenness centrality of all vertices relative to the
+     *         specified source vertices.
+     */
+    template<typename MatrixT>
+    std::vector<float>
+    vertex_betweenness_centrality_parallel(MatrixT             const &A,
+                                           grb::IndexArrayType const &s,
+                                           grb::IndexType batch_size = 64)
+    {
+        grb::IndexType n(A.nrows());
+        if ((n != A.ncols()) || (batch_size == 0))
+        {
+            throw grb::DimensionException();
+        }
+        for (auto src : s)
+        {
+            if (src >= n) throw grb::IndexOutOfBoundsException();
+        }
+
+        auto bc(bc_from_sources<double>(BCGraph(A), s, batch_size));
+        return std::vector<float>(bc.begin(), bc.end());
+    }
+
+    //************************************************************************
+    /**
+     * @brief Estimate the vertex betweenness centrality of all vertices from
+     *        a uniform random sample of source vertices.
+     *
+     * The contributions of num_samples distinct sources are scaled by
+     * n/num_samples; with num_samples >= n this is the exact result.
+     *
+     * @param[in]  A            The graph (only the structure is used).
+     * @param[in]  num_samples  The number of source vertices to sample.
+     * @param[in]  seed         The seed for the source sampling.
+     * @param[in]  batch_size   The number of sources handled per task.
+     *
+     * @return The estimated betweenness centrality of all vertices.
+     */
+    template<typename MatrixT>
+    std::vector<float>
+    approximate_betweenness_centrality(MatrixT const  &A,
+                                       grb::IndexType  num_samples,
+                                       unsigned int    seed = 0,
+                                       grb::IndexType  batch_size = 64)
+    {
+        grb::IndexType n(A.nrows());
+        if ((n != A.ncols()) || (num_samples == 0) || (batch_size == 0))
+        {
+            throw grb::DimensionException();
+        }
+
+        grb::IndexArrayType sources(n);
+        std::iota(sources.begin(), sources.end(), 0);
+        if (num_samples < n)
+        {
+            std::mt19937_64 generator(seed);
+            std::shuffle(sources.begin(), sources.end(), generator);
+            sources.resize(num_samples);
+            std::sort(sources.begin(), sources.end());
+        }
+
+        auto bc(bc_from_sources<double>(BCGraph(A), sources, batch_size));
+
+        double scale(static_cast<double>(n)/sources.size());
+        std::vector<float> result(n);
+        for (grb::IndexType v = 0; v < n; ++v)
+        {
+            result[v] = static_cast<float>(bc[v]*scale);
+        }
+        return result;
+    }
+
 } // algorithms
@@ -27,7 +27,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <tuple>
 
 #include <graphblas/graphblas.hpp>
@@ -35,6 +37,104 @@
 //****************************************************************************
 namespace algorithms
 {
+    //************************************************************************
+    /// Estimate of the number of output locations a vector mask allows.
+    template <typename MaskT>
+    grb::IndexType mask_allowed_count(MaskT const &mask, grb::IndexType)
+    {
+        return mask.nvals();
+    }
+
+    inline grb::IndexType mask_allowed_count(grb::NoMask const &,
+                                             grb::IndexType     n)
+    {
+        return n;
+    }
+
+    template <typename VectorT>
+    grb::IndexType mask_allowed_count(
+        grb::VectorComplementView<VectorT> const &mask, grb::IndexType)
+    {
+        // exact if all stored values of the mask are true
+        return mask.size() - mask.m_vec.nvals();
+    }
+
+    //************************************************************************
+    /**
+     * @brief Direction-optimizing (push/pull) vector-matrix multiply for
+     *        frontier expansion: w<mask> = u +.* A.
+     *
+     * While the frontier u has fewer stored values than the number of
+     * locations the mask allows this "pushes": u +.* A with each stored
+     * u[k] scattering A[k].  Otherwise it "pulls": u +.* (A')' computes a
+     * dot product of u with a row of A' only for the locations the mask
+     * allows.  In both cases the backend only computes unmasked outputs.
+     *
+     * @param[in]     u_nvals  The number of stored values in u, when the
+     *                         caller knows it: in nonblocking mode asking u
+     *                         would complete the (fusable) op producing u.
+     * @param[in]     mask_allowed  The number of locations the mask allows,
+     *                         when the caller tracks it (N minus the visited
+     *                         count for a complemented visited mask): asking
+     *                         the mask costs a pass or completes the op that
+     *                         last wrote it, every level.
+     * @param[in,out] AT       Holds A' once the first pull has built it;
+     *                         pass the same (initially empty) pointer to
+     *                         every call with the same A.
+     */
+    template <typename WVectorT,
+              typename MaskT,
+              typename AccumT,
+              typename SemiringT,
+              typename UVectorT,
+              typename MatrixT,
+              typename ATMatrixT>
+    void vxm_push_pull(WVectorT                   &w,
+                       MaskT                const &mask,
+                       AccumT               const &accum,
+                       SemiringT                   op,
+                       UVectorT             const &u,
+                       grb::IndexType              u_nvals,
+                       grb::IndexType              mask_allowed,
+                       MatrixT              const &A,
+                       std::unique_ptr<ATMatrixT> &AT,
+                       grb::OutputControlEnum      outp = grb::MERGE)
+    {
+        if (u_nvals < mask_allowed)
+        {
+            grb::vxm(w, mask, accum, op, u, A, outp);
+        }
+        else
+        {
+            if (!AT)
+            {
+                AT = std::make_unique<ATMatrixT>(A.ncols(), A.nrows());
+                grb::transpose(*AT, grb::NoMask(), grb::NoAccumulate(), A);
+            }
+            grb::vxm(w, mask, accum, op, u, grb::transpose(*AT), outp);
+        }
+    }
+
+    template <typename WVectorT,
+              typename MaskT,
+              typename AccumT,
+              typename SemiringT,
+              typename UVectorT,
+              typename MatrixT,
+              typename ATMatrixT>
+    void vxm_push_pull(WVectorT                   &w,
+                       MaskT                const &mask,
+                       AccumT               const &accum,
+                       SemiringT                   op,
+                       UVectorT             const &u,
+                       MatrixT              const &A,
+                       std::unique_ptr<ATMatrixT> &AT,
+                       grb::OutputControlEnum      outp = grb::MERGE)
+    {
+        vxm_push_pull(w, mask, accum, op, u, u.nvals(),
+                      mask_allowed_count(mask, w.size()), A, AT, outp);
+    }
+
     //************************************************************************
     /**
      * @brief Perform a single "parent" breadth first search (BFS) traversal
@@ -75,9 +175,19 @@ namespace algorithms
         parent_list.clear();
         parent_list.setElement(source, source);
 
-        while (wavefront.nvals() > 0)
+        // built on demand for the pull direction
+        std::unique_ptr<grb::Matrix<typename MatrixT::ScalarType>> graphT;
+
+        // parent_list holds the vertices of every frontier so far (each
+        // frontier is masked by it, so they are disjoint)
+        grb::IndexType num_visited(0);
+        grb::IndexType frontier_size;
+        while ((frontier_size = wavefront.nvals()) > 0)
         {
-            // convert all stored values to their column index
+            num_visited += frontier_size;
+
+            // convert all stored values to their column index (the ramp is
+            // dense, so the number of stored values does not change)
             grb::eWiseMult(wavefront,
                            grb::NoMask(), grb::NoAccumulate(),
                            grb::First<grb::IndexType>(),
@@ -86,11 +196,12 @@ namespace algorithms
             // First because we are left multiplying wavefront rows
             // Masking out the parent list ensures wavefront values do not
             // overlap values already stored in the parent list
-            grb::vxm(wavefront,
-                     grb::complement(grb::structure(parent_list)),
-                     grb::NoAccumulate(),
-                     grb::MinFirstSemiring<grb::IndexType>(),
-                     wavefront, graph, grb::REPLACE);
+            vxm_push_pull(wavefront,
+                          grb::complement(grb::structure(parent_list)),
+                          grb::NoAccumulate(),
+                          grb::MinFirstSemiring<grb::IndexType>(),
+                          wavefront, frontier_size, N - num_visited,
+                          graph, graphT, grb::REPLACE);
 
             // We don't need to mask here since we did it in mxm.
             // Merges new parents in current wavefront with existing parents
@@ -152,9 +263,19 @@ namespace algorithms
                        grb::First<grb::IndexType>(),
                        index_ramp, parent_list);
 
-        while (wavefront.nvals() > 0)
+        // built on demand for the pull direction
+        std::unique_ptr<grb::Matrix<T>> graphT;
+
+        // parent_list holds the vertices of every frontier so far (each
+        // frontier is masked by it, so they are disjoint)
+        grb::IndexType num_visited(0);
+        grb::IndexType frontier_size;
+        while ((frontier_size = wavefront.nvals()) > 0)
         {
-            // convert all stored values to their column index
+            num_visited += frontier_size;
+
+            // convert all stored values to their column index (the ramp is
+            // dense, so the number of stored values does not change)
             grb::eWiseMult(wavefront,
                            grb::NoMask(), grb::NoAccumulate(),
                            grb::First<grb::IndexType>(),
@@ -163,11 +284,12 @@ namespace algorithms
             // First because we are left multiplying wavefront rows
             // Masking out the parent list ensures wavefront values do not
             // overlap values already stored in the parent list
-            grb::vxm(wavefront,
-                     grb::complement(grb::structure(parent_list)),
-                     grb::NoAccumulate(),
-                     grb::MinFirstSemiring<T>(),
-                     wavefront, graph, grb::REPLACE);
+            vxm_push_pull(wavefront,
+                          grb::complement(grb::structure(parent_list)),
+                          grb::NoAccumulate(),
+                          grb::MinFirstSemiring<T>(),
+                          wavefront, frontier_size, N - num_visited,
+                          graph, graphT, grb::REPLACE);
 
             // We don't need to mask here since we did it in mxm.
             // Merges new parents in current wavefront with existing parents
@@ -394,11 +516,19 @@ namespace algorithms
             throw grb::DimensionException();
         }
 
+        // built on demand for the pull direction
+        std::unique_ptr<grb::Matrix<typename MatrixT::ScalarType>> graphT;
+
+        // levels gains the vertices of each frontier, which is masked by it
+        // (an estimate if roots are already stored in the levels passed in)
+        grb::IndexType num_visited(levels.nvals());
         grb::IndexType depth = 0;
-        while (wavefront.nvals() > 0)
+        grb::IndexType frontier_size;
+        while ((frontier_size = wavefront.nvals()) > 0)
         {
             // Increment the level
             ++depth;
+            num_visited += frontier_size;
 
             // Apply the level to all newly visited nodes
             grb::apply(levels,
@@ -411,12 +541,13 @@ namespace algorithms
                        grb::REPLACE);
 
             // Advance the wavefront and mask out nodes already assigned levels
-            grb::vxm(wavefront,
-                     grb::complement(levels),
-                     grb::NoAccumulate(),
-                     grb::LogicalSemiring<grb::IndexType>(),
-                     wavefront, graph,
-                     grb::REPLACE);
+            vxm_push_pull(wavefront,
+                          grb::complement(levels),
+                          grb::NoAccumulate(),
+                          grb::LogicalSemiring<grb::IndexType>(),
+                          wavefront, frontier_size,
+                          grows - std::min(num_visited, grows),
+                          graph, graphT, grb::REPLACE);
         }
     }
 
@@ -515,11 +646,19 @@ namespace algorithms
             throw grb::DimensionException();
         }
 
+        // built on demand for the pull direction
+        std::unique_ptr<grb::Matrix<typename MatrixT::ScalarType>> graphT;
+
+        // levels gains the vertices of each frontier, which is masked by it
+        // (an estimate if roots are already stored in the levels passed in)
+        grb::IndexType num_visited(levels.nvals());
         grb::IndexType depth = 0;
-        while (wavefront.nvals() > 0)
+        grb::IndexType frontier_size;
+        while ((frontier_size = wavefront.nvals()) > 0)
         {
             // Increment the level
             ++depth;
+            num_visited += frontier_size;
 
             grb::assign(levels,
                         wavefront,
@@ -529,12 +668,13 @@ namespace algorithms
                         grb::MERGE);
 
             // Advance the wavefront and mask out nodes already assigned levels
-            grb::vxm(wavefront,
-                     grb::complement(levels),
-                     grb::NoAccumulate(),
-                     grb::LogicalSemiring<grb::IndexType>(),
-                     wavefront, graph,
-                     grb::REPLACE);
+            vxm_push_pull(wavefront,
+                          grb::complement(levels),
+                          grb::NoAccumulate(),
+                          grb::LogicalSemiring<grb::IndexType>(),
+                          wavefront, frontier_size,
+                          grows - std::min(num_visited, grows),
+                          graph, graphT, grb::REPLACE);
         }
     }
 }
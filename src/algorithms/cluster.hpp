@@ -28,6 +28,10 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
 #include <math.h>
 #include <graphblas/graphblas.hpp>
 
@@ -426,30 +430,170 @@ namespace algorithms
 
     //************************************************************************
     /**
-     * @brief Compute the clusters in the given graph using markov clustering.
+     * @brief Parameters of markov_cluster.  The pruning defaults are those of
+     *        the mcl program (van Dongen, "Graph Clustering by Flow
+     *        Simulation").
+     */
+    struct MarkovClusterOptions
+    {
+        /// Expansion power e: each iteration starts with A := A^e.
+        grb::IndexType expansion             = 2;
+
+        /// Mask each product of the expansion with the previous one, so A
+        /// never gains elements outside the structure of the graph (the
+        /// expansion of the positional markov_cluster overload).
+        bool           masked_expansion      = false;
+
+        /// Inflation power r: elements are raised to r and the columns
+        /// renormalized.
+        double         inflation             = 2.0;
+
+        /// After inflation, elements below this fraction of their column's
+        /// mass are dropped (0 only drops the elements that underflowed).
+        double         prune_threshold       = 1.0e-4;
+
+        /// Keep at most this many of the largest elements of each column
+        /// (0 for no limit).
+        grb::IndexType select_k              = 1100;
+
+        /// When pruning and selection leave a column with less than
+        /// recover_mass of its mass, its largest dropped elements are put
+        /// back (up to recover_k elements in the column; 0 disables it).
+        grb::IndexType recover_k             = 1400;
+        double         recover_mass          = 0.9;
+
+        /// CHAOS: stop when the largest max(c) - sum(c.^2) over the
+        /// (stochastic) columns c falls below convergence_threshold.  The
+        /// chaos is zero exactly when the stored elements of every column
+        /// are equal, as they are at the MCL limit.
+        /// MEAN_SQUARED_CHANGE: stop when the sum of the squared changes of
+        /// the elements over one iteration, divided by N^2, falls below it.
+        enum ConvergenceTest { CHAOS, MEAN_SQUARED_CHANGE };
+        ConvergenceTest convergence_test      = CHAOS;
+        double          convergence_threshold = 1.0e-12;
+
+        unsigned int   max_iters             = 100;
+    };
+
+    namespace
+    {
+        //********************************************************************
+        // Inflate, normalize and prune the rows of the expanded (transposed)
+        // matrix held in tuples, appending what is kept to the out tuples.
+        // Returns the chaos of the kept rows.
+        template<typename RealT>
+        double mcl_inflate_prune(
+            grb::IndexArrayType                                   const &rows,
+            grb::IndexArrayType                                   const &cols,
+            std::vector<RealT>                                    const &vals,
+            MarkovClusterOptions                                  const &opts,
+            std::vector<std::tuple<grb::IndexType, RealT>>              &row_buf,
+            grb::IndexArrayType                                         &out_rows,
+            grb::IndexArrayType                                         &out_cols,
+            std::vector<RealT>                                          &out_vals)
+        {
+            out_rows.clear();
+            out_cols.clear();
+            out_vals.clear();
+
+            auto by_value([](auto const &a, auto const &b)
+                          { return std::get<1>(a) > std::get<1>(b); });
+            auto by_column([](auto const &a, auto const &b)
+                           { return std::get<0>(a) < std::get<0>(b); });
+
+            double chaos(0.);
+            size_t const nvals(vals.size());
+            size_t first(0);
+            while (first < nvals)
+            {
+                grb::IndexType row_idx(rows[first]);
+                size_t last(first);
+                RealT sum(0);
+                row_buf.clear();
+                for (; (last < nvals) && (rows[last] == row_idx); ++last)
+                {
+                    RealT val(std::pow(vals[last], opts.inflation));
+                    row_buf.emplace_back(cols[last], val);
+                    sum += val;
+                }
+                first = last;
+                if (sum <= RealT(0)) continue;
+
+                // Largest first; keep the nonzero elements above threshold
+                // (at least one), select the largest select_k of them, and
+                // then recover if too little of the mass is left.
+                std::sort(row_buf.begin(), row_buf.end(), by_value);
+                RealT const threshold(opts.prune_threshold * sum);
+                size_t num_kept(1);
+                while ((num_kept < row_buf.size()) &&
+                       (std::get<1>(row_buf[num_kept]) >= threshold) &&
+                       (std::get<1>(row_buf[num_kept]) > RealT(0)))
+                {
+                    ++num_kept;
+                }
+
+                if ((opts.select_k > 0) && (num_kept > opts.select_k))
+                {
+                    num_kept = opts.select_k;
+                }
+
+                RealT kept_sum(0);
+                for (size_t ix = 0; ix < num_kept; ++ix)
+                {
+                    kept_sum += std::get<1>(row_buf[ix]);
+                }
+
+                size_t max_kept(std::min<size_t>(opts.recover_k,
+                                                 row_buf.size()));
+                while ((num_kept < max_kept) &&
+                       (kept_sum < opts.recover_mass * sum) &&
+                       (std::get<1>(row_buf[num_kept]) > RealT(0)))
+                {
+                    kept_sum += std::get<1>(row_buf[num_kept++]);
+                }
+
+                // Renormalize what is kept and measure its chaos
+                RealT const max_val(std::get<1>(row_buf[0]) / kept_sum);
+                RealT sum_sq(0);
+                row_buf.resize(num_kept);
+                std::sort(row_buf.begin(), row_buf.end(), by_column);
+                for (auto &&[col_idx, val] : row_buf)
+                {
+                    RealT norm_val(val / kept_sum);
+                    sum_sq += norm_val * norm_val;
+                    out_rows.push_back(row_idx);
+                    out_cols.push_back(col_idx);
+                    out_vals.push_back(norm_val);
+                }
+                chaos = std::max(chaos, double(max_val - sum_sq));
+            }
+            return chaos;
+        }
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the clusters in the given graph using markov clustering
+     *        with pruning.
      *
-     * @param[in] graph     The graph to compute the clusters of.  It is
-     *                      recommended that graph has self loops added.
-     * @param[in] e         The power parameter (default 2).
-     * @param[in] r         The inflation parameter (default 2).
-     * @param[in] convergence_threshold  If the mean-squared difference in the
-     *                      cluster_matrix of two successive iterations falls
-     *                      below this threshold the algorithm will return the
-     *                      last computed matrix.
-     * @param[in] max_iters The maximum number of iterations to run if
-     *                      convergence doesn't occur first (oscillation common)
+     * The iteration runs on the transpose of the column stochastic matrix so
+     * that the per-column inflation, pruning and selection are row passes.
+     * Inflation, normalization, pruning and the chaos test are a single
+     * pass over the expanded matrix, and the matrices and tuple buffers are
+     * reused across iterations.
+     *
+     * @param[in] graph  The graph to compute the clusters of.  It is
+     *                   recommended that graph has self loops added.
+     * @param[in] opts   Expansion, inflation, pruning and stopping
+     *                   parameters.
      *
      * @return A matrix whose columns correspond to the vertices, and vertices
      *         with the same (max) value in a given row belong to the
      *         same cluster.
      */
     template<typename MatrixT, typename RealT=double>
-    grb::Matrix<RealT> markov_cluster(
-        MatrixT const  &graph,
-        grb::IndexType  e = 2,
-        grb::IndexType  r = 2,
-        double          convergence_threshold = 1.0e-16,
-        unsigned int    max_iters = std::numeric_limits<unsigned int>::max())
+    grb::Matrix<RealT> markov_cluster(MatrixT              const &graph,
+                                      MarkovClusterOptions const &opts)
     {
         using RealMatrixT = grb::Matrix<RealT>;
 
@@ -460,76 +604,150 @@ namespace algorithms
             throw grb::DimensionException();
         }
 
-        // A = (RealT)graph
-        RealMatrixT Anorm(rows, cols);
-        grb::apply(Anorm,
+        // M = (RealT)graph', rows normalized
+        RealMatrixT M(rows, cols);
+        grb::apply(M,
                    grb::NoMask(), grb::NoAccumulate(),
                    grb::Identity<RealT>(),
-                   graph);
-        grb::normalize_cols(Anorm);
-        //grb::print_matrix(std::cout, Anorm, "Anorm");
+                   grb::transpose(graph));
+        grb::normalize_rows(M);
 
-        for (unsigned int iter = 0; iter < max_iters; ++iter)
-        {
-            //std::cout << "================= ITERATION " << iter << "============="
-            //          << std::endl;
-            //grb::print_matrix(std::cout, Anorm, "A(col norm)");
+        RealMatrixT Mpower(rows, cols);
+        RealMatrixT Mprev(rows, cols);
+        grb::IndexArrayType in_rows, in_cols, out_rows, out_cols;
+        std::vector<RealT> in_vals, out_vals;
+        std::vector<std::tuple<grb::IndexType, RealT>> row_buf;
 
-            // Power Expansion: compute Anorm^e.
-            RealMatrixT Apower(Anorm);
-            for (grb::IndexType k = 0; k < (e - 1); ++k)
+        for (unsigned int iter = 0; iter < opts.max_iters; ++iter)
+        {
+            // Expansion: Mpower = M^e
+            if (opts.masked_expansion)
+            {
+                grb::apply(Mpower,
+                           grb::NoMask(), grb::NoAccumulate(),
+                           grb::Identity<RealT>(), M);
+                for (grb::IndexType k = 1; k < opts.expansion; ++k)
+                {
+                    grb::mxm(Mpower,
+                             Mpower, grb::NoAccumulate(),
+                             grb::ArithmeticSemiring<RealT>(),
+                             M, Mpower, grb::REPLACE);
+                }
+            }
+            else if (opts.expansion < 2)
+            {
+                grb::apply(Mpower,
+                           grb::NoMask(), grb::NoAccumulate(),
+                           grb::Identity<RealT>(), M);
+            }
+            else
             {
-                grb::mxm(Apower,
-                         Apower, grb::NoAccumulate(),
+                grb::mxm(Mpower,
+                         grb::NoMask(), grb::NoAccumulate(),
                          grb::ArithmeticSemiring<RealT>(),
-                         Apower, Anorm, grb::REPLACE);
+                         M, M);
+                for (grb::IndexType k = 2; k < opts.expansion; ++k)
+                {
+                    grb::mxm(Mpower,
+                             grb::NoMask(), grb::NoAccumulate(),
+                             grb::ArithmeticSemiring<RealT>(),
+                             Mpower, M);
+                }
             }
 
-            //grb::print_matrix(std::cout, Apower, "Apower = Anorm^e");
+            // Inflation, pruning and normalization: M = prune(Mpower .^ r)
+            grb::IndexType nvals(Mpower.nvals());
+            in_rows.resize(nvals);
+            in_cols.resize(nvals);
+            in_vals.resize(nvals);
+            Mpower.extractTuples(in_rows.begin(), in_cols.begin(),
+                                 in_vals.begin());
+
+            double change(mcl_inflate_prune(in_rows, in_cols, in_vals, opts,
+                                            row_buf,
+                                            out_rows, out_cols, out_vals));
+            if (opts.convergence_test ==
+                MarkovClusterOptions::MEAN_SQUARED_CHANGE)
+            {
+                Mprev = M;
+            }
+            M.clear();
+            M.build(out_rows.begin(), out_cols.begin(), out_vals.begin(),
+                    out_vals.size());
 
-            // Inflate. element wise raise to power r, normalize columns
-            RealMatrixT Ainfl(Apower);
-            for (grb::IndexType k = 0; k < (r - 1); ++k)
+            if (opts.convergence_test ==
+                MarkovClusterOptions::MEAN_SQUARED_CHANGE)
             {
-                grb::eWiseMult(Ainfl,
-                               Ainfl,
-                               grb::NoAccumulate(),
+                // E = (Mprev - M).^2, summed and divided by N^2
+                grb::eWiseAdd(Mprev,
+                              grb::NoMask(), grb::NoAccumulate(),
+                              grb::Minus<RealT>(),
+                              Mprev, M);
+                grb::eWiseMult(Mprev,
+                               grb::NoMask(), grb::NoAccumulate(),
                                grb::Times<RealT>(),
-                               Ainfl, Apower, grb::REPLACE);
+                               Mprev, Mprev);
+                RealT squared_change(0);
+                grb::reduce(squared_change,
+                            grb::NoAccumulate(),
+                            grb::PlusMonoid<RealT>(),
+                            Mprev);
+                change = squared_change/((double)rows*(double)rows);
             }
-            //grb::print_matrix(std::cout, Ainfl, "Ainfl = Apower .^ r");
-            grb::normalize_cols(Ainfl);
-            //grb::print_matrix(std::cout, Ainfl, "*** new Anorm ***");
-
-            // Compute mean squared error
-            RealMatrixT E(rows, cols);
-            grb::eWiseAdd(E,
-                          grb::NoMask(), grb::NoAccumulate(),
-                          grb::Minus<RealT>(),
-                          Anorm, Ainfl);
-            grb::eWiseMult(E,
-                           grb::NoMask(), grb::NoAccumulate(),
-                           grb::Times<RealT>(),
-                           E, E);
-            RealT mean_squared_error(0.);
-            grb::reduce(mean_squared_error,
-                        grb::NoAccumulate(),
-                        grb::PlusMonoid<RealT>(),
-                        E);
-            mean_squared_error /= ((double)rows*(double)rows);
-            //std::cout << "****|error|^2/N^2 = " << mean_squared_error << std::endl;
-
-            if (mean_squared_error < convergence_threshold) //(Ainfl == Anorm)
+
+            if (change < opts.convergence_threshold)
             {
-                //std::cout << "****CONVERGED****" << std::endl;
-                return Ainfl;
+                break;
             }
-
-            Anorm = Ainfl;
         }
 
-        //std::cout << "Exceeded max interations." << std::endl;
-        return Anorm;
+        RealMatrixT result(rows, cols);
+        grb::transpose(result, grb::NoMask(), grb::NoAccumulate(), M);
+        return result;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the clusters in the given graph using markov clustering
+     *        without pruning.
+     *
+     * Every element of the inflated matrix is kept (pruning is opt-in
+     * through MarkovClusterOptions) and convergence is the mean squared
+     * change of the matrix over one iteration.
+     *
+     * @param[in] graph     The graph to compute the clusters of.  It is
+     *                      recommended that graph has self loops added.
+     * @param[in] e         The power parameter (default 2).
+     * @param[in] r         The inflation parameter (default 2).
+     * @param[in] convergence_threshold  The algorithm returns when the sum
+     *                      of the squared changes of the cluster matrix over
+     *                      one iteration, divided by N^2, falls below this.
+     * @param[in] max_iters The maximum number of iterations to run if
+     *                      convergence doesn't occur first (oscillation common)
+     *
+     * @return A matrix whose columns correspond to the vertices, and vertices
+     *         with the same (max) value in a given row belong to the
+     *         same cluster.
+     */
+    template<typename MatrixT, typename RealT=double>
+    grb::Matrix<RealT> markov_cluster(
+        MatrixT const  &graph,
+        grb::IndexType  e = 2,
+        grb::IndexType  r = 2,
+        double          convergence_threshold = 1.0e-16,
+        unsigned int    max_iters = std::numeric_limits<unsigned int>::max())
+    {
+        MarkovClusterOptions opts;
+        opts.expansion             = e;
+        opts.inflation             = double(r);
+        opts.masked_expansion      = true;
+        opts.prune_threshold       = 0.0;
+        opts.select_k              = 0;
+        opts.recover_k             = 0;
+        opts.convergence_test      = MarkovClusterOptions::MEAN_SQUARED_CHANGE;
+        opts.convergence_threshold = convergence_threshold;
+        opts.max_iters             = max_iters;
+        return markov_cluster<MatrixT, RealT>(graph, opts);
     }
 
 } // algorithms
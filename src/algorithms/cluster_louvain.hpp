@@ -29,9 +29,181 @@
 
 #include <vector>
 #include <random>
+#include <numeric>
+#include <algorithm>
+#include <limits>
 #include <graphblas/graphblas.hpp>
 #include <graphblas/matrix_utils.hpp>
 
+//****************************************************************************
+namespace
+{
+    /// Symmetric weighted graph in compressed row form, used by the local
+    /// moving phase of louvain_cluster_multilevel.
+    template <typename RealT>
+    struct LouvainGraph
+    {
+        grb::CsrMatrix<RealT> adj;    ///< edge weights
+        std::vector<RealT>    k;      ///< weighted degree (row sums)
+        RealT                 two_m;  ///< sum of all weighted degrees
+
+        /// Compress W once: O(nvals(W) + nrows(W))
+        explicit LouvainGraph(grb::Matrix<RealT> const &W)
+            : adj(W),
+              k(W.nrows(), static_cast<RealT>(0))
+        {
+            auto const &row_ptr(adj.rowPointers());
+            auto const &weight(adj.values());
+            for (grb::IndexType i = 0; i < num_nodes(); ++i)
+            {
+                k[i] = std::accumulate(weight.begin() + row_ptr[i],
+                                       weight.begin() + row_ptr[i + 1],
+                                       static_cast<RealT>(0));
+            }
+            two_m = std::accumulate(k.begin(), k.end(),
+                                    static_cast<RealT>(0));
+        }
+
+        grb::IndexType num_nodes() const { return k.size(); }
+    };
+
+    //************************************************************************
+    /// Q = sum_c [ in_c/2m - (tot_c/2m)^2 ], O(nvals(g))
+    template <typename RealT>
+    RealT louvain_modularity(LouvainGraph<RealT>         const &g,
+                             std::vector<grb::IndexType> const &comm)
+    {
+        grb::IndexType n(g.num_nodes());
+        std::vector<RealT> in(n, static_cast<RealT>(0));
+        std::vector<RealT> tot(n, static_cast<RealT>(0));
+
+        auto const &row_ptr(g.adj.rowPointers());
+        auto const &col_idx(g.adj.colIndices());
+        auto const &weight(g.adj.values());
+        for (grb::IndexType i = 0; i < n; ++i)
+        {
+            tot[comm[i]] += g.k[i];
+            for (grb::IndexType p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+            {
+                if (comm[col_idx[p]] == comm[i]) in[comm[i]] += weight[p];
+            }
+        }
+
+        RealT q(0);
+        for (grb::IndexType c = 0; c < n; ++c)
+        {
+            RealT frac(tot[c]/g.two_m);
+            q += in[c]/g.two_m - frac*frac;
+        }
+        return q;
+    }
+
+    //************************************************************************
+    /**
+     * Move single vertices between neighbouring communities (starting from
+     * singletons) while modularity increases.  The community totals are
+     * maintained incrementally, and the weights from a vertex to each of its
+     * neighbouring communities are gathered into a sparse accumulator, so a
+     * sweep is O(nvals(g)).
+     *
+     * @return true if any vertex changed community.
+     */
+    template <typename RealT, typename GeneratorT>
+    bool louvain_local_moves(LouvainGraph<RealT>   const &g,
+                             std::vector<grb::IndexType> &comm,
+                             GeneratorT                  &generator,
+                             unsigned int                 max_sweeps,
+                             RealT                        min_gain)
+    {
+        grb::IndexType n(g.num_nodes());
+        comm.resize(n);
+        std::iota(comm.begin(), comm.end(), 0);
+
+        std::vector<RealT> tot(g.k);
+        auto const &row_ptr(g.adj.rowPointers());
+        auto const &col_idx(g.adj.colIndices());
+        auto const &weight(g.adj.values());
+
+        // sparse accumulator over the neighbouring communities
+        std::vector<RealT>          neigh_weight(n, static_cast<RealT>(0));
+        std::vector<char>           touched(n, 0);
+        std::vector<grb::IndexType> neigh_comm;
+
+        std::vector<grb::IndexType> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), generator);
+
+        bool  any_moved(false);
+        RealT q(louvain_modularity(g, comm));
+
+        for (unsigned int sweep = 0; sweep < max_sweeps; ++sweep)
+        {
+            grb::IndexType moves(0);
+
+            for (auto i : order)
+            {
+                // isolated vertices stay in their own community
+                if (g.k[i] == static_cast<RealT>(0)) continue;
+
+                grb::IndexType ci(comm[i]);
+                RealT          ki(g.k[i]);
+
+                neigh_comm.clear();
+                touched[ci] = 1;
+                neigh_weight[ci] = static_cast<RealT>(0);
+                neigh_comm.push_back(ci);
+
+                for (grb::IndexType p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+                {
+                    grb::IndexType j(col_idx[p]);
+                    if (j == i) continue;
+
+                    grb::IndexType cj(comm[j]);
+                    if (!touched[cj])
+                    {
+                        touched[cj] = 1;
+                        neigh_weight[cj] = static_cast<RealT>(0);
+                        neigh_comm.push_back(cj);
+                    }
+                    neigh_weight[cj] += weight[p];
+                }
+
+                // remove i from its community, then find the best to rejoin;
+                // ties keep the current community.
+                tot[ci] -= ki;
+                grb::IndexType best(ci);
+                RealT best_gain(neigh_weight[ci] - tot[ci]*ki/g.two_m);
+                for (auto c : neigh_comm)
+                {
+                    RealT gain(neigh_weight[c] - tot[c]*ki/g.two_m);
+                    if (gain > best_gain)
+                    {
+                        best = c;
+                        best_gain = gain;
+                    }
+                    touched[c] = 0;
+                }
+                tot[best] += ki;
+
+                if (best != ci)
+                {
+                    comm[i] = best;
+                    ++moves;
+                }
+            }
+
+            if (moves == 0) break;
+            any_moved = true;
+
+            RealT new_q(louvain_modularity(g, comm));
+            if (new_q - q < min_gain) break;
+            q = new_q;
+        }
+
+        return any_moved;
+    }
+}
+
 //****************************************************************************
 namespace algorithms
 {
@@ -84,6 +256,9 @@ namespace algorithms
      * @return A matrix whose columns correspond to the vertices, and vertices
      *         with the same (max) value in a given row belong to the
      *         same cluster.
+     *
+     * @note Every vertex update is a vxm against all of S; use
+     *       louvain_cluster_multilevel for large graphs.
      */
     template<typename MatrixT, typename RealT=double>
     grb::Matrix<bool> louvain_cluster(
@@ -126,10 +301,8 @@ namespace algorithms
 
         grb::Vector<bool> S_row(rows);
 
-        // create a dense mask vector of all trues
-        grb::Vector<bool> mask(rows);
-        grb::assign(mask, grb::NoMask(), grb::NoAccumulate(),
-                    true, grb::AllIndices());
+        // assigned to a row of S to clear it
+        grb::Vector<bool> empty_row(rows);
 
         //SetRandom<RealT> set_random(random_seed);
         std::default_random_engine             generator;
@@ -158,22 +331,16 @@ namespace algorithms
                                  grb::transpose(S),
                                  grb::AllIndices(), i);
 
-                    // S := (I - e_i*e_i')S means clear i-th row of S (using a mask)
-                    grb::Matrix<bool> Mask(rows, rows);
-                    grb::assign(Mask, grb::NoMask(),
+                    // S := (I - e_i*e_i')S means clear i-th row of S
+                    grb::assign(S, grb::NoMask(),
                                 grb::NoAccumulate(),
-                                mask, i, grb::AllIndices());
-
-                    grb::apply(S, grb::complement(Mask),
-                               grb::NoAccumulate(),
-                               grb::Identity<bool>(),
-                               S, grb::REPLACE);
+                                empty_row, i, grb::AllIndices());
 
                     // v' = e_i' * (A + A') == extract row i of (A + A')
                     grb::Vector<RealT> v(rows);
                     grb::extract(v, grb::NoMask(),
                                  grb::NoAccumulate(),
-                                 ApAT,
+                                 grb::transpose(ApAT),
                                  grb::AllIndices(), i);
 
                     // v' += (-k_i/m)*k'
@@ -347,10 +514,8 @@ namespace algorithms
 
         grb::Vector<bool> S_row(rows);
 
-        // create a dense mask vector of all trues
-        grb::Vector<bool> mask(rows);
-        grb::assign(mask, grb::NoMask(), grb::NoAccumulate(),
-                    true, grb::AllIndices());
+        // assigned to a row of S to clear it
+        grb::Vector<bool> empty_row(rows);
 
         //SetRandom<RealT> set_random(random_seed);
         std::default_random_engine             generator;
@@ -385,16 +550,10 @@ namespace algorithms
                                  grb::transpose(S),
                                  grb::AllIndices(), i);
 
-                    // S := (I - e_i*e_i')S means clear i-th row of S (using a mask)
-                    grb::Matrix<bool> Mask(rows, rows);
-                    grb::assign(Mask, grb::NoMask(),
+                    // S := (I - e_i*e_i')S means clear i-th row of S
+                    grb::assign(S, grb::NoMask(),
                                 grb::NoAccumulate(),
-                                mask, i, grb::AllIndices());
-
-                    grb::apply(S, grb::complement(Mask),
-                               grb::NoAccumulate(),
-                               grb::Identity<bool>(),
-                               S, grb::REPLACE);
+                                empty_row, i, grb::AllIndices());
 
                     // v' = e_i' * (A + A') == extract row i of (A + A')
                     grb::extract(v, grb::NoMask(),
@@ -530,4 +689,126 @@ namespace algorithms
         return S;
     }
 
+    //************************************************************************
+    /**
+     * @brief Compute the communities of a graph using the multilevel Louvain
+     *        method (Blondel et al.).
+     *
+     * Each phase moves single vertices between neighbouring communities
+     * while modularity increases, then coarsens the graph so that every
+     * community becomes one vertex (W := S' * W * S) and repeats on the
+     * smaller graph.  Unlike louvain_cluster, no per-vertex N x N
+     * temporaries are created: a sweep over the vertices is O(nvals).
+     *
+     * @param[in]  graph        NxN adjacency matrix; can be weighted.  A
+     *                          directed graph is symmetrized as (A + A')/2.
+     * @param[out] communities  N vector holding the community ID of each
+     *                          vertex (IDs are consecutive and zero-based).
+     * @param[in]  random_seed  The seed for the RNG that orders the vertices
+     * @param[in]  max_phases   The maximum number of coarsening phases
+     * @param[in]  max_sweeps   The maximum number of sweeps in each phase
+     * @param[in]  min_gain     Stop when a sweep or phase improves modularity
+     *                          by less than this amount.
+     *
+     * @return The modularity of the partition at the end of each phase.
+     */
+    template<typename MatrixT, typename RealT=double>
+    std::vector<RealT> louvain_cluster_multilevel(
+        MatrixT const               &graph,
+        grb::Vector<grb::IndexType> &communities,
+        double                       random_seed = 11.0, // arbitrary
+        unsigned int                 max_phases =
+                                      std::numeric_limits<unsigned int>::max(),
+        unsigned int                 max_sweeps =
+                                      std::numeric_limits<unsigned int>::max(),
+        RealT                        min_gain = 1.e-7)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::IndexType rows(graph.nrows());
+        grb::IndexType cols(graph.ncols());
+        if ((rows != cols) || (communities.size() != rows))
+        {
+            throw grb::DimensionException();
+        }
+
+        // W = (A + A')/2
+        grb::Matrix<RealT> A(rows, rows);
+        grb::apply(A, grb::NoMask(), grb::NoAccumulate(),
+                   grb::Identity<T, RealT>(), graph);
+        grb::Matrix<RealT> W(A);
+        grb::transpose(W, grb::NoMask(), grb::Plus<RealT>(), A);
+        grb::apply(W, grb::NoMask(), grb::NoAccumulate(),
+                   std::bind(grb::Times<RealT>(),
+                             std::placeholders::_1,
+                             static_cast<RealT>(0.5)),
+                   W);
+        A.clear();
+
+        // community of each original vertex
+        std::vector<grb::IndexType> vertex_comm(rows);
+        std::iota(vertex_comm.begin(), vertex_comm.end(), 0);
+
+        std::vector<RealT> modularity;
+
+        std::default_random_engine generator;
+        generator.seed(random_seed);
+
+        std::vector<grb::IndexType> comm;
+        for (unsigned int phase = 0; phase < max_phases; ++phase)
+        {
+            if (W.nvals() == 0) break;
+
+            LouvainGraph<RealT> g(W);
+            if (!louvain_local_moves(g, comm, generator, max_sweeps, min_gain))
+            {
+                if (modularity.empty())
+                {
+                    modularity.push_back(louvain_modularity(g, comm));
+                }
+                break;
+            }
+
+            // renumber the surviving communities consecutively
+            grb::IndexType n(g.num_nodes());
+            std::vector<grb::IndexType> renum(n, n);
+            grb::IndexType num_comms(0);
+            for (auto &c : comm)
+            {
+                if (renum[c] == n) renum[c] = num_comms++;
+                c = renum[c];
+            }
+
+            for (auto &c : vertex_comm) c = comm[c];
+
+            RealT q(louvain_modularity(g, comm));
+            bool  converged(!modularity.empty() &&
+                            (q - modularity.back() < min_gain));
+            modularity.push_back(q);
+            if (converged || (num_comms == n)) break;
+
+            // coarsen: W := S' * W * S, S(i, comm[i]) = 1
+            grb::IndexArrayType node_ids(n);
+            std::iota(node_ids.begin(), node_ids.end(), 0);
+            grb::Matrix<RealT> S(n, num_comms);
+            S.build(node_ids, comm,
+                    std::vector<RealT>(n, static_cast<RealT>(1)));
+
+            grb::Matrix<RealT> WS(n, num_comms);
+            grb::mxm(WS, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<RealT>(), W, S);
+            grb::Matrix<RealT> Wc(num_comms, num_comms);
+            grb::mxm(Wc, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<RealT>(), grb::transpose(S), WS);
+            W = std::move(Wc);
+        }
+
+        grb::IndexArrayType vertex_ids(rows);
+        std::iota(vertex_ids.begin(), vertex_ids.end(), 0);
+        communities.clear();
+        communities.build(vertex_ids, vertex_comm);
+
+        return modularity;
+    }
+
 } // algorithms
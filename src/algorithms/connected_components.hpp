@@ -0,0 +1,214 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+namespace algorithms
+{
+    /**
+     * @brief Label the connected components of an undirected graph using
+     *        the FastSV algorithm (Zhang, Azad and Hu).
+     *
+     * Every vertex keeps a parent f (initially itself) and repeats, until
+     * the grandparents gp = f(f) stop changing:
+     *
+     *   mngp = min(mngp, A min.second gp)  (min grandparent of neighbors)
+     *   f(f(u)) = min(f(f(u)), mngp(u))    (stochastic hooking)
+     *   f = min(f, mngp)                   (aggressive hooking)
+     *   f = min(f, gp)                     (shortcutting)
+     *   gp = f(f)                          (pointer jumping with extract)
+     *
+     * The stochastic hooking scatters onto f(u), which may repeat; instead
+     * of an assign with duplicate indices it is a min.second mxv with the
+     * (parent x vertex) membership matrix so the result is well defined.
+     *
+     * Each pass is O(nnz + N) and the number of passes is typically
+     * O(log N), against one BFS per component for a BFS based labeling.
+     *
+     * @param[in]  graph       NxN adjacency matrix of an undirected graph
+     *                         (structure only; it must be symmetric, so pass
+     *                         A + A' to get the weakly connected components
+     *                         of a directed graph).
+     * @param[out] components  On return, components[v] is the smallest vertex
+     *                         id in v's component (dense; any previous
+     *                         contents are replaced).
+     *
+     * @return The number of connected components.
+     */
+    template <typename MatrixT>
+    grb::IndexType connected_components(
+        MatrixT const               &graph,
+        grb::Vector<grb::IndexType> &components)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::IndexType num_nodes(graph.nrows());
+        if ((graph.ncols() != num_nodes) || (components.size() != num_nodes))
+        {
+            throw grb::DimensionException();
+        }
+        if (num_nodes == 0)
+        {
+            return 0;
+        }
+
+        grb::IndexArrayType vertices(num_nodes);
+        for (grb::IndexType ix = 0; ix < num_nodes; ++ix)
+        {
+            vertices[ix] = ix;
+        }
+        grb::IndexArrayType parents(vertices);
+
+        grb::Vector<grb::IndexType> f(parents);
+        grb::Vector<grb::IndexType> gp(f);
+        grb::Vector<grb::IndexType> mngp(f);
+        grb::Vector<grb::IndexType> gp_prev(num_nodes);
+
+        grb::Matrix<bool> membership(num_nodes, num_nodes);
+        std::vector<bool> ones(num_nodes, true);
+
+        do
+        {
+            // minimum grandparent over each vertex's neighbors
+            grb::mxv(mngp, grb::NoMask(), grb::Min<grb::IndexType>(),
+                     grb::MinSecondSemiring<T, grb::IndexType,
+                                            grb::IndexType>(),
+                     graph, gp);
+
+            // stochastic hooking: f(f(u)) = min(f(f(u)), mngp(u))
+            membership.clear();
+            membership.build(parents.begin(), vertices.begin(), ones.begin(),
+                             num_nodes);
+            grb::mxv(f, grb::NoMask(), grb::Min<grb::IndexType>(),
+                     grb::MinSecondSemiring<bool, grb::IndexType,
+                                            grb::IndexType>(),
+                     membership, mngp);
+
+            // aggressive hooking and shortcutting
+            grb::eWiseAdd(f, grb::NoMask(), grb::NoAccumulate(),
+                          grb::Min<grb::IndexType>(), f, mngp);
+            grb::eWiseAdd(f, grb::NoMask(), grb::NoAccumulate(),
+                          grb::Min<grb::IndexType>(), f, gp);
+
+            // pointer jumping: gp = f(f)
+            f.extractTuples(vertices.begin(), parents.begin());
+            gp_prev = gp;
+            grb::extract(gp, grb::NoMask(), grb::NoAccumulate(),
+                         f, parents);
+        } while (gp != gp_prev);
+
+        components = f;
+
+        grb::IndexType num_components(0);
+        for (grb::IndexType ix = 0; ix < num_nodes; ++ix)
+        {
+            if (parents[ix] == ix) ++num_components;
+        }
+        return num_components;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Expand component labels into component membership for a batch
+     *        of source vertices.
+     *
+     * The answer to a batch of reachability BFS's on an undirected graph:
+     * members(k, v) is true iff v is in the same component as sources[k].
+     * The labels can be computed once with connected_components and reused
+     * for any number of batches.
+     *
+     * @param[in]  components  Component labels from connected_components.
+     * @param[in]  sources     The source vertices of the batch.
+     * @param[out] members     sources.size() x N matrix of the vertices in
+     *                         each source's component.
+     */
+    template <typename MembersMatrixT>
+    void component_members(grb::Vector<grb::IndexType> const &components,
+                           grb::IndexArrayType         const &sources,
+                           MembersMatrixT                    &members)
+    {
+        using T = typename MembersMatrixT::ScalarType;
+
+        grb::IndexType num_nodes(components.size());
+        if ((members.nrows() != sources.size()) ||
+            (members.ncols() != num_nodes) ||
+            (components.nvals() != num_nodes))
+        {
+            throw grb::DimensionException();
+        }
+
+        grb::IndexArrayType vertices(num_nodes), labels(num_nodes);
+        components.extractTuples(vertices.begin(), labels.begin());
+
+        // (label x vertex) membership, then the rows of the sources' labels
+        std::vector<T> ones(num_nodes, static_cast<T>(true));
+        grb::Matrix<T> membership(num_nodes, num_nodes);
+        membership.build(labels.begin(), vertices.begin(), ones.begin(),
+                         num_nodes);
+
+        grb::IndexArrayType source_labels(sources.size());
+        for (grb::IndexType ix = 0; ix < sources.size(); ++ix)
+        {
+            source_labels[ix] = labels[sources[ix]];
+        }
+
+        grb::extract(members, grb::NoMask(), grb::NoAccumulate(),
+                     membership, source_labels, grb::AllIndices(),
+                     grb::REPLACE);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Component membership of a batch of source vertices, computed
+     *        with connected_components (one FastSV run for the whole batch).
+     *
+     * @param[in]  graph    NxN adjacency matrix of an undirected graph.
+     * @param[in]  sources  The source vertices of the batch.
+     * @param[out] members  sources.size() x N matrix: members(k, v) is true
+     *                      iff v is in the same component as sources[k].
+     *
+     * @return The number of connected components in the graph.
+     */
+    template <typename MatrixT, typename MembersMatrixT>
+    grb::IndexType batch_connected_components(
+        MatrixT             const &graph,
+        grb::IndexArrayType const &sources,
+        MembersMatrixT            &members)
+    {
+        grb::Vector<grb::IndexType> components(graph.nrows());
+        auto num_components(connected_components(graph, components));
+        component_members(components, sources, members);
+        return num_components;
+    }
+
+} // algorithms
@@ -29,6 +29,9 @@
 
 #include <iostream>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <numeric>
 
 #include <graphblas/graphblas.hpp>
 
@@ -52,31 +55,142 @@ namespace
 
     //************************************************************************
     template <typename T, typename LessT = std::less<T>>
-    struct SupportTest
+    struct SupportMinTest
     {
         T const m_threshold;
 
-        SupportTest(T threshold) : m_threshold(threshold) {}
+        SupportMinTest(T threshold) : m_threshold(threshold) {}
 
         bool operator()(T val)
         {
-            return LessT()(val, m_threshold);  // val < threshold
+            return !LessT()(val, m_threshold);  // val >= threshold
         }
     };
 
     //************************************************************************
-    template <typename T, typename LessT = std::less<T>>
-    struct SupportMinTest
+    /// Undirected graph for the support-maintaining truss engine: symmetric
+    /// compressed rows (sorted, no self loops) where the stored value of
+    /// every entry is the id of its undirected edge.
+    struct TrussGraph
     {
-        T const m_threshold;
+        grb::CsrMatrix<grb::IndexType> adj;
+        std::vector<grb::IndexType>    src, dst;   ///< endpoints, src < dst
 
-        SupportMinTest(T threshold) : m_threshold(threshold) {}
+        grb::IndexType num_edges() const { return src.size(); }
 
-        bool operator()(T val)
+        /// @return the id of edge {u,v}, or num_edges() if not present
+        grb::IndexType find_edge(grb::IndexType u, grb::IndexType v) const
         {
-            return !LessT()(val, m_threshold);  // val >= threshold
+            auto const &col_idx(adj.colIndices());
+            auto first(col_idx.begin() + adj.rowPointers()[u]);
+            auto last(col_idx.begin() + adj.rowPointers()[u + 1]);
+            auto it(std::lower_bound(first, last, v));
+            return ((it != last) && (*it == v)) ?
+                adj.values()[it - col_idx.begin()] : num_edges();
         }
     };
+
+    //************************************************************************
+    /// The structure of A (or of A + A' if A is not symmetric): O(nnz log nnz)
+    template <typename MatrixT>
+    TrussGraph make_truss_graph(MatrixT const &A)
+    {
+        using T = typename MatrixT::ScalarType;
+        grb::IndexType n(A.nrows());
+        grb::IndexType nvals(A.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<T> vals(nvals);
+        A.extractTuples(rows.begin(), cols.begin(), vals.begin());
+
+        std::vector<std::pair<grb::IndexType, grb::IndexType>> edges;
+        edges.reserve(nvals);
+        for (grb::IndexType idx = 0; idx < nvals; ++idx)
+        {
+            if (rows[idx] != cols[idx])
+            {
+                edges.emplace_back(std::min(rows[idx], cols[idx]),
+                                   std::max(rows[idx], cols[idx]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        grb::IndexType num_edges(edges.size());
+        std::vector<grb::IndexType> src, dst;
+        src.reserve(num_edges);
+        dst.reserve(num_edges);
+        for (auto const &[u, v] : edges)
+        {
+            src.push_back(u);
+            dst.push_back(v);
+        }
+
+        // both orientations of every edge, tagged with the edge id.  The
+        // edges are sorted by (u,v), so listing every row's smaller
+        // neighbours first, then its larger ones, leaves the rows sorted.
+        grb::IndexArrayType adj_rows(dst), adj_cols(src);
+        adj_rows.insert(adj_rows.end(), src.begin(), src.end());
+        adj_cols.insert(adj_cols.end(), dst.begin(), dst.end());
+        grb::IndexArrayType ids(2*num_edges);
+        std::iota(ids.begin(), ids.begin() + num_edges, 0);
+        std::iota(ids.begin() + num_edges, ids.end(), 0);
+
+        return TrussGraph{
+            grb::CsrMatrix<grb::IndexType>(n, n, adj_rows.begin(),
+                                           adj_cols.begin(), ids.begin(),
+                                           ids.size()),
+            std::move(src), std::move(dst)};
+    }
+
+    //************************************************************************
+    /// Call fn(e1, e2) for every triangle {e, e1, e2} whose other two edges
+    /// are still alive (merge of the two sorted endpoint rows).
+    template <typename FnT>
+    void for_each_live_triangle(TrussGraph        const &g,
+                                std::vector<char> const &alive,
+                                grb::IndexType           e,
+                                FnT                      fn)
+    {
+        auto const &row_ptr(g.adj.rowPointers());
+        auto const &col_idx(g.adj.colIndices());
+        auto const &edge_id(g.adj.values());
+
+        grb::IndexType pu(row_ptr[g.src[e]]), pu_end(row_ptr[g.src[e] + 1]);
+        grb::IndexType pv(row_ptr[g.dst[e]]), pv_end(row_ptr[g.dst[e] + 1]);
+        while ((pu < pu_end) && (pv < pv_end))
+        {
+            if (col_idx[pu] < col_idx[pv])
+            {
+                ++pu;
+            }
+            else if (col_idx[pv] < col_idx[pu])
+            {
+                ++pv;
+            }
+            else
+            {
+                grb::IndexType e1(edge_id[pu]), e2(edge_id[pv]);
+                if (alive[e1] && alive[e2]) fn(e1, e2);
+                ++pu;
+                ++pv;
+            }
+        }
+    }
+
+    //************************************************************************
+    /// Number of triangles containing each edge
+    inline std::vector<grb::IndexType> edge_support(TrussGraph const &g)
+    {
+        std::vector<char> alive(g.num_edges(), 1);
+        std::vector<grb::IndexType> support(g.num_edges(), 0);
+        for (grb::IndexType e = 0; e < g.num_edges(); ++e)
+        {
+            for_each_live_triangle(g, alive, e,
+                                   [&](grb::IndexType, grb::IndexType)
+                                   { ++support[e]; });
+        }
+        return support;
+    }
 }
 
 //****************************************************************************
@@ -145,13 +259,11 @@ namespace algorithms
 
         // 4. Determine edges which lack enough support for k-truss
         // x = find(s < k-2)
+        // (only the structure of x and xc is used)
         auto x = std::make_shared<grb::Vector<bool>>(num_edges);
-        grb::apply(*x, grb::NoMask(), grb::NoAccumulate(),
-                   SupportTest<EdgeType>(k_size - 2),
-                   *s, grb::REPLACE);
-        grb::apply(*x, *x, grb::NoAccumulate(),
-                   grb::Identity<EdgeType>(),
-                   *x, grb::REPLACE);
+        grb::select(*x, grb::NoMask(), grb::NoAccumulate(),
+                    grb::ValueLessThan<EdgeType>(),
+                    *s, static_cast<EdgeType>(k_size - 2), grb::REPLACE);
         //grb::print_vector(std::cout, *x, "edges lacking support");
 
         while (x->nvals() > 0)
@@ -170,14 +282,9 @@ namespace algorithms
 
             // Step 0b: Get the indices of 'trues' in x
             grb::Vector<bool> xc(num_edges);
-            grb::apply(
-                xc, grb::NoMask(), grb::NoAccumulate(),
-                SupportTest<EdgeType, std::greater_equal<EdgeType>>(k_size - 2),
-                *s, grb::REPLACE);
-            // masked no-op to get rid of stored falses.
-            grb::apply(xc, xc, grb::NoAccumulate(),
-                       grb::Identity<EdgeType>(),
-                       xc, grb::REPLACE);
+            grb::select(xc, grb::NoMask(), grb::NoAccumulate(),
+                        grb::ValueGreaterEqual<EdgeType>(),
+                        *s, static_cast<EdgeType>(k_size - 2), grb::REPLACE);
             //grb::print_vector(std::cout, xc, "complement(x)");
 
             grb::IndexArrayType xc_indices(xc.nvals());
@@ -258,19 +365,15 @@ namespace algorithms
 
             // 4. Determine edges which lack enough support for k-truss
             x = std::make_shared<grb::Vector<bool>>(num_edges);
-            grb::apply(*x,
-                       grb::NoMask(), grb::NoAccumulate(),
-                       SupportTest<EdgeType>(k_size - 2),
-                       *s, grb::REPLACE);
+            grb::select(*x,
+                        grb::NoMask(), grb::NoAccumulate(),
+                        grb::ValueLessThan<EdgeType>(),
+                        *s, static_cast<EdgeType>(k_size - 2), grb::REPLACE);
             //grb::print_vector(std::cout, *x, "new x");
-            grb::apply(*x, *x, grb::NoAccumulate(),
-                       grb::Identity<EdgeType>(),
-                       *x, grb::REPLACE);
-            //grb::print_vector(std::cout, *x, "new x (masked noop)");
         }
 
         // return incidence matrix containing all edges in k-trusses
-        return *E;
+        return std::move(*E);
     }
 
     //************************************************************************
@@ -319,4 +422,196 @@ namespace algorithms
         return A;
     }
 
+    //************************************************************************
+    /**
+     * @brief Compute the k-truss of an undirected graph by peeling, keeping
+     *        the support of every edge up to date instead of recomputing it.
+     *
+     * The support (number of triangles) of each edge is computed once.  An
+     * edge with support below k-2 is removed, and only the supports of the
+     * other two edges of each triangle it still closes are decremented; any
+     * edge dropping below k-2 is queued for removal in turn.
+     *
+     * @param[in] Ain     Undirected adjacency matrix (only the structure is
+     *                    used; self loops are ignored).
+     * @param[in] k_size  The k of the k-truss (k >= 2).
+     *
+     * @return The entries of Ain (less self loops) on the edges of the
+     *         k-truss.
+     */
+    template<typename AMatrixT>
+    AMatrixT k_truss_incremental(AMatrixT const &Ain,
+                                 grb::IndexType  k_size)
+    {
+        using AType = typename AMatrixT::ScalarType;
+
+        grb::IndexType num_vertices(Ain.nrows());
+        if (num_vertices != Ain.ncols())
+        {
+            throw grb::DimensionException();
+        }
+
+        TrussGraph g(make_truss_graph(Ain));
+        std::vector<grb::IndexType> support(edge_support(g));
+        grb::IndexType min_support((k_size > 2) ? k_size - 2 : 0);
+
+        std::vector<char> alive(g.num_edges(), 1);
+        std::vector<char> queued(g.num_edges(), 0);
+        std::vector<grb::IndexType> queue;
+        for (grb::IndexType e = 0; e < g.num_edges(); ++e)
+        {
+            if (support[e] < min_support)
+            {
+                queued[e] = 1;
+                queue.push_back(e);
+            }
+        }
+
+        // a triangle is broken (and its other two supports decremented)
+        // by whichever of its edges is removed first
+        for (grb::IndexType head = 0; head < queue.size(); ++head)
+        {
+            grb::IndexType e(queue[head]);
+            for_each_live_triangle(
+                g, alive, e,
+                [&](grb::IndexType e1, grb::IndexType e2)
+                {
+                    for (auto f : {e1, e2})
+                    {
+                        if ((--support[f] < min_support) && !queued[f])
+                        {
+                            queued[f] = 1;
+                            queue.push_back(f);
+                        }
+                    }
+                });
+            alive[e] = 0;
+        }
+
+        grb::IndexType nvals(Ain.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<AType> vals(nvals);
+        Ain.extractTuples(rows.begin(), cols.begin(), vals.begin());
+
+        grb::IndexType kept(0);
+        for (grb::IndexType idx = 0; idx < nvals; ++idx)
+        {
+            if ((rows[idx] != cols[idx]) &&
+                alive[g.find_edge(rows[idx], cols[idx])])
+            {
+                rows[kept] = rows[idx];
+                cols[kept] = cols[idx];
+                vals[kept] = vals[idx];
+                ++kept;
+            }
+        }
+
+        AMatrixT A(num_vertices, num_vertices);
+        A.build(rows.begin(), cols.begin(), vals.begin(), kept);
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the truss number of every edge of an undirected graph
+     *        in one pass.
+     *
+     * The truss number of an edge is the largest k such that the edge is in
+     * the k-truss (2 for an edge in no triangle).  Edges are kept in buckets
+     * by support and repeatedly the edge of least support s is removed and
+     * assigned s+2; the supports of the edges it shares a remaining
+     * triangle with are decremented (but not below s), moving them down one
+     * bucket in O(1).  Total work is O(sum over edges of the endpoint
+     * degrees).
+     *
+     * @param[in] Ain  Undirected adjacency matrix (only the structure is
+     *                 used; self loops are ignored).
+     *
+     * @return A symmetric matrix holding the truss number of each edge {i,j}
+     *         at (i,j) and (j,i).
+     */
+    template<typename AMatrixT>
+    grb::Matrix<grb::IndexType> truss_decomposition(AMatrixT const &Ain)
+    {
+        grb::IndexType num_vertices(Ain.nrows());
+        if (num_vertices != Ain.ncols())
+        {
+            throw grb::DimensionException();
+        }
+
+        TrussGraph g(make_truss_graph(Ain));
+        grb::IndexType num_edges(g.num_edges());
+        std::vector<grb::IndexType> support(edge_support(g));
+
+        // bucket sort the edges by support: order[bin_start[s]...] holds
+        // the unprocessed edges of support s, pos[e] is e's place in order
+        grb::IndexType max_support(
+            num_edges ? *std::max_element(support.begin(), support.end()) : 0);
+        std::vector<grb::IndexType> bin_start(max_support + 2, 0);
+        for (auto s : support) ++bin_start[s + 1];
+        for (grb::IndexType s = 0; s <= max_support; ++s)
+        {
+            bin_start[s + 1] += bin_start[s];
+        }
+
+        std::vector<grb::IndexType> order(num_edges), pos(num_edges);
+        {
+            std::vector<grb::IndexType> next(bin_start.begin(),
+                                             bin_start.end() - 1);
+            for (grb::IndexType e = 0; e < num_edges; ++e)
+            {
+                pos[e] = next[support[e]]++;
+                order[pos[e]] = e;
+            }
+        }
+
+        std::vector<char> alive(num_edges, 1);
+        std::vector<grb::IndexType> truss(num_edges);
+        for (grb::IndexType idx = 0; idx < num_edges; ++idx)
+        {
+            grb::IndexType e(order[idx]);
+            grb::IndexType s(support[e]);
+            truss[e] = s + 2;
+
+            for_each_live_triangle(
+                g, alive, e,
+                [&](grb::IndexType e1, grb::IndexType e2)
+                {
+                    for (auto f : {e1, e2})
+                    {
+                        if (support[f] > s)
+                        {
+                            // swap f with the first edge of its bucket and
+                            // shrink the bucket from the front
+                            grb::IndexType sf(support[f]);
+                            grb::IndexType first(bin_start[sf]);
+                            grb::IndexType other(order[first]);
+                            std::swap(order[pos[f]], order[first]);
+                            pos[other] = pos[f];
+                            pos[f] = first;
+                            ++bin_start[sf];
+                            --support[f];
+                        }
+                    }
+                });
+            alive[e] = 0;
+        }
+
+        grb::IndexArrayType rows, cols;
+        std::vector<grb::IndexType> vals;
+        rows.reserve(2*num_edges);
+        cols.reserve(2*num_edges);
+        vals.reserve(2*num_edges);
+        for (grb::IndexType e = 0; e < num_edges; ++e)
+        {
+            rows.push_back(g.src[e]);  cols.push_back(g.dst[e]);
+            rows.push_back(g.dst[e]);  cols.push_back(g.src[e]);
+            vals.push_back(truss[e]);
+            vals.push_back(truss[e]);
+        }
+
+        grb::Matrix<grb::IndexType> T(num_vertices, num_vertices);
+        T.build(rows, cols, vals);
+        return T;
+    }
 }
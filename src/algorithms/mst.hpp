@@ -27,12 +27,104 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
+#include <tuple>
+#include <limits>
 #include <iostream>
 
 #include <graphblas/graphblas.hpp>
 
+//****************************************************************************
+namespace
+{
+    //************************************************************************
+    /// An undirected edge {lo, hi} (lo < hi) with its weight.  Edges are
+    /// totally ordered by (weight, lo, hi) so that ties between equal
+    /// weights are broken the same way by every component, which keeps
+    /// the Boruvka hooking free of cycles.
+    template <typename T>
+    struct MSFEdge
+    {
+        T              weight;
+        grb::IndexType lo;
+        grb::IndexType hi;
+
+        MSFEdge(T w = std::numeric_limits<T>::max(),
+                grb::IndexType l = std::numeric_limits<grb::IndexType>::max(),
+                grb::IndexType h = std::numeric_limits<grb::IndexType>::max())
+            : weight(w), lo(l), hi(h) {}
+
+        bool operator<(MSFEdge const &rhs) const
+        {
+            return std::tie(weight, lo, hi) <
+                std::tie(rhs.weight, rhs.lo, rhs.hi);
+        }
+
+        bool operator==(MSFEdge const &rhs) const
+        {
+            return (weight == rhs.weight) && (lo == rhs.lo) && (hi == rhs.hi);
+        }
+
+        bool operator!=(MSFEdge const &rhs) const { return !(*this == rhs); }
+    };
+
+    template <typename T>
+    std::ostream &operator<<(std::ostream &ostr, MSFEdge<T> const &e)
+    {
+        ostr << "(" << e.lo << "," << e.hi << ":" << e.weight << ")";
+        return ostr;
+    }
+
+    //************************************************************************
+    template <typename T>
+    struct MSFEdgeMin
+    {
+        MSFEdge<T> operator()(MSFEdge<T> const &lhs,
+                              MSFEdge<T> const &rhs) const
+        {
+            return (rhs < lhs) ? rhs : lhs;
+        }
+    };
+
+    //************************************************************************
+    /// min.second over (component x vertex) membership and per-vertex
+    /// minimum edges: yields the minimum edge leaving each component.
+    template <typename T>
+    class MSFMinSecondSemiring
+    {
+    public:
+        using first_argument_type = bool;
+        using second_argument_type = MSFEdge<T>;
+        using result_type = MSFEdge<T>;
+
+        MSFEdge<T> add(MSFEdge<T> const &a, MSFEdge<T> const &b) const
+        { return MSFEdgeMin<T>()(a, b); }
+
+        MSFEdge<T> mult(bool, MSFEdge<T> const &b) const { return b; }
+
+        MSFEdge<T> zero() const { return MSFEdge<T>(); }
+    };
+
+    //************************************************************************
+    /// Select predicate that keeps the edges whose endpoints currently
+    /// belong to different components.
+    struct MSFCrossesComponents
+    {
+        std::vector<grb::IndexType> const &m_labels;
+
+        MSFCrossesComponents(std::vector<grb::IndexType> const &labels)
+            : m_labels(labels) {}
+
+        template <typename D1>
+        bool operator()(D1, grb::IndexType i, grb::IndexType j, int64_t) const
+        {
+            return m_labels[i] != m_labels[j];
+        }
+    };
+}
+
 //****************************************************************************
 namespace algorithms
 {
@@ -227,4 +319,168 @@ namespace algorithms
         return weight;
     }
 
+    /**
+     * @brief Compute a minimum spanning forest of the given undirected graph
+     *        using Boruvka's algorithm.
+     *
+     * Every round each component (a tree of the forest built so far) picks
+     * its lightest outgoing edge: a row min-reduction of the remaining
+     * edges followed by a min.second mxv with the component membership.
+     * Components hook onto the component at the other end of their edge,
+     * parents are shortened by pointer jumping (extract f(f)) until every
+     * vertex points at its root, and the edges inside a component are
+     * removed with select.  The number of components at least halves in
+     * every round, so the total work is O((nnz + N) log N).  All of the
+     * per-edge work is done by GraphBLAS operations, so it runs in
+     * parallel on the openmp platform.
+     *
+     * The graph is treated as undirected: an edge stored in only one
+     * direction is used in both, self loops are ignored, and an edge
+     * stored in both directions with different weights uses the smaller.
+     * Unlike mst(), the graph does not need to be connected.
+     *
+     * @param[in]  graph   The NxN graph to perform the computation on.
+     * @param[out] forest  The NxN symmetric adjacency matrix of the edges of
+     *                     the minimum spanning forest (any previous
+     *                     contents are cleared).
+     *
+     * @return The total weight of the minimum spanning forest.
+     */
+    template<typename MatrixT, typename ForestMatrixT>
+    typename MatrixT::ScalarType msf(MatrixT const &graph,
+                                     ForestMatrixT &forest)
+    {
+        using T = typename MatrixT::ScalarType;
+        using EdgeT = MSFEdge<T>;
+
+        grb::IndexType num_nodes(graph.nrows());
+        if ((graph.ncols() != num_nodes) ||
+            (forest.nrows() != num_nodes) || (forest.ncols() != num_nodes))
+        {
+            throw grb::DimensionException();
+        }
+
+        // Symmetric matrix of the candidate edges, each entry holding its
+        // undirected edge (duplicates keep the lighter one)
+        grb::IndexArrayType rows, cols;
+        std::vector<EdgeT> edges;
+        {
+            grb::IndexArrayType i(graph.nvals()), j(graph.nvals());
+            std::vector<T> vals(graph.nvals());
+            graph.extractTuples(i.begin(), j.begin(), vals.begin());
+
+            rows.reserve(2*i.size());
+            cols.reserve(2*i.size());
+            edges.reserve(2*i.size());
+            for (grb::IndexType ix = 0; ix < i.size(); ++ix)
+            {
+                if (i[ix] == j[ix]) continue;
+
+                EdgeT e(vals[ix], std::min(i[ix], j[ix]),
+                        std::max(i[ix], j[ix]));
+                rows.push_back(i[ix]); cols.push_back(j[ix]); edges.push_back(e);
+                rows.push_back(j[ix]); cols.push_back(i[ix]); edges.push_back(e);
+            }
+        }
+        grb::Matrix<EdgeT> E(num_nodes, num_nodes);
+        E.build(rows.begin(), cols.begin(), edges.begin(), edges.size(),
+                MSFEdgeMin<T>());
+
+        // Every vertex starts out as its own component
+        grb::IndexArrayType vertices(num_nodes);
+        for (grb::IndexType ix = 0; ix < num_nodes; ++ix)
+        {
+            vertices[ix] = ix;
+        }
+        grb::IndexArrayType labels(vertices);
+        grb::Vector<grb::IndexType> f(labels);
+        grb::Vector<grb::IndexType> f_next(num_nodes);
+
+        grb::IndexArrayType src, dst;
+        std::vector<T> weights;
+        T weight = static_cast<T>(0);
+
+        grb::Vector<EdgeT> vertex_min(num_nodes);
+        grb::Vector<EdgeT> comp_min(num_nodes);
+        grb::Matrix<bool>  membership(num_nodes, num_nodes);
+        std::vector<bool>  ones(num_nodes, true);
+
+        grb::IndexArrayType roots, hook_roots, hooks;
+        std::vector<EdgeT>  root_edges;
+
+        while (E.nvals() > 0)
+        {
+            // Lightest edge at every vertex, then for every component
+            grb::reduce(vertex_min, grb::NoMask(), grb::NoAccumulate(),
+                        MSFEdgeMin<T>(), E, grb::REPLACE);
+
+            membership.clear();
+            membership.build(labels.begin(), vertices.begin(), ones.begin(),
+                             num_nodes);
+            grb::mxv(comp_min, grb::NoMask(), grb::NoAccumulate(),
+                     MSFMinSecondSemiring<T>(), membership, vertex_min,
+                     grb::REPLACE);
+
+            // Hook every component onto the one across its lightest edge;
+            // of two components that picked the same edge only the larger
+            // label hooks.
+            roots.resize(comp_min.nvals());
+            root_edges.resize(comp_min.nvals());
+            comp_min.extractTuples(roots.begin(), root_edges.begin());
+
+            hook_roots.clear();
+            hooks.clear();
+            for (grb::IndexType ix = 0; ix < roots.size(); ++ix)
+            {
+                grb::IndexType root(roots[ix]);
+                EdgeT const &e(root_edges[ix]);
+                grb::IndexType other((labels[e.lo] == root) ?
+                                     labels[e.hi] : labels[e.lo]);
+
+                if ((root < other) && comp_min.hasElement(other) &&
+                    (comp_min.extractElement(other) == e))
+                {
+                    continue;
+                }
+
+                hook_roots.push_back(root);
+                hooks.push_back(other);
+
+                src.push_back(e.lo);
+                dst.push_back(e.hi);
+                weights.push_back(e.weight);
+                weight += e.weight;
+            }
+
+            grb::Vector<grb::IndexType> hook_vec(hooks);
+            grb::assign(f, grb::NoMask(), grb::NoAccumulate(),
+                        hook_vec, hook_roots);
+
+            // Pointer jumping: f = f(f) until every vertex names its root
+            while (true)
+            {
+                f.extractTuples(vertices.begin(), labels.begin());
+                grb::extract(f_next, grb::NoMask(), grb::NoAccumulate(),
+                             f, labels);
+                if (f_next == f) break;
+                f = f_next;
+            }
+
+            // Drop the edges that are now inside a component
+            grb::select(E, grb::NoMask(), grb::NoAccumulate(),
+                        MSFCrossesComponents(labels), E, 0, grb::REPLACE);
+        }
+
+        forest.clear();
+        grb::IndexArrayType forest_rows(src), forest_cols(dst);
+        forest_rows.insert(forest_rows.end(), dst.begin(), dst.end());
+        forest_cols.insert(forest_cols.end(), src.begin(), src.end());
+        std::vector<T> forest_vals(weights);
+        forest_vals.insert(forest_vals.end(), weights.begin(), weights.end());
+        forest.build(forest_rows.begin(), forest_cols.begin(),
+                     forest_vals.begin(), forest_vals.size());
+
+        return weight;
+    }
+
 } // algorithms
@@ -274,21 +274,18 @@ namespace algorithms
     //************************************************************************
 
     //************************************************************************
+    // select() predicate: low <= val < low + width (low is the select value)
     template <typename ScalarT>
     struct SelectInRange
     {
-        ScalarT const m_low, m_high;
+        ScalarT const m_width;
 
-        SelectInRange(ScalarT low, ScalarT high) : m_low(low), m_high(high) {}
+        SelectInRange(ScalarT width) : m_width(width) {}
 
-        inline bool operator()(ScalarT input)
+        inline bool operator()(ScalarT val, grb::IndexType, grb::IndexType,
+                               ScalarT low) const
         {
-            if ((m_low <= input) && (input < m_high))
-            {
-                return true;
-            }
-
-            return false;
+            return ((low <= val) && (val < low + m_width));
         }
     };
 
@@ -321,37 +318,23 @@ namespace algorithms
 
         // AL = A .* (A <= delta)
         MatrixT AL(n, n);
-        grb::apply(AL, grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::LessEqual<T>(),
-                             std::placeholders::_1,
-                             static_cast<T>(delta)),
-                   graph);
-        grb::apply(AL, AL, grb::NoAccumulate(),
-                   grb::Identity<T>(), graph, grb::REPLACE);
+        grb::select(AL, grb::NoMask(), grb::NoAccumulate(),
+                    grb::ValueLessEqual<T>(), graph, delta);
         //grb::print_matrix(std::cerr, AL, "AL = A(<=delta)");
 
         // AH = A .* (A > delta)
         MatrixT AH(n, n);
-        grb::apply(AH, grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::GreaterThan<T>(),
-                             std::placeholders::_1,
-                             delta),
-                   graph);
-        grb::apply(AH, AH, grb::NoAccumulate(),
-                   grb::Identity<T>(), graph, grb::REPLACE);
+        grb::select(AH, grb::NoMask(), grb::NoAccumulate(),
+                    grb::ValueGreaterThan<T>(), graph, delta);
         //grb::print_matrix(std::cerr, AH, "AH = A(>delta)");
 
         // i = 0
         grb::IndexType i(0);
 
-        // t >= i*delta
-        grb::apply(tcomp, grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::GreaterEqual<T>(),
-                             std::placeholders::_1,
-                             static_cast<T>(i)*delta),
-                   t);
-        grb::apply(tcomp, tcomp, grb::NoAccumulate(),
-                   grb::Identity<bool>(), tcomp);
+        // t >= i*delta (only the structure of tcomp, tBi and s is used)
+        grb::select(tcomp, grb::NoMask(), grb::NoAccumulate(),
+                    grb::ValueGreaterEqual<T>(), t,
+                    static_cast<T>(i)*delta);
 
         //grb::print_vector(std::cerr, tcomp, "tcomp = t(>=i*delta)");
 
@@ -364,16 +347,15 @@ namespace algorithms
             s.clear();
 
             // tBi = t .* (i*delta <= t < (i+1)*delta)
-            SelectInRange<T> in_range((T)i*delta, ((T)(i + 1))*delta);
-            grb::apply(tBi, grb::NoMask(), grb::NoAccumulate(),
-                       in_range, t);
-            grb::apply(tBi, tBi, grb::NoAccumulate(),
-                       grb::Identity<T>(), tBi, grb::REPLACE);
+            SelectInRange<T> in_range(delta);
+            T const low(static_cast<T>(i)*delta);
+            grb::select(tBi, grb::NoMask(), grb::NoAccumulate(),
+                        in_range, t, low);
             //grb::print_vector(std::cerr, tBi,
             //                        "tBi<tless> = tReq([i*d, (i+1)*d))");
 
             // tm<tBi> = t
-            grb::apply(tmasked, tBi, grb::NoAccumulate(),
+            grb::apply(tmasked, grb::structure(tBi), grb::NoAccumulate(),
                        grb::Identity<T>(), t, grb::REPLACE);
             //grb::print_vector(std::cerr, tmasked, "tm = t<tBi>");
 
@@ -408,10 +390,10 @@ namespace algorithms
                 //grb::print_vector(std::cerr, tless, "tless<tReq> = tReq .< t");
 
                 // tBi<tless> = i*delta <= tReq < (i+1)*delta
-                grb::apply(tBi,
-                           tless,
-                           grb::NoAccumulate(),
-                           in_range, tReq, grb::REPLACE);
+                grb::select(tBi,
+                            tless,
+                            grb::NoAccumulate(),
+                            in_range, tReq, low, grb::REPLACE);
                 //grb::apply(tnew, tnew, grb::NoAccumulate(),
                 //                 grb::Identity<bool>(), tnew, grb::REPLACE);
                 //grb::print_vector(std::cerr, tBi,
@@ -426,14 +408,14 @@ namespace algorithms
                 //grb::print_vector(std::cerr, t, "t = min(t, tReq)");
 
                 // tm<tBi> = t
-                grb::apply(tmasked, tBi, grb::NoAccumulate(),
+                grb::apply(tmasked, grb::structure(tBi), grb::NoAccumulate(),
                            grb::Identity<T>(), t, grb::REPLACE);
                 //grb::print_vector(std::cerr, tmasked, "tm = t<tBi>");
             }
             //std::cerr << "******************** end inner loop *****************\n";
 
             // (t .* s)
-            grb::apply(tmasked, s, grb::NoAccumulate(),
+            grb::apply(tmasked, grb::structure(s), grb::NoAccumulate(),
                        grb::Identity<T>(), t, grb::REPLACE);
             //grb::print_vector(std::cerr, tmasked, "tm = t<s>");
 
@@ -454,15 +436,11 @@ namespace algorithms
             ++i;
 
             // t >= i*delta
-            grb::apply(tcomp,
-                       grb::NoMask(),
-                       grb::NoAccumulate(),
-                       std::bind(grb::GreaterEqual<T>(),
-                                 std::placeholders::_1,
-                                 static_cast<T>(i)*delta),
-                       t);
-            grb::apply(tcomp, tcomp, grb::NoAccumulate(),
-                       grb::Identity<bool>(), tcomp, grb::REPLACE);
+            grb::select(tcomp,
+                        grb::NoMask(),
+                        grb::NoAccumulate(),
+                        grb::ValueGreaterEqual<T>(), t,
+                        static_cast<T>(i)*delta);
             //grb::print_vector(std::cerr, tcomp, "tcomp = t(>=i*delta)");
         }
 
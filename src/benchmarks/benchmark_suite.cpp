@@ -0,0 +1,531 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+/**
+ * @file benchmark_suite.cpp
+ *
+ * Regression benchmarks for the GraphBLAS operations on synthetic graphs
+ * generated in-process (R-MAT, Erdős–Rényi and 2D grid).  Every mask,
+ * accumulate and transpose variant of mxm, mxv and vxm, and the masked and
+ * accumulated eWiseAdd/eWiseMult, apply and reduce operations are timed
+ * after a number of warmup runs, and the results are written as TSV or
+ * JSON, one record per (graph, operation, variant):
+ *
+ *   median_usec, p95_usec  over the timed repetitions,
+ *   gflops                 2 * (multiply-add count of the unmasked
+ *                          operation) / median time,
+ *   bytes_per_nnz          compressed (index, value) bytes of the inputs
+ *                          and the result per stored result value.
+ *
+ * Usage:
+ *   benchmark_suite [--graph rmat|er|grid|all] [--scale S]
+ *                   [--edge-factor E] [--reps R] [--warmup W]
+ *                   [--seed N] [--format tsv|json] [--output FILE]
+ *
+ * The graphs have 2^S vertices (the grid is the nearest square) and the
+ * R-MAT and Erdős–Rényi graphs have about E undirected edges per vertex.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <graphblas/graphblas.hpp>
+#include <benchmarks/graph_generators.hpp>
+
+#ifndef GRB_BENCHMARK_PLATFORM
+#define GRB_BENCHMARK_PLATFORM "unknown"
+#endif
+
+using namespace grb;
+
+namespace
+{
+    using T = double;
+    using MatType = Matrix<T>;
+    using VecType = Vector<T>;
+
+    //************************************************************************
+    struct Options
+    {
+        std::string  graph       = "all";
+        unsigned int scale       = 12;
+        IndexType    edge_factor = 8;
+        unsigned int reps        = 10;
+        unsigned int warmup      = 2;
+        unsigned int seed        = 0;
+        std::string  format      = "tsv";
+        std::string  output;
+    };
+
+    //************************************************************************
+    struct Record
+    {
+        std::string graph;
+        IndexType   n;
+        IndexType   nvals;
+        std::string op;
+        std::string variant;
+        IndexType   result_nvals;
+        unsigned int reps;
+        double      median_usec;
+        double      p95_usec;
+        double      gflops;
+        double      bytes_per_nnz;
+    };
+
+    //************************************************************************
+    /// Graph and the operands derived from it, plus the flop model inputs.
+    struct Workload
+    {
+        std::string name;
+        MatType     A;
+        MatType     M;          ///< mask: the structure of A
+        VecType     u;          ///< dense vector operand
+        VecType     m;          ///< mask vector: every other vertex
+        std::vector<IndexType> row_deg, col_deg;
+
+        Workload(std::string const &graph_name, MatType &&graph)
+            : name(graph_name),
+              A(std::move(graph)),
+              M(A),
+              u(A.nrows()),
+              m(A.nrows()),
+              row_deg(A.nrows(), 0),
+              col_deg(A.ncols(), 0)
+        {
+            IndexArrayType rows(A.nvals()), cols(A.nvals());
+            std::vector<T> vals(A.nvals());
+            A.extractTuples(rows.begin(), cols.begin(), vals.begin());
+            for (auto r : rows) ++row_deg[r];
+            for (auto c : cols) ++col_deg[c];
+
+            assign(u, NoMask(), NoAccumulate(), 1.0, AllIndices());
+            for (IndexType idx = 0; idx < m.size(); idx += 2)
+            {
+                m.setElement(idx, 1.0);
+            }
+        }
+
+        /// multiply-adds in op(A) * op(A), unmasked
+        double mxm_flops(bool transpose_a, bool transpose_b) const
+        {
+            auto const &left_cols(transpose_a ? row_deg : col_deg);
+            auto const &right_rows(transpose_b ? col_deg : row_deg);
+            double flops(0.);
+            for (IndexType k = 0; k < left_cols.size(); ++k)
+            {
+                flops += static_cast<double>(left_cols[k])*right_rows[k];
+            }
+            return flops;
+        }
+    };
+
+    //************************************************************************
+    class Runner
+    {
+    public:
+        Runner(Options const &opts) : m_opts(opts) {}
+
+        /**
+         * Time op() after setup() (untimed) for warmup + reps runs.
+         * op must leave its result in the object nvals_of() inspects.
+         */
+        template <typename SetupT, typename OpT, typename ResultT>
+        void run(Workload    const &w,
+                 std::string const &op_name,
+                 std::string const &variant,
+                 double             flops,
+                 IndexType          input_nvals,
+                 SetupT             setup,
+                 OpT                op,
+                 ResultT     const &result)
+        {
+            std::vector<double> times;
+            times.reserve(m_opts.reps);
+            for (unsigned int rep = 0; rep < m_opts.warmup + m_opts.reps; ++rep)
+            {
+                setup();
+                auto start(std::chrono::steady_clock::now());
+                op();
+                grb::wait();
+                auto stop(std::chrono::steady_clock::now());
+                if (rep >= m_opts.warmup)
+                {
+                    times.push_back(
+                        std::chrono::duration<double, std::micro>(
+                            stop - start).count());
+                }
+            }
+            std::sort(times.begin(), times.end());
+
+            Record rec;
+            rec.graph        = w.name;
+            rec.n            = w.A.nrows();
+            rec.nvals        = w.A.nvals();
+            rec.op           = op_name;
+            rec.variant      = variant;
+            rec.result_nvals = result.nvals();
+            rec.reps         = m_opts.reps;
+            rec.median_usec  = percentile(times, 0.5);
+            rec.p95_usec     = percentile(times, 0.95);
+            rec.gflops       = (rec.median_usec > 0.) ?
+                2.*flops/(rec.median_usec*1.e3) : 0.;
+            rec.bytes_per_nnz =
+                static_cast<double>((input_nvals + rec.result_nvals)*
+                                    (sizeof(IndexType) + sizeof(T)))/
+                std::max<IndexType>(rec.result_nvals, 1);
+            m_records.push_back(rec);
+
+            std::cerr << w.name << " " << op_name << " " << variant << ": "
+                      << rec.median_usec << " usec" << std::endl;
+        }
+
+        void write(std::ostream &os) const
+        {
+            if (m_opts.format == "json")
+            {
+                write_json(os);
+            }
+            else
+            {
+                write_tsv(os);
+            }
+        }
+
+    private:
+        static double percentile(std::vector<double> const &sorted, double p)
+        {
+            if (sorted.empty()) return 0.;
+            std::size_t idx(static_cast<std::size_t>(
+                std::ceil(p*sorted.size())) - 1);
+            return sorted[std::min(idx, sorted.size() - 1)];
+        }
+
+        void write_tsv(std::ostream &os) const
+        {
+            os << "platform\tgraph\tn\tnvals\top\tvariant\tresult_nvals\treps"
+               << "\tmedian_usec\tp95_usec\tgflops\tbytes_per_nnz\n";
+            for (auto const &r : m_records)
+            {
+                os << GRB_BENCHMARK_PLATFORM << '\t' << r.graph << '\t'
+                   << r.n << '\t' << r.nvals << '\t' << r.op << '\t'
+                   << r.variant << '\t' << r.result_nvals << '\t' << r.reps
+                   << '\t' << r.median_usec << '\t' << r.p95_usec << '\t'
+                   << r.gflops << '\t' << r.bytes_per_nnz << '\n';
+            }
+        }
+
+        void write_json(std::ostream &os) const
+        {
+            os << "{\n  \"platform\": \"" << GRB_BENCHMARK_PLATFORM << "\",\n"
+               << "  \"scale\": " << m_opts.scale << ",\n"
+               << "  \"edge_factor\": " << m_opts.edge_factor << ",\n"
+               << "  \"seed\": " << m_opts.seed << ",\n"
+               << "  \"results\": [";
+            for (std::size_t idx = 0; idx < m_records.size(); ++idx)
+            {
+                auto const &r(m_records[idx]);
+                os << (idx ? ",\n" : "\n")
+                   << "    {\"graph\": \"" << r.graph << "\", \"n\": " << r.n
+                   << ", \"nvals\": " << r.nvals
+                   << ", \"op\": \"" << r.op << "\", \"variant\": \""
+                   << r.variant << "\", \"result_nvals\": " << r.result_nvals
+                   << ", \"reps\": " << r.reps
+                   << ", \"median_usec\": " << r.median_usec
+                   << ", \"p95_usec\": " << r.p95_usec
+                   << ", \"gflops\": " << r.gflops
+                   << ", \"bytes_per_nnz\": " << r.bytes_per_nnz << "}";
+            }
+            os << "\n  ]\n}\n";
+        }
+
+        Options const       &m_opts;
+        std::vector<Record>  m_records;
+    };
+
+    //************************************************************************
+    // Call fn(name, mask) for each of the five ways a mask can be passed.
+    template <typename MaskT, typename FnT>
+    void for_each_mask(MaskT const &mask, FnT fn)
+    {
+        fn("nomask",   NoMask());
+        fn("mask",     mask);
+        fn("cmask",    complement(mask));
+        fn("smask",    structure(mask));
+        fn("csmask",   complement(structure(mask)));
+    }
+
+    template <typename FnT>
+    void for_each_accum(FnT fn)
+    {
+        fn("noaccum", NoAccumulate());
+        fn("accum",   Plus<T>());
+    }
+
+    //************************************************************************
+    void bench_mxm(Runner &runner, Workload const &w)
+    {
+        MatType C(w.A.nrows(), w.A.ncols());
+        auto setup = [&]() { C = w.M; };
+
+        auto variants = [&](char const *trans, bool ta, bool tb,
+                            auto const &A, auto const &B)
+        {
+            double flops(w.mxm_flops(ta, tb));
+            for_each_mask(w.M, [&](char const *mask_name, auto const &mask)
+            {
+                for_each_accum([&](char const *accum_name, auto accum)
+                {
+                    std::string variant(std::string(trans) + "_" +
+                                        mask_name + "_" + accum_name);
+                    runner.run(w, "mxm", variant, flops, 2*w.A.nvals(),
+                               setup,
+                               [&]() { mxm(C, mask, accum,
+                                           ArithmeticSemiring<T>(), A, B,
+                                           REPLACE); },
+                               C);
+                });
+            });
+        };
+
+        variants("AB",   false, false, w.A, w.A);
+        variants("ATB",  true,  false, transpose(w.A), w.A);
+        variants("ABT",  false, true,  w.A, transpose(w.A));
+        variants("ATBT", true,  true,  transpose(w.A), transpose(w.A));
+    }
+
+    //************************************************************************
+    void bench_mxv_vxm(Runner &runner, Workload const &w)
+    {
+        VecType out(w.A.nrows());
+        auto setup = [&]() { out = w.m; };
+        double flops(w.A.nvals());
+
+        auto variants = [&](char const *op_name, char const *trans,
+                            auto const &A, bool vxm_order)
+        {
+            for_each_mask(w.m, [&](char const *mask_name, auto const &mask)
+            {
+                for_each_accum([&](char const *accum_name, auto accum)
+                {
+                    std::string variant(std::string(trans) + "_" +
+                                        mask_name + "_" + accum_name);
+                    runner.run(w, op_name, variant, flops,
+                               w.A.nvals() + w.u.nvals(), setup,
+                               [&]()
+                               {
+                                   if (vxm_order)
+                                       vxm(out, mask, accum,
+                                           ArithmeticSemiring<T>(), w.u, A,
+                                           REPLACE);
+                                   else
+                                       mxv(out, mask, accum,
+                                           ArithmeticSemiring<T>(), A, w.u,
+                                           REPLACE);
+                               },
+                               out);
+                });
+            });
+        };
+
+        variants("mxv", "A",  w.A, false);
+        variants("mxv", "AT", transpose(w.A), false);
+        variants("vxm", "A",  w.A, true);
+        variants("vxm", "AT", transpose(w.A), true);
+    }
+
+    //************************************************************************
+    void bench_ewise(Runner &runner, Workload const &w)
+    {
+        MatType C(w.A.nrows(), w.A.ncols());
+        MatType const B(w.M);
+        auto mat_setup = [&]() { C = w.M; };
+
+        for_each_mask(w.M, [&](char const *mask_name, auto const &mask)
+        {
+            for_each_accum([&](char const *accum_name, auto accum)
+            {
+                std::string variant(std::string(mask_name) + "_" + accum_name);
+                runner.run(w, "ewiseadd_matrix", variant, 0.5*w.A.nvals(),
+                           2*w.A.nvals(), mat_setup,
+                           [&]() { eWiseAdd(C, mask, accum, Plus<T>(),
+                                            w.A, B, REPLACE); },
+                           C);
+                runner.run(w, "ewisemult_matrix", variant, 0.5*w.A.nvals(),
+                           2*w.A.nvals(), mat_setup,
+                           [&]() { eWiseMult(C, mask, accum, Times<T>(),
+                                             w.A, B, REPLACE); },
+                           C);
+                runner.run(w, "apply_matrix", variant, 0.5*w.A.nvals(),
+                           w.A.nvals(), mat_setup,
+                           [&]() { apply(C, mask, accum,
+                                         AdditiveInverse<T>(), w.A,
+                                         REPLACE); },
+                           C);
+            });
+        });
+
+        VecType out(w.A.nrows());
+        auto vec_setup = [&]() { out = w.m; };
+        for_each_mask(w.m, [&](char const *mask_name, auto const &mask)
+        {
+            for_each_accum([&](char const *accum_name, auto accum)
+            {
+                std::string variant(std::string(mask_name) + "_" + accum_name);
+                runner.run(w, "ewiseadd_vector", variant, 0.5*w.u.nvals(),
+                           w.u.nvals() + w.m.nvals(), vec_setup,
+                           [&]() { eWiseAdd(out, mask, accum, Plus<T>(),
+                                            w.u, w.m, REPLACE); },
+                           out);
+                runner.run(w, "ewisemult_vector", variant, 0.5*w.m.nvals(),
+                           w.u.nvals() + w.m.nvals(), vec_setup,
+                           [&]() { eWiseMult(out, mask, accum, Times<T>(),
+                                             w.u, w.m, REPLACE); },
+                           out);
+                runner.run(w, "reduce_rows", variant, 0.5*w.A.nvals(),
+                           w.A.nvals(), vec_setup,
+                           [&]() { reduce(out, mask, accum, Plus<T>(),
+                                          w.A, REPLACE); },
+                           out);
+            });
+        });
+
+        T sum(0);
+        VecType scalar_holder(1);
+        runner.run(w, "reduce_scalar", "nomask_noaccum", 0.5*w.A.nvals(),
+                   w.A.nvals(), [&]() { sum = 0; },
+                   [&]()
+                   {
+                       reduce(sum, NoAccumulate(), PlusMonoid<T>(), w.A);
+                       scalar_holder.setElement(0, sum);
+                   },
+                   scalar_holder);
+    }
+
+    //************************************************************************
+    void bench_graph(Runner &runner, Workload const &w)
+    {
+        bench_mxm(runner, w);
+        bench_mxv_vxm(runner, w);
+        bench_ewise(runner, w);
+    }
+
+    //************************************************************************
+    Options parse_args(int argc, char **argv)
+    {
+        Options opts;
+        for (int idx = 1; idx < argc; ++idx)
+        {
+            std::string arg(argv[idx]);
+            if (idx + 1 >= argc)
+            {
+                std::cerr << "ERROR: missing value for " << arg << std::endl;
+                exit(1);
+            }
+            std::string val(argv[++idx]);
+
+            if      (arg == "--graph")       opts.graph = val;
+            else if (arg == "--scale")       opts.scale = std::stoul(val);
+            else if (arg == "--edge-factor") opts.edge_factor = std::stoul(val);
+            else if (arg == "--reps")        opts.reps = std::stoul(val);
+            else if (arg == "--warmup")      opts.warmup = std::stoul(val);
+            else if (arg == "--seed")        opts.seed = std::stoul(val);
+            else if (arg == "--format")      opts.format = val;
+            else if (arg == "--output")      opts.output = val;
+            else
+            {
+                std::cerr << "ERROR: unknown argument " << arg << std::endl;
+                exit(1);
+            }
+        }
+
+        if ((opts.reps == 0) ||
+            ((opts.format != "tsv") && (opts.format != "json")) ||
+            ((opts.graph != "all") && (opts.graph != "rmat") &&
+             (opts.graph != "er") && (opts.graph != "grid")))
+        {
+            std::cerr << "ERROR: invalid arguments." << std::endl;
+            exit(1);
+        }
+        return opts;
+    }
+}
+
+//****************************************************************************
+int main(int argc, char **argv)
+{
+    Options opts(parse_args(argc, argv));
+    Runner runner(opts);
+
+    if ((opts.graph == "all") || (opts.graph == "rmat"))
+    {
+        IndexArrayType rows, cols;
+        IndexType n(benchmarks::rmat_edges(opts.scale, opts.edge_factor,
+                                           rows, cols, opts.seed));
+        bench_graph(runner, Workload(
+            "rmat", benchmarks::build_graph<T>(n, rows, cols)));
+    }
+
+    if ((opts.graph == "all") || (opts.graph == "er"))
+    {
+        IndexArrayType rows, cols;
+        IndexType n(benchmarks::erdos_renyi_edges(
+                        IndexType(1) << opts.scale, 2.*opts.edge_factor,
+                        rows, cols, opts.seed));
+        bench_graph(runner, Workload(
+            "er", benchmarks::build_graph<T>(n, rows, cols)));
+    }
+
+    if ((opts.graph == "all") || (opts.graph == "grid"))
+    {
+        IndexType side(static_cast<IndexType>(
+            std::llround(std::sqrt(double(IndexType(1) << opts.scale)))));
+        IndexArrayType rows, cols;
+        IndexType n(benchmarks::grid_edges(side, side, rows, cols));
+        bench_graph(runner, Workload(
+            "grid", benchmarks::build_graph<T>(n, rows, cols)));
+    }
+
+    if (opts.output.empty())
+    {
+        runner.write(std::cout);
+    }
+    else
+    {
+        std::ofstream ofs(opts.output);
+        runner.write(ofs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+namespace benchmarks
+{
+    /**
+     * @brief Synthetic graph generators for the benchmark suite.
+     *
+     * Each generator appends the edges of an undirected graph to rows/cols
+     * (both directions, no self loops; duplicates are possible and are
+     * combined by build_graph) and returns the number of vertices.  The
+     * same seed always produces the same graph.
+     */
+
+    //************************************************************************
+    /**
+     * @brief R-MAT (recursive matrix) graph with 2^scale vertices and
+     *        edge_factor * 2^scale generated edges.
+     *
+     * Each edge descends scale levels of the adjacency matrix quadrants with
+     * probabilities a, b, c and 1-a-b-c.  The vertex labels are randomly
+     * permuted afterwards, as in Graph500, so the high degree vertices are
+     * not clustered at the low indices.
+     */
+    inline grb::IndexType rmat_edges(unsigned int         scale,
+                                     grb::IndexType       edge_factor,
+                                     grb::IndexArrayType &rows,
+                                     grb::IndexArrayType &cols,
+                                     unsigned int         seed = 0,
+                                     double               a = 0.57,
+                                     double               b = 0.19,
+                                     double               c = 0.19)
+    {
+        if ((a < 0.) || (b < 0.) || (c < 0.) || (a + b + c > 1.))
+        {
+            throw grb::InvalidValueException();
+        }
+
+        grb::IndexType n(grb::IndexType(1) << scale);
+        grb::IndexType num_edges(edge_factor*n);
+
+        std::mt19937_64 generator(seed);
+        std::uniform_real_distribution<double> uniform(0., 1.);
+
+        std::vector<grb::IndexType> perm(n);
+        std::iota(perm.begin(), perm.end(), 0);
+        std::shuffle(perm.begin(), perm.end(), generator);
+
+        rows.reserve(rows.size() + 2*num_edges);
+        cols.reserve(cols.size() + 2*num_edges);
+        for (grb::IndexType e = 0; e < num_edges; ++e)
+        {
+            grb::IndexType i(0), j(0);
+            for (unsigned int level = 0; level < scale; ++level)
+            {
+                double r(uniform(generator));
+                i <<= 1;
+                j <<= 1;
+                if (r < a)              { }
+                else if (r < a + b)     { j |= 1; }
+                else if (r < a + b + c) { i |= 1; }
+                else                    { i |= 1; j |= 1; }
+            }
+
+            if (i == j) continue;
+            rows.push_back(perm[i]);  cols.push_back(perm[j]);
+            rows.push_back(perm[j]);  cols.push_back(perm[i]);
+        }
+        return n;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Erdős–Rényi G(n, m) graph with m = n * avg_degree / 2 edges
+     *        drawn uniformly at random.
+     */
+    inline grb::IndexType erdos_renyi_edges(grb::IndexType       n,
+                                            double               avg_degree,
+                                            grb::IndexArrayType &rows,
+                                            grb::IndexArrayType &cols,
+                                            unsigned int         seed = 0)
+    {
+        if ((n < 2) || (avg_degree < 0.))
+        {
+            throw grb::InvalidValueException();
+        }
+
+        grb::IndexType num_edges(
+            static_cast<grb::IndexType>(std::llround(n*avg_degree/2.)));
+
+        std::mt19937_64 generator(seed);
+        std::uniform_int_distribution<grb::IndexType> vertex(0, n - 1);
+
+        rows.reserve(rows.size() + 2*num_edges);
+        cols.reserve(cols.size() + 2*num_edges);
+        for (grb::IndexType e = 0; e < num_edges; )
+        {
+            grb::IndexType i(vertex(generator)), j(vertex(generator));
+            if (i == j) continue;
+            rows.push_back(i);  cols.push_back(j);
+            rows.push_back(j);  cols.push_back(i);
+            ++e;
+        }
+        return n;
+    }
+
+    //************************************************************************
+    /**
+     * @brief 2D grid graph (4-point stencil) of nx by ny vertices; vertex
+     *        (x, y) has index y*nx + x.
+     */
+    inline grb::IndexType grid_edges(grb::IndexType       nx,
+                                     grb::IndexType       ny,
+                                     grb::IndexArrayType &rows,
+                                     grb::IndexArrayType &cols)
+    {
+        for (grb::IndexType y = 0; y < ny; ++y)
+        {
+            for (grb::IndexType x = 0; x < nx; ++x)
+            {
+                grb::IndexType v(y*nx + x);
+                if (x + 1 < nx)
+                {
+                    rows.push_back(v);      cols.push_back(v + 1);
+                    rows.push_back(v + 1);  cols.push_back(v);
+                }
+                if (y + 1 < ny)
+                {
+                    rows.push_back(v);       cols.push_back(v + nx);
+                    rows.push_back(v + nx);  cols.push_back(v);
+                }
+            }
+        }
+        return nx*ny;
+    }
+
+    //************************************************************************
+    /// Build an n x n matrix with value 1 on every generated edge (duplicate
+    /// edges are stored once).
+    template <typename ScalarT>
+    grb::Matrix<ScalarT> build_graph(grb::IndexType             n,
+                                     grb::IndexArrayType const &rows,
+                                     grb::IndexArrayType const &cols)
+    {
+        grb::Matrix<ScalarT> A(n, n);
+        A.build(rows, cols,
+                std::vector<ScalarT>(rows.size(), static_cast<ScalarT>(1)),
+                grb::Second<ScalarT>());
+        return A;
+    }
+
+} // benchmarks
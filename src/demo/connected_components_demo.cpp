@@ -0,0 +1,133 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <graphblas/graphblas.hpp>
+#include <algorithms/bfs.hpp>
+#include <algorithms/connected_components.hpp>
+#include <benchmarks/graph_generators.hpp>
+#include "Timer.hpp"
+
+//****************************************************************************
+// Label the components with one bfs_level per component (from its smallest
+// vertex), the way it was done before connected_components.
+template <typename MatrixT>
+grb::IndexType bfs_components(MatrixT const               &A,
+                              grb::Vector<grb::IndexType> &components)
+{
+    grb::IndexType num_nodes(A.nrows());
+    grb::IndexType num_components(0);
+    std::vector<grb::IndexType> labels(num_nodes, num_nodes);
+    grb::IndexArrayType idx;
+    std::vector<grb::IndexType> vals;
+
+    for (grb::IndexType src = 0; src < num_nodes; ++src)
+    {
+        if (labels[src] != num_nodes) continue;
+
+        ++num_components;
+        grb::Vector<grb::IndexType> levels(num_nodes);
+        algorithms::bfs_level(A, src, levels);
+
+        idx.resize(levels.nvals());
+        vals.resize(levels.nvals());
+        levels.extractTuples(idx.begin(), vals.begin());
+        for (auto v : idx) labels[v] = src;
+    }
+
+    components = grb::Vector<grb::IndexType>(labels);
+    return num_components;
+}
+
+//****************************************************************************
+template <typename MatrixT>
+void compare(std::string const &name, MatrixT const &A)
+{
+    Timer<std::chrono::steady_clock, std::chrono::microseconds> my_timer;
+    grb::IndexType num_nodes(A.nrows());
+
+    std::cout << name << ": " << num_nodes << " vertices, "
+              << A.nvals() << " stored edges" << std::endl;
+
+    grb::Vector<grb::IndexType> cc_labels(num_nodes);
+    my_timer.start();
+    auto cc_count = algorithms::connected_components(A, cc_labels);
+    my_timer.stop();
+    double cc_time = my_timer.elapsed()/1000.;
+
+    grb::Vector<grb::IndexType> bfs_labels(num_nodes);
+    my_timer.start();
+    auto bfs_count = bfs_components(A, bfs_labels);
+    my_timer.stop();
+    double bfs_time = my_timer.elapsed()/1000.;
+
+    std::cout << "    connected_components: " << cc_count
+              << " components, " << cc_time << " msec." << std::endl;
+    std::cout << "    repeated bfs_level:   " << bfs_count
+              << " components, " << bfs_time << " msec." << std::endl;
+    std::cout << "    labels "
+              << ((cc_labels == bfs_labels) ? "match" : "DO NOT MATCH")
+              << ", speedup " << bfs_time/cc_time << std::endl;
+}
+
+//****************************************************************************
+// usage: connected_components_demo [scale] [R-MAT edge factor]
+int main(int argc, char **argv)
+{
+    unsigned int scale = (argc > 1) ? std::stoul(argv[1]) : 14;
+    grb::IndexType edge_factor = (argc > 2) ? std::stoul(argv[2]) : 1;
+    grb::IndexType n(grb::IndexType(1) << scale);
+
+    // sparse R-MAT graphs leave many small components and isolated vertices
+    {
+        grb::IndexArrayType rows, cols;
+        benchmarks::rmat_edges(scale, edge_factor, rows, cols, 1);
+        compare("R-MAT", benchmarks::build_graph<bool>(n, rows, cols));
+    }
+
+    // just above the giant component threshold (average degree 1)
+    {
+        grb::IndexArrayType rows, cols;
+        benchmarks::erdos_renyi_edges(n, 1.5, rows, cols, 1);
+        compare("Erdos-Renyi", benchmarks::build_graph<bool>(n, rows, cols));
+    }
+
+    // one component with a large diameter
+    {
+        grb::IndexType side(grb::IndexType(1) << (scale/2));
+        grb::IndexArrayType rows, cols;
+        benchmarks::grid_edges(side, side, rows, cols);
+        compare("grid", benchmarks::build_graph<bool>(side*side, rows, cols));
+    }
+
+    return 0;
+}
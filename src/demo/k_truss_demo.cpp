@@ -28,9 +28,11 @@
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <chrono>
 
 #include <graphblas/graphblas.hpp>
 #include <algorithms/k_truss.hpp>
+#include "Timer.hpp"
 
 using namespace grb;
 
@@ -116,6 +118,20 @@ int main(int argc, char **argv)
 {
     using T = int;
 
+    // An optional edge list file (e.g., k_truss_data.tsv) replaces the
+    // built-in karate club graph; its matrices are not printed.
+    bool const verbose(argc < 2);
+    if (!verbose)
+    {
+        ReadOptions options;
+        options.symmetrize = true;
+        options.remove_self_loops = true;
+        std::vector<T> weights;
+        i.clear();
+        j.clear();
+        read_edge_list(std::string(argv[1]), i, j, weights, options);
+    }
+
     // create an incidence matrix from the data
     IndexType num_edges = 0;
     IndexType num_nodes = 0;
@@ -140,28 +156,85 @@ int main(int argc, char **argv)
 
     Matrix<T> E(num_edges, num_nodes);
     E.build(edge_array.begin(), node_array.begin(), v.begin(), v.size());
-    print_matrix(std::cout, E, "Incidence");
+    if (verbose) print_matrix(std::cout, E, "Incidence");
+
+    // The chained peeling of the original demo (built-in graph only)
+    if (verbose)
+    {
+        std::cout << "Running k-truss algorithm..." << std::endl;
 
-    std::cout << "Running k-truss algorithm..." << std::endl;
+        auto Eout3 = algorithms::k_truss(E, 3);
+        std::cout << "===============================================" << std::endl;
+        print_matrix(std::cout, Eout3, "Edges in 3-trusses");
+        std::cout << "===============================================" << std::endl;
 
-    auto Eout3 = algorithms::k_truss(E, 3);
-    std::cout << "===============================================" << std::endl;
-    print_matrix(std::cout, Eout3, "Edges in 3-trusses");
-    std::cout << "===============================================" << std::endl;
+        auto Eout4 = algorithms::k_truss(Eout3, 4);
+        std::cout << "===============================================" << std::endl;
+        print_matrix(std::cout, Eout4, "Edges in 4-trusses");
+        std::cout << "===============================================" << std::endl;
+
+        auto Eout5 = algorithms::k_truss(Eout4, 5);
+        std::cout << "===============================================" << std::endl;
+        print_matrix(std::cout, Eout5, "Edges in 5-trusses");
+        std::cout << "===============================================" << std::endl;
+
+        auto Eout6 = algorithms::k_truss(Eout5, 6);
+        std::cout << "===============================================" << std::endl;
+        print_matrix(std::cout, Eout6, "Edges in 6-trusses");
+        std::cout << "===============================================" << std::endl;
+    }
+
+    // Compare the peeling variants on the adjacency matrix
+    Matrix<T> A(num_nodes, num_nodes);
+    {
+        IndexArrayType ai, aj;
+        for (IndexType ix = 0; ix < i.size(); ++ix)
+        {
+            if (i[ix] != j[ix])
+            {
+                ai.push_back(i[ix]);  aj.push_back(j[ix]);
+                ai.push_back(j[ix]);  aj.push_back(i[ix]);
+            }
+        }
+        A.build(ai, aj, std::vector<T>(ai.size(), 1), Second<T>());
+    }
+
+    Timer<std::chrono::steady_clock, std::chrono::microseconds> my_timer;
+    for (IndexType k = 3; k <= 6; ++k)
+    {
+        my_timer.start();
+        auto Ek = algorithms::k_truss(E, k);
+        my_timer.stop();
+        std::cout << "k = " << k << ": k_truss (incidence): "
+                  << Ek.nrows() << " edges, "
+                  << my_timer.elapsed() << " usec." << std::endl;
+
+        my_timer.start();
+        auto Ak2 = algorithms::k_truss2(A, k);
+        my_timer.stop();
+        std::cout << "k = " << k << ": k_truss2 (adjacency): "
+                  << Ak2.nvals()/2 << " edges, "
+                  << my_timer.elapsed() << " usec." << std::endl;
+
+        my_timer.start();
+        auto Akinc = algorithms::k_truss_incremental(A, k);
+        my_timer.stop();
+        std::cout << "k = " << k << ": k_truss_incremental:   "
+                  << Akinc.nvals()/2 << " edges, "
+                  << my_timer.elapsed() << " usec." << std::endl;
+
+        if (Ek.nrows() == 0) break;
+    }
 
-    auto Eout4 = algorithms::k_truss(Eout3, 4);
-    std::cout << "===============================================" << std::endl;
-    print_matrix(std::cout, Eout4, "Edges in 4-trusses");
-    std::cout << "===============================================" << std::endl;
+    my_timer.start();
+    auto Truss = algorithms::truss_decomposition(A);
+    my_timer.stop();
 
-    auto Eout5 = algorithms::k_truss(Eout4, 5);
-    std::cout << "===============================================" << std::endl;
-    print_matrix(std::cout, Eout5, "Edges in 5-trusses");
-    std::cout << "===============================================" << std::endl;
+    IndexType max_truss(0);
+    reduce(max_truss, NoAccumulate(), MaxMonoid<IndexType>(), Truss);
+    std::cout << "truss_decomposition: max truss number = " << max_truss
+              << ", " << my_timer.elapsed() << " usec." << std::endl;
+    if (verbose) print_matrix(std::cout, Truss, "Truss numbers");
 
-    auto Eout6 = algorithms::k_truss(Eout5, 6);
-    std::cout << "===============================================" << std::endl;
-    print_matrix(std::cout, Eout6, "Edges in 6-trusses");
-    std::cout << "===============================================" << std::endl;
     return 0;
 }
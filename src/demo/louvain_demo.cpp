@@ -104,5 +104,20 @@ int main(int argc, char **argv)
         algorithms::get_louvain_cluster_assignments(cluster2_matrix);
     print_vector(std::cout, cluster2_assignments, "cluster (masked)  assignments");
 
+    //===================
+    grb::Vector<grb::IndexType> cluster3_assignments(NUM_NODES);
+    my_timer.start();
+    auto modularity =
+        algorithms::louvain_cluster_multilevel(A, cluster3_assignments);
+    my_timer.stop();
+
+    std::cout << "Elapsed time: " << my_timer.elapsed() << " msec." << std::endl;
+    for (size_t phase = 0; phase < modularity.size(); ++phase)
+    {
+        std::cout << "Phase " << phase << " modularity: "
+                  << modularity[phase] << std::endl;
+    }
+    print_vector(std::cout, cluster3_assignments, "cluster (multilevel) assignments");
+
     return 0;
 }
@@ -26,7 +26,6 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <chrono>
 
 #define GRAPHBLAS_DEBUG 1
@@ -42,30 +41,40 @@ IndexType read_edge_list(std::string const &pathname,
                          IndexArrayType &row_indices,
                          IndexArrayType &col_indices)
 {
-    std::ifstream infile(pathname);
-    IndexType max_id = 0;
-    uint64_t num_rows = 0;
-    uint64_t src, dst;
+    std::vector<int32_t> weights;
+    IndexType num_nodes(grb::read_edge_list(pathname,
+                                            row_indices, col_indices,
+                                            weights));
 
-    while (infile)
-    {
-        infile >> src >> dst;
-        //std::cout << "Read: " << src << ", " << dst << std::endl;
-        max_id = std::max(max_id, src);
-        max_id = std::max(max_id, dst);
-
-        //if (src > max_id) max_id = src;
-        //if (dst > max_id) max_id = dst;
+    std::cout << "Read " << row_indices.size() << " rows." << std::endl;
+    std::cout << "#Nodes = " << num_nodes << std::endl;
 
-        row_indices.push_back(src);
-        col_indices.push_back(dst);
+    return num_nodes;
+}
 
-        ++num_rows;
-    }
-    std::cout << "Read " << num_rows << " rows." << std::endl;
-    std::cout << "#Nodes = " << (max_id + 1) << std::endl;
+//****************************************************************************
+// Read the structure of a matrix saved with grb::save_binary (no parsing)
+IndexType read_binary(std::string const &pathname,
+                      IndexArrayType &row_indices,
+                      IndexArrayType &col_indices)
+{
+    auto mapped(load_binary<int32_t>(pathname));
+    std::vector<int32_t> vals(mapped.nvals());
+    row_indices.resize(mapped.nvals());
+    col_indices.resize(mapped.nvals());
+    mapped.extractTuples(row_indices.begin(), col_indices.begin(),
+                         vals.begin());
+
+    std::cout << "Read " << mapped.nvals() << " stored values." << std::endl;
+    std::cout << "#Nodes = " << mapped.nrows() << std::endl;
+    return mapped.nrows();
+}
 
-    return (max_id + 1);
+bool has_suffix(std::string const &str, std::string const &suffix)
+{
+    return ((str.size() >= suffix.size()) &&
+            (str.compare(str.size() - suffix.size(), suffix.size(),
+                         suffix) == 0));
 }
 
 
@@ -75,15 +84,25 @@ int main(int argc, char **argv)
     if (argc < 2)
     {
         std::cerr << "ERROR: too few arguments." << std::endl;
-        std::cerr << "Usage: " << argv[0] << " <edge list file>" << std::endl;
+        std::cerr << "Usage: " << argv[0]
+                  << " <edge list file | .gbin file> [save .gbin file]"
+                  << std::endl;
         exit(1);
     }
 
-    // Read the edgelist and create the tuple arrays
+    // Read the edgelist (or binary matrix) and create the tuple arrays
     std::string pathname(argv[1]);
     IndexArrayType iA, jA;
 
-    IndexType const NUM_NODES(read_edge_list(pathname, iA, jA));
+    Timer<std::chrono::steady_clock, std::chrono::microseconds> my_timer;
+
+    my_timer.start();
+    IndexType const NUM_NODES(has_suffix(pathname, ".gbin") ?
+                              read_binary(pathname, iA, jA) :
+                              read_edge_list(pathname, iA, jA));
+    my_timer.stop();
+    std::cout << "read                      : " << my_timer.elapsed()
+              << " usec" << std::endl;
 
     using T = int32_t;
     using MatType = Matrix<T>;
@@ -94,13 +113,33 @@ int main(int argc, char **argv)
     MatType B(NUM_NODES, NUM_NODES);
     BoolMatType M(NUM_NODES, NUM_NODES);
 
+    my_timer.start();
     A.build(iA.begin(), jA.begin(), v.begin(), iA.size());
+    my_timer.stop();
+    std::cout << "A.build                   : " << my_timer.elapsed()
+              << " usec, A.nvals = " << A.nvals() << std::endl;
+
+    if (argc > 2)
+    {
+        // save A so that later runs can skip the text parsing
+        save_binary(argv[2], A);
+        std::cout << "Saved A to " << argv[2] << std::endl;
+    }
+
+    my_timer.start();
     B.build(iA.begin(), jA.begin(), v.begin(), iA.size());
+    my_timer.stop();
+    std::cout << "B.build                   : " << my_timer.elapsed()
+              << " usec, B.nvals = " << B.nvals() << std::endl;
+
+    my_timer.start();
     M.build(iA.begin(), jA.begin(), bv.begin(), iA.size());
+    my_timer.stop();
+    std::cout << "M.build                   : " << my_timer.elapsed()
+              << " usec, M.nvals = " << M.nvals() << std::endl;
 
     std::cout << "Running algorithm(s)... nvals = " << M.nvals() << std::endl;
 
-    Timer<std::chrono::steady_clock, std::chrono::microseconds> my_timer;
     MatType C(NUM_NODES, NUM_NODES);
     mxm(C,
         NoMask(),
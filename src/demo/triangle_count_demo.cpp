@@ -26,7 +26,6 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <chrono>
 
 #define GRAPHBLAS_DEBUG 1
@@ -52,65 +51,53 @@ int main(int argc, char **argv)
 
     grb::IndexArrayType iL, iU, iA;
     grb::IndexArrayType jL, jU, jA;
-    uint64_t num_rows = 0;
-    uint64_t max_id = 0;
-    uint64_t src, dst;
+    grb::IndexArrayType src, dst;
+    std::vector<int32_t> weights;
 
     my_timer.start();
+    grb::IndexType const num_nodes(
+        grb::read_edge_list(pathname, src, dst, weights));
+
+    for (grb::IndexType ix = 0; ix < src.size(); ++ix)
     {
-        std::ifstream infile(pathname);
-        while (infile)
+        if (src[ix] < dst[ix])
+        {
+            iA.push_back(src[ix]);
+            jA.push_back(dst[ix]);
+
+            iU.push_back(src[ix]);
+            jU.push_back(dst[ix]);
+        }
+        else if (dst[ix] < src[ix])
         {
-            infile >> src >> dst;
-            //std::cout << "Read: " << src << ", " << dst << std::endl;
-            if (src > max_id) max_id = src;
-            if (dst > max_id) max_id = dst;
-
-            if (src < dst)
-            {
-                iA.push_back(src);
-                jA.push_back(dst);
-
-                iU.push_back(src);
-                jU.push_back(dst);
-            }
-            else if (dst < src)
-            {
-                iA.push_back(src);
-                jA.push_back(dst);
-
-                iL.push_back(src);
-                jL.push_back(dst);
-            }
-            // else ignore self loops
-
-            ++num_rows;
+            iA.push_back(src[ix]);
+            jA.push_back(dst[ix]);
+
+            iL.push_back(src[ix]);
+            jL.push_back(dst[ix]);
         }
+        // else ignore self loops
     }
     my_timer.stop();
     std::cout << "Elapsed read time: " << my_timer.elapsed() << " usec." << std::endl;
 
-    std::cout << "Read " << num_rows << " rows." << std::endl;
-    std::cout << "#Nodes = " << (max_id + 1) << std::endl;
+    std::cout << "Read " << src.size() << " rows." << std::endl;
+    std::cout << "#Nodes = " << num_nodes << std::endl;
 
     // sort the
     using DegIdx = std::tuple<grb::IndexType,grb::IndexType>;
     my_timer.start();
-    std::vector<DegIdx> degrees(max_id + 1);
-    for (grb::IndexType idx = 0; idx <= max_id; ++idx)
+    std::vector<DegIdx> degrees(num_nodes);
+    for (grb::IndexType idx = 0; idx < num_nodes; ++idx)
     {
         degrees[idx] = {0UL, idx};
     }
 
+    for (grb::IndexType ix = 0; ix < src.size(); ++ix)
     {
-        std::ifstream infile(pathname);
-        while (infile)
+        if (src[ix] != dst[ix])
         {
-            infile >> src >> dst;
-            if (src != dst)
-            {
-                std::get<0>(degrees[src]) += 1;
-            }
+            std::get<0>(degrees[src[ix]]) += 1;
         }
     }
 
@@ -136,7 +123,7 @@ int main(int argc, char **argv)
         idx++;
     }
 
-    grb::IndexType NUM_NODES(max_id + 1);
+    grb::IndexType NUM_NODES(num_nodes);
     using T = int32_t;
     std::vector<T> v(iA.size(), 1);
 
@@ -195,5 +182,13 @@ int main(int argc, char **argv)
     std::cout << "# triangles (B=LU; C=L.*B; #=|C|) = " << count << std::endl;
     std::cout << "Elapsed time: " << my_timer.elapsed() << " usec." << std::endl;
 
+    //===================
+    my_timer.start();
+    count = algorithms::triangle_count_fused(L);
+    my_timer.stop();
+
+    std::cout << "# triangles (fused row intersections of L; no C) = " << count << std::endl;
+    std::cout << "Elapsed time: " << my_timer.elapsed() << " usec." << std::endl;
+
     return 0;
 }
@@ -0,0 +1,287 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/detail/nonblocking.hpp>
+
+namespace grb
+{
+    //************************************************************************
+    /**
+     * @brief Read only compressed sparse row (CSR) copy of a matrix.
+     *
+     * The stored values of row i are at positions [row_ptr[i], row_ptr[i+1])
+     * of the col_idx and vals arrays, with the column indices of each row in
+     * increasing order.  There is no per-row allocation and no tuple
+     * padding, and every row is one contiguous scan.  mxm and mxv accept a
+     * CsrMatrix as their A operand and read these arrays directly; the
+     * graph algorithms use it for the adjacency structure they traverse.
+     *
+     * @note In nonblocking mode a CsrMatrix is an input like a Matrix:
+     *       destroying it completes the pending operations that use it.
+     */
+    template<typename ScalarT>
+    class CsrMatrix
+    {
+    public:
+        using ScalarType = ScalarT;
+
+        /**
+         * @brief Build from (row, column, value) tuples in any order:
+         *        O(n + nrows) plus sorting the rows that need it.
+         *
+         * @param[in] num_rows  Number of rows in the matrix
+         * @param[in] num_cols  Number of columns in the matrix
+         * @param[in] i_it      Row indices of the tuples
+         * @param[in] j_it      Column indices of the tuples
+         * @param[in] v_it      Values of the tuples
+         * @param[in] n         Number of tuples (no location may repeat)
+         */
+        template<typename RAIteratorI,
+                 typename RAIteratorJ,
+                 typename RAIteratorV>
+        CsrMatrix(IndexType    num_rows,
+                  IndexType    num_cols,
+                  RAIteratorI  i_it,
+                  RAIteratorJ  j_it,
+                  RAIteratorV  v_it,
+                  IndexType    n)
+            : m_num_rows(num_rows),
+              m_num_cols(num_cols),
+              m_row_ptr(num_rows + 1, 0UL),
+              m_col_idx(n),
+              m_vals(n)
+        {
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                if ((i_it[ix] >= m_num_rows) || (j_it[ix] >= m_num_cols))
+                {
+                    throw IndexOutOfBoundsException(
+                        "CsrMatrix: index out of bounds");
+                }
+                ++m_row_ptr[i_it[ix] + 1];
+            }
+            std::partial_sum(m_row_ptr.begin(), m_row_ptr.end(),
+                             m_row_ptr.begin());
+
+            // counting sort by row (stable, so rows of tuples that are
+            // already ordered by column stay ordered)
+            std::vector<IndexType> pos(m_row_ptr.begin(), m_row_ptr.end() - 1);
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                IndexType p(pos[i_it[ix]]++);
+                m_col_idx[p] = j_it[ix];
+                m_vals[p]    = static_cast<ScalarT>(v_it[ix]);
+            }
+
+            sortRows();
+        }
+
+        /**
+         * @brief Compressed copy of the stored values of a matrix (any
+         *        backend), cast to ScalarT.
+         */
+        template<typename MatrixT,
+                 typename std::enable_if_t<
+                     !std::is_same_v<MatrixT, CsrMatrix>, int> = 0>
+        explicit CsrMatrix(MatrixT const &A)
+            : CsrMatrix(fromTuples(A))
+        {
+        }
+
+        CsrMatrix(CsrMatrix const &rhs) = default;
+
+        /// Queued operations that read rhs are completed first.  rhs is left
+        /// with zero dimensions and can only be assigned to or destroyed.
+        CsrMatrix(CsrMatrix &&rhs) noexcept
+            : m_num_rows((detail::complete_pending_uses_noexcept(&rhs),
+                          rhs.m_num_rows)),
+              m_num_cols(rhs.m_num_cols),
+              m_row_ptr(std::move(rhs.m_row_ptr)),
+              m_col_idx(std::move(rhs.m_col_idx)),
+              m_vals(std::move(rhs.m_vals))
+        {
+            rhs.m_num_rows = 0;
+            rhs.m_num_cols = 0;
+        }
+
+        ~CsrMatrix() { detail::complete_pending_uses_noexcept(this); }
+
+        CsrMatrix &operator=(CsrMatrix const &rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::complete_pending_uses(this);
+                m_num_rows = rhs.m_num_rows;
+                m_num_cols = rhs.m_num_cols;
+                m_row_ptr  = rhs.m_row_ptr;
+                m_col_idx  = rhs.m_col_idx;
+                m_vals     = rhs.m_vals;
+            }
+            return *this;
+        }
+
+        CsrMatrix &operator=(CsrMatrix &&rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::complete_pending_uses(this);
+                detail::complete_pending_uses(&rhs);
+                m_num_rows = rhs.m_num_rows;
+                m_num_cols = rhs.m_num_cols;
+                m_row_ptr  = std::move(rhs.m_row_ptr);
+                m_col_idx  = std::move(rhs.m_col_idx);
+                m_vals     = std::move(rhs.m_vals);
+            }
+            return *this;
+        }
+
+        IndexType nrows() const { return m_num_rows; }
+        IndexType ncols() const { return m_num_cols; }
+        IndexType nvals() const { return m_col_idx.size(); }
+
+        /// row i is [rowPointers()[i], rowPointers()[i+1]) (nrows()+1 entries)
+        std::vector<IndexType> const &rowPointers() const { return m_row_ptr; }
+        std::vector<IndexType> const &colIndices()  const { return m_col_idx; }
+        std::vector<ScalarT>   const &values()      const { return m_vals; }
+
+        IndexType rowSize(IndexType row_index) const
+        {
+            return m_row_ptr[row_index + 1] - m_row_ptr[row_index];
+        }
+
+        void printInfo(std::ostream &os) const
+        {
+            os << "CsrMatrix<" << typeid(ScalarT).name() << "> ("
+               << m_num_rows << " x " << m_num_cols << "), nvals = "
+               << nvals() << std::endl;
+        }
+
+        friend std::ostream &operator<<(std::ostream    &os,
+                                        CsrMatrix const &mat)
+        {
+            mat.printInfo(os);
+            for (IndexType row = 0; row < mat.m_num_rows; ++row)
+            {
+                if (mat.rowSize(row) == 0) continue;
+
+                os << row << " :";
+                for (IndexType p = mat.m_row_ptr[row];
+                     p < mat.m_row_ptr[row + 1]; ++p)
+                {
+                    os << " " << mat.m_col_idx[p] << ":" << mat.m_vals[p];
+                }
+                os << std::endl;
+            }
+            return os;
+        }
+
+        /// The arrays are read by the backends directly.
+        friend inline CsrMatrix const &get_internal_matrix(CsrMatrix const &mat)
+        {
+            return mat;
+        }
+
+    private:
+        template<typename MatrixT>
+        static CsrMatrix fromTuples(MatrixT const &A)
+        {
+            IndexType nvals(A.nvals());
+            IndexArrayType rows(nvals), cols(nvals);
+            std::vector<typename MatrixT::ScalarType> vals(nvals);
+            A.extractTuples(rows.begin(), cols.begin(), vals.begin());
+
+            return CsrMatrix(A.nrows(), A.ncols(),
+                             rows.begin(), cols.begin(), vals.begin(), nvals);
+        }
+
+        // Sort the rows that are not ordered by column and reject repeated
+        // locations.
+        void sortRows()
+        {
+            std::vector<std::pair<IndexType, ScalarT>> row;
+            for (IndexType i = 0; i < m_num_rows; ++i)
+            {
+                auto first(m_col_idx.begin() + m_row_ptr[i]);
+                auto last(m_col_idx.begin() + m_row_ptr[i + 1]);
+                if (std::is_sorted(first, last)) continue;
+
+                row.clear();
+                for (IndexType p = m_row_ptr[i]; p < m_row_ptr[i + 1]; ++p)
+                {
+                    row.emplace_back(m_col_idx[p], m_vals[p]);
+                }
+                std::sort(row.begin(), row.end(),
+                          [](auto const &a, auto const &b)
+                          { return a.first < b.first; });
+
+                IndexType p(m_row_ptr[i]);
+                for (auto const &[col, val] : row)
+                {
+                    m_col_idx[p] = col;
+                    m_vals[p++]  = val;
+                }
+            }
+
+            for (IndexType i = 0; i < m_num_rows; ++i)
+            {
+                auto first(m_col_idx.begin() + m_row_ptr[i]);
+                auto last(m_col_idx.begin() + m_row_ptr[i + 1]);
+                if (std::adjacent_find(first, last) != last)
+                {
+                    throw InvalidValueException(
+                        "CsrMatrix: repeated location");
+                }
+            }
+        }
+
+        IndexType              m_num_rows;
+        IndexType              m_num_cols;
+        std::vector<IndexType> m_row_ptr;
+        std::vector<IndexType> m_col_idx;
+        std::vector<ScalarT>   m_vals;
+    };
+
+    namespace detail
+    {
+        /// Inputs of queued operations are held by reference, like Matrix.
+        template<typename ScalarT>
+        inline constexpr bool is_container_v<CsrMatrix<ScalarT>> = true;
+    }
+
+} // end namespace grb
@@ -0,0 +1,85 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <graphblas/Vector.hpp>
+
+//****************************************************************************
+//****************************************************************************
+
+namespace grb
+{
+    //************************************************************************
+    /**
+     * @brief A square matrix operand with the elements of a vector on its
+     *        diagonal, i.e. diag(v), that is never materialized.
+     *
+     * mxm, mxv and vxm recognize this view and replace the multiplication
+     * by row/column scaling (scale_rows/scale_cols) or an element-wise
+     * product, which is one pass over the other operand.
+     */
+    template<typename VectorT>
+    class DiagonalView
+    {
+    public:
+        using ScalarType = typename VectorT::ScalarType;
+
+        DiagonalView(VectorT const &vec)
+            : m_vec(vec)
+        {
+        }
+
+        IndexType nrows() const { return m_vec.size(); }
+        IndexType ncols() const { return m_vec.size(); }
+        IndexType nvals() const { return m_vec.nvals(); }
+
+        void printInfo(std::ostream &os) const
+        {
+            os << "DiagonalView of: ";
+            m_vec.printInfo(os);
+        }
+
+        friend std::ostream &operator<<(std::ostream       &os,
+                                        DiagonalView const &mat)
+        {
+            os << "DiagonalView of: ";
+            os << mat.m_vec;
+            return os;
+        }
+
+        VectorT const &m_vec;
+    };
+
+    //************************************************************************
+    template<typename VectorT>
+    inline DiagonalView<VectorT> diagonal(VectorT const &v)
+    {
+        return DiagonalView<VectorT>(v);
+    }
+} // end namespace grb
@@ -29,8 +29,10 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
+#include <graphblas/detail/nonblocking.hpp>
 #include <graphblas/types.hpp>
 
 #define GB_INCLUDE_BACKEND_MATRIX 1
@@ -46,6 +48,10 @@ namespace grb
      * @note The backend should be able to decide when to ignore any of the
      *       template tags and/or arguments.
      *
+     * @note In nonblocking mode the methods that observe stored values first
+     *       complete the pending operations writing this matrix, and the
+     *       methods that modify (or destroy) it complete the pending
+     *       operations that use it.  nrows() and ncols() never wait.
      */
     template<typename ScalarT, typename... TagsT>
     class Matrix
@@ -80,7 +86,20 @@ namespace grb
          * @param[in] rhs   The matrix to copy.
          */
         Matrix(Matrix<ScalarT, TagsT...> const &rhs)
-            : m_mat(rhs.m_mat)
+            : m_mat((detail::complete_pending_writes(&rhs), rhs.m_mat))
+        {
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param[in] rhs   The matrix to move from.  It is left with zero
+         *                  dimensions and can only be move-assigned to or
+         *                  destroyed (copy assignment checks dimensions).
+         */
+        Matrix(Matrix<ScalarT, TagsT...> &&rhs) noexcept
+            : m_mat((detail::complete_pending_uses_noexcept(&rhs),
+                     std::move(rhs.m_mat)))
         {
         }
 
@@ -112,24 +131,53 @@ namespace grb
         {
         }
 
-        ~Matrix() { }
+        ~Matrix() { detail::complete_pending_uses_noexcept(this); }
 
-        /// @todo Should assignment work only if dimensions are same?
+        /// Copy assignment requires equal dimensions (DimensionException
+        /// otherwise), like any other operation writing into this matrix.
         Matrix<ScalarT, TagsT...> &
         operator=(Matrix<ScalarT, TagsT...> const &rhs)
         {
             if (this != &rhs)
             {
+                detail::complete_pending_uses(this);
+                detail::complete_pending_writes(&rhs);
                 // backend currently doing dimension check.
                 m_mat = rhs.m_mat;
             }
             return *this;
         }
 
+        /// Move assignment replaces the whole matrix, dimensions included: unlike
+        /// copy assignment there is no dimension check, so this is the O(1) way
+        /// to replace a matrix by a result of another shape.  rhs receives the
+        /// previous contents and dimensions of this matrix.
+        Matrix<ScalarT, TagsT...> &
+        operator=(Matrix<ScalarT, TagsT...> &&rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                detail::complete_pending_uses_noexcept(this);
+                detail::complete_pending_uses_noexcept(&rhs);
+                m_mat = std::move(rhs.m_mat);
+            }
+            return *this;
+        }
+
+        /// O(1) exchange of the contents (and dimensions) of two matrices
+        void swap(Matrix<ScalarT, TagsT...> &rhs) noexcept
+        {
+            detail::complete_pending_uses_noexcept(this);
+            detail::complete_pending_uses_noexcept(&rhs);
+            m_mat.swap(rhs.m_mat);
+        }
+
 
         /// @todo need to change to mix and match internal types
         bool operator==(Matrix<ScalarT, TagsT...> const &rhs) const
         {
+            detail::complete_pending_writes(this);
+            detail::complete_pending_writes(&rhs);
             return (m_mat == rhs.m_mat);
         }
 
@@ -163,6 +211,7 @@ namespace grb
                    IndexType    num_vals,
                    BinaryOpT    dup = BinaryOpT())
         {
+            detail::complete_pending_uses(this);
             m_mat.build(i_it, j_it, v_it, num_vals, dup);
         }
 
@@ -192,15 +241,25 @@ namespace grb
                 throw DimensionException("Matrix::build");
             }
 
+            detail::complete_pending_uses(this);
             m_mat.build(row_indices.begin(), col_indices.begin(),
                         values.begin(), values.size(), dup);
         }
 
-        void clear() { m_mat.clear(); }
+        void clear()
+        {
+            detail::complete_pending_uses(this);
+            m_mat.clear();
+        }
 
         IndexType nrows() const  { return m_mat.nrows(); }
         IndexType ncols() const  { return m_mat.ncols(); }
-        IndexType nvals() const  { return m_mat.nvals(); }
+
+        IndexType nvals() const
+        {
+            detail::complete_pending_writes(this);
+            return m_mat.nvals();
+        }
 
         /**
          * @brief Resize the matrix dimensions (smaller or larger)
@@ -214,27 +273,32 @@ namespace grb
             if ((new_num_rows == 0) || (new_num_cols == 0))
                 throw InvalidValueException();
 
+            detail::complete_pending_uses(this);
             m_mat.resize(new_num_rows, new_num_cols);
         }
 
         bool hasElement(IndexType row, IndexType col) const
         {
+            detail::complete_pending_writes(this);
             return m_mat.hasElement(row, col);
         }
 
         void setElement(IndexType row, IndexType col, ScalarT const &val)
         {
+            detail::complete_pending_uses(this);
             m_mat.setElement(row, col, val);
         }
 
         void removeElement(IndexType row, IndexType col)
         {
+            detail::complete_pending_uses(this);
             m_mat.removeElement(row, col);
         }
 
         /// @throw NoValueException if there is no value stored at (row,col)
         ScalarT extractElement(IndexType row, IndexType col) const
         {
+            detail::complete_pending_writes(this);
             return m_mat.extractElement(row, col);
         }
 
@@ -245,6 +309,7 @@ namespace grb
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values) const
         {
+            detail::complete_pending_writes(this);
             m_mat.extractTuples(row_it, col_it, values);
         }
 
@@ -254,6 +319,7 @@ namespace grb
                                   ColSequenceT            &col_indices,
                                   std::vector<ScalarT>    &values) const
         {
+            detail::complete_pending_writes(this);
             m_mat.extractTuples(row_indices.begin(),
                                 col_indices.begin(),
                                 values.begin());
@@ -262,6 +328,7 @@ namespace grb
         // ================================================
         void printInfo(std::ostream &ostr) const
         {
+            detail::complete_pending_writes(this);
             ostr << "grb::Matrix: ";
             m_mat.printInfo(ostr);
         }
@@ -287,6 +354,11 @@ namespace grb
             return matrix.m_mat;
         }
 
+        friend inline void swap(Matrix &lhs, Matrix &rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
     };
 
     /// @deprecated
@@ -29,8 +29,10 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
+#include <graphblas/detail/nonblocking.hpp>
 #include <graphblas/types.hpp>
 
 #define GB_INCLUDE_BACKEND_VECTOR 1
@@ -39,6 +41,10 @@
 namespace grb
 {
     //**************************************************************************
+    /// @note In nonblocking mode the methods that observe stored values first
+    ///       complete the pending operations writing this vector, and the
+    ///       methods that modify (or destroy) it complete the pending
+    ///       operations that use it.  size() never waits.
     template<typename ScalarT, typename... TagsT>
     class Vector
     {
@@ -97,27 +103,82 @@ namespace grb
             : m_vec(values, zero)
         {
         }
+
+        /**
+         * @brief Copy constructor.
+         *
+         * @param[in] rhs  The vector to copy.
+         */
+        Vector(Vector<ScalarT, TagsT...> const &rhs)
+            : m_vec((detail::complete_pending_writes(&rhs), rhs.m_vec))
+        {
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param[in] rhs  The vector to move from.  It is left with size zero
+         *                 and can only be move-assigned to or destroyed (copy
+         *                 assignment checks the size).
+         */
+        Vector(Vector<ScalarT, TagsT...> &&rhs) noexcept
+            : m_vec((detail::complete_pending_uses_noexcept(&rhs),
+                     std::move(rhs.m_vec)))
+        {
+        }
+
         /// Destructor
-        ~Vector() { }
+        ~Vector() { detail::complete_pending_uses_noexcept(this); }
 
         /**
          * @brief Assignment from another vector
          *
          * @param[in]  rhs  The vector to copy from.
          *
-         * @todo Should assignment work only if dimensions are same?
+         * @throw DimensionException  If the sizes differ.
          * @note This clears any previous information
          */
-        Vector<ScalarT, TagsT...>
+        Vector<ScalarT, TagsT...>&
         operator=(Vector<ScalarT, TagsT...> const &rhs)
         {
             if (this != &rhs)
             {
+                detail::complete_pending_uses(this);
+                detail::complete_pending_writes(&rhs);
                 m_vec = rhs.m_vec;
             }
             return *this;
         }
 
+        /**
+         * @brief Move assignment from another vector
+         *
+         * @param[in]  rhs  The vector to move from; it receives the previous
+         *                  contents of this vector.
+         *
+         * @note Unlike copy assignment there is no size check: the vector is
+         *       replaced whole, size included, and rhs gets the old size.
+         */
+        Vector<ScalarT, TagsT...>&
+        operator=(Vector<ScalarT, TagsT...> &&rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                detail::complete_pending_uses_noexcept(this);
+                detail::complete_pending_uses_noexcept(&rhs);
+                m_vec = std::move(rhs.m_vec);
+            }
+            return *this;
+        }
+
+        /// O(1) exchange of the contents (and sizes) of two vectors
+        void swap(Vector<ScalarT, TagsT...> &rhs) noexcept
+        {
+            detail::complete_pending_uses_noexcept(this);
+            detail::complete_pending_uses_noexcept(&rhs);
+            m_vec.swap(rhs.m_vec);
+        }
+
         /**
          * @brief Assignment from dense data
          *
@@ -128,6 +189,7 @@ namespace grb
          */
         Vector<ScalarT, TagsT...>& operator=(std::vector<ScalarT> const &rhs)
         {
+            detail::complete_pending_uses(this);
             m_vec = rhs;
             return *this;
         }
@@ -135,6 +197,8 @@ namespace grb
         /// @todo need to change to mix and match internal types
         bool operator==(Vector<ScalarT, TagsT...> const &rhs) const
         {
+            detail::complete_pending_writes(this);
+            detail::complete_pending_writes(&rhs);
             return (m_vec == rhs.m_vec);
         }
 
@@ -164,6 +228,7 @@ namespace grb
                    IndexType    num_vals,
                    BinaryOpT    dup = BinaryOpT())
         {
+            detail::complete_pending_uses(this);
             m_vec.build(i_it, v_it, num_vals, dup);
         }
 
@@ -189,13 +254,23 @@ namespace grb
             {
                 throw DimensionException("Vector::build");
             }
+            detail::complete_pending_uses(this);
             m_vec.build(indices.begin(), values.begin(), values.size(), dup);
         }
 
-        void clear() { m_vec.clear(); }
+        void clear()
+        {
+            detail::complete_pending_uses(this);
+            m_vec.clear();
+        }
 
         IndexType size() const   { return m_vec.size(); }
-        IndexType nvals() const  { return m_vec.nvals(); }
+
+        IndexType nvals() const
+        {
+            detail::complete_pending_writes(this);
+            return m_vec.nvals();
+        }
 
         /**
          * @brief Resize the vector (smaller or larger)
@@ -208,27 +283,32 @@ namespace grb
             if (new_size == 0)
                 throw InvalidValueException();
 
+            detail::complete_pending_uses(this);
             m_vec.resize(new_size);
         }
 
         bool hasElement(IndexType index) const
         {
+            detail::complete_pending_writes(this);
             return m_vec.hasElement(index);
         }
 
         void setElement(IndexType index, ScalarT const &new_val)
         {
+            detail::complete_pending_uses(this);
             m_vec.setElement(index, new_val);
         }
 
         void removeElement(IndexType index)
         {
+            detail::complete_pending_uses(this);
             m_vec.removeElement(index);
         }
 
         /// @throw NoValueException if there is no value stored at (row,col)
         ScalarT extractElement(IndexType index) const
         {
+            detail::complete_pending_writes(this);
             return m_vec.extractElement(index);
         }
 
@@ -237,18 +317,21 @@ namespace grb
         void extractTuples(RAIteratorIT        i_it,
                            RAIteratorVT        v_it) const
         {
+            detail::complete_pending_writes(this);
             m_vec.extractTuples(i_it, v_it);
         }
 
         void extractTuples(IndexArrayType        &indices,
                            std::vector<ScalarT>  &values) const
         {
+            detail::complete_pending_writes(this);
             m_vec.extractTuples(indices, values);
         }
 
         // ================================================
         void printInfo(std::ostream &ostr) const
         {
+            detail::complete_pending_writes(this);
             ostr << "grb::Vector: ";
             m_vec.printInfo(ostr);
         }
@@ -273,6 +356,11 @@ namespace grb
         {
             return vector.m_vec;
         }
+
+        friend inline void swap(Vector &lhs, Vector &rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
     };
 
     /// @deprecated
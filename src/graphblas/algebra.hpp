@@ -32,8 +32,11 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <type_traits>
 #include <utility>
 
+#include <graphblas/types.hpp>
+
 namespace grb
 {
     namespace detail
@@ -338,6 +341,112 @@ namespace grb
         inline D3 operator()(D1 lhs, D2 rhs) const { return std::pow(lhs, rhs); }
     };
 
+    //************************************************************************
+    // The Index Unary Operators (select predicates)
+    //************************************************************************
+    // Called by select() with a stored value, its row and column indices
+    // (the column is 0 for vectors) and the scalar passed to select; an
+    // entry is kept when the operator returns true.
+    //
+    // In lambda speak
+    // [](D1 a, IndexType i, IndexType j, D2 s) -> bool { return a > s; }
+
+    // Keep entries on or below the s-th diagonal: j <= i + s
+    template<typename D1>
+    struct TriL
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, int64_t s) const
+        {
+            return (static_cast<int64_t>(j) <= static_cast<int64_t>(i) + s);
+        }
+    };
+
+    // Keep entries on or above the s-th diagonal: j >= i + s
+    template<typename D1>
+    struct TriU
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, int64_t s) const
+        {
+            return (static_cast<int64_t>(j) >= static_cast<int64_t>(i) + s);
+        }
+    };
+
+    // Keep entries on the s-th diagonal: j == i + s
+    template<typename D1>
+    struct Diag
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, int64_t s) const
+        {
+            return (static_cast<int64_t>(j) == static_cast<int64_t>(i) + s);
+        }
+    };
+
+    // Keep entries off the s-th diagonal: j != i + s
+    template<typename D1>
+    struct OffDiag
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, int64_t s) const
+        {
+            return (static_cast<int64_t>(j) != static_cast<int64_t>(i) + s);
+        }
+    };
+
+    //-------------------------------------------------------------------------
+
+    template<typename D1, typename D2 = D1>
+    struct ValueEqual
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 s) const
+        {
+            return a == s;
+        }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueNotEqual
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 s) const
+        {
+            return a != s;
+        }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueGreaterThan
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 s) const
+        {
+            return a > s;
+        }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueGreaterEqual
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 s) const
+        {
+            return a >= s;
+        }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueLessThan
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 s) const
+        {
+            return a < s;
+        }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueLessEqual
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 s) const
+        {
+            return a <= s;
+        }
+    };
+
 } // namespace grb
 
 
@@ -376,6 +485,39 @@ namespace grb
         }                                                       \
     };
 
+/**
+ * The macro for building simple templated monoid classes that also have a
+ * terminal value (annihilator): op(terminal, x) == terminal for all x, so a
+ * reduction can stop as soon as it reaches the terminal.
+ *
+ * @param[in]  M_NAME     The class name
+ * @param[in]  BINARYOP   The binary op callable to turn into a monoid
+ * @param[in]  IDENTITY   The identity value
+ * @param[in]  TERMINAL   The terminal value
+ */
+#define GEN_GRAPHBLAS_TERMINAL_MONOID(M_NAME, BINARYOP, IDENTITY, TERMINAL) \
+    template <typename ScalarT>                                 \
+    struct M_NAME                                               \
+    {                                                           \
+    public:                                                     \
+        using result_type = ScalarT;                            \
+                                                                \
+        ScalarT identity() const                                \
+        {                                                       \
+            return static_cast<ScalarT>(IDENTITY);              \
+        }                                                       \
+                                                                \
+        ScalarT terminal() const                                \
+        {                                                       \
+            return static_cast<ScalarT>(TERMINAL);              \
+        }                                                       \
+                                                                \
+        ScalarT operator()(ScalarT lhs, ScalarT rhs) const      \
+        {                                                       \
+            return BINARYOP<ScalarT>()(lhs, rhs);               \
+        }                                                       \
+    };
+
 //****************************************************************************
 namespace grb
 {
@@ -383,8 +525,8 @@ namespace grb
     GEN_GRAPHBLAS_MONOID(TimesMonoid, Times, 1)
 
     /// @todo the following identity only works for boolean domain
-    GEN_GRAPHBLAS_MONOID(LogicalOrMonoid,   LogicalOr,   false)
-    GEN_GRAPHBLAS_MONOID(LogicalAndMonoid,  LogicalAnd,  true)
+    GEN_GRAPHBLAS_TERMINAL_MONOID(LogicalOrMonoid,   LogicalOr,   false, true)
+    GEN_GRAPHBLAS_TERMINAL_MONOID(LogicalAndMonoid,  LogicalAnd,  true,  false)
     GEN_GRAPHBLAS_MONOID(LogicalXorMonoid,  LogicalXor,  false)
     GEN_GRAPHBLAS_MONOID(LogicalXnorMonoid, LogicalXnor, true)
 
@@ -407,6 +549,11 @@ namespace grb
             return static_cast<ScalarT>(std::numeric_limits<ScalarT>::min());
         }
 
+        ScalarT terminal() const
+        {
+            return static_cast<ScalarT>(std::numeric_limits<ScalarT>::max());
+        }
+
         ScalarT operator()(ScalarT lhs, ScalarT rhs) const
         {
             return grb::Max<ScalarT>()(lhs, rhs);
@@ -426,6 +573,11 @@ namespace grb
             return static_cast<ScalarT>(-std::numeric_limits<ScalarT>::infinity());
         }
 
+        ScalarT terminal() const
+        {
+            return static_cast<ScalarT>(std::numeric_limits<ScalarT>::infinity());
+        }
+
         ScalarT operator()(ScalarT lhs, ScalarT rhs) const
         {
             return grb::Max<ScalarT>()(lhs, rhs);
@@ -454,6 +606,11 @@ namespace grb
             return static_cast<ScalarT>(std::numeric_limits<ScalarT>::max());
         }
 
+        ScalarT terminal() const
+        {
+            return static_cast<ScalarT>(std::numeric_limits<ScalarT>::min());
+        }
+
         ScalarT operator()(ScalarT lhs, ScalarT rhs) const
         {
             return grb::Min<ScalarT>()(lhs, rhs);
@@ -473,6 +630,11 @@ namespace grb
             return static_cast<ScalarT>(std::numeric_limits<ScalarT>::infinity());
         }
 
+        ScalarT terminal() const
+        {
+            return static_cast<ScalarT>(-std::numeric_limits<ScalarT>::infinity());
+        }
+
         ScalarT operator()(ScalarT lhs, ScalarT rhs) const
         {
             return grb::Min<ScalarT>()(lhs, rhs);
@@ -509,6 +671,11 @@ namespace grb
                                                                         \
         D3 zero() const                                                 \
         { return ADD_MONOID<D3>().identity(); }                         \
+                                                                        \
+        /* only if the add monoid has a terminal value */               \
+        template <typename AddMonoidT = ADD_MONOID<D3> >                \
+        auto terminal() const -> decltype(AddMonoidT().terminal())      \
+        { return AddMonoidT().terminal(); }                             \
     };
 
 
@@ -613,6 +780,12 @@ namespace grb
             return sr.zero();
         }
 
+        template <typename SR = SemiringT>
+        auto terminal() const -> decltype(std::declval<SR const &>().terminal())
+        {
+            return sr.terminal();
+        }
+
         typename SemiringT::result_type operator() (
             typename SemiringT::result_type lhs,
             typename SemiringT::result_type rhs) const
@@ -640,4 +813,36 @@ namespace grb
         return AdditiveMonoidFromSemiring<SemiringT>(sr);
     }
 
+    //************************************************************************
+    // Terminal values (annihilators) of monoids and semiring additions
+    //************************************************************************
+
+    template <typename OpT, typename = void>
+    struct has_terminal : std::false_type {};
+
+    template <typename OpT>
+    struct has_terminal<
+        OpT, std::void_t<decltype(std::declval<OpT const &>().terminal())> >
+        : std::true_type {};
+
+    /// True if the monoid (or semiring) has a terminal value
+    template <typename OpT>
+    inline constexpr bool has_terminal_v = has_terminal<OpT>::value;
+
+    //************************************************************************
+    /// True if val is the terminal value of op: further additions cannot
+    /// change it.  Always false (and free) for ops without a terminal.
+    template <typename OpT, typename ValueT>
+    inline bool is_terminal(OpT const &op, ValueT const &val)
+    {
+        if constexpr (has_terminal_v<OpT>)
+        {
+            return (val == op.terminal());
+        }
+        else
+        {
+            return false;
+        }
+    }
+
 } // namespace grb
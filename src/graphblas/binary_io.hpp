@@ -0,0 +1,518 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+// Binary (memory-mapped) matrix file format
+//
+// A file holds one matrix in compressed sparse row form:
+//
+//   BinaryMatrixHeader (64 bytes)
+//   row_ptr[nrows + 1]   uint64
+//   col_idx[nvals]       uint64, sorted within each row
+//   vals[nvals]          scalar_size bytes each (bool is stored as one byte)
+//
+// All integers are in the byte order of the machine that wrote the file;
+// every array starts on an 8-byte boundary so the file can be mapped and
+// used in place.
+//****************************************************************************
+namespace grb
+{
+    namespace detail
+    {
+        static constexpr char     BINARY_MATRIX_MAGIC[8] = "GBTLCSR";
+        static constexpr uint32_t BINARY_MATRIX_VERSION  = 1;
+        static constexpr uint32_t BINARY_BYTE_ORDER_MARK = 0x01020304;
+
+        struct BinaryMatrixHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t byte_order;
+            uint32_t scalar_code;
+            uint32_t scalar_size;
+            uint64_t nrows;
+            uint64_t ncols;
+            uint64_t nvals;
+            uint64_t reserved[2];
+        };
+        static_assert(sizeof(BinaryMatrixHeader) == 64,
+                      "BinaryMatrixHeader must be 64 bytes");
+        static_assert(sizeof(IndexType) == sizeof(uint64_t),
+                      "binary matrix format requires 64-bit indices");
+
+        template<typename T> struct dependent_false : std::false_type {};
+
+        /// Type code stored in the file header: distinguishes bool, signed
+        /// and unsigned integers, and floating point, along with the size.
+        template<typename ScalarT>
+        constexpr uint32_t binary_scalar_code()
+        {
+            if constexpr (std::is_same_v<ScalarT, bool>)
+                return 0x01;
+            else if constexpr (std::is_integral_v<ScalarT>)
+                return ((std::is_signed_v<ScalarT> ? 0x10 : 0x20) |
+                        static_cast<uint32_t>(sizeof(ScalarT)));
+            else if constexpr (std::is_floating_point_v<ScalarT>)
+                return (0x40 | static_cast<uint32_t>(sizeof(ScalarT)));
+            else
+                static_assert(dependent_false<ScalarT>::value,
+                              "binary matrix format supports arithmetic types only");
+        }
+
+        //********************************************************************
+        /// Read-only memory mapping of an entire file (unmapped on
+        /// destruction).
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(std::string const &pathname)
+            {
+                int fd = ::open(pathname.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    throw PanicException("MappedFile: cannot open " + pathname);
+                }
+
+                struct stat st;
+                if (::fstat(fd, &st) != 0)
+                {
+                    ::close(fd);
+                    throw PanicException("MappedFile: cannot stat " + pathname);
+                }
+                m_size = static_cast<size_t>(st.st_size);
+
+                if (m_size > 0)
+                {
+                    void *addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE,
+                                        fd, 0);
+                    if (addr == MAP_FAILED)
+                    {
+                        ::close(fd);
+                        throw PanicException("MappedFile: cannot map " + pathname);
+                    }
+                    m_data = static_cast<char const *>(addr);
+                }
+                ::close(fd);  // the mapping stays valid
+            }
+
+            ~MappedFile()
+            {
+                if (m_data != nullptr)
+                {
+                    ::munmap(const_cast<char *>(m_data), m_size);
+                }
+            }
+
+            MappedFile(MappedFile const &) = delete;
+            MappedFile &operator=(MappedFile const &) = delete;
+
+            char const *data() const { return m_data; }
+            size_t      size() const { return m_size; }
+
+        private:
+            char const *m_data = nullptr;
+            size_t      m_size = 0;
+        };
+    } // namespace detail
+
+    //************************************************************************
+    /**
+     * @brief Read-only CSR matrix backed by a memory-mapped binary file.
+     *
+     * The arrays are used in place: construction maps the file and checks
+     * the header, the row pointers, the column indices (in range and
+     * strictly increasing in each row) and, for bool, the value bytes, in
+     * one pass without copying them.  Copies share the mapping, which is
+     * released when the last copy is destroyed.
+     */
+    template<typename ScalarT>
+    class MappedMatrix
+    {
+    public:
+        using ScalarType = ScalarT;
+
+        explicit MappedMatrix(std::string const &pathname)
+            : m_file(std::make_shared<detail::MappedFile>(pathname))
+        {
+            using detail::BinaryMatrixHeader;
+
+            if (m_file->size() < sizeof(BinaryMatrixHeader))
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: file too small: " + pathname);
+            }
+
+            BinaryMatrixHeader const *header =
+                reinterpret_cast<BinaryMatrixHeader const *>(m_file->data());
+            if (std::memcmp(header->magic, detail::BINARY_MATRIX_MAGIC,
+                            sizeof(header->magic)) != 0)
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: not a binary matrix file: " + pathname);
+            }
+            if (header->version != detail::BINARY_MATRIX_VERSION)
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: unsupported version: " + pathname);
+            }
+            if (header->byte_order != detail::BINARY_BYTE_ORDER_MARK)
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: byte order mismatch: " + pathname);
+            }
+            if ((header->scalar_code != detail::binary_scalar_code<ScalarT>()) ||
+                (header->scalar_size != sizeof(ScalarT)))
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: scalar type mismatch: " + pathname);
+            }
+
+            m_num_rows = header->nrows;
+            m_num_cols = header->ncols;
+            m_nvals    = header->nvals;
+
+            // The sizes come from the file: reject counts whose byte size
+            // would overflow before comparing against the file size.
+            size_t const max_size(std::numeric_limits<size_t>::max());
+            size_t const max_elts(max_size/(2*sizeof(IndexType) +
+                                            sizeof(ScalarT) + 1));
+            if ((m_num_rows >= max_elts) || (m_nvals >= max_elts))
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: dimensions too large: " + pathname);
+            }
+
+            size_t expected = sizeof(BinaryMatrixHeader) +
+                sizeof(IndexType)*(m_num_rows + 1) +
+                sizeof(IndexType)*m_nvals +
+                sizeof(ScalarT)*m_nvals;
+            if (m_file->size() < expected)
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: file is truncated: " + pathname);
+            }
+
+            char const *pos = m_file->data() + sizeof(BinaryMatrixHeader);
+            m_row_ptr = reinterpret_cast<IndexType const *>(pos);
+            pos += sizeof(IndexType)*(m_num_rows + 1);
+            m_col_idx = reinterpret_cast<IndexType const *>(pos);
+            pos += sizeof(IndexType)*m_nvals;
+            m_vals    = reinterpret_cast<ScalarT const *>(pos);
+
+            // Every row range must lie inside the column/value arrays
+            bool valid_row_ptr((m_row_ptr[0] == 0) &&
+                               (m_row_ptr[m_num_rows] == m_nvals));
+            for (IndexType row = 0; valid_row_ptr && (row < m_num_rows); ++row)
+            {
+                valid_row_ptr = ((m_row_ptr[row] <= m_row_ptr[row + 1]) &&
+                                 (m_row_ptr[row + 1] <= m_nvals));
+            }
+            if (!valid_row_ptr)
+            {
+                throw InvalidValueException(
+                    "MappedMatrix: inconsistent row pointers: " + pathname);
+            }
+
+            // Column indices must be in range and strictly increasing
+            // within each row (findElement and build rely on both).
+            for (IndexType row = 0; row < m_num_rows; ++row)
+            {
+                for (IndexType pos = m_row_ptr[row]; pos < m_row_ptr[row + 1];
+                     ++pos)
+                {
+                    if ((m_col_idx[pos] >= m_num_cols) ||
+                        ((pos > m_row_ptr[row]) &&
+                         (m_col_idx[pos] <= m_col_idx[pos - 1])))
+                    {
+                        throw InvalidValueException(
+                            "MappedMatrix: invalid column index: " + pathname);
+                    }
+                }
+            }
+
+            // A bool byte other than 0 or 1 is not a valid bool object.
+            if constexpr (std::is_same_v<ScalarT, bool>)
+            {
+                unsigned char const *bytes(
+                    reinterpret_cast<unsigned char const *>(m_vals));
+                for (IndexType pos = 0; pos < m_nvals; ++pos)
+                {
+                    if (bytes[pos] > 1)
+                    {
+                        throw InvalidValueException(
+                            "MappedMatrix: invalid bool value: " + pathname);
+                    }
+                }
+            }
+        }
+
+        IndexType nrows() const { return m_num_rows; }
+        IndexType ncols() const { return m_num_cols; }
+        IndexType nvals() const { return m_nvals; }
+
+        // Raw storage access (nrows+1, nvals and nvals entries respectively)
+        IndexType const *rowPointers() const { return m_row_ptr; }
+        IndexType const *colIndices()  const { return m_col_idx; }
+        ScalarT   const *values()      const { return m_vals; }
+
+        IndexType rowBegin(IndexType row_index) const
+        {
+            return m_row_ptr[row_index];
+        }
+
+        IndexType rowEnd(IndexType row_index) const
+        {
+            return m_row_ptr[row_index + 1];
+        }
+
+        IndexType rowSize(IndexType row_index) const
+        {
+            return m_row_ptr[row_index + 1] - m_row_ptr[row_index];
+        }
+
+        bool hasElement(IndexType irow, IndexType icol) const
+        {
+            if (irow >= m_num_rows || icol >= m_num_cols)
+            {
+                throw IndexOutOfBoundsException(
+                    "hasElement: index out of bounds");
+            }
+
+            return (findElement(irow, icol) != NOT_FOUND);
+        }
+
+        ScalarT extractElement(IndexType irow, IndexType icol) const
+        {
+            if (irow >= m_num_rows || icol >= m_num_cols)
+            {
+                throw IndexOutOfBoundsException(
+                    "extractElement: index out of bounds");
+            }
+
+            IndexType pos(findElement(irow, icol));
+            if (pos == NOT_FOUND)
+            {
+                throw NoValueException("extractElement: no entry at index");
+            }
+            return m_vals[pos];
+        }
+
+        template<typename RAIteratorIT,
+                 typename RAIteratorJT,
+                 typename RAIteratorVT>
+        void extractTuples(RAIteratorIT        row_it,
+                           RAIteratorJT        col_it,
+                           RAIteratorVT        values) const
+        {
+            for (IndexType row = 0; row < m_num_rows; ++row)
+            {
+                for (IndexType pos = rowBegin(row); pos < rowEnd(row); ++pos)
+                {
+                    *row_it = row;            ++row_it;
+                    *col_it = m_col_idx[pos]; ++col_it;
+                    *values = m_vals[pos];    ++values;
+                }
+            }
+        }
+
+    private:
+        static constexpr IndexType NOT_FOUND =
+            std::numeric_limits<IndexType>::max();
+
+        // binary search within the row
+        IndexType findElement(IndexType irow, IndexType icol) const
+        {
+            IndexType const *first(m_col_idx + m_row_ptr[irow]);
+            IndexType const *last(m_col_idx + m_row_ptr[irow + 1]);
+            IndexType const *it(std::lower_bound(first, last, icol));
+            if ((it != last) && (*it == icol))
+            {
+                return (it - m_col_idx);
+            }
+            return NOT_FOUND;
+        }
+
+        std::shared_ptr<detail::MappedFile> m_file;
+
+        IndexType        m_num_rows;
+        IndexType        m_num_cols;
+        IndexType        m_nvals;
+        IndexType const *m_row_ptr;
+        IndexType const *m_col_idx;
+        ScalarT   const *m_vals;
+    };
+
+    //************************************************************************
+    /**
+     * @brief Write a matrix to a file in the binary (CSR) format.
+     *
+     * @param[in] pathname  File to create or overwrite.
+     * @param[in] A         The matrix to write.
+     */
+    template<typename MatrixT>
+    void save_binary(std::string const &pathname, MatrixT const &A)
+    {
+        using ScalarT = typename MatrixT::ScalarType;
+        using StoredT = std::conditional_t<std::is_same_v<ScalarT, bool>,
+                                           uint8_t, ScalarT>;
+        static_assert(sizeof(StoredT) == sizeof(ScalarT),
+                      "bool must be one byte to be stored in place");
+
+        IndexType const nrows(A.nrows());
+        IndexType const nvals(A.nvals());
+
+        IndexArrayType       rows(nvals), cols(nvals);
+        std::vector<ScalarT> vals(nvals);
+        A.extractTuples(rows.begin(), cols.begin(), vals.begin());
+
+        // counting sort by row (stable), then sort each row by column
+        IndexArrayType row_ptr(nrows + 1, 0);
+        for (IndexType ix = 0; ix < nvals; ++ix)
+        {
+            ++row_ptr[rows[ix] + 1];
+        }
+        std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+        IndexArrayType perm(nvals);
+        IndexArrayType next(row_ptr.begin(), row_ptr.end() - 1);
+        for (IndexType ix = 0; ix < nvals; ++ix)
+        {
+            perm[next[rows[ix]]++] = ix;
+        }
+
+        IndexArrayType       col_idx(nvals);
+        std::vector<StoredT> stored_vals(nvals);
+        for (IndexType row = 0; row < nrows; ++row)
+        {
+            auto first(perm.begin() + row_ptr[row]);
+            auto last(perm.begin() + row_ptr[row + 1]);
+            if (!std::is_sorted(first, last,
+                                [&cols](IndexType a, IndexType b)
+                                { return cols[a] < cols[b]; }))
+            {
+                std::sort(first, last,
+                          [&cols](IndexType a, IndexType b)
+                          { return cols[a] < cols[b]; });
+            }
+            for (IndexType pos = row_ptr[row]; pos < row_ptr[row + 1]; ++pos)
+            {
+                col_idx[pos]     = cols[perm[pos]];
+                stored_vals[pos] = static_cast<StoredT>(vals[perm[pos]]);
+            }
+        }
+
+        detail::BinaryMatrixHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, detail::BINARY_MATRIX_MAGIC,
+                    sizeof(header.magic));
+        header.version     = detail::BINARY_MATRIX_VERSION;
+        header.byte_order  = detail::BINARY_BYTE_ORDER_MARK;
+        header.scalar_code = detail::binary_scalar_code<ScalarT>();
+        header.scalar_size = sizeof(ScalarT);
+        header.nrows       = nrows;
+        header.ncols       = A.ncols();
+        header.nvals       = nvals;
+
+        std::ofstream ofs(pathname, std::ios::binary | std::ios::trunc);
+        if (!ofs)
+        {
+            throw PanicException("save_binary: cannot open " + pathname);
+        }
+        ofs.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<char const *>(row_ptr.data()),
+                  sizeof(IndexType)*row_ptr.size());
+        ofs.write(reinterpret_cast<char const *>(col_idx.data()),
+                  sizeof(IndexType)*col_idx.size());
+        ofs.write(reinterpret_cast<char const *>(stored_vals.data()),
+                  sizeof(StoredT)*stored_vals.size());
+        if (!ofs)
+        {
+            throw PanicException("save_binary: write failed: " + pathname);
+        }
+    }
+
+    //************************************************************************
+    /**
+     * @brief Map a binary matrix file as a read-only CSR matrix (zero copy).
+     *
+     * @tparam    ScalarT   Must match the scalar type the file was saved with.
+     * @param[in] pathname  File written by save_binary.
+     */
+    template<typename ScalarT>
+    MappedMatrix<ScalarT> load_binary(std::string const &pathname)
+    {
+        return MappedMatrix<ScalarT>(pathname);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Load a binary matrix file into a Matrix.
+     *
+     * A is resized to the stored dimensions and its contents replaced.  The
+     * column indices and values are passed to build() directly from the
+     * mapping, in row-major order.
+     */
+    template<typename ScalarT, typename... TagsT>
+    void load_binary(std::string const &pathname,
+                     Matrix<ScalarT, TagsT...> &A)
+    {
+        MappedMatrix<ScalarT> mapped(pathname);
+
+        IndexArrayType rows(mapped.nvals());
+        for (IndexType row = 0; row < mapped.nrows(); ++row)
+        {
+            std::fill(rows.begin() + mapped.rowBegin(row),
+                      rows.begin() + mapped.rowEnd(row), row);
+        }
+
+        A.clear();
+        A.resize(mapped.nrows(), mapped.ncols());
+        A.build(rows.begin(), mapped.colIndices(), mapped.values(),
+                mapped.nvals());
+    }
+
+} // namespace grb
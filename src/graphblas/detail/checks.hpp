@@ -31,6 +31,7 @@
 #define GB_INCLUDE_BACKEND_VECTOR 1
 #include <backend_include.hpp>
 #include "logging.h"
+#include "nonblocking.hpp"
 
 namespace grb
 {
@@ -323,4 +324,31 @@ namespace grb
     {
     }
 
+    // ================================================
+    // Index-out-of-bounds is an execution error detected by the backend, but
+    // in nonblocking mode a queued operation may never run (it is dropped if
+    // its output is overwritten first), so the contents of the index arrays
+    // are checked before the operation is queued.
+
+    template <typename S>
+    void check_index_array_content_deferred(const S &seq, IndexType dim,
+                                            const std::string &msg)
+    {
+        if (detail::execution_context().mode() == BLOCKING) return;
+
+        for (auto ix : seq)
+        {
+            if (ix >= dim)
+            {
+                throw IndexOutOfBoundsException(msg);
+            }
+        }
+    }
+
+    inline void check_index_array_content_deferred(const grb::AllIndices &seq,
+                                                   IndexType dim,
+                                                   const std::string &msg)
+    {
+    }
+
 } // end namespace grb
@@ -0,0 +1,707 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+// Nonblocking execution.  In NONBLOCKING mode (see grb::init) the operations
+// in operations.hpp only check their arguments and append the work to a
+// queue.  The queue is completed lazily: when a value of a container is
+// observed (nvals, extractElement, ...), when a container is modified
+// outside of an operation or destroyed, or on grb::wait().  Only the ops
+// the observed container depends on are run.
+//
+// At completion two transformations are applied:
+//  - an op whose output is overwritten by a later op before anything reads
+//    it is dropped;
+//  - an element-wise vector op without mask or accumulator (the producer)
+//    immediately followed by a vxm that consumes its output (the consumer)
+//    runs as one pass when the produced vector is dead afterwards: the
+//    produced elements are streamed into the multiply and never stored.
+//
+// The frontend containers are captured by reference, everything else
+// (operators, views, index arrays, scalars) by value.  Index sequences that
+// refer to external storage must outlive the operation.  The queue is not
+// thread safe; the operations must be issued from one thread.
+//****************************************************************************
+
+namespace grb
+{
+    /// Execution modes accepted by grb::init (cf. GrB_Mode in the C API)
+    enum ExecutionMode
+    {
+        BLOCKING,
+        NONBLOCKING
+    };
+
+    template<typename ScalarT, typename... TagsT> class Matrix;
+    template<typename ScalarT, typename... TagsT> class Vector;
+
+    namespace detail
+    {
+        //********************************************************************
+        /// Counters reported by the execution context (used for testing).
+        struct ExecutionStats
+        {
+            std::size_t deferred   = 0;  ///< ops queued
+            std::size_t executed   = 0;  ///< ops run (a fused pair counts once)
+            std::size_t fused      = 0;  ///< producer/consumer pairs fused
+            std::size_t eliminated = 0;  ///< ops dropped as dead writes
+        };
+
+        //********************************************************************
+        /// A deferred operation: one output container and the containers it
+        /// reads.  An op that overwrites its output (no accumulator, and no
+        /// mask or REPLACE) does not read the previous contents.
+        class PendingOp
+        {
+        public:
+            PendingOp(void const               *output,
+                      bool                      overwrites_output,
+                      std::vector<void const *> inputs)
+                : m_output(output),
+                  m_overwrites_output(overwrites_output),
+                  m_inputs(std::move(inputs))
+            {
+            }
+
+            virtual ~PendingOp() = default;
+
+            virtual void run() = 0;
+
+            /// Run this op with producer (the op queued immediately before
+            /// it) fused in.  Returns false (without doing anything) if this
+            /// op does not know how to consume producer.
+            virtual bool run_fused(PendingOp &) { return false; }
+
+            void const *output() const          { return m_output; }
+            bool overwrites_output() const      { return m_overwrites_output; }
+
+            /// Number of inputs that refer to obj
+            std::size_t input_count(void const *obj) const
+            {
+                return static_cast<std::size_t>(
+                    std::count(m_inputs.begin(), m_inputs.end(), obj));
+            }
+
+            bool reads(void const *obj) const
+            {
+                return ((input_count(obj) > 0) ||
+                        ((obj == m_output) && !m_overwrites_output));
+            }
+
+            bool touches(void const *obj) const
+            {
+                return ((obj == m_output) || (input_count(obj) > 0));
+            }
+
+            std::vector<void const *> const &inputs() const { return m_inputs; }
+
+        private:
+            void const               *m_output;
+            bool                      m_overwrites_output;
+            std::vector<void const *> m_inputs;
+        };
+
+        //********************************************************************
+        /// A deferred op producing a vector whose stored values can be
+        /// streamed, in increasing index order, without storing them.
+        ///
+        /// The sink is a template parameter of stream().  The producer and
+        /// the consumer only meet through the queue, so the elements cross
+        /// that (virtual) boundary in fixed size chunks: both loops are
+        /// compiled with the concrete types, and there is one indirect call
+        /// per chunk instead of one per element.
+        template<typename ScalarT>
+        class VectorProducer
+        {
+        public:
+            using ElementType = std::tuple<IndexType, ScalarT>;
+            using ChunkFnType = void (*)(void *, ElementType const *,
+                                         std::size_t);
+
+            static constexpr std::size_t CHUNK_SIZE = 256;
+
+            virtual ~VectorProducer() = default;
+
+            /// Call sink(index, value) for each produced element.
+            template<typename SinkT>
+            void stream(SinkT &&sink) const
+            {
+                using SinkType = std::remove_reference_t<SinkT>;
+                stream_chunks(
+                    [](void *context, ElementType const *elts, std::size_t n)
+                    {
+                        SinkType &chunk_sink(*static_cast<SinkType *>(context));
+                        for (std::size_t k = 0; k < n; ++k)
+                        {
+                            chunk_sink(std::get<0>(elts[k]),
+                                       std::get<1>(elts[k]));
+                        }
+                    },
+                    const_cast<void *>(static_cast<void const *>(&sink)));
+            }
+
+        protected:
+            /// Call chunk_fn(context, elements, n) for consecutive chunks of
+            /// at most CHUNK_SIZE produced elements.
+            virtual void stream_chunks(ChunkFnType chunk_fn,
+                                       void       *context) const = 0;
+        };
+
+        //********************************************************************
+        class ExecutionContext
+        {
+        public:
+            ExecutionMode mode() const { return m_mode; }
+
+            void set_mode(ExecutionMode mode)
+            {
+                complete_all();
+                m_mode = mode;
+            }
+
+            bool has_pending() const { return !m_queue.empty(); }
+
+            ExecutionStats const &stats() const { return m_stats; }
+            void reset_stats() { m_stats = ExecutionStats(); }
+
+            void enqueue(std::unique_ptr<PendingOp> op)
+            {
+                ++m_stats.deferred;
+                m_queue.push_back(std::move(op));
+            }
+
+            /// Run every pending op.
+            void complete_all()
+            {
+                complete(std::vector<bool>(m_queue.size(), true));
+            }
+
+            /// Run the pending ops needed to produce the current value of
+            /// obj (its last writer and everything that one depends on).
+            void complete_writes_to(void const *obj)
+            {
+                for (std::size_t k = m_queue.size(); k > 0; --k)
+                {
+                    if (m_queue[k - 1]->output() == obj)
+                    {
+                        complete(select_dependencies(k - 1, nullptr));
+                        return;
+                    }
+                }
+            }
+
+            /// Run every pending op that reads or writes obj (and what those
+            /// depend on), so obj can be modified or destroyed.
+            void complete_uses_of(void const *obj)
+            {
+                for (std::size_t k = m_queue.size(); k > 0; --k)
+                {
+                    if (m_queue[k - 1]->touches(obj))
+                    {
+                        complete(select_dependencies(k - 1, obj));
+                        return;
+                    }
+                }
+            }
+
+            /// Errors raised while completing ops from a context that cannot
+            /// throw (destructors, moves) are reported by the next wait().
+            void defer_error(std::exception_ptr error)
+            {
+                if (!m_deferred_error) m_deferred_error = error;
+            }
+
+            void rethrow_deferred_error()
+            {
+                if (m_deferred_error)
+                {
+                    std::exception_ptr error(m_deferred_error);
+                    m_deferred_error = nullptr;
+                    std::rethrow_exception(error);
+                }
+            }
+
+        private:
+            /// Select op last and the earlier ops it (transitively) conflicts
+            /// with (read-after-write, write-after-read, write-after-write).
+            /// If obj is given, also every op touching obj.
+            std::vector<bool> select_dependencies(std::size_t last,
+                                                  void const *obj) const
+            {
+                std::vector<bool> selected(m_queue.size(), false);
+                std::vector<void const *> written, read;
+
+                auto add([&](PendingOp const &op)
+                         {
+                             written.push_back(op.output());
+                             read.insert(read.end(),
+                                         op.inputs().begin(),
+                                         op.inputs().end());
+                             if (!op.overwrites_output())
+                                 read.push_back(op.output());
+                         });
+                auto contains([](std::vector<void const *> const &ids,
+                                 void const *id)
+                              {
+                                  return (std::find(ids.begin(), ids.end(), id)
+                                          != ids.end());
+                              });
+
+                selected[last] = true;
+                add(*m_queue[last]);
+                for (std::size_t k = last; k > 0; --k)
+                {
+                    PendingOp const &op(*m_queue[k - 1]);
+                    bool conflict = ((obj != nullptr) && op.touches(obj)) ||
+                        contains(written, op.output()) ||
+                        contains(read, op.output());
+                    for (auto id : op.inputs())
+                        conflict = conflict || contains(written, id);
+
+                    if (conflict)
+                    {
+                        selected[k - 1] = true;
+                        add(op);
+                    }
+                }
+                return selected;
+            }
+
+            /// True if the next op after position pos that touches obj
+            /// overwrites it without reading it.
+            static bool dead_after(
+                std::vector<std::unique_ptr<PendingOp>> const &queue,
+                std::size_t                                    pos,
+                void const                                    *obj)
+            {
+                for (std::size_t k = pos + 1; k < queue.size(); ++k)
+                {
+                    if (queue[k]->touches(obj))
+                    {
+                        return ((queue[k]->output() == obj) &&
+                                queue[k]->overwrites_output() &&
+                                !queue[k]->reads(obj));
+                    }
+                }
+                return false;
+            }
+
+            void complete(std::vector<bool> const &selected)
+            {
+                std::vector<std::unique_ptr<PendingOp>> queue;
+                queue.swap(m_queue);
+
+                try
+                {
+                    for (std::size_t k = 0; k < queue.size(); ++k)
+                    {
+                        if (!selected[k])
+                        {
+                            m_queue.push_back(std::move(queue[k]));
+                            continue;
+                        }
+
+                        PendingOp &op(*queue[k]);
+                        if (op.overwrites_output() &&
+                            dead_after(queue, k, op.output()))
+                        {
+                            ++m_stats.eliminated;
+                            continue;
+                        }
+
+                        // The produced vector must not be needed after the
+                        // consumer: either the consumer overwrites it, or the
+                        // next op to touch it does.
+                        if ((k + 1 < queue.size()) && selected[k + 1])
+                        {
+                            PendingOp &next(*queue[k + 1]);
+                            bool dead =
+                                ((next.output() == op.output()) &&
+                                 next.overwrites_output()) ||
+                                dead_after(queue, k + 1, op.output());
+                            if (dead && next.run_fused(op))
+                            {
+                                ++m_stats.fused;
+                                ++m_stats.executed;
+                                ++k;
+                                continue;
+                            }
+                        }
+
+                        op.run();
+                        ++m_stats.executed;
+                    }
+                }
+                catch (...)
+                {
+                    // The outputs of the remaining ops are undefined.
+                    m_queue.clear();
+                    throw;
+                }
+            }
+
+            ExecutionMode                           m_mode = BLOCKING;
+            std::vector<std::unique_ptr<PendingOp>> m_queue;
+            ExecutionStats                          m_stats;
+            std::exception_ptr                      m_deferred_error;
+        };
+
+        inline ExecutionContext &execution_context()
+        {
+            static ExecutionContext context;
+            return context;
+        }
+
+        //********************************************************************
+        // Hooks called by the frontend containers
+        //********************************************************************
+
+        /// Before a value of obj is observed
+        inline void complete_pending_writes(void const *obj)
+        {
+            ExecutionContext &context(execution_context());
+            if (context.has_pending()) context.complete_writes_to(obj);
+        }
+
+        /// Before obj is modified (outside of an operation)
+        inline void complete_pending_uses(void const *obj)
+        {
+            ExecutionContext &context(execution_context());
+            if (context.has_pending()) context.complete_uses_of(obj);
+        }
+
+        /// Before obj is moved from/to or destroyed
+        inline void complete_pending_uses_noexcept(void const *obj) noexcept
+        {
+            ExecutionContext &context(execution_context());
+            if (context.has_pending())
+            {
+                try
+                {
+                    context.complete_uses_of(obj);
+                }
+                catch (...)
+                {
+                    context.defer_error(std::current_exception());
+                }
+            }
+        }
+
+        //********************************************************************
+        // Capturing the arguments of a deferred operation
+        //********************************************************************
+
+        template<typename T>
+        inline constexpr bool is_container_v = false;
+
+        template<typename ScalarT, typename... TagsT>
+        inline constexpr bool is_container_v<Matrix<ScalarT, TagsT...>> = true;
+
+        template<typename ScalarT, typename... TagsT>
+        inline constexpr bool is_container_v<Vector<ScalarT, TagsT...>> = true;
+
+        template<typename T, typename = void>
+        struct has_matrix_member : std::false_type {};
+
+        template<typename T>
+        struct has_matrix_member<T, std::void_t<decltype(std::declval<T const &>().m_mat)>>
+            : std::true_type {};
+
+        template<typename T, typename = void>
+        struct has_vector_member : std::false_type {};
+
+        template<typename T>
+        struct has_vector_member<T, std::void_t<decltype(std::declval<T const &>().m_vec)>>
+            : std::true_type {};
+
+        /// The container an argument refers to (directly or via a view), or
+        /// nullptr for operators, scalars, index arrays and NoMask.
+        template<typename T>
+        inline void const *object_id(T const &arg)
+        {
+            if constexpr (is_container_v<T>)
+                return &arg;
+            else if constexpr (has_matrix_member<T>::value)
+                return object_id(arg.m_mat);
+            else if constexpr (has_vector_member<T>::value)
+                return object_id(arg.m_vec);
+            else
+                return nullptr;
+        }
+
+        template<typename... ArgsT>
+        inline std::vector<void const *> object_ids(ArgsT const &... args)
+        {
+            std::vector<void const *> ids;
+            for (void const *id : {object_id(args)...})
+            {
+                if (id != nullptr) ids.push_back(id);
+            }
+            return ids;
+        }
+
+        template<typename T>
+        inline auto capture(T const &arg)
+        {
+            if constexpr (is_container_v<T>)
+                return std::cref(arg);
+            else
+                return arg;
+        }
+
+        template<typename T>
+        using capture_t = decltype(capture(std::declval<T const &>()));
+
+        template<typename T>
+        inline T const &unwrap(std::reference_wrapper<T const> const &arg)
+        {
+            return arg.get();
+        }
+
+        template<typename T>
+        inline T const &unwrap(T const &arg) { return arg; }
+
+        //********************************************************************
+        template<typename OutputT, typename KernelT, typename... ArgsT>
+        class PendingCall : public PendingOp
+        {
+        public:
+            PendingCall(OutputT  &output,
+                        bool      overwrites_output,
+                        KernelT   kernel,
+                        ArgsT...  args)
+                : PendingOp(&output, overwrites_output, object_ids(unwrap(args)...)),
+                  m_output(output),
+                  m_kernel(std::move(kernel)),
+                  m_args(std::move(args)...)
+            {
+            }
+
+            void run() override
+            {
+                std::apply([this](auto const &... args)
+                           { m_kernel(m_output, unwrap(args)...); },
+                           m_args);
+            }
+
+        protected:
+            OutputT             &m_output;
+            KernelT              m_kernel;
+            std::tuple<ArgsT...> m_args;
+        };
+
+        //********************************************************************
+        template<typename ScalarT, typename OutputT, typename KernelT,
+                 typename StreamT, typename... ArgsT>
+        class PendingVectorProducer : public PendingCall<OutputT, KernelT, ArgsT...>,
+                                      public VectorProducer<ScalarT>
+        {
+        public:
+            using ElementType = typename VectorProducer<ScalarT>::ElementType;
+            using ChunkFnType = typename VectorProducer<ScalarT>::ChunkFnType;
+            using VectorProducer<ScalarT>::CHUNK_SIZE;
+
+            PendingVectorProducer(OutputT  &output,
+                                  KernelT   kernel,
+                                  StreamT   stream,
+                                  ArgsT...  args)
+                : PendingCall<OutputT, KernelT, ArgsT...>(
+                    output, true, std::move(kernel), std::move(args)...),
+                  m_stream(std::move(stream))
+            {
+            }
+
+        protected:
+            void stream_chunks(ChunkFnType chunk_fn,
+                               void       *context) const override
+            {
+                std::array<ElementType, CHUNK_SIZE> chunk;
+                std::size_t n(0);
+                auto sink([&](IndexType index, ScalarT const &value)
+                          {
+                              chunk[n++] = ElementType(index, value);
+                              if (n == CHUNK_SIZE)
+                              {
+                                  chunk_fn(context, chunk.data(), n);
+                                  n = 0;
+                              }
+                          });
+
+                std::apply([this, &sink](auto const &... args)
+                           { m_stream(sink, unwrap(args)...); },
+                           this->m_args);
+                if (n > 0) chunk_fn(context, chunk.data(), n);
+            }
+
+        private:
+            StreamT m_stream;
+        };
+
+        //********************************************************************
+        template<typename UScalarT, typename OutputT, typename KernelT,
+                 typename FusedKernelT, typename... ArgsT>
+        class PendingVectorConsumer : public PendingCall<OutputT, KernelT, ArgsT...>
+        {
+        public:
+            PendingVectorConsumer(OutputT      &output,
+                                  bool          overwrites_output,
+                                  void const   *streamed_input,
+                                  KernelT       kernel,
+                                  FusedKernelT  fused_kernel,
+                                  ArgsT...      args)
+                : PendingCall<OutputT, KernelT, ArgsT...>(
+                    output, overwrites_output, std::move(kernel),
+                    std::move(args)...),
+                  m_streamed_input(streamed_input),
+                  m_fused_kernel(std::move(fused_kernel))
+            {
+            }
+
+            bool run_fused(PendingOp &producer) override
+            {
+                auto source =
+                    dynamic_cast<VectorProducer<UScalarT> const *>(&producer);
+                if ((source == nullptr) ||
+                    (producer.output() != m_streamed_input) ||
+                    (this->input_count(m_streamed_input) != 1))
+                {
+                    return false;
+                }
+
+                std::apply([this, source](auto const &... args)
+                           {
+                               m_fused_kernel(this->m_output, *source,
+                                              unwrap(args)...);
+                           },
+                           this->m_args);
+                return true;
+            }
+
+        private:
+            void const   *m_streamed_input;
+            FusedKernelT  m_fused_kernel;
+        };
+
+        //********************************************************************
+        // Dispatch from the operations
+        //********************************************************************
+
+        /// True when an operation replaces the whole contents of its output
+        template<typename MaskT, typename AccumT>
+        inline bool overwrites_output(MaskT const &, AccumT const &,
+                                      OutputControlEnum outp)
+        {
+            return (std::is_same_v<AccumT, NoAccumulate> &&
+                    (std::is_same_v<MaskT, NoMask> || (outp == REPLACE)));
+        }
+
+        /// Run kernel(output, args...) now (blocking mode) or queue it.
+        template<typename OutputT, typename KernelT, typename... ArgsT>
+        inline void execute(OutputT        &output,
+                            bool            overwrites_output,
+                            KernelT         kernel,
+                            ArgsT const &... args)
+        {
+            ExecutionContext &context(execution_context());
+            if (context.mode() == BLOCKING)
+            {
+                kernel(output, args...);
+                return;
+            }
+
+            context.enqueue(
+                std::make_unique<PendingCall<OutputT, KernelT, capture_t<ArgsT>...>>(
+                    output, overwrites_output, std::move(kernel),
+                    capture(args)...));
+        }
+
+        /// As execute, for an op without mask and accumulator whose result
+        /// can also be produced by stream(sink, args...) (see VectorProducer).
+        template<typename ScalarT, typename OutputT, typename KernelT,
+                 typename StreamT, typename... ArgsT>
+        inline void execute_producer(OutputT        &output,
+                                     KernelT         kernel,
+                                     StreamT         stream,
+                                     ArgsT const &... args)
+        {
+            ExecutionContext &context(execution_context());
+            if (context.mode() == BLOCKING)
+            {
+                kernel(output, args...);
+                return;
+            }
+
+            context.enqueue(
+                std::make_unique<PendingVectorProducer<
+                    ScalarT, OutputT, KernelT, StreamT, capture_t<ArgsT>...>>(
+                        output, std::move(kernel), std::move(stream),
+                        capture(args)...));
+        }
+
+        /// As execute, for an op that reads streamed_input (a vector of
+        /// UScalarT) and can instead consume it from a preceding producer:
+        /// fused_kernel(output, producer, args...).
+        template<typename UScalarT, typename OutputT, typename KernelT,
+                 typename FusedKernelT, typename... ArgsT>
+        inline void execute_consumer(OutputT        &output,
+                                     bool            overwrites_output,
+                                     void const     *streamed_input,
+                                     KernelT         kernel,
+                                     FusedKernelT    fused_kernel,
+                                     ArgsT const &... args)
+        {
+            ExecutionContext &context(execution_context());
+            if (context.mode() == BLOCKING)
+            {
+                kernel(output, args...);
+                return;
+            }
+
+            context.enqueue(
+                std::make_unique<PendingVectorConsumer<
+                    UScalarT, OutputT, KernelT, FusedKernelT, capture_t<ArgsT>...>>(
+                        output, overwrites_output, streamed_input,
+                        std::move(kernel), std::move(fused_kernel),
+                        capture(args)...));
+        }
+    } // namespace detail
+} // namespace grb
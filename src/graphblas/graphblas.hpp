@@ -51,13 +51,17 @@ namespace grb
 
 #include <graphblas/Matrix.hpp>
 #include <graphblas/Vector.hpp>
+#include <graphblas/CsrMatrix.hpp>
 #include <graphblas/StructureView.hpp>
 #include <graphblas/ComplementView.hpp>
 #include <graphblas/StructuralComplementView.hpp>
 #include <graphblas/TransposeView.hpp>
+#include <graphblas/DiagonalView.hpp>
 
 #include <graphblas/operations.hpp>
 #include <graphblas/matrix_utils.hpp>
+#include <graphblas/binary_io.hpp>
+#include <graphblas/matrix_io.hpp>
 
 #define GB_INCLUDE_BACKEND_ALL 1
 #include <backend_include.hpp>
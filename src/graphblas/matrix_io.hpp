@@ -0,0 +1,529 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/binary_io.hpp>
+
+//****************************************************************************
+// Text matrix readers (edge lists and MatrixMarket coordinate files)
+//
+// The file is memory mapped and split at line boundaries into chunks that
+// are parsed independently (concurrently when compiled with OpenMP) with
+// std::from_chars.  The per-chunk tuples are concatenated in file order, so
+// duplicates are combined in the order they appear in the file.
+//****************************************************************************
+namespace grb
+{
+    //************************************************************************
+    /// Options for read_edge_list and read_matrix_market
+    struct ReadOptions
+    {
+        /// Also store (j, i) for every (i, j) read (A + A' structure).
+        bool      symmetrize        = false;
+
+        /// Drop (i, i) entries.
+        bool      remove_self_loops = false;
+
+        /// Index of the first row/column in an edge list file (0 or 1).
+        /// MatrixMarket files are always 1-based.
+        IndexType index_base        = 0;
+
+        /// Approximate number of bytes parsed per chunk.
+        size_t    chunk_bytes       = (1UL << 20);
+    };
+
+    namespace detail
+    {
+        //********************************************************************
+        /// Tuples parsed from one chunk of a text file.
+        template<typename ScalarT>
+        struct ParsedChunk
+        {
+            IndexArrayType       rows;
+            IndexArrayType       cols;
+            std::vector<ScalarT> vals;
+            IndexType            max_index = 0;
+            std::string          error;
+        };
+
+        inline char const *skip_blanks(char const *pos, char const *end)
+        {
+            while ((pos < end) && ((*pos == ' ') || (*pos == '\t') ||
+                                   (*pos == '\r') || (*pos == ',')))
+            {
+                ++pos;
+            }
+            return pos;
+        }
+
+        inline char const *next_line(char const *pos, char const *end)
+        {
+            while ((pos < end) && (*pos != '\n')) ++pos;
+            return (pos < end) ? pos + 1 : end;
+        }
+
+        /// True if a number may end at pos: end of input, a blank or the
+        /// end of the line.
+        inline bool at_separator(char const *pos, char const *end)
+        {
+            return ((pos == end) || (*pos == ' ') || (*pos == '\t') ||
+                    (*pos == '\r') || (*pos == ',') || (*pos == '\n'));
+        }
+
+        /// Parse one index (an unsigned integer) at pos.
+        /// @return the position after it, or nullptr on failure
+        inline char const *parse_index(char const *pos, char const *end,
+                                       IndexType &index)
+        {
+            if ((pos < end) && (*pos == '+')) ++pos;
+            auto [ptr, ec] = std::from_chars(pos, end, index);
+            return ((ec == std::errc()) && at_separator(ptr, end)) ?
+                ptr : nullptr;
+        }
+
+        /// Parse one value (integer or floating point) at pos.  Integer
+        /// types also accept "3.0" style values that are in range.
+        /// @return the position after it, or nullptr on failure
+        template<typename T>
+        char const *parse_number(char const *pos, char const *end, T &value)
+        {
+            char const *ptr(nullptr);
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                double tmp;
+                auto [dptr, dec] = std::from_chars(pos, end, tmp);
+                if (dec == std::errc())
+                {
+                    value = (tmp != 0.0);
+                    ptr = dptr;
+                }
+            }
+            else
+            {
+                if ((pos < end) && (*pos == '+')) ++pos;
+                auto [iptr, ec] = std::from_chars(pos, end, value);
+                if (ec == std::errc())
+                {
+                    ptr = iptr;
+                }
+                if constexpr (std::is_integral_v<T>)
+                {
+                    if (!ptr || !at_separator(ptr, end))
+                    {
+                        double tmp;
+                        auto [dptr, dec] = std::from_chars(pos, end, tmp);
+                        ptr = nullptr;
+                        if ((dec == std::errc()) &&
+                            (tmp >= static_cast<double>(
+                                 std::numeric_limits<T>::lowest())) &&
+                            (tmp <= static_cast<double>(
+                                 std::numeric_limits<T>::max())))
+                        {
+                            value = static_cast<T>(tmp);
+                            ptr = dptr;
+                        }
+                    }
+                }
+            }
+            return (ptr && at_separator(ptr, end)) ? ptr : nullptr;
+        }
+
+        /// Split [begin, end) into about chunk_bytes pieces, each ending
+        /// just after a newline (or at end).
+        inline std::vector<char const *> split_lines(char const *begin,
+                                                     char const *end,
+                                                     size_t      chunk_bytes)
+        {
+            std::vector<char const *> bounds(1, begin);
+            chunk_bytes = std::max<size_t>(chunk_bytes, 1);
+            char const *pos = begin;
+            while (static_cast<size_t>(end - pos) > chunk_bytes)
+            {
+                pos = next_line(pos + chunk_bytes, end);
+                bounds.push_back(pos);
+            }
+            if (bounds.back() != end)
+            {
+                bounds.push_back(end);
+            }
+            return bounds;
+        }
+
+        /// Parse lines of "i j [v]" in [begin, end).  Lines that are blank
+        /// or start with '%' or '#' are skipped; a missing value is 1.
+        /// Indices are converted to 0-based by subtracting index_base.
+        template<typename ScalarT>
+        void parse_chunk(ParsedChunk<ScalarT> &chunk,
+                         char const           *begin,
+                         char const           *end,
+                         IndexType             index_base,
+                         bool                  remove_self_loops,
+                         bool                  has_values)
+        {
+            char const *line = begin;
+            while (line < end)
+            {
+                char const *eol = line;
+                while ((eol < end) && (*eol != '\n')) ++eol;
+
+                char const *pos = skip_blanks(line, eol);
+                if ((pos < eol) && (*pos != '%') && (*pos != '#'))
+                {
+                    IndexType i, j;
+                    ScalarT   v = static_cast<ScalarT>(1);
+                    pos = parse_index(pos, eol, i);
+                    if (pos) pos = parse_index(skip_blanks(pos, eol), eol, j);
+                    if (pos && has_values)
+                    {
+                        char const *vpos = skip_blanks(pos, eol);
+                        if (vpos < eol) pos = parse_number(vpos, eol, v);
+                    }
+                    if (!pos)
+                    {
+                        chunk.error = "malformed line: " +
+                            std::string(line, std::min<size_t>(eol - line, 80));
+                        return;
+                    }
+                    if ((i < index_base) || (j < index_base))
+                    {
+                        chunk.error = "index below base: " +
+                            std::string(line, std::min<size_t>(eol - line, 80));
+                        return;
+                    }
+                    i -= index_base;
+                    j -= index_base;
+
+                    if (!(remove_self_loops && (i == j)))
+                    {
+                        chunk.rows.push_back(i);
+                        chunk.cols.push_back(j);
+                        chunk.vals.push_back(v);
+                        chunk.max_index = std::max(chunk.max_index,
+                                                   std::max(i, j));
+                    }
+                }
+                line = (eol < end) ? eol + 1 : end;
+            }
+        }
+
+        /// Parse [begin, end) in chunks and concatenate the tuples in file
+        /// order.
+        /// @return the largest (0-based) index read
+        template<typename ScalarT>
+        IndexType parse_tuples(char const           *begin,
+                               char const           *end,
+                               ReadOptions const    &options,
+                               IndexType             index_base,
+                               bool                  has_values,
+                               IndexArrayType       &rows,
+                               IndexArrayType       &cols,
+                               std::vector<ScalarT> &vals)
+        {
+            auto bounds(split_lines(begin, end, options.chunk_bytes));
+            IndexType num_chunks(bounds.size() - 1);
+            std::vector<ParsedChunk<ScalarT>> chunks(num_chunks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (IndexType c = 0; c < num_chunks; ++c)
+            {
+                parse_chunk(chunks[c], bounds[c], bounds[c + 1], index_base,
+                            options.remove_self_loops, has_values);
+            }
+
+            IndexType max_index(0);
+            std::vector<IndexType> offsets(num_chunks + 1, 0);
+            for (IndexType c = 0; c < num_chunks; ++c)
+            {
+                if (!chunks[c].error.empty())
+                {
+                    throw InvalidValueException(chunks[c].error);
+                }
+                offsets[c + 1] = offsets[c] + chunks[c].rows.size();
+                if (!chunks[c].rows.empty())
+                {
+                    max_index = std::max(max_index, chunks[c].max_index);
+                }
+            }
+
+            rows.resize(offsets[num_chunks]);
+            cols.resize(offsets[num_chunks]);
+            vals.resize(offsets[num_chunks]);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (IndexType c = 0; c < num_chunks; ++c)
+            {
+                std::copy(chunks[c].rows.begin(), chunks[c].rows.end(),
+                          rows.begin() + offsets[c]);
+                std::copy(chunks[c].cols.begin(), chunks[c].cols.end(),
+                          cols.begin() + offsets[c]);
+                if constexpr (!std::is_same_v<ScalarT, bool>)
+                {
+                    std::copy(chunks[c].vals.begin(), chunks[c].vals.end(),
+                              vals.begin() + offsets[c]);
+                }
+            }
+
+            // std::vector<bool> elements share words: copy serially
+            if constexpr (std::is_same_v<ScalarT, bool>)
+            {
+                for (IndexType c = 0; c < num_chunks; ++c)
+                {
+                    std::copy(chunks[c].vals.begin(), chunks[c].vals.end(),
+                              vals.begin() + offsets[c]);
+                }
+            }
+
+            return max_index;
+        }
+
+        /// Append (j, i, f(v)) for every off-diagonal (i, j, v).
+        template<typename ScalarT, typename MirrorT>
+        void mirror_tuples(IndexArrayType       &rows,
+                           IndexArrayType       &cols,
+                           std::vector<ScalarT> &vals,
+                           MirrorT               mirror)
+        {
+            IndexType n(rows.size());
+            IndexType num_off_diagonal(0);
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                if (rows[ix] != cols[ix]) ++num_off_diagonal;
+            }
+            rows.reserve(n + num_off_diagonal);
+            cols.reserve(n + num_off_diagonal);
+            vals.reserve(n + num_off_diagonal);
+
+            for (IndexType ix = 0; ix < n; ++ix)
+            {
+                if (rows[ix] != cols[ix])
+                {
+                    rows.push_back(cols[ix]);
+                    cols.push_back(rows[ix]);
+                    vals.push_back(mirror(vals[ix]));
+                }
+            }
+        }
+    } // namespace detail
+
+    //************************************************************************
+    /**
+     * @brief Read an edge list ("src dst [weight]" per line) into tuples.
+     *
+     * Blank lines and lines starting with '%' or '#' are ignored, and a
+     * missing weight is read as 1.
+     *
+     * @return The number of vertices (largest index read + 1, or 0)
+     */
+    template<typename ScalarT>
+    IndexType read_edge_list(std::string const    &pathname,
+                             IndexArrayType       &row_indices,
+                             IndexArrayType       &col_indices,
+                             std::vector<ScalarT> &values,
+                             ReadOptions const    &options = ReadOptions())
+    {
+        if (options.index_base > 1)
+        {
+            throw InvalidValueException("read_edge_list: index base must be 0 or 1");
+        }
+
+        detail::MappedFile file(pathname);
+        IndexType max_index =
+            detail::parse_tuples(file.data(), file.data() + file.size(),
+                                 options, options.index_base, true,
+                                 row_indices, col_indices, values);
+
+        if (options.symmetrize)
+        {
+            detail::mirror_tuples(row_indices, col_indices, values,
+                                  [](ScalarT v) { return v; });
+        }
+
+        return (row_indices.empty() ? 0 : max_index + 1);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Read an edge list into a square matrix.
+     *
+     * Duplicate edges are combined with dup in file order.
+     */
+    template<typename MatrixT,
+             typename BinaryOpT = Second<typename MatrixT::ScalarType>>
+    MatrixT read_edge_list(std::string const &pathname,
+                           ReadOptions const &options = ReadOptions(),
+                           BinaryOpT          dup = BinaryOpT())
+    {
+        using ScalarT = typename MatrixT::ScalarType;
+        IndexArrayType       rows, cols;
+        std::vector<ScalarT> vals;
+        IndexType num_nodes(read_edge_list(pathname, rows, cols, vals, options));
+
+        MatrixT A(num_nodes, num_nodes);
+        A.build(rows.begin(), cols.begin(), vals.begin(), vals.size(), dup);
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Read a MatrixMarket coordinate file into a matrix.
+     *
+     * Supports the real, integer and pattern fields (pattern values are 1)
+     * and the general, symmetric and skew-symmetric symmetries; the latter
+     * two are expanded to both triangles.  options.symmetrize additionally
+     * mirrors a general file and options.index_base is ignored.
+     */
+    template<typename MatrixT,
+             typename BinaryOpT = Second<typename MatrixT::ScalarType>>
+    MatrixT read_matrix_market(std::string const &pathname,
+                               ReadOptions const &options = ReadOptions(),
+                               BinaryOpT          dup = BinaryOpT())
+    {
+        using ScalarT = typename MatrixT::ScalarType;
+
+        detail::MappedFile file(pathname);
+        char const *pos = file.data();
+        char const *end = file.data() + file.size();
+
+        // banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+        char const *eol = detail::next_line(pos, end);
+        std::string banner(pos, eol);
+        std::transform(banner.begin(), banner.end(), banner.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (banner.compare(0, 14, "%%matrixmarket") != 0)
+        {
+            throw InvalidValueException(
+                "read_matrix_market: missing banner: " + pathname);
+        }
+        if (banner.find("coordinate") == std::string::npos)
+        {
+            throw InvalidValueException(
+                "read_matrix_market: only coordinate format is supported");
+        }
+        if (banner.find("complex") != std::string::npos)
+        {
+            throw InvalidValueException(
+                "read_matrix_market: complex values are not supported");
+        }
+        bool const has_values(banner.find("pattern") == std::string::npos);
+        bool const skew(banner.find("skew-symmetric") != std::string::npos);
+        bool const symmetric(!skew &&
+                             ((banner.find("symmetric") != std::string::npos) ||
+                              (banner.find("hermitian") != std::string::npos)));
+
+        // skip comments, then read the size line
+        pos = eol;
+        IndexType nrows(0), ncols(0), nnz(0);
+        while (pos < end)
+        {
+            eol = detail::next_line(pos, end);
+            char const *p = detail::skip_blanks(pos, eol);
+            pos = eol;
+            if ((p == eol) || (*p == '%') || (*p == '\n')) continue;
+
+            p = detail::parse_index(p, eol, nrows);
+            if (p) p = detail::parse_index(detail::skip_blanks(p, eol), eol, ncols);
+            if (p) p = detail::parse_index(detail::skip_blanks(p, eol), eol, nnz);
+            if (!p)
+            {
+                throw InvalidValueException(
+                    "read_matrix_market: malformed size line: " + pathname);
+            }
+            break;
+        }
+
+        // nnz > nrows*ncols, without overflowing the product
+        if ((nnz > 0) &&
+            ((nrows == 0) ||
+             (nnz / nrows + ((nnz % nrows) ? 1 : 0) > ncols)))
+        {
+            throw InvalidValueException(
+                "read_matrix_market: more entries than matrix elements: " +
+                pathname);
+        }
+
+        // nnz comes from the file: never reserve more entries than the
+        // remaining bytes could hold (each line is at least "i j\n").
+        IndexType const max_entries((end - pos)/4 + 1);
+        IndexArrayType       rows, cols;
+        std::vector<ScalarT> vals;
+        rows.reserve(std::min(nnz, max_entries));
+        cols.reserve(std::min(nnz, max_entries));
+        vals.reserve(std::min(nnz, max_entries));
+        detail::parse_tuples(pos, end, options, 1, has_values,
+                             rows, cols, vals);
+        for (IndexType ix = 0; ix < rows.size(); ++ix)
+        {
+            if ((rows[ix] >= nrows) || (cols[ix] >= ncols))
+            {
+                throw IndexOutOfBoundsException(
+                    "read_matrix_market: index exceeds matrix size: " +
+                    pathname);
+            }
+        }
+
+        if (skew)
+        {
+            if constexpr (std::is_signed_v<ScalarT> ||
+                          std::is_floating_point_v<ScalarT>)
+            {
+                detail::mirror_tuples(rows, cols, vals,
+                                      [](ScalarT v) { return -v; });
+            }
+            else
+            {
+                throw InvalidValueException(
+                    "read_matrix_market: skew-symmetric needs a signed type");
+            }
+        }
+        else if (symmetric || options.symmetrize)
+        {
+            detail::mirror_tuples(rows, cols, vals,
+                                  [](ScalarT v) { return v; });
+        }
+
+        MatrixT A(nrows, ncols);
+        A.build(rows.begin(), cols.begin(), vals.begin(), vals.size(), dup);
+        return A;
+    }
+
+} // namespace grb
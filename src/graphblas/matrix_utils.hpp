@@ -95,36 +95,12 @@ namespace grb
     template<typename MatrixT>
     void split(MatrixT const &A, MatrixT &L, MatrixT &U)
     {
-        /// @todo assert A, L, and U are same size.
-
         using T = typename MatrixT::ScalarType;
 
-        grb::IndexType nvals(A.nvals());
-
-        grb::IndexArrayType i(nvals), j(nvals);
-        std::vector<T> v(nvals);
-        A.extractTuples(i, j, v);
-
-        IndexArrayType iL,jL, iU,jU;
-        std::vector<T> vL, vU;
-
-        for (grb::IndexType idx = 0; idx < nvals; ++idx)
-        {
-            if (i[idx] < j[idx])
-            {
-                iU.push_back(i[idx]);
-                jU.push_back(j[idx]);
-                vU.push_back(v[idx]);
-            }
-            else
-            {
-                iL.push_back(i[idx]);
-                jL.push_back(j[idx]);
-                vL.push_back(v[idx]);
-            }
-        }
-        L.build(iL.begin(), jL.begin(), vL.begin(), vL.size());
-        U.build(iU.begin(), jU.begin(), vU.begin(), vU.size());
+        grb::select(L, grb::NoMask(), grb::NoAccumulate(),
+                    grb::TriL<T>(), A, 0);
+        grb::select(U, grb::NoMask(), grb::NoAccumulate(),
+                    grb::TriU<T>(), A, 1);
     }
 
     //************************************************************************
@@ -149,19 +125,8 @@ namespace grb
                    grb::MultiplicativeInverse<T>(),
                    w);
 
-        IndexArrayType indices(w.nvals());
-        std::vector<typename MatrixT::ScalarType> vals(w.nvals());
-        w.extractTuples(indices.begin(), vals.begin());
-
-        //populate diagnal:
-        MatrixT Adiag(w.size(), w.size());
-        Adiag.build(indices.begin(), indices.begin(), vals.begin(), vals.size());
-
-        //Perform matrix multiply to scale rows
-        grb::mxm(A,
-                 grb::NoMask(), grb::NoAccumulate(),
-                 grb::ArithmeticSemiring<T>(),
-                 Adiag, A);
+        // Scale the rows in place (empty rows stay empty)
+        grb::scale_rows(A, w, grb::Times<T>());
     }
 
 
@@ -177,7 +142,7 @@ namespace grb
     {
         using T = typename MatrixT::ScalarType;
 
-        grb::Vector<T> w(A.nrows());
+        grb::Vector<T> w(A.ncols());
         grb::reduce(w,
                     grb::NoMask(), grb::NoAccumulate(),
                     grb::Plus<T>(),
@@ -187,18 +152,7 @@ namespace grb
                    grb::MultiplicativeInverse<T>(),
                    w);
 
-        IndexArrayType indices(w.nvals());
-        std::vector<typename MatrixT::ScalarType> vals(w.nvals());
-        w.extractTuples(indices.begin(), vals.begin());
-
-        //populate diagnal:
-        MatrixT Adiag(w.size(), w.size());
-        Adiag.build(indices.begin(), indices.begin(), vals.begin(), vals.size());
-
-        //Perform matrix multiply to scale rows
-        grb::mxm(A,
-                 grb::NoMask(), grb::NoAccumulate(),
-                 grb::ArithmeticSemiring<T>(),
-                 A, Adiag);
+        // Scale the columns in place (empty columns stay empty)
+        grb::scale_cols(A, w, grb::Times<T>());
     }
 }
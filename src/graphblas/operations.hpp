@@ -33,17 +33,20 @@
 #include <graphblas/types.hpp>
 #include <graphblas/algebra.hpp>
 #include <graphblas/TransposeView.hpp>
+#include <graphblas/DiagonalView.hpp>
 #include <graphblas/StructureView.hpp>
 #include <graphblas/ComplementView.hpp>
 #include <graphblas/StructuralComplementView.hpp>
 
 #include <graphblas/Matrix.hpp>
 #include <graphblas/Vector.hpp>
+#include <graphblas/CsrMatrix.hpp>
 #include <graphblas/indices.hpp>
 
 #include <graphblas/detail/logging.h>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/checks.hpp>
+#include <graphblas/detail/nonblocking.hpp>
 
 #define GB_INCLUDE_BACKEND_TRANSPOSE_VIEW 1
 #define GB_INCLUDE_BACKEND_COMPLEMENT_VIEW 1
@@ -90,12 +93,19 @@ namespace grb
         check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
         check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
 
-        backend::mxm(get_internal_matrix(C),
-                     get_internal_matrix(Mask),
-                     accum, op,
-                     get_internal_matrix(A),
-                     get_internal_matrix(B),
-                     outp);
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, auto const &B, OutputControlEnum outp)
+            {
+                backend::mxm(get_internal_matrix(C),
+                             get_internal_matrix(Mask),
+                             accum, op,
+                             get_internal_matrix(A),
+                             get_internal_matrix(B),
+                             outp);
+            },
+            Mask, accum, op, A, B, outp);
 
         GRB_LOG_VERBOSE("C (Result): " << get_internal_matrix(C));
         GRB_LOG_FN_END("mxm - 4.3.1 - matrix-matrix multiply");
@@ -131,7 +141,38 @@ namespace grb
         check_size_ncols(w, A, "vxm: w.size != A.ncols");
         check_size_nrows(u, A, "vxm: u.size != A.nrows");
 
-        backend::vxm(get_internal_vector(w), get_internal_vector(mask), accum, op, get_internal_vector(u), get_internal_matrix(A), outp);
+        auto kernel(
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &u, auto const &A, OutputControlEnum outp)
+            {
+                backend::vxm(get_internal_vector(w), get_internal_vector(mask),
+                             accum, op, get_internal_vector(u),
+                             get_internal_matrix(A), outp);
+            });
+
+        if constexpr (detail::is_container_v<UVectorT> &&
+                      detail::is_container_v<AMatrixT>)
+        {
+            // u may come from a fusable element-wise producer (push only)
+            detail::execute_consumer<typename UVectorT::ScalarType>(
+                w, detail::overwrites_output(mask, accum, outp), &u, kernel,
+                [](auto &w, auto const &producer, auto const &mask,
+                   auto const &accum, auto const &op, auto const &,
+                   auto const &A, OutputControlEnum outp)
+                {
+                    backend::vxm_fused(
+                        get_internal_vector(w), get_internal_vector(mask),
+                        accum, op,
+                        [&producer](auto &&emit) { producer.stream(emit); },
+                        get_internal_matrix(A), outp);
+                },
+                mask, accum, op, u, A, outp);
+        }
+        else
+        {
+            detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                            kernel, mask, accum, op, u, A, outp);
+        }
 
         GRB_LOG_VERBOSE("w out :" << get_internal_vector(w));
         GRB_LOG_FN_END("mxm - 4.3.2 - vector-matrix multiply");
@@ -167,12 +208,342 @@ namespace grb
         check_size_nrows(w, A, "mxv: w.size != A.nrows");
         check_size_ncols(u, A, "mxv: u.size != A.ncols");
 
-        backend::mxv(get_internal_vector(w), get_internal_vector(mask), accum, op, get_internal_matrix(A), get_internal_vector(u), outp);
+        detail::execute(
+            w, detail::overwrites_output(mask, accum, outp),
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &A, auto const &u, OutputControlEnum outp)
+            {
+                backend::mxv(get_internal_vector(w), get_internal_vector(mask),
+                             accum, op, get_internal_matrix(A),
+                             get_internal_vector(u), outp);
+            },
+            mask, accum, op, A, u, outp);
         GRB_LOG_VERBOSE("w out :" << get_internal_vector(w));
         GRB_LOG_FN_END("mxv - 4.3.3 - matrix-vector multiply");
     }
 
 
+    //************************************************************************
+    // Diagonal scaling (not in the C API)
+    //************************************************************************
+
+    /**
+     * @brief In place A := diag(d) * A, i.e. A(i,j) := op(d(i), A(i,j)).
+     *
+     * Rows of A without a stored d(i) are cleared.  This is one pass over
+     * the stored elements of A with no temporaries, and is what mxm uses
+     * when its first operand is a DiagonalView.
+     */
+    template<typename AMatrixT,
+             typename DVectorT,
+             typename BinaryOpT = Times<typename AMatrixT::ScalarType>>
+    inline void scale_rows(AMatrixT       &A,
+                           DVectorT const &d,
+                           BinaryOpT       op = BinaryOpT())
+    {
+        GRB_LOG_FN_BEGIN("scale_rows - A := diag(d) op A");
+        check_size_nrows(d, A, "scale_rows: d.size != A.nrows");
+
+        detail::execute(
+            A, false,
+            [](auto &A, auto const &d, auto const &op)
+            {
+                backend::scale_rows(get_internal_matrix(A),
+                                    get_internal_vector(d), op);
+            },
+            d, op);
+
+        GRB_LOG_FN_END("scale_rows - A := diag(d) op A");
+    }
+
+    /**
+     * @brief In place A := A * diag(d), i.e. A(i,j) := op(A(i,j), d(j)).
+     *
+     * Elements of A without a stored d(j) are removed.
+     */
+    template<typename AMatrixT,
+             typename DVectorT,
+             typename BinaryOpT = Times<typename AMatrixT::ScalarType>>
+    inline void scale_cols(AMatrixT       &A,
+                           DVectorT const &d,
+                           BinaryOpT       op = BinaryOpT())
+    {
+        GRB_LOG_FN_BEGIN("scale_cols - A := A op diag(d)");
+        check_size_ncols(d, A, "scale_cols: d.size != A.ncols");
+
+        detail::execute(
+            A, false,
+            [](auto &A, auto const &d, auto const &op)
+            {
+                backend::scale_cols(get_internal_matrix(A),
+                                    get_internal_vector(d), op);
+            },
+            d, op);
+
+        GRB_LOG_FN_END("scale_cols - A := A op diag(d)");
+    }
+
+    //************************************************************************
+    // mxm, vxm, mxv with a DiagonalView operand
+    //************************************************************************
+
+    // A product with diag(d) needs no additions: the rows (or columns) of
+    // the other operand are scaled by the semiring's multiply.  These
+    // overloads are more specialized than the general ones above.
+    namespace detail
+    {
+        template<typename CMatrixT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename MatrixT,
+                 typename ScaleT>
+        inline void mxm_diagonal(CMatrixT         &C,
+                                 MaskT      const &Mask,
+                                 AccumT     const &accum,
+                                 MatrixT    const &A,
+                                 ScaleT            scale,
+                                 OutputControlEnum outp)
+        {
+            using TScalarT = typename SemiringT::result_type;
+
+            if constexpr (std::is_same_v<MaskT, NoMask> &&
+                          std::is_same_v<AccumT, NoAccumulate> &&
+                          std::is_same_v<CMatrixT, MatrixT> &&
+                          std::is_same_v<typename CMatrixT::ScalarType,
+                                         TScalarT>)
+            {
+                // Scale C in place, after copying A into it if needed
+                if (&C != &A)
+                {
+                    apply(C, NoMask(), NoAccumulate(), Identity<TScalarT>(), A);
+                }
+                scale(C);
+            }
+            else
+            {
+                Matrix<TScalarT> T(C.nrows(), C.ncols());
+                apply(T, NoMask(), NoAccumulate(), Identity<TScalarT>(), A);
+                scale(T);
+                apply(C, Mask, accum, Identity<TScalarT>(), T, outp);
+            }
+        }
+    }
+
+    // C<M,z> := diag(d) +.* B
+    template<typename CMatrixT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename DVectorT,
+             typename BMatrixT>
+    inline void mxm(CMatrixT                     &C,
+                    MaskT                  const &Mask,
+                    AccumT                 const &accum,
+                    SemiringT                     op,
+                    DiagonalView<DVectorT> const &A,
+                    BMatrixT               const &B,
+                    OutputControlEnum             outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("mxm - diag(d) * B");
+        check_nrows_nrows(C, Mask, "mxm: C.nrows != Mask.nrows");
+        check_ncols_ncols(C, Mask, "mxm: C.ncols != Mask.ncols");
+        check_nrows_nrows(C, A, "mxm: C.nrows != A.nrows");
+        check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
+        check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
+
+        detail::mxm_diagonal<CMatrixT, MaskT, AccumT, SemiringT>(
+            C, Mask, accum, B,
+            [&op, &A](auto &T) { scale_rows(T, A.m_vec, multiply_op(op)); },
+            outp);
+        GRB_LOG_FN_END("mxm - diag(d) * B");
+    }
+
+    // C<M,z> := A +.* diag(d)
+    template<typename CMatrixT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename AMatrixT,
+             typename DVectorT>
+    inline void mxm(CMatrixT                     &C,
+                    MaskT                  const &Mask,
+                    AccumT                 const &accum,
+                    SemiringT                     op,
+                    AMatrixT               const &A,
+                    DiagonalView<DVectorT> const &B,
+                    OutputControlEnum             outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("mxm - A * diag(d)");
+        check_nrows_nrows(C, Mask, "mxm: C.nrows != Mask.nrows");
+        check_ncols_ncols(C, Mask, "mxm: C.ncols != Mask.ncols");
+        check_nrows_nrows(C, A, "mxm: C.nrows != A.nrows");
+        check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
+        check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
+
+        detail::mxm_diagonal<CMatrixT, MaskT, AccumT, SemiringT>(
+            C, Mask, accum, A,
+            [&op, &B](auto &T) { scale_cols(T, B.m_vec, multiply_op(op)); },
+            outp);
+        GRB_LOG_FN_END("mxm - A * diag(d)");
+    }
+
+    // C<M,z> := diag(a) +.* diag(b) = diag(a .* b).  Without this overload
+    // the two above would be equally good matches.
+    template<typename CMatrixT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename DAVectorT,
+             typename DBVectorT>
+    inline void mxm(CMatrixT                      &C,
+                    MaskT                   const &Mask,
+                    AccumT                  const &accum,
+                    SemiringT                      op,
+                    DiagonalView<DAVectorT> const &A,
+                    DiagonalView<DBVectorT> const &B,
+                    OutputControlEnum              outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("mxm - diag(a) * diag(b)");
+        check_nrows_nrows(C, Mask, "mxm: C.nrows != Mask.nrows");
+        check_ncols_ncols(C, Mask, "mxm: C.ncols != Mask.ncols");
+        check_nrows_nrows(C, A, "mxm: C.nrows != A.nrows");
+        check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
+        check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
+
+        using TScalarT = typename SemiringT::result_type;
+        Vector<TScalarT> t(A.nrows());
+        eWiseMult(t, NoMask(), NoAccumulate(), multiply_op(op),
+                  A.m_vec, B.m_vec);
+
+        IndexArrayType indices(t.nvals());
+        std::vector<TScalarT> vals(t.nvals());
+        t.extractTuples(indices.begin(), vals.begin());
+
+        Matrix<TScalarT> T(C.nrows(), C.ncols());
+        T.build(indices.begin(), indices.begin(), vals.begin(), vals.size());
+        apply(C, Mask, accum, Identity<TScalarT>(), T, outp);
+        GRB_LOG_FN_END("mxm - diag(a) * diag(b)");
+    }
+
+    // w<m,z> := u +.* diag(d), i.e. the element-wise product u .* d
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename UVectorT,
+             typename DVectorT>
+    inline void vxm(WVectorT                     &w,
+                    MaskT                  const &mask,
+                    AccumT                 const &accum,
+                    SemiringT                     op,
+                    UVectorT               const &u,
+                    DiagonalView<DVectorT> const &A,
+                    OutputControlEnum             outp = MERGE)
+    {
+        check_size_size(w, mask, "vxm: w.size != mask.size");
+        check_size_ncols(w, A, "vxm: w.size != A.ncols");
+        check_size_nrows(u, A, "vxm: u.size != A.nrows");
+        eWiseMult(w, mask, accum, multiply_op(op), u, A.m_vec, outp);
+    }
+
+    // w<m,z> := diag(d) +.* u, i.e. the element-wise product d .* u
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename DVectorT,
+             typename UVectorT>
+    inline void mxv(WVectorT                     &w,
+                    MaskT                  const &mask,
+                    AccumT                 const &accum,
+                    SemiringT                     op,
+                    DiagonalView<DVectorT> const &A,
+                    UVectorT               const &u,
+                    OutputControlEnum             outp = MERGE)
+    {
+        check_size_size(w, mask, "mxv: w.size != mask.size");
+        check_size_nrows(w, A, "mxv: w.size != A.nrows");
+        check_size_ncols(u, A, "mxv: u.size != A.ncols");
+        eWiseMult(w, mask, accum, multiply_op(op), A.m_vec, u, outp);
+    }
+
+    //************************************************************************
+    // mxm and mxv with a CsrMatrix operand
+    //************************************************************************
+
+    // The backend reads the rows of A directly from the compressed arrays.
+    // B may be a Matrix or a CsrMatrix.
+    template<typename CMatrixT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename AScalarT,
+             typename BMatrixT>
+    inline void mxm(CMatrixT                  &C,
+                    MaskT               const &Mask,
+                    AccumT              const &accum,
+                    SemiringT                  op,
+                    CsrMatrix<AScalarT> const &A,
+                    BMatrixT            const &B,
+                    OutputControlEnum          outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("mxm - csr(A) * B");
+        check_nrows_nrows(C, Mask, "mxm: C.nrows != Mask.nrows");
+        check_ncols_ncols(C, Mask, "mxm: C.ncols != Mask.ncols");
+        check_nrows_nrows(C, A, "mxm: C.nrows != A.nrows");
+        check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
+        check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
+
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, auto const &B, OutputControlEnum outp)
+            {
+                backend::mxm_csr(get_internal_matrix(C),
+                                 get_internal_matrix(Mask),
+                                 accum, op, A,
+                                 get_internal_matrix(B),
+                                 outp);
+            },
+            Mask, accum, op, A, B, outp);
+        GRB_LOG_FN_END("mxm - csr(A) * B");
+    }
+
+    // w<m,z> := csr(A) +.* u
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename AScalarT,
+             typename UVectorT>
+    inline void mxv(WVectorT                  &w,
+                    MaskT               const &mask,
+                    AccumT              const &accum,
+                    SemiringT                  op,
+                    CsrMatrix<AScalarT> const &A,
+                    UVectorT            const &u,
+                    OutputControlEnum          outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("mxv - csr(A) * u");
+        check_size_size(w, mask, "mxv: w.size != mask.size");
+        check_size_nrows(w, A, "mxv: w.size != A.nrows");
+        check_size_ncols(u, A, "mxv: u.size != A.ncols");
+
+        detail::execute(
+            w, detail::overwrites_output(mask, accum, outp),
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &A, auto const &u, OutputControlEnum outp)
+            {
+                backend::mxv_csr(get_internal_vector(w),
+                                 get_internal_vector(mask),
+                                 accum, op, A,
+                                 get_internal_vector(u), outp);
+            },
+            mask, accum, op, A, u, outp);
+        GRB_LOG_FN_END("mxv - csr(A) * u");
+    }
+
     //************************************************************************
     // eWiseAdd and eWiseMult
     //************************************************************************
@@ -210,9 +581,45 @@ namespace grb
         check_size_size(w, u, "eWiseMult(vec): w.size != u.size");
         check_size_size(u, v, "eWiseMult(vec): u.size != v.size");
 
-        backend::eWiseMult(get_internal_vector(w),
-                           get_internal_vector(mask), accum, op, get_internal_vector(u), get_internal_vector(v),
-                           outp);
+        auto kernel(
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &u, auto const &v, OutputControlEnum outp)
+            {
+                backend::eWiseMult(get_internal_vector(w),
+                                   get_internal_vector(mask), accum, op,
+                                   get_internal_vector(u),
+                                   get_internal_vector(v),
+                                   outp);
+            });
+
+        if constexpr (std::is_same_v<MaskT, NoMask> &&
+                      std::is_same_v<AccumT, NoAccumulate> &&
+                      detail::is_container_v<UVectorT> &&
+                      detail::is_container_v<VVectorT>)
+        {
+            detail::execute_producer<WScalarT>(
+                w, kernel,
+                [](auto const &sink, auto const &, auto const &,
+                   auto op, auto const &u, auto const &v,
+                   OutputControlEnum)
+                {
+                    auto const &v_vec(get_internal_vector(v));
+                    for (auto&& [idx, u_val] : get_internal_vector(u).getContents())
+                    {
+                        if (v_vec.hasElement(idx))
+                        {
+                            sink(idx, static_cast<WScalarT>(
+                                     op(u_val, v_vec.extractElement(idx))));
+                        }
+                    }
+                },
+                mask, accum, op, u, v, outp);
+        }
+        else
+        {
+            detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                            kernel, mask, accum, op, u, v, outp);
+        }
 
         GRB_LOG_VERBOSE("w out :" << get_internal_vector(w));
         GRB_LOG_FN_END("eWiseMult - 4.3.4.1 - element-wise vector multiply");
@@ -250,12 +657,19 @@ namespace grb
         check_ncols_ncols(A, B, "eWiseMult(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseMult(mat): A.nrows != B.nrows");
 
-        backend::eWiseMult(get_internal_matrix(C),
-                           get_internal_matrix(Mask),
-                           accum, op,
-                           get_internal_matrix(A),
-                           get_internal_matrix(B),
-                           outp);
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, auto const &B, OutputControlEnum outp)
+            {
+                backend::eWiseMult(get_internal_matrix(C),
+                                   get_internal_matrix(Mask),
+                                   accum, op,
+                                   get_internal_matrix(A),
+                                   get_internal_matrix(B),
+                                   outp);
+            },
+            Mask, accum, op, A, B, outp);
 
         GRB_LOG_VERBOSE("C out :" << get_internal_matrix(C));
         GRB_LOG_FN_END("eWiseMult - 4.3.4.2 - element-wise matrix multiply");
@@ -296,12 +710,68 @@ namespace grb
         check_size_size(w, u, "eWiseAdd(vec): w.size != u.size");
         check_size_size(u, v, "eWiseAdd(vec): u.size != v.size");
 
-        backend::eWiseAdd(get_internal_vector(w),
-                          get_internal_vector(mask),
-                          accum, op,
-                          get_internal_vector(u),
-                          get_internal_vector(v),
-                          outp);
+        auto kernel(
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &u, auto const &v, OutputControlEnum outp)
+            {
+                backend::eWiseAdd(get_internal_vector(w),
+                                  get_internal_vector(mask),
+                                  accum, op,
+                                  get_internal_vector(u),
+                                  get_internal_vector(v),
+                                  outp);
+            });
+
+        if constexpr (std::is_same_v<MaskT, NoMask> &&
+                      std::is_same_v<AccumT, NoAccumulate> &&
+                      detail::is_container_v<UVectorT> &&
+                      detail::is_container_v<VVectorT>)
+        {
+            detail::execute_producer<WScalarT>(
+                w, kernel,
+                [](auto const &sink, auto const &, auto const &,
+                   auto op, auto const &u, auto const &v,
+                   OutputControlEnum)
+                {
+                    auto u_contents(get_internal_vector(u).getContents());
+                    auto v_contents(get_internal_vector(v).getContents());
+                    auto u_it(u_contents.begin()), v_it(v_contents.begin());
+                    while ((u_it != u_contents.end()) ||
+                           (v_it != v_contents.end()))
+                    {
+                        if ((v_it == v_contents.end()) ||
+                            ((u_it != u_contents.end()) &&
+                             (std::get<0>(*u_it) < std::get<0>(*v_it))))
+                        {
+                            sink(std::get<0>(*u_it),
+                                 static_cast<WScalarT>(std::get<1>(*u_it)));
+                            ++u_it;
+                        }
+                        else if ((u_it == u_contents.end()) ||
+                                 (std::get<0>(*v_it) < std::get<0>(*u_it)))
+                        {
+                            sink(std::get<0>(*v_it),
+                                 static_cast<WScalarT>(std::get<1>(*v_it)));
+                            ++v_it;
+                        }
+                        else
+                        {
+                            sink(std::get<0>(*u_it),
+                                 static_cast<WScalarT>(
+                                     op(std::get<1>(*u_it),
+                                        std::get<1>(*v_it))));
+                            ++u_it;
+                            ++v_it;
+                        }
+                    }
+                },
+                mask, accum, op, u, v, outp);
+        }
+        else
+        {
+            detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                            kernel, mask, accum, op, u, v, outp);
+        }
 
         GRB_LOG_VERBOSE("w out :" << get_internal_vector(w));
         GRB_LOG_FN_END("eWiseAdd - 4.3.5.1 - element-wise vector addition");
@@ -339,12 +809,19 @@ namespace grb
         check_ncols_ncols(A, B, "eWiseAdd(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseAdd(mat): A.nrows != B.nrows");
 
-        backend::eWiseAdd(get_internal_matrix(C),
-                          get_internal_matrix(Mask)
-                          , accum, op,
-                          get_internal_matrix(A),
-                          get_internal_matrix(B),
-                          outp);
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, auto const &B, OutputControlEnum outp)
+            {
+                backend::eWiseAdd(get_internal_matrix(C),
+                                  get_internal_matrix(Mask),
+                                  accum, op,
+                                  get_internal_matrix(A),
+                                  get_internal_matrix(B),
+                                  outp);
+            },
+            Mask, accum, op, A, B, outp);
 
         GRB_LOG_VERBOSE("C out :" << get_internal_matrix(C));
         GRB_LOG_FN_END("eWiseAdd - 4.3.5.2 - element-wise matrix addition");
@@ -379,12 +856,21 @@ namespace grb
         check_size_size(w, mask, "extract(std vec): w.size != mask.size");
         check_size_nindices(w, indices,
                             "extract(std vec): w.size != indicies.size");
-
-        backend::extract(get_internal_vector(w),
-                         get_internal_vector(mask),
-                         accum,
-                         get_internal_vector(u),
-                         indices, outp);
+        check_index_array_content_deferred(
+            indices, u.size(), "extract(std vec): indices >= u.size");
+
+        detail::execute(
+            w, detail::overwrites_output(mask, accum, outp),
+            [](auto &w, auto const &mask, auto const &accum, auto const &u,
+               auto const &indices, OutputControlEnum outp)
+            {
+                backend::extract(get_internal_vector(w),
+                                 get_internal_vector(mask),
+                                 accum,
+                                 get_internal_vector(u),
+                                 indices, outp);
+            },
+            mask, accum, u, indices, outp);
 
         GRB_LOG_FN_END("extract - 4.3.6.1 - standard vector variant");
     }
@@ -421,12 +907,24 @@ namespace grb
                              "extract(std mat): C.nrows != row_indices");
         check_ncols_nindices(C, col_indices,
                              "extract(std mat): C.ncols != col_indices");
-
-        backend::extract(get_internal_matrix(C),
-                         get_internal_matrix(Mask),
-                         accum,
-                         get_internal_matrix(A),
-                         row_indices, col_indices, outp);
+        check_index_array_content_deferred(
+            row_indices, A.nrows(), "extract(std mat): row_indices >= A.nrows");
+        check_index_array_content_deferred(
+            col_indices, A.ncols(), "extract(std mat): col_indices >= A.ncols");
+
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &A,
+               auto const &row_indices, auto const &col_indices,
+               OutputControlEnum outp)
+            {
+                backend::extract(get_internal_matrix(C),
+                                 get_internal_matrix(Mask),
+                                 accum,
+                                 get_internal_matrix(A),
+                                 row_indices, col_indices, outp);
+            },
+            Mask, accum, A, row_indices, col_indices, outp);
 
         GRB_LOG_FN_END("SEQUENTIAL extract - 4.3.6.2 - standard matrix variant");
     }
@@ -462,13 +960,23 @@ namespace grb
                             "extract(col): w.size != row_indicies");
         check_index_within_ncols(col_index, A,
                                  "extract(col): col_index >= A.ncols");
-
-        backend::extract(get_internal_vector(w),
-                         get_internal_vector(mask),
-                         accum,
-                         get_internal_matrix(A),
-                         row_indices,
-                         col_index, outp);
+        check_index_array_content_deferred(
+            row_indices, A.nrows(), "extract(col): row_indices >= A.nrows");
+
+        detail::execute(
+            w, detail::overwrites_output(mask, accum, outp),
+            [](auto &w, auto const &mask, auto const &accum, auto const &A,
+               auto const &row_indices, IndexType col_index,
+               OutputControlEnum outp)
+            {
+                backend::extract(get_internal_vector(w),
+                                 get_internal_vector(mask),
+                                 accum,
+                                 get_internal_matrix(A),
+                                 row_indices,
+                                 col_index, outp);
+            },
+            mask, accum, A, row_indices, col_index, outp);
         GRB_LOG_FN_END("extract - 4.3.6.3 - column (and row) variant");
     }
 
@@ -502,12 +1010,22 @@ namespace grb
         check_size_size(w, mask, "assign(std vec): w.size != mask.size");
         check_size_nindices(u, indices,
                             "assign(std vec): u.size != |indicies|");
-
-        backend::assign(get_internal_vector(w),
-                        get_internal_vector(mask),
-                        accum,
-                        get_internal_vector(u),
-                        indices, outp);
+        check_index_array_content_deferred(
+            indices, w.size(), "assign(std vec): indices content check");
+
+        // assign only writes the indexed elements (never overwrites w)
+        detail::execute(
+            w, false,
+            [](auto &w, auto const &mask, auto const &accum, auto const &u,
+               auto const &indices, OutputControlEnum outp)
+            {
+                backend::assign(get_internal_vector(w),
+                                get_internal_vector(mask),
+                                accum,
+                                get_internal_vector(u),
+                                indices, outp);
+            },
+            mask, accum, u, indices, outp);
 
         GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
         GRB_LOG_FN_END("assign - 4.3.7.1 - standard vector variant");
@@ -545,12 +1063,24 @@ namespace grb
                              "assign(std mat): A.nrows != |row_indices|");
         check_ncols_nindices(A, col_indices,
                              "assign(std mat): A.ncols != |col_indices|");
-
-        backend::assign(get_internal_matrix(C),
-                        get_internal_matrix(Mask),
-                        accum,
-                        get_internal_matrix(A),
-                        row_indices, col_indices, outp);
+        check_index_array_content_deferred(
+            row_indices, C.nrows(), "assign(std mat): row_indices content check");
+        check_index_array_content_deferred(
+            col_indices, C.ncols(), "assign(std mat): col_indices content check");
+
+        detail::execute(
+            C, false,
+            [](auto &C, auto const &Mask, auto const &accum, auto const &A,
+               auto const &row_indices, auto const &col_indices,
+               OutputControlEnum outp)
+            {
+                backend::assign(get_internal_matrix(C),
+                                get_internal_matrix(Mask),
+                                accum,
+                                get_internal_matrix(A),
+                                row_indices, col_indices, outp);
+            },
+            Mask, accum, A, row_indices, col_indices, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("assign - 4.3.7.2 - standard matrix variant");
@@ -586,12 +1116,22 @@ namespace grb
                             "assign(col): u.size != |row_indices|");
         check_index_within_ncols(col_index, C,
                                  "assign(col): col_index >= C.ncols");
-
-        backend::assign(get_internal_matrix(C),
-                        get_internal_vector(mask),
-                        accum,
-                        get_internal_vector(u),
-                        row_indices, col_index, outp);
+        check_index_array_content_deferred(
+            row_indices, C.nrows(), "assign(col): indices content check");
+
+        detail::execute(
+            C, false,
+            [](auto &C, auto const &mask, auto const &accum, auto const &u,
+               auto const &row_indices, IndexType col_index,
+               OutputControlEnum outp)
+            {
+                backend::assign(get_internal_matrix(C),
+                                get_internal_vector(mask),
+                                accum,
+                                get_internal_vector(u),
+                                row_indices, col_index, outp);
+            },
+            mask, accum, u, row_indices, col_index, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("assign - 4.3.7.3 - column variant");
@@ -626,12 +1166,22 @@ namespace grb
                             "assign(row): u.size != |col_indices|");
         check_index_within_nrows(row_index, C,
                                  "assign(col): row_index >= C.nrows");
-
-        backend::assign(get_internal_matrix(C),
-                        get_internal_vector(mask),
-                        accum,
-                        get_internal_vector(u),
-                        row_index, col_indices, outp);
+        check_index_array_content_deferred(
+            col_indices, C.ncols(), "assign(row): indices content check");
+
+        detail::execute(
+            C, false,
+            [](auto &C, auto const &mask, auto const &accum, auto const &u,
+               IndexType row_index, auto const &col_indices,
+               OutputControlEnum outp)
+            {
+                backend::assign(get_internal_matrix(C),
+                                get_internal_vector(mask),
+                                accum,
+                                get_internal_vector(u),
+                                row_index, col_indices, outp);
+            },
+            mask, accum, u, row_index, col_indices, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("assign - 4.3.7.4 - row variant");
@@ -665,11 +1215,20 @@ namespace grb
         check_size_size(w, mask, "assign(const vec): w.size != mask.size");
         check_nindices_within_size(indices, w,
                                    "assign(const vec): indicies.size !<= w.size");
-
-        backend::assign_constant(get_internal_vector(w),
-                                 get_internal_vector(mask),
-                                 accum, val,
-                                 indices, outp);
+        check_index_array_content_deferred(
+            indices, w.size(), "assign(const vec): indices content check");
+
+        detail::execute(
+            w, false,
+            [](auto &w, auto const &mask, auto const &accum, auto const &val,
+               auto const &indices, OutputControlEnum outp)
+            {
+                backend::assign_constant(get_internal_vector(w),
+                                         get_internal_vector(mask),
+                                         accum, val,
+                                         indices, outp);
+            },
+            mask, accum, val, indices, outp);
 
         GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
         GRB_LOG_FN_END("assign - 4.3.7.5 - constant vector variant");
@@ -712,11 +1271,23 @@ namespace grb
         check_nindices_within_ncols(
             col_indices, C,
             "assign(const mat): indicies.size !<= C.ncols");
-        backend::assign_constant(get_internal_matrix(C),
-                                 get_internal_matrix(Mask),
-                                 accum, val,
-                                 row_indices, col_indices,
-                                 outp);
+        check_index_array_content_deferred(
+            row_indices, C.nrows(), "assign(std mat): row_indices content check");
+        check_index_array_content_deferred(
+            col_indices, C.ncols(), "assign(std mat): col_indices content check");
+        detail::execute(
+            C, false,
+            [](auto &C, auto const &Mask, auto const &accum, auto const &val,
+               auto const &row_indices, auto const &col_indices,
+               OutputControlEnum outp)
+            {
+                backend::assign_constant(get_internal_matrix(C),
+                                         get_internal_matrix(Mask),
+                                         accum, val,
+                                         row_indices, col_indices,
+                                         outp);
+            },
+            Mask, accum, val, row_indices, col_indices, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("assign - 4.3.7.6 - constant matrix variant");
@@ -751,11 +1322,38 @@ namespace grb
         check_size_size(w, mask, "apply(vec): w.size != mask.size");
         check_size_size(w, u, "apply(vec): w.size != u.size");
 
-        backend::apply(get_internal_vector(w),
-                       get_internal_vector(mask),
-                       accum, op,
-                       get_internal_vector(u),
-                       outp);
+        auto kernel(
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &u, OutputControlEnum outp)
+            {
+                backend::apply(get_internal_vector(w),
+                               get_internal_vector(mask),
+                               accum, op,
+                               get_internal_vector(u),
+                               outp);
+            });
+
+        if constexpr (std::is_same_v<MaskT, NoMask> &&
+                      std::is_same_v<AccumT, NoAccumulate> &&
+                      detail::is_container_v<UVectorT>)
+        {
+            detail::execute_producer<WScalarT>(
+                w, kernel,
+                [](auto const &sink, auto const &, auto const &,
+                   auto op, auto const &u, OutputControlEnum)
+                {
+                    for (auto&& [idx, u_val] : get_internal_vector(u).getContents())
+                    {
+                        sink(idx, static_cast<WScalarT>(op(u_val)));
+                    }
+                },
+                mask, accum, op, u, outp);
+        }
+        else
+        {
+            detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                            kernel, mask, accum, op, u, outp);
+        }
 
         GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
         GRB_LOG_FN_END("apply - 4.3.8.1 - vector variant");
@@ -789,11 +1387,18 @@ namespace grb
         check_ncols_ncols(C, A, "apply(mat): C.ncols != A.ncols");
         check_nrows_nrows(C, A, "apply(mat): C.nrows != A.nrows");
 
-        backend::apply(get_internal_matrix(C),
-                       get_internal_matrix(Mask),
-                       accum, op,
-                       get_internal_matrix(A),
-                       outp);
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, OutputControlEnum outp)
+            {
+                backend::apply(get_internal_matrix(C),
+                               get_internal_matrix(Mask),
+                               accum, op,
+                               get_internal_matrix(A),
+                               outp);
+            },
+            Mask, accum, op, A, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("apply - 4.3.8.2 - matrix variant");
@@ -836,12 +1441,42 @@ namespace grb
             check_size_size(w, mask, "apply(vec,binop): w.size != mask.size");
             check_size_size(w, rhs, "apply(vec,binop): w.size != u.size");
 
-            backend::apply_binop_1st(get_internal_vector(w),
-                                     get_internal_vector(mask),
-                                     accum, op,
-                                     lhs,
-                                     get_internal_vector(rhs),
-                                     outp);
+            auto kernel(
+                [](auto &w, auto const &mask, auto const &accum,
+                   auto const &op, auto const &lhs, auto const &rhs,
+                   OutputControlEnum outp)
+                {
+                    backend::apply_binop_1st(get_internal_vector(w),
+                                             get_internal_vector(mask),
+                                             accum, op,
+                                             lhs,
+                                             get_internal_vector(rhs),
+                                             outp);
+                });
+
+            if constexpr (std::is_same_v<MaskT, NoMask> &&
+                          std::is_same_v<AccumT, NoAccumulate> &&
+                          detail::is_container_v<SecondT>)
+            {
+                detail::execute_producer<WScalarT>(
+                    w, kernel,
+                    [](auto const &sink, auto const &, auto const &,
+                       auto op, auto const &lhs, auto const &rhs,
+                       OutputControlEnum)
+                    {
+                        for (auto&& [idx, u_val] :
+                                 get_internal_vector(rhs).getContents())
+                        {
+                            sink(idx, static_cast<WScalarT>(op(lhs, u_val)));
+                        }
+                    },
+                    mask, accum, op, lhs, rhs, outp);
+            }
+            else
+            {
+                detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                                kernel, mask, accum, op, lhs, rhs, outp);
+            }
 
             GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
             GRB_LOG_FN_END("apply - 4.3.8.3 - vector binaryop bind1st variant");
@@ -859,12 +1494,42 @@ namespace grb
             check_size_size(w, mask, "apply(vec,binop): w.size != mask.size");
             check_size_size(w, lhs, "apply(vec,binop): w.size != u.size");
 
-            backend::apply_binop_2nd(get_internal_vector(w),
-                                     get_internal_vector(mask),
-                                     accum, op,
-                                     get_internal_vector(lhs),
-                                     rhs,
-                                     outp);
+            auto kernel(
+                [](auto &w, auto const &mask, auto const &accum,
+                   auto const &op, auto const &lhs, auto const &rhs,
+                   OutputControlEnum outp)
+                {
+                    backend::apply_binop_2nd(get_internal_vector(w),
+                                             get_internal_vector(mask),
+                                             accum, op,
+                                             get_internal_vector(lhs),
+                                             rhs,
+                                             outp);
+                });
+
+            if constexpr (std::is_same_v<MaskT, NoMask> &&
+                          std::is_same_v<AccumT, NoAccumulate> &&
+                          detail::is_container_v<FirstT>)
+            {
+                detail::execute_producer<WScalarT>(
+                    w, kernel,
+                    [](auto const &sink, auto const &, auto const &,
+                       auto op, auto const &lhs, auto const &rhs,
+                       OutputControlEnum)
+                    {
+                        for (auto&& [idx, u_val] :
+                                 get_internal_vector(lhs).getContents())
+                        {
+                            sink(idx, static_cast<WScalarT>(op(u_val, rhs)));
+                        }
+                    },
+                    mask, accum, op, lhs, rhs, outp);
+            }
+            else
+            {
+                detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                                kernel, mask, accum, op, lhs, rhs, outp);
+            }
 
             GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
             GRB_LOG_FN_END("apply - 4.3.8.3 - vector binaryop bind2nd variant");
@@ -910,12 +1575,20 @@ namespace grb
             check_ncols_ncols(C, rhs, "apply(mat,binop): C.ncols != A.ncols");
             check_nrows_nrows(C, rhs, "apply(mat,binop): C.nrows != A.nrows");
 
-            backend::apply_binop_1st(get_internal_matrix(C),
-                                     get_internal_matrix(Mask),
-                                     accum, op,
-                                     lhs,
-                                     get_internal_matrix(rhs),
-                                     outp);
+            detail::execute(
+                C, detail::overwrites_output(Mask, accum, outp),
+                [](auto &C, auto const &Mask, auto const &accum,
+                   auto const &op, auto const &lhs, auto const &rhs,
+                   OutputControlEnum outp)
+                {
+                    backend::apply_binop_1st(get_internal_matrix(C),
+                                             get_internal_matrix(Mask),
+                                             accum, op,
+                                             lhs,
+                                             get_internal_matrix(rhs),
+                                             outp);
+                },
+                Mask, accum, op, lhs, rhs, outp);
 
             GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
             GRB_LOG_FN_END("apply - 4.3.8.4 - matrix binaryop bind1st variant");
@@ -936,18 +1609,147 @@ namespace grb
             check_ncols_ncols(C, lhs, "apply(mat,binop): C.ncols != A.ncols");
             check_nrows_nrows(C, lhs, "apply(mat,binop): C.nrows != A.nrows");
 
-            backend::apply_binop_2nd(get_internal_matrix(C),
-                                     get_internal_matrix(Mask),
-                                     accum, op,
-                                     get_internal_matrix(lhs),
-                                     rhs,
-                                     outp);
+            detail::execute(
+                C, detail::overwrites_output(Mask, accum, outp),
+                [](auto &C, auto const &Mask, auto const &accum,
+                   auto const &op, auto const &lhs, auto const &rhs,
+                   OutputControlEnum outp)
+                {
+                    backend::apply_binop_2nd(get_internal_matrix(C),
+                                             get_internal_matrix(Mask),
+                                             accum, op,
+                                             get_internal_matrix(lhs),
+                                             rhs,
+                                             outp);
+                },
+                Mask, accum, op, lhs, rhs, outp);
 
             GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
             GRB_LOG_FN_END("apply - 4.3.8.4 - matrix binaryop bind2nd variant");
         }
     }
 
+    //************************************************************************
+    // select
+    //************************************************************************
+
+    // select: vector variant, w<m,z> := u(op(u, i, 0, val))
+    template<typename WScalarT,
+             typename MaskT,
+             typename AccumT,
+             typename IndexUnaryOpT,
+             typename UVectorT,
+             typename ValueT,
+             typename ...WTagsT>
+    inline void select(Vector<WScalarT, WTagsT...> &w,
+                       MaskT                 const &mask,
+                       AccumT                const &accum,
+                       IndexUnaryOpT                op,
+                       UVectorT              const &u,
+                       ValueT                const &val,
+                       OutputControlEnum            outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("select - vector variant");
+        GRB_LOG_VERBOSE("w in: " << get_internal_vector(w));
+        GRB_LOG_VERBOSE("mask in: " << get_internal_vector(mask));
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("u in: " << get_internal_vector(u));
+        GRB_LOG_VERBOSE("val in: " << val);
+        GRB_LOG_VERBOSE_OUTP(outp);
+
+        check_size_size(w, mask, "select(vec): w.size != mask.size");
+        check_size_size(w, u, "select(vec): w.size != u.size");
+
+        auto kernel(
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &u, auto const &val, OutputControlEnum outp)
+            {
+                backend::select(get_internal_vector(w),
+                                get_internal_vector(mask),
+                                accum, op,
+                                get_internal_vector(u),
+                                val,
+                                outp);
+            });
+
+        if constexpr (std::is_same_v<MaskT, NoMask> &&
+                      std::is_same_v<AccumT, NoAccumulate> &&
+                      detail::is_container_v<UVectorT>)
+        {
+            detail::execute_producer<WScalarT>(
+                w, kernel,
+                [](auto const &sink, auto const &, auto const &,
+                   auto op, auto const &u, auto const &val, OutputControlEnum)
+                {
+                    for (auto&& [idx, u_val] : get_internal_vector(u).getContents())
+                    {
+                        if (op(u_val, idx, 0, val))
+                        {
+                            sink(idx, static_cast<WScalarT>(u_val));
+                        }
+                    }
+                },
+                mask, accum, op, u, val, outp);
+        }
+        else
+        {
+            detail::execute(w, detail::overwrites_output(mask, accum, outp),
+                            kernel, mask, accum, op, u, val, outp);
+        }
+
+        GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
+        GRB_LOG_FN_END("select - vector variant");
+    }
+
+    // select: matrix variant, C<M,z> := A(op(A, i, j, val))
+    template<typename CScalarT,
+             typename MaskT,
+             typename AccumT,
+             typename IndexUnaryOpT,
+             typename AMatrixT,
+             typename ValueT,
+             typename ...CTagsT>
+    inline void select(Matrix<CScalarT, CTagsT...> &C,
+                       MaskT                 const &Mask,
+                       AccumT                const &accum,
+                       IndexUnaryOpT                op,
+                       AMatrixT              const &A,
+                       ValueT                const &val,
+                       OutputControlEnum            outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("select - matrix variant");
+        GRB_LOG_VERBOSE("C in: " << get_internal_matrix(C));
+        GRB_LOG_VERBOSE("Mask in: " << get_internal_matrix(Mask));
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("A in: " << A);
+        GRB_LOG_VERBOSE("val in: " << val);
+        GRB_LOG_VERBOSE_OUTP(outp);
+
+        check_ncols_ncols(C, Mask, "select(mat): C.ncols != Mask.ncols");
+        check_nrows_nrows(C, Mask, "select(mat): C.nrows != Mask.nrows");
+        check_ncols_ncols(C, A, "select(mat): C.ncols != A.ncols");
+        check_nrows_nrows(C, A, "select(mat): C.nrows != A.nrows");
+
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, auto const &val, OutputControlEnum outp)
+            {
+                backend::select(get_internal_matrix(C),
+                                get_internal_matrix(Mask),
+                                accum, op,
+                                get_internal_matrix(A),
+                                val,
+                                outp);
+            },
+            Mask, accum, op, A, val, outp);
+
+        GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
+        GRB_LOG_FN_END("select - matrix variant");
+    }
+
     //************************************************************************
     // reduce
     //************************************************************************
@@ -977,11 +1779,18 @@ namespace grb
         check_size_size(w, mask, "reduce(mat2vec): w.size != mask.size");
         check_size_nrows(w, A, "reduce(mat2vec): w.size != A.nrows");
 
-        backend::reduce(get_internal_vector(w),
-                        get_internal_vector(mask),
-                        accum, op,
-                        get_internal_matrix(A),
-                        outp);
+        detail::execute(
+            w, detail::overwrites_output(mask, accum, outp),
+            [](auto &w, auto const &mask, auto const &accum, auto const &op,
+               auto const &A, OutputControlEnum outp)
+            {
+                backend::reduce(get_internal_vector(w),
+                                get_internal_vector(mask),
+                                accum, op,
+                                get_internal_matrix(A),
+                                outp);
+            },
+            mask, accum, op, A, outp);
 
         GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
         GRB_LOG_FN_END("reduce - 4.3.9.1 - matrix to vector variant");
@@ -1005,6 +1814,8 @@ namespace grb
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("u in: " << get_internal_vector(u));
 
+        // The scalar is observed immediately
+        detail::complete_pending_writes(&u);
         backend::reduce_vector_to_scalar(val,
                                          accum, op,
                                          get_internal_vector(u));
@@ -1033,6 +1844,8 @@ namespace grb
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("A in: " << get_internal_matrix(A));
 
+        // The scalar is observed immediately
+        detail::complete_pending_writes(&A);
         backend::reduce_matrix_to_scalar(val,
                                          accum, op,
                                          get_internal_matrix(A));
@@ -1068,7 +1881,16 @@ namespace grb
         check_ncols_nrows(C, A, "transpose: C.ncols != A.nrows");
         check_ncols_nrows(A, C, "transpose: A.ncols != C.nrows");
 
-        backend::transpose(get_internal_matrix(C), get_internal_matrix(Mask), accum, get_internal_matrix(A), outp);
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &A,
+               OutputControlEnum outp)
+            {
+                backend::transpose(get_internal_matrix(C),
+                                   get_internal_matrix(Mask),
+                                   accum, get_internal_matrix(A), outp);
+            },
+            Mask, accum, A, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("transpose - 4.3.10");
@@ -1109,12 +1931,19 @@ namespace grb
         check_nrows_nrowsxnrows(C, A, B,
                                 "kronecker: C.nrows != A.nrows*B.nrows");
 
-        backend::kronecker(get_internal_matrix(C),
-                           get_internal_matrix(Mask),
-                           accum, op,
-                           get_internal_matrix(A),
-                           get_internal_matrix(B),
-                           outp);
+        detail::execute(
+            C, detail::overwrites_output(Mask, accum, outp),
+            [](auto &C, auto const &Mask, auto const &accum, auto const &op,
+               auto const &A, auto const &B, OutputControlEnum outp)
+            {
+                backend::kronecker(get_internal_matrix(C),
+                                   get_internal_matrix(Mask),
+                                   accum, op,
+                                   get_internal_matrix(A),
+                                   get_internal_matrix(B),
+                                   outp);
+            },
+            Mask, accum, op, A, B, outp);
 
         GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
         GRB_LOG_FN_END("kronecker - 4.3.11");
@@ -1123,10 +1952,53 @@ namespace grb
     //************************************************************************
     // Context etc.
     //************************************************************************
-    void init() {}
+    /**
+     * @brief Select the execution mode.  In NONBLOCKING mode operations are
+     *        deferred until their results are observed (or wait() is called),
+     *        see detail/nonblocking.hpp.  Pending operations are completed
+     *        before the mode changes.
+     */
+    inline void init(ExecutionMode mode = BLOCKING)
+    {
+        detail::execution_context().set_mode(mode);
+    }
+
+    /// Complete all pending operations and return to blocking mode.
+    inline void finalize()
+    {
+        detail::execution_context().set_mode(BLOCKING);
+        detail::execution_context().rethrow_deferred_error();
+    }
+
+    inline ExecutionMode getExecutionMode()
+    {
+        return detail::execution_context().mode();
+    }
+
+    /**
+     * @brief Complete all pending operations.
+     *
+     * @throw Any exception raised by a deferred operation (the outputs of the
+     *        operations that were still pending are then undefined).
+     */
+    inline void wait()
+    {
+        detail::execution_context().complete_all();
+        detail::execution_context().rethrow_deferred_error();
+    }
 
+    /// Complete the pending operations needed to produce obj (a matrix,
+    /// vector or view).
     template <typename T>
-    void wait(T&& obj) {}
+    inline void wait(T const &obj)
+    {
+        void const *id(detail::object_id(obj));
+        if (id != nullptr)
+        {
+            detail::complete_pending_writes(id);
+        }
+        detail::execution_context().rethrow_deferred_error();
+    }
 
     //************************************************************************
     // Views
@@ -0,0 +1,545 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+/**
+ * Multithreaded (OpenMP) versions of the row loop kernels of the optimized
+ * backend.  Everything else in the openmp platform is shared with
+ * optimized_sequential, whose operations include this file as
+ * <sparse_kernels.hpp>; see optimized_sequential/sparse_kernels.hpp for the
+ * sequential versions and the contract of each kernel.
+ *
+ * Nothing may throw inside a parallel region, so the kernels rely on their
+ * callers having validated indices and dimensions.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <vector>
+#include <tuple>
+#include <omp.h>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/optimized_sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/optimized_sequential/LilSparseMatrix.hpp>
+
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+
+        //********************************************************************
+        // Multithreading helpers
+        //********************************************************************
+
+        /// Number of row ranges to create per thread.  More than one range
+        /// per thread lets the dynamic schedule absorb errors in the work
+        /// estimates.
+        static constexpr IndexType ROW_PARTITIONS_PER_THREAD = 4;
+
+        //**********************************************************************
+        /// Split the rows [0, nrows) into contiguous ranges with roughly equal
+        /// total work, where the work of row i is estimated by weight(i) (one
+        /// is added to every row so that runs of empty rows are still spread
+        /// out).
+        ///
+        /// @return  bounds such that range p covers rows [bounds[p], bounds[p+1])
+        template <typename WeightFnT>
+        std::vector<IndexType> partition_rows_by_weight(IndexType nrows,
+                                                        WeightFnT weight)
+        {
+            IndexType num_parts(std::max<IndexType>(
+                1, std::min<IndexType>(
+                    nrows,
+                    ROW_PARTITIONS_PER_THREAD * omp_get_max_threads())));
+
+            std::vector<IndexType> prefix(nrows + 1, 0UL);
+            for (IndexType i = 0; i < nrows; ++i)
+            {
+                prefix[i + 1] = prefix[i] + weight(i) + 1;
+            }
+
+            std::vector<IndexType> bounds(num_parts + 1, nrows);
+            bounds[0] = 0;
+            for (IndexType part = 1; part < num_parts; ++part)
+            {
+                IndexType target = (prefix[nrows] * part) / num_parts;
+                IndexType row = std::lower_bound(prefix.begin(), prefix.end(),
+                                                 target) - prefix.begin();
+                bounds[part] = std::clamp(row, bounds[part - 1], nrows);
+            }
+
+            return bounds;
+        }
+
+        //**********************************************************************
+        /// Partition the rows of A by the number of stored values in each.
+        /// Used for dot product (pull) kernels.
+        template <typename MatrixT>
+        std::vector<IndexType> partition_rows_by_nnz(MatrixT const &A)
+        {
+            return partition_rows_by_weight(
+                A.nrows(), [&A](IndexType i) { return A[i].size(); });
+        }
+
+        //**********************************************************************
+        /// Partition the rows of A for computing A*B row by row (axpy/push
+        /// kernels): the work of row i is the number of multiplies it
+        /// generates, sum_k |B[k]| for each stored A[i][k].
+        template <typename AMatrixT, typename BMatrixT>
+        std::vector<IndexType> partition_rows_by_flops(AMatrixT const &A,
+                                                       BMatrixT const &B)
+        {
+            return partition_rows_by_weight(
+                A.nrows(),
+                [&A, &B](IndexType i)
+                {
+                    IndexType flops(0);
+                    for (auto const &Ai_elt : A[i])
+                    {
+                        flops += B[std::get<0>(Ai_elt)].size();
+                    }
+                    return flops;
+                });
+        }
+
+        //**********************************************************************
+        /// Replace the contents of a matrix row (obtained with the non-const
+        /// operator[]) with the contents of a scratch row.  Unlike setRow()
+        /// this does not update the matrix's nvals, so it is safe to call
+        /// concurrently on distinct rows; call recomputeNvals() afterwards.
+        ///
+        /// @note When the types match the scratch row is swapped out and is
+        ///       left holding the old row contents.
+        template <typename CScalarT, typename TScalarT>
+        void set_row_contents(
+            std::vector<std::tuple<IndexType, CScalarT> > &c_row,
+            std::vector<std::tuple<IndexType, TScalarT> > &t_row)
+        {
+            if constexpr (std::is_same_v<CScalarT, TScalarT>)
+            {
+                c_row.swap(t_row);
+            }
+            else
+            {
+                c_row.clear();
+                c_row.reserve(t_row.size());
+                for (auto&& [idx, val] : t_row)
+                {
+                    c_row.emplace_back(idx, static_cast<CScalarT>(val));
+                }
+            }
+        }
+
+
+        //**********************************************************************
+        /// t = the per-range results concatenated in range order.
+        template <typename TScalarT>
+        void concatenate_parts(
+            std::vector<std::tuple<IndexType, TScalarT> >                &t,
+            std::vector<std::vector<std::tuple<IndexType, TScalarT> > > const &parts)
+        {
+            IndexType total(0);
+            for (auto const &part_t : parts)
+            {
+                total += part_t.size();
+            }
+
+            t.clear();
+            t.reserve(total);
+            for (auto const &part_t : parts)
+            {
+                t.insert(t.end(), part_t.begin(), part_t.end());
+            }
+        }
+
+        //**********************************************************************
+        /// Compute t = [(i, dot(A[i]))] for every non-empty row of A that the
+        /// mask allows, in parallel unless A is hypersparse (then only its
+        /// stored rows are visited, sequentially).
+        template <typename TScalarT,
+                  typename MatrixT,
+                  typename MaskT,
+                  typename DotFnT>
+        void masked_row_dots(
+            std::vector<std::tuple<IndexType, TScalarT> > &t,
+            MatrixT                                 const &A,
+            MaskT                                   const &mask,
+            DotFnT                                         dot_fn)
+        {
+            if (A.hypersparse())
+            {
+                t.clear();
+                A.forEachRow([&](IndexType i, auto const &row)
+                {
+                    TScalarT t_val;
+                    if (mask_allows(mask, i) && dot_fn(t_val, row))
+                    {
+                        t.emplace_back(i, t_val);
+                    }
+                });
+                return;
+            }
+
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+            std::vector<std::vector<std::tuple<IndexType, TScalarT> > >
+                part_results(num_parts);
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (IndexType part = 0; part < num_parts; ++part)
+            {
+                for (IndexType i = row_bounds[part];
+                     i < row_bounds[part + 1]; ++i)
+                {
+                    TScalarT t_val;
+                    if (!A[i].empty() && mask_allows(mask, i) &&
+                        dot_fn(t_val, A[i]))
+                    {
+                        part_results[part].emplace_back(i, t_val);
+                    }
+                }
+            }
+
+            // ranges are in row order so concatenation keeps t sorted
+            concatenate_parts(t, part_results);
+        }
+
+        //**********************************************************************
+        /// Compute t<mask> = sum_k u[k]*A[k] in parallel.  The output index
+        /// range [0, A.ncols()) is split into disjoint ranges and each range
+        /// is accumulated by one thread from the part of every A[k] (u[k]
+        /// stored) that falls in it, so the partial results never overlap and
+        /// are concatenated in order.  Every range costs a binary search per
+        /// stored u[k], in exchange for no merge of per-thread results.
+        template <typename TScalarT,
+                  typename SemiringT,
+                  typename USequenceT,
+                  typename MatrixT,
+                  typename MaskT>
+        void masked_vector_axpy(
+            std::vector<std::tuple<IndexType, TScalarT> > &t,
+            SemiringT                                      op,
+            USequenceT                              const &u_contents,
+            MatrixT                                 const &A,
+            MaskT                                   const &mask)
+        {
+            t.clear();
+
+            // random access to the stored values of u from every range
+            using UElementType = std::decay_t<decltype(*u_contents.begin())>;
+            std::vector<UElementType> u_vec;
+            u_vec.reserve(u_contents.size());
+            for (auto &&u_elt : u_contents)
+            {
+                u_vec.push_back(u_elt);
+            }
+            if (u_vec.empty()) return;
+
+            IndexType const ncols(A.ncols());
+            IndexType num_parts(std::max<IndexType>(
+                1, std::min<IndexType>(
+                    ncols, ROW_PARTITIONS_PER_THREAD * omp_get_max_threads())));
+            std::vector<std::vector<std::tuple<IndexType, TScalarT> > >
+                part_results(num_parts);
+
+            auto add_op([&op](auto lhs, auto rhs) { return op.add(lhs, rhs); });
+            auto col_less([](auto const &elt, IndexType idx)
+                          { return std::get<0>(elt) < idx; });
+
+#pragma omp parallel
+            {
+                SparseAccumulator<TScalarT> spa(ncols);
+
+                // [first, last) offsets of the range's part of each A[k]
+                std::vector<std::tuple<IndexType, IndexType> >
+                    spans(u_vec.size());
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    IndexType first_col((ncols * part) / num_parts);
+                    IndexType last_col((ncols * (part + 1)) / num_parts);
+
+                    IndexType flops(0);
+                    for (IndexType pos = 0; pos < u_vec.size(); ++pos)
+                    {
+                        auto const &a_row(A[std::get<0>(u_vec[pos])]);
+                        auto lo(std::lower_bound(a_row.begin(), a_row.end(),
+                                                 first_col, col_less));
+                        auto hi(std::lower_bound(lo, a_row.end(),
+                                                 last_col, col_less));
+                        spans[pos] = std::make_tuple(lo - a_row.begin(),
+                                                     hi - a_row.begin());
+                        flops += hi - lo;
+                    }
+                    if (flops == 0) continue;
+
+                    spa.start_row(flops);
+                    for (IndexType pos = 0; pos < u_vec.size(); ++pos)
+                    {
+                        auto &&[k, u_k] = u_vec[pos];
+                        auto const &a_row(A[k]);
+                        for (IndexType a_pos = std::get<0>(spans[pos]);
+                             a_pos < std::get<1>(spans[pos]); ++a_pos)
+                        {
+                            auto &&[j, a_kj] = a_row[a_pos];
+                            if (mask_allows(mask, j))
+                            {
+                                spa.accumulate(j, op.mult(u_k, a_kj), add_op);
+                            }
+                        }
+                    }
+                    spa.gather(part_results[part]);
+                }
+            }
+
+            // ranges are in index order so concatenation keeps t sorted
+            concatenate_parts(t, part_results);
+        }
+
+        //**********************************************************************
+        /// Compute t = [(i, op_j(A[i][j]))] for the non-empty rows of A.
+        /// Rows are reduced concurrently into dense slots and compacted in
+        /// row order; a hypersparse A is reduced sequentially.
+        template <typename TScalarT,
+                  typename MatrixT,
+                  typename BinaryOpT>
+        void reduce_rows(
+            std::vector<std::tuple<IndexType, TScalarT> > &t,
+            MatrixT                                 const &A,
+            BinaryOpT                                      op)
+        {
+            if (A.hypersparse())
+            {
+                A.forEachRow([&](IndexType row_idx, auto const &a_row)
+                {
+                    TScalarT t_val;
+                    if (reduction(t_val, a_row, op))
+                    {
+                        t.emplace_back(row_idx, t_val);
+                    }
+                });
+                return;
+            }
+
+            IndexType const nrows(A.nrows());
+            std::vector<std::optional<TScalarT> > t_vals(nrows);
+
+#pragma omp parallel for schedule(dynamic, 64)
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                TScalarT t_val;
+                if (reduction(t_val, A[row_idx], op))
+                {
+                    t_vals[row_idx] = t_val;
+                }
+            }
+
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                if (t_vals[row_idx])
+                {
+                    t.emplace_back(row_idx, *t_vals[row_idx]);
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// T := the elements A(i, j) of A for which op(A(i, j), i, j, val)
+        /// is true.  Rows of T are written concurrently unless A is
+        /// hypersparse.  T must be empty; the caller recomputes T's nvals.
+        template <typename TScalarT,
+                  typename MatrixT,
+                  typename IndexUnaryOpT,
+                  typename ValueT>
+        void select_rows(LilSparseMatrix<TScalarT>       &T,
+                         MatrixT                   const &A,
+                         IndexUnaryOpT                    op,
+                         ValueT                    const &val)
+        {
+            if (A.hypersparse())
+            {
+                T.reserveRows(max_nonempty_rows(A));
+
+                A.forEachRow([&](IndexType row_idx, auto const &a_row)
+                {
+                    for (auto&& [a_idx, a_val] : a_row)
+                    {
+                        if (op(a_val, row_idx, a_idx, val))
+                        {
+                            T.mutableRow(row_idx).emplace_back(a_idx, a_val);
+                        }
+                    }
+                });
+                return;
+            }
+
+            T.setHypersparse(false);
+            IndexType const nrows(A.nrows());
+
+#pragma omp parallel for schedule(dynamic, 64)
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                auto &t_row(T.mutableRow(row_idx));
+                for (auto&& [a_idx, a_val] : A[row_idx])
+                {
+                    if (op(a_val, row_idx, a_idx, val))
+                    {
+                        t_row.emplace_back(a_idx, a_val);
+                    }
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// Call f(row_idx, row) for the non-empty rows of A, concurrently
+        /// unless A is hypersparse.  f may modify (or clear) the row it is
+        /// given but no other row of A.  The caller recomputes A's nvals.
+        template <typename MatrixT,
+                  typename FunctionT>
+        void update_rows(MatrixT &A, FunctionT f)
+        {
+            if (A.hypersparse())
+            {
+                A.forEachRow(f);
+                return;
+            }
+
+            IndexType const nrows(A.nrows());
+
+#pragma omp parallel for schedule(dynamic, 64)
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                auto &row(A.mutableRow(row_idx));
+                if (!row.empty()) f(row_idx, row);
+            }
+        }
+
+        // *******************************************************************
+        // w = u(indices) for an explicit index list: the indices are looked
+        // up concurrently into dense slots, then compacted.  Each thread
+        // walks its own contiguous block of the sequence with a forward
+        // iterator, so any sequence (AllIndices ranges, lists) works.  The
+        // indices must already have been checked against u.size().
+        template<typename CScalarT,
+                 typename UVectorT,
+                 typename SequenceT>
+        void vectorGather(
+                std::vector<std::tuple<IndexType, CScalarT> > &vec_dest,
+                UVectorT                                const &u,
+                SequenceT                               const &indices)
+        {
+            vec_dest.clear();
+            if (u.nvals() == 0) return;
+
+            IndexType const num_indices(indices.size());
+            std::vector<std::optional<CScalarT> > vals(num_indices);
+
+#pragma omp parallel
+            {
+                IndexType const num_threads(omp_get_num_threads());
+                IndexType const thread_id(omp_get_thread_num());
+                IndexType const first((num_indices * thread_id) / num_threads);
+                IndexType const last((num_indices * (thread_id + 1)) /
+                                     num_threads);
+
+                auto idx_it(indices.begin());
+                std::advance(idx_it, first);
+                for (IndexType pos = first; pos < last; ++pos, ++idx_it)
+                {
+                    typename UVectorT::ScalarType u_val;
+                    if (u.lookupElement(*idx_it, u_val))
+                    {
+                        vals[pos] = static_cast<CScalarT>(u_val);
+                    }
+                }
+            }
+
+            for (IndexType pos = 0; pos < num_indices; ++pos)
+            {
+                if (vals[pos])
+                {
+                    vec_dest.emplace_back(pos, *vals[pos]);
+                }
+            }
+        }
+
+        // *******************************************************************
+        // C = A(rows, cols): the column list is prepared once and matched
+        // against each requested row (in parallel), so the cost is
+        // proportional to the requested rows and the output (see
+        // IndexLookup).
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename RowSequenceT,
+                 typename ColLookupT>
+        void matrixExtractRows(LilSparseMatrix<CScalarT>        &C,
+                               LilSparseMatrix<AScalarT> const  &A,
+                               RowSequenceT              const  &row_indices,
+                               ColLookupT                const  &cols)
+        {
+            IndexArrayType rows;
+            for (auto row_it = row_indices.begin();
+                 row_it != row_indices.end(); ++row_it)
+            {
+                rows.push_back(*row_it);
+            }
+
+            // rows of C are written concurrently
+            C.clear();
+            C.setHypersparse(false);
+
+            IndexType const num_rows(rows.size());
+#pragma omp parallel
+            {
+                std::vector<std::tuple<IndexType,CScalarT> > out_row;
+
+#pragma omp for schedule(dynamic, 64)
+                for (IndexType out_row_index = 0; out_row_index < num_rows;
+                     ++out_row_index)
+                {
+                    auto const &row(A[rows[out_row_index]]);
+                    if (row.empty()) continue;
+
+                    // Extract the values from the row
+                    cols.extract(out_row, row);
+                    if (!out_row.empty())
+                        C.mutableRow(out_row_index).swap(out_row);
+                }
+            }
+            C.recomputeNvals();
+        }
+
+    } // backend
+} // grb
@@ -0,0 +1,1082 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+/**
+ * Multithreaded (OpenMP) row loop kernels of the mxm variants; see
+ * optimized_sequential/sparse_mxm_kernels.hpp for the sequential versions.
+ */
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/optimized_sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/optimized_sequential/LilSparseMatrix.hpp>
+
+#include "sparse_kernels.hpp"
+
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        // A * B
+        //**********************************************************************
+
+        // The rows of C are computed independently, so the row loops below
+        // are split into ranges of roughly equal flop counts that are
+        // distributed dynamically across threads.  Each thread owns its
+        // scratch rows and rows of C are written in place (not with setRow or
+        // mergeRow which update the shared nvals count), so C's nvals must
+        // be recomputed once all rows are written.  C is switched out of
+        // hypersparse storage first, which cannot insert rows concurrently.
+
+        //**********************************************************************
+        // Perform C = A*B where C, A and B must all be unique
+        template<typename CScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_NoMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(A, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                SparseAccumulator<TScalarType>                 spa(B.ncols());
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        // T[i] = A[i] +.* B
+                        spa_axpy_row(T_row, spa, semiring, A[i], B);
+
+                        // C[i] = T[i]
+                        set_row_contents(C.mutableRow(i), T_row);  // set even if empty.
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C = C + AB, where C, A, and B must all be unique
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_NoMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(A, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                SparseAccumulator<TScalarType>                 spa(B.ncols());
+                typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        // T[i] = A[i] +.* B
+                        spa_axpy_row(T_row, spa, semiring, A[i], B);
+
+                        if (!T_row.empty())
+                        {
+                            // C[i] = C[i] + T[i]
+                            ewise_or(C_row, C[i], T_row, accum);
+                            set_row_contents(C.mutableRow(i), C_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = A +.* B where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_Mask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(A, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                SparseAccumulator<TScalarType>                 spa(B.ncols());
+                typename LilSparseMatrix<CScalarT>::RowType C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    // compute row i of answer
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        bool const complement_flag = false;
+
+                        // T[i] = M[i] .* (A[i] +.* B)
+                        spa_masked_axpy_row(T_row, spa,
+                                            M[i], structure_flag, complement_flag,
+                                            semiring, A[i], B);
+
+                        if (outp == REPLACE)
+                        {
+                            // C[i] = T[i], z = "replace"
+                            set_row_contents(C.mutableRow(i), T_row);  // even if empty.
+                        }
+                        else
+                        {
+                            // C[i] = [!M .* C]  U  T[i], z = "merge"
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], T_row);
+                            set_row_contents(C.mutableRow(i), C_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = C + (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_Mask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(A, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                SparseAccumulator<TScalarType>                 spa(B.ncols());
+                typename LilSparseMatrix<ZScalarType>::RowType Z_row;
+                typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    // compute row i of answer
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        bool const complement_flag = false;
+
+                        // T[i] = M[i] .* (A[i] +.* B)
+                        spa_masked_axpy_row(T_row, spa,
+                                            M[i], structure_flag, complement_flag,
+                                            semiring, A[i], B);
+
+                        // Z[i] = (M .* C) + T[i]
+                        Z_row.clear();
+                        masked_accum(Z_row,
+                                     M[i], structure_flag, complement_flag,
+                                     accum, C[i], T_row);
+
+                        if (outp == MERGE)
+                        {
+                            // C[i]  = [!M .* C]  U  Z[i]
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], Z_row);
+                            set_row_contents(C.mutableRow(i), C_row);  // set even if it is empty.
+                        }
+                        else // z = replace
+                        {
+                            // C[i] = Z[i]
+                            set_row_contents(C.mutableRow(i), Z_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_CompMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(A, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                SparseAccumulator<TScalarType>                 spa(B.ncols());
+                typename LilSparseMatrix<CScalarT>::RowType    Z_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    // compute row i of answer
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        // if M[i] is empty it is like NoMask_NoAccum
+
+                        bool const complement_flag = true;
+
+                        // T[i] = !M[i] .* (A[i] +.* B)
+                        spa_masked_axpy_row(T_row, spa,
+                                            M[i], structure_flag, complement_flag,
+                                            semiring, A[i], B);
+
+                        if ((outp == REPLACE) || M[i].empty())
+                        {
+                            // C[i] = T[i]
+                            set_row_contents(C.mutableRow(i), T_row);  // even if empty.
+                        }
+                        else
+                        {
+                            Z_row.clear();
+                            // Z[i] = (M[i] .* C[i]) U T[i]
+                            masked_merge(Z_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], T_row);
+                            set_row_contents(C.mutableRow(i), Z_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = C + (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_CompMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(A, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                SparseAccumulator<TScalarType>                 spa(B.ncols());
+                typename LilSparseMatrix<ZScalarType>::RowType Z_row;
+                typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    // compute row i of answer
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        // if M[i] is empty it is like NoMask_NoAccum
+
+                        bool const complement_flag = true;
+
+                        // T[i] = !M[i] .* (A[i] +.* B)
+                        spa_masked_axpy_row(T_row, spa,
+                                            M[i], structure_flag, complement_flag,
+                                            semiring, A[i], B);
+
+                        // Z[i] = (!M[i] .* C[i]) + T[i], where T[i] is masked by !M[i]
+                        Z_row.clear();
+                        masked_accum(Z_row,
+                                     M[i], structure_flag, complement_flag,
+                                     accum, C[i], T_row);
+
+                        if ((outp == REPLACE) || M[i].empty())
+                        {
+                            set_row_contents(C.mutableRow(i), Z_row);
+                        }
+                        else /* merge */
+                        {
+                            // C[i] = [M[i] .* C[i]]  U  Z[i], where Z is disjoint from M
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], Z_row);
+                            set_row_contents(C.mutableRow(i), C_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // A * B'
+        //**********************************************************************
+
+        //**********************************************************************
+        // Perform C = A +.* B' where C, A, and B are all unique
+        template<typename CScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_NoMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<CScalarT>::RowType C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        C_row.clear();
+                        if (A[i].empty()) continue;
+
+                        // fill row i of T
+                        auto const &A_i(A[i]);
+                        B.forEachRow([&](IndexType j, auto const &B_j)
+                        {
+                            TScalarType t_ij;
+
+                            // Perform the dot product
+                            // C[i][j] = T_ij = (CScalarT) (A[i] . B[j])
+                            if (dot(t_ij, A_i, B_j, semiring))
+                            {
+                                C_row.emplace_back(j, static_cast<CScalarT>(t_ij));
+                            }
+                        });
+
+                        set_row_contents(C.mutableRow(i), C_row);  // set even if it is empty.
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C = C + AB', where C, A, and B must all be unique
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_NoMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                std::vector<std::tuple<IndexType,TScalarType> > T_row;
+                typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        if (A[i].empty()) continue;
+
+                        T_row.clear();
+
+                        // Compute row i of T
+                        // T[i] = (CScalarT) (A[i] *.+ B')
+                        auto const &A_i(A[i]);
+                        B.forEachRow([&](IndexType j, auto const &B_j)
+                        {
+                            TScalarType t_ij;
+
+                            // Perform the dot product
+                            // T[i][j] = (CScalarT) (A[i] . B[j])
+                            if (dot(t_ij, A_i, B_j, semiring))
+                            {
+                                T_row.emplace_back(j, t_ij);
+                            }
+                        });
+
+                        if (!T_row.empty())
+                        {
+                            // C[i] = C[i] + T[i]
+                            ewise_or(C_row, C[i], T_row, accum);
+                            set_row_contents(C.mutableRow(i), C_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = A +.* B' where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_Mask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                typename LilSparseMatrix<CScalarT>::RowType C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        bool const complement_flag = false;
+                        T_row.clear();
+
+                        // T[i] = M[i] .* (A[i] dot B[j])
+                        if (!A[i].empty() && !M[i].empty())
+                        {
+                            auto const &M_i(M[i]);
+                            auto M_iter(M_i.begin());
+                            auto const &A_i(A[i]);
+                            B.forEachRow([&](IndexType j, auto const &B_j)
+                            {
+                                if (!advance_and_check_mask_iterator(
+                                        M_iter, M_i.end(), structure_flag, j))
+                                    return;
+
+                                // Perform the dot product
+                                TScalarType t_ij;
+                                if (dot(t_ij, A_i, B_j, semiring))
+                                {
+                                    T_row.emplace_back(j, t_ij);
+                                }
+                            });
+                        }
+
+                        if (outp == REPLACE)
+                        {
+                            // C[i] = T[i], z = "replace"
+                            set_row_contents(C.mutableRow(i), T_row);
+                        }
+                        else /* merge */
+                        {
+                            // C[i] = [!M .* C]  U  T[i], z = "merge"
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], T_row);
+                            set_row_contents(C.mutableRow(i), C_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = C + (A +.* B') where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_Mask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType  T_row;
+                typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
+                typename LilSparseMatrix<CScalarT>::RowType     C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        bool const complement_flag = false;  /// @todo constexpr?
+                        T_row.clear();
+
+                        if (!A[i].empty() && !M[i].empty())
+                        {
+                            auto const &M_i(M[i]);
+                            auto m_it(M_i.begin());
+
+                            // Compute: T[i] = M[i] .* {C[i] + (A +.* B')[i]}
+                            auto const &A_i(A[i]);
+                            B.forEachRow([&](IndexType j, auto const &B_j)
+                            {
+                                // See if M[i] allows write.
+                                if (!advance_and_check_mask_iterator(
+                                        m_it, M_i.end(), structure_flag, j))
+                                {
+                                    return;
+                                }
+
+                                // Perform the dot product and accum if necessary
+                                TScalarType t_ij;
+                                if (dot(t_ij, A_i, B_j, semiring))
+                                {
+                                    T_row.emplace_back(j, t_ij);
+                                }
+                            });
+                        }
+
+                        // Z[i] = (M .* C) + T[i]
+                        Z_row.clear();
+                        masked_accum(Z_row,
+                                     M[i], structure_flag, complement_flag,
+                                     accum, C[i], T_row);
+
+                        if (outp == REPLACE)
+                        {
+                            set_row_contents(C.mutableRow(i), Z_row);
+                        }
+                        else /* merge */
+                        {
+                            // C[i] := (!M[i] .* C[i])  U  Z[i]
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], Z_row);
+                            set_row_contents(C.mutableRow(i), C_row);  // set even if it is empty.
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = (A +.* B') where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_CompMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        bool const complement_flag = true;
+
+                        T_row.clear();
+
+                        // T[i] = !M[i] .* (A[i] dot B[j])
+                        if (!A[i].empty()) // && !M[i].empty()) cannot do mask shortcut
+                        {
+                            auto const &M_i(M[i]);
+                            auto M_iter(M_i.begin());
+                            auto const &A_i(A[i]);
+                            B.forEachRow([&](IndexType j, auto const &B_j)
+                            {
+                                if (advance_and_check_mask_iterator(
+                                        M_iter, M_i.end(), structure_flag, j))
+                                    return;
+
+                                // Perform the dot product
+                                TScalarType t_ij;
+                                if (dot(t_ij, A_i, B_j, semiring))
+                                {
+                                    T_row.emplace_back(j, t_ij);
+                                }
+                            });
+                        }
+
+                        if (outp == REPLACE)
+                        {
+                            // C[i] = T[i], z = "replace"
+                            set_row_contents(C.mutableRow(i), T_row);
+                        }
+                        else /* merge */
+                        {
+                            // C[i] = [M .* C]  U  T[i], z = "merge"
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], T_row);
+                            set_row_contents(C.mutableRow(i), C_row);
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = C + (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_CompMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            C.setHypersparse(false);
+            auto row_bounds(partition_rows_by_nnz(A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                typename LilSparseMatrix<TScalarType>::RowType T_row;
+                typename LilSparseMatrix<ZScalarType>::RowType Z_row;
+                typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        bool const complement_flag = true;
+
+                        T_row.clear();
+
+                        if (!A[i].empty()) // && !M[i].empty()) cannot do mask shortcut
+                        {
+                            auto const &M_i(M[i]);
+                            auto m_it(M_i.begin());
+
+                            // Compute: T[i] = M[i] .* {C[i] + (A +.* B')[i]}
+                            auto const &A_i(A[i]);
+                            B.forEachRow([&](IndexType j, auto const &B_j)
+                            {
+                                // See if M[i] allows write.
+                                if (advance_and_check_mask_iterator(
+                                        m_it, M_i.end(), structure_flag, j))
+                                {
+                                    return;
+                                }
+
+                                // Perform the dot product and accum if necessary
+                                TScalarType t_ij;
+                                if (dot(t_ij, A_i, B_j, semiring))
+                                {
+                                    T_row.emplace_back(j, t_ij);
+                                }
+                            });
+                        }
+
+                        // Z[i] = (M .* C) + T[i]
+                        Z_row.clear();
+                        masked_accum(Z_row,
+                                     M[i], structure_flag, complement_flag,
+                                     accum, C[i], T_row);
+
+
+                        if (outp == REPLACE)
+                        {
+                            set_row_contents(C.mutableRow(i), Z_row);
+                        }
+                        else /* merge */
+                        {
+                            // T[i] := (M[i] .* C[i])  U  Z[i]
+                            C_row.clear();
+                            masked_merge(C_row,
+                                         M[i], structure_flag, complement_flag,
+                                         C[i], Z_row);
+                            set_row_contents(C.mutableRow(i), C_row);  // set even if it is empty.
+                        }
+                    }
+                }
+            }
+
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        // A' * B
+        //**********************************************************************
+
+        // The A'*B kernels first form the rows of A' (O(nnz(A))) so that each
+        // row of T can be computed independently with a row accumulator:
+        // T[i] = A'[i] +.* B.  Row i of A' lists k in increasing order, so
+        // the products are reduced in the same order as scattering
+        // a_ki*B[k] into T[i] for k = 0, 1, ...  Rows of T are written only
+        // by the thread that owns them (T is switched out of hypersparse
+        // storage first, which cannot insert rows concurrently).
+
+        //**********************************************************************
+        // Perform T = A'*B where T, A and B must all be unique
+        template<typename TScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATB_NoMask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            auto const AT(ATB_transpose(A));
+            T.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(AT, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                SparseAccumulator<TScalarT> spa(B.ncols());
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        if (AT[i].empty()) continue;
+
+                        // T[i] = A'[i] +.* B  // must reduce in D3, hence T.
+                        spa_axpy_row(T.mutableRow(i), spa, semiring, AT[i], B);
+                    }
+                }
+            }
+        }
+
+        //**********************************************************************
+        // Perform T<M> = A'*B where T, A and B must all be unique
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATB_Mask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            auto const AT(ATB_transpose(A));
+            T.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(AT, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                SparseAccumulator<TScalarT> spa(B.ncols());
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        if (AT[i].empty() || M[i].empty()) continue;
+
+                        // T[i] = M[i] .* (A'[i] +.* B)  // must reduce in D3, hence T.
+                        spa_masked_axpy_row(T.mutableRow(i), spa,
+                                            M[i], structure_flag, false,
+                                            semiring, AT[i], B);
+                    }
+                }
+            }
+        }
+
+        //**********************************************************************
+        // Perform T<!M> = A'*B where T, A and B must all be unique
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATB_CompMask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            auto const AT(ATB_transpose(A));
+            T.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(AT, B));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                SparseAccumulator<TScalarT> spa(B.ncols());
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        if (AT[i].empty()) continue;
+
+                        // T[i] = !M[i] .* (A'[i] +.* B)  // must reduce in D3, hence T.
+                        spa_masked_axpy_row(T.mutableRow(i), spa,
+                                            M[i], structure_flag, true,
+                                            semiring, AT[i], B);
+                    }
+                }
+            }
+        }
+
+        //**********************************************************************
+        // A' * B'
+        //**********************************************************************
+
+        //**********************************************************************
+        // Compute T<!M> = (A'*B') = (B*A)', assuming T, B, and A are unique.
+        // Row i of B*A is column i of T, so the complemented mask is applied
+        // from the corresponding column of M: masked locations are skipped
+        // during accumulation and never computed.
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATBT_CompMask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            // MT[i] = M(:,i)
+            LilSparseMatrix<MScalarT> MT(M.ncols(), M.nrows());
+            for_each_row_union([&](IndexType j)
+            {
+                for (auto&& [i, m_ji] : M[j])
+                {
+                    MT.mutableRow(i).emplace_back(j, m_ji);
+                }
+            }, M);
+
+            // TT[i] = !M'[i] .* (B[i] +.* A), rows computed in parallel
+            LilSparseMatrix<TScalarT> TT(B.nrows(), A.ncols());
+            TT.setHypersparse(false);
+            MT.setHypersparse(false);
+            auto row_bounds(partition_rows_by_flops(B, A));
+            IndexType num_parts(row_bounds.size() - 1);
+
+#pragma omp parallel
+            {
+                SparseAccumulator<TScalarT> spa(A.ncols());
+
+#pragma omp for schedule(dynamic, 1)
+                for (IndexType part = 0; part < num_parts; ++part)
+                {
+                    for (IndexType i = row_bounds[part];
+                         i < row_bounds[part + 1]; ++i)
+                    {
+                        if (B[i].empty()) continue;
+
+                        // must reduce in D3
+                        spa_masked_axpy_row(TT.mutableRow(i), spa,
+                                            MT[i], structure_flag, true,
+                                            semiring, B[i], A);
+                    }
+                }
+            }
+
+            // T = TT'
+            for_each_row_union([&](IndexType i)
+            {
+                for (auto&& [j, t_ji] : TT[i])
+                {
+                    T.mutableRow(j).emplace_back(i, t_ji);
+                }
+            }, TT);
+        }
+
+    } // backend
+} // grb
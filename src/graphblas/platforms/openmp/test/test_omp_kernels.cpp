@@ -0,0 +1,246 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+#include <list>
+#include <omp.h>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE omp_kernels_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    // Deterministic, unevenly loaded test matrix: row i has roughly
+    // (i % 17) stored values.
+    Matrix<double> make_skewed_matrix(IndexType nrows, IndexType ncols)
+    {
+        IndexArrayType rows, cols;
+        std::vector<double> vals;
+        for (IndexType i = 0; i < nrows; ++i)
+        {
+            for (IndexType k = 0; k < (i % 17); ++k)
+            {
+                rows.push_back(i);
+                cols.push_back((i*7 + k*13) % ncols);
+                vals.push_back(static_cast<double>((i + k) % 5 + 1));
+            }
+        }
+        Matrix<double> A(nrows, ncols);
+        A.build(rows, cols, vals, Plus<double>());
+        return A;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(partition_rows_covers_all_rows)
+{
+    IndexType const N = 1000;
+    auto bounds = backend::partition_rows_by_weight(
+        N, [](IndexType i) { return (i < 10) ? 10000UL : 0UL; });
+
+    BOOST_REQUIRE_GE(bounds.size(), 2UL);
+    BOOST_CHECK_EQUAL(bounds.front(), 0UL);
+    BOOST_CHECK_EQUAL(bounds.back(), N);
+    for (IndexType p = 1; p < bounds.size(); ++p)
+    {
+        BOOST_CHECK_LE(bounds[p - 1], bounds[p]);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(partition_rows_empty_matrix)
+{
+    auto bounds = backend::partition_rows_by_weight(
+        0, [](IndexType) { return 0UL; });
+
+    BOOST_REQUIRE_EQUAL(bounds.size(), 2UL);
+    BOOST_CHECK_EQUAL(bounds[0], 0UL);
+    BOOST_CHECK_EQUAL(bounds[1], 0UL);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mxm_thread_count_independent)
+{
+    IndexType const N = 300;
+    Matrix<double> A(make_skewed_matrix(N, N));
+    Matrix<double> M(make_skewed_matrix(N, N));
+
+    int num_threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    Matrix<double> C1(N, N), C1t(N, N), C1m(N, N), C1c(N, N);
+    mxm(C1,  NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    mxm(C1t, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+    mxm(C1m, M, Plus<double>(), ArithmeticSemiring<double>(), A, A, MERGE);
+    mxm(C1c, complement(M), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A), REPLACE);
+
+    omp_set_num_threads(4);
+    Matrix<double> C4(N, N), C4t(N, N), C4m(N, N), C4c(N, N);
+    mxm(C4,  NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    mxm(C4t, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+    mxm(C4m, M, Plus<double>(), ArithmeticSemiring<double>(), A, A, MERGE);
+    mxm(C4c, complement(M), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A), REPLACE);
+
+    omp_set_num_threads(num_threads);
+
+    BOOST_CHECK_EQUAL(C1, C4);
+    BOOST_CHECK_EQUAL(C1t, C4t);
+    BOOST_CHECK_EQUAL(C1m, C4m);
+    BOOST_CHECK_EQUAL(C1c, C4c);
+    BOOST_CHECK_EQUAL(C1.nvals(), C4.nvals());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mxv_vxm_thread_count_independent)
+{
+    IndexType const N = 300;
+    Matrix<double> A(make_skewed_matrix(N, N));
+    Vector<double> u(N);
+    for (IndexType i = 0; i < N; i += 3)
+    {
+        u.setElement(i, static_cast<double>(i % 7 + 1));
+    }
+
+    int num_threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    Vector<double> w1(N), w1t(N), v1(N), v1t(N);
+    mxv(w1,  NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    mxv(w1t, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        transpose(A), u);
+    vxm(v1,  NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, A);
+    vxm(v1t, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        u, transpose(A));
+
+    omp_set_num_threads(4);
+    Vector<double> w4(N), w4t(N), v4(N), v4t(N);
+    mxv(w4,  NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    mxv(w4t, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        transpose(A), u);
+    vxm(v4,  NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, A);
+    vxm(v4t, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        u, transpose(A));
+
+    omp_set_num_threads(num_threads);
+
+    BOOST_CHECK_EQUAL(w1, w4);
+    BOOST_CHECK_EQUAL(w1t, w4t);
+    BOOST_CHECK_EQUAL(v1, v4);
+    BOOST_CHECK_EQUAL(v1t, v4t);
+    BOOST_CHECK_EQUAL(w1t, v1);
+}
+
+//****************************************************************************
+// Gathers with AllIndices and with index sequences that are not random
+// access, split over several threads
+BOOST_AUTO_TEST_CASE(vector_extract_thread_count_independent)
+{
+    IndexType const N = 1000;
+    Vector<double> u(N);
+    for (IndexType i = 0; i < N; i += 3)
+    {
+        u.setElement(i, static_cast<double>(i % 7 + 1));
+    }
+
+    IndexArrayType      rev_indices;
+    std::list<IndexType> list_indices;
+    Vector<double>      rev_ans(N);
+    for (IndexType k = 0; k < N; ++k)
+    {
+        rev_indices.push_back(N - 1 - k);
+        list_indices.push_back(N - 1 - k);
+        if ((N - 1 - k) % 3 == 0)
+        {
+            rev_ans.setElement(k, static_cast<double>((N - 1 - k) % 7 + 1));
+        }
+    }
+
+    int num_threads = omp_get_max_threads();
+    for (int threads : {1, 4})
+    {
+        omp_set_num_threads(threads);
+
+        Vector<double> w_all(N), w_rev(N), w_list(N);
+        extract(w_all, NoMask(), NoAccumulate(), u, AllIndices());
+        extract(w_rev, NoMask(), NoAccumulate(), u, rev_indices);
+        extract(w_list, NoMask(), NoAccumulate(), u, list_indices);
+
+        BOOST_CHECK_EQUAL(w_all, u);
+        BOOST_CHECK_EQUAL(w_rev, rev_ans);
+        BOOST_CHECK_EQUAL(w_list, rev_ans);
+    }
+    omp_set_num_threads(num_threads);
+}
+
+//****************************************************************************
+// Row dot products over a hypersparse matrix visit only its stored rows
+BOOST_AUTO_TEST_CASE(mxv_vxm_hypersparse)
+{
+    IndexType const N = 64*1024;
+    IndexArrayType      i = {5, 5, 4000, 60000};
+    IndexArrayType      j = {1, 60000, 2, 60000};
+    std::vector<double> v = {1, 2, 3, 4};
+    Matrix<double> A(N, N);
+    A.build(i, j, v);
+    BOOST_CHECK(get_internal_matrix(A).hypersparse());
+
+    Vector<double> u(N);
+    u.setElement(1, 10.);
+    u.setElement(60000, 100.);
+
+    Vector<double> ans(N);
+    ans.setElement(5, 210.);
+    ans.setElement(60000, 400.);
+
+    int num_threads = omp_get_max_threads();
+    for (int threads : {1, 4})
+    {
+        omp_set_num_threads(threads);
+
+        Vector<double> w(N), wt(N);
+        mxv(w, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+        vxm(wt, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+            u, transpose(A));
+        BOOST_CHECK_EQUAL(w, ans);
+        BOOST_CHECK_EQUAL(wt, ans);
+    }
+    omp_set_num_threads(num_threads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
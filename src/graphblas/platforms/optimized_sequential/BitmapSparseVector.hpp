@@ -29,15 +29,34 @@
 
 #include <iostream>
 #include <vector>
+#include <tuple>
+#include <iterator>
 #include <typeinfo>
 #include <numeric>
+#include <utility>
+#include <algorithm>
 
 namespace grb
 {
     namespace backend
     {
         /**
-         * @brief Class representing a sparse vector by using a bitmap + dense vector
+         * @brief Class representing a sparse vector with two interchangeable
+         *        storage formats:
+         *
+         * - sparse list: sorted index and value arrays, O(nvals) storage and
+         *   O(nvals) traversal.  Used for vectors with few stored values
+         *   (e.g., BFS/SSSP frontiers).
+         * - bitmap: a dense value array plus a bitmap, O(size) storage with
+         *   O(1) random access and update.  Used for dense-ish vectors.
+         *
+         * The format is chosen automatically from the density: setElement()
+         * switches to bitmap when nvals exceeds size/SPARSE_DIVISOR, and
+         * setContents(), build() and clear() pick the format from the final
+         * number of stored values.  The dense arrays are kept allocated (but
+         * not maintained) while in sparse format and are reset when next
+         * converted to, which costs O(size) but only happens when nvals is
+         * proportional to size.
          */
         template<typename ScalarT>
         class BitmapSparseVector
@@ -45,20 +64,9 @@ namespace grb
         public:
             using ScalarType = ScalarT;
 
-            // Ambiguous with size constructor
-            // template <typename OtherVectorT>
-            // BitmapSparseVector(OtherVectorT const &rhs)
-            //     : m_size(rhs.m_size),
-            //       m_nvals(rhs.m_nvals),
-            //       m_vals(rhs.m_vals.size()),
-            //       m_bitmap(rhs.m_bitmap)
-            // {
-            //     for (size_t ix = 0; ix < rhs.m_vals.size(); ++ix)
-            //     {
-            //         m_vals[ix] =
-            //             static_cast<ScalarType>(rhs.m_vals[ix]);
-            //     }
-            // }
+            /// Vectors with at most size/SPARSE_DIVISOR stored values use the
+            /// sparse list format.
+            static constexpr IndexType SPARSE_DIVISOR = 16;
 
             /**
              * @brief Construct an empty sparse vector with given size
@@ -68,8 +76,7 @@ namespace grb
             BitmapSparseVector(IndexType nsize)
                 : m_size(nsize),
                   m_nvals(0),
-                  m_vals(nsize),
-                  m_bitmap(nsize, false)
+                  m_is_sparse(true)
             {
                 if (nsize == 0)
                 {
@@ -79,7 +86,8 @@ namespace grb
 
             BitmapSparseVector(IndexType nsize, ScalarT const &value)
                 : m_size(nsize),
-                  m_nvals(0),
+                  m_nvals(nsize),
+                  m_is_sparse(false),
                   m_vals(nsize, value),
                   m_bitmap(nsize, true)
             {
@@ -95,6 +103,7 @@ namespace grb
             BitmapSparseVector(std::vector<ScalarT> const &rhs)
                 : m_size(rhs.size()),
                   m_nvals(rhs.size()),
+                  m_is_sparse(false),
                   m_vals(rhs),
                   m_bitmap(rhs.size(), true)
             {
@@ -117,23 +126,22 @@ namespace grb
                                ScalarT const              &zero)
                 : m_size(rhs.size()),
                   m_nvals(0),
-                  m_vals(rhs.size()),
-                  m_bitmap(rhs.size(), false)
+                  m_is_sparse(true)
             {
                 if (rhs.size() == 0)
                 {
                     throw InvalidValueException();
                 }
 
+                std::vector<std::tuple<IndexType, ScalarT> > contents;
                 for (IndexType idx = 0; idx < rhs.size(); ++idx)
                 {
                     if (rhs[idx] != zero)
                     {
-                        m_vals[idx] = rhs[idx];
-                        m_bitmap[idx] = true;
-                        ++m_nvals;
+                        contents.emplace_back(idx, rhs[idx]);
                     }
                 }
+                setContents(contents);
             }
 
             /**
@@ -146,22 +154,17 @@ namespace grb
                 std::vector<ScalarT>   const &values)
                 : m_size(nsize),
                   m_nvals(0),
-                  m_vals(nsize),
-                  m_bitmap(nsize, false)
+                  m_is_sparse(true)
             {
                 /// @todo check for same size indices and values
                 for (IndexType idx = 0; idx < indices.size(); ++idx)
                 {
-                    IndexType i = indices[idx];
-                    if (i >= m_size)
+                    if (indices[idx] >= m_size)
                     {
                         throw DimensionException();  // Should this be IndexOutOfBounds?
                     }
-
-                    m_vals[i] = values[idx];
-                    m_bitmap[i] = true;
-                    ++m_nvals;
                 }
+                build(indices.begin(), values.begin(), indices.size());
             }
 
             /**
@@ -173,9 +176,40 @@ namespace grb
             BitmapSparseVector(BitmapSparseVector<ScalarT> const &rhs)
                 : m_size(rhs.m_size),
                   m_nvals(rhs.m_nvals),
-                  m_vals(rhs.m_vals),
-                  m_bitmap(rhs.m_bitmap)
+                  m_is_sparse(rhs.m_is_sparse),
+                  m_indices(rhs.m_indices),
+                  m_sparse_vals(rhs.m_sparse_vals)
+            {
+                if (!m_is_sparse)
+                {
+                    m_vals = rhs.m_vals;
+                    m_bitmap = rhs.m_bitmap;
+                }
+            }
+
+            /**
+             * @brief Move constructor for BitmapSparseVector.
+             *
+             * @param[in] rhs  The BitmapSparseVector to move from.  It is left
+             *                 with size zero and can only be move-assigned
+             *                 to or destroyed.
+             */
+            BitmapSparseVector(BitmapSparseVector<ScalarT> &&rhs) noexcept
+                : m_size(rhs.m_size),
+                  m_nvals(rhs.m_nvals),
+                  m_is_sparse(rhs.m_is_sparse),
+                  m_indices(std::move(rhs.m_indices)),
+                  m_sparse_vals(std::move(rhs.m_sparse_vals)),
+                  m_vals(std::move(rhs.m_vals)),
+                  m_bitmap(std::move(rhs.m_bitmap))
             {
+                rhs.m_size = 0;
+                rhs.m_nvals = 0;
+                rhs.m_is_sparse = true;
+                rhs.m_indices.clear();
+                rhs.m_sparse_vals.clear();
+                rhs.m_vals.clear();
+                rhs.m_bitmap.clear();
             }
 
             ~BitmapSparseVector() {}
@@ -198,12 +232,49 @@ namespace grb
                     }
 
                     m_nvals = rhs.m_nvals;
-                    m_vals = rhs.m_vals;
-                    m_bitmap = rhs.m_bitmap;
+                    m_is_sparse = rhs.m_is_sparse;
+                    m_indices = rhs.m_indices;
+                    m_sparse_vals = rhs.m_sparse_vals;
+                    if (!m_is_sparse)
+                    {
+                        m_vals = rhs.m_vals;
+                        m_bitmap = rhs.m_bitmap;
+                    }
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Move assignment (takes the size of rhs, which receives
+             *        the old contents of this vector).
+             *
+             * @param[in] rhs  The BitmapSparseVector to move from
+             *
+             * @return *this.
+             */
+            BitmapSparseVector<ScalarT>& operator=(
+                BitmapSparseVector<ScalarT> &&rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    swap(rhs);
                 }
                 return *this;
             }
 
+            /// O(1) exchange of contents and size
+            void swap(BitmapSparseVector<ScalarT> &rhs) noexcept
+            {
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_nvals, rhs.m_nvals);
+                std::swap(m_is_sparse, rhs.m_is_sparse);
+                std::swap(m_num_moved, rhs.m_num_moved);
+                m_indices.swap(rhs.m_indices);
+                m_sparse_vals.swap(rhs.m_sparse_vals);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+            }
+
             /**
              * @brief Assignment from a dense vector.
              *
@@ -217,12 +288,13 @@ namespace grb
                 {
                     throw DimensionException();
                 }
-                for (IndexType idx = 0; idx < rhs.size(); ++idx)
-                {
-                    m_vals[idx] = rhs[idx];
-                    m_bitmap[idx] = true;
-                }
+
+                m_vals = rhs;
+                m_bitmap.assign(m_size, true);
                 m_nvals = m_size;
+                m_is_sparse = false;
+                m_indices.clear();
+                m_sparse_vals.clear();
                 return *this;
             }
 
@@ -239,21 +311,41 @@ namespace grb
                     return false;
                 }
 
-                for (IndexType i = 0; i < m_size; ++i)
+                if (m_is_sparse && rhs.m_is_sparse)
                 {
-                    if (m_bitmap[i] != rhs.m_bitmap[i])
-                    {
-                        return false;
-                    }
-                    if (m_bitmap[i])
+                    return ((m_indices == rhs.m_indices) &&
+                            (m_sparse_vals == rhs.m_sparse_vals));
+                }
+                else if (!m_is_sparse && !rhs.m_is_sparse)
+                {
+                    for (IndexType i = 0; i < m_size; ++i)
                     {
-                        if (m_vals[i] != rhs.m_vals[i])
+                        if (m_bitmap[i] != rhs.m_bitmap[i])
                         {
                             return false;
                         }
+                        if (m_bitmap[i])
+                        {
+                            if (m_vals[i] != rhs.m_vals[i])
+                            {
+                                return false;
+                            }
+                        }
                     }
+                    return true;
                 }
 
+                // mixed formats: check the sparse one against the bitmap
+                BitmapSparseVector<ScalarT> const &sp(m_is_sparse ? *this : rhs);
+                BitmapSparseVector<ScalarT> const &bm(m_is_sparse ? rhs : *this);
+                for (IndexType ix = 0; ix < sp.m_indices.size(); ++ix)
+                {
+                    IndexType idx(sp.m_indices[ix]);
+                    if (!bm.m_bitmap[idx] || (bm.m_vals[idx] != sp.m_sparse_vals[ix]))
+                    {
+                        return false;
+                    }
+                }
                 return true;
             }
 
@@ -269,16 +361,24 @@ namespace grb
 
             // METHODS
 
+            /// O(nvals) in sparse format; the dense arrays are left as is
+            /// and reset on the next conversion to bitmap format.
             void clear()
             {
                 m_nvals = 0;
-                //m_vals.clear();
-                m_bitmap.assign(m_size, false);
+                m_is_sparse = true;
+                m_num_moved = 0;
+                m_indices.clear();
+                m_sparse_vals.clear();
             }
 
             IndexType size() const { return m_size; }
             IndexType nvals() const { return m_nvals; }
 
+            /// @return true if the values are currently stored in the sparse
+            ///         list format (false for bitmap format).
+            bool isSparse() const { return m_is_sparse; }
+
             /**
              * @brief Resize the vector (smaller or larger)
              *
@@ -291,6 +391,21 @@ namespace grb
                 //if (nsize == 0)
                 //   throw InvalidValueException();
 
+                if (m_is_sparse)
+                {
+                    if (new_size < m_size)
+                    {
+                        auto it(std::lower_bound(m_indices.begin(),
+                                                 m_indices.end(), new_size));
+                        IndexType num_left(it - m_indices.begin());
+                        m_indices.resize(num_left);
+                        m_sparse_vals.resize(num_left);
+                        m_nvals = num_left;
+                    }
+                    m_size = new_size;
+                    return;
+                }
+
                 if (new_size < m_size)
                 {
                     m_size = new_size;
@@ -338,18 +453,67 @@ namespace grb
                        IndexType     nvals,
                        BinaryOpT     dup = BinaryOpT())
             {
+                for (IndexType idx = 0; idx < nvals; ++idx)
+                {
+                    if (i_it[idx] >= m_size)
+                    {
+                        throw IndexOutOfBoundsException();
+                    }
+                }
+
+                // Few values: O(nvals log nvals) sort into the sparse list
+                // format, independent of the size of the vector.
+                if (nvals * SPARSE_DIVISOR <= m_size)
+                {
+                    std::vector<std::tuple<IndexType, ScalarT> > tuples;
+                    tuples.reserve(nvals);
+                    bool input_sorted(true);
+                    for (IndexType idx = 0; idx < nvals; ++idx)
+                    {
+                        if ((idx > 0) && (i_it[idx] < i_it[idx - 1]))
+                        {
+                            input_sorted = false;
+                        }
+                        tuples.emplace_back(i_it[idx], v_it[idx]);
+                    }
+
+                    if (!input_sorted)
+                    {
+                        // stable so that dup is applied in input order
+                        std::stable_sort(
+                            tuples.begin(), tuples.end(),
+                            [](auto const &a, auto const &b)
+                            { return std::get<0>(a) < std::get<0>(b); });
+                    }
+
+                    m_indices.clear();
+                    m_sparse_vals.clear();
+                    for (auto&& [idx, val] : tuples)
+                    {
+                        if (!m_indices.empty() && (m_indices.back() == idx))
+                        {
+                            m_sparse_vals.back() = dup(m_sparse_vals.back(), val);
+                        }
+                        else
+                        {
+                            m_indices.push_back(idx);
+                            m_sparse_vals.push_back(val);
+                        }
+                    }
+                    m_nvals = m_indices.size();
+                    m_is_sparse = true;
+                    m_num_moved = 0;
+                    return;
+                }
+
                 std::vector<ScalarType> vals(m_size);
                 std::vector<bool> bitmap(m_size);
+                IndexType num_stored(0);
 
                 /// @todo check for same size indices and values
                 for (IndexType idx = 0; idx < nvals; ++idx)
                 {
                     IndexType i = i_it[idx];
-                    if (i >= m_size)
-                    {
-                        throw IndexOutOfBoundsException();
-                    }
-
                     if (bitmap[i] == true)
                     {
                         vals[i] = dup(vals[i], v_it[idx]);
@@ -358,12 +522,21 @@ namespace grb
                     {
                         vals[i] = v_it[idx];
                         bitmap[i] = true;
+                        ++num_stored;
                     }
                 }
 
                 m_vals.swap(vals);
                 m_bitmap.swap(bitmap);
-                m_nvals = nvals;
+                m_nvals = num_stored;
+                m_is_sparse = false;
+                m_indices.clear();
+                m_sparse_vals.clear();
+
+                if (m_nvals * SPARSE_DIVISOR <= m_size)
+                {
+                    to_sparse();
+                }
             }
 
             bool hasElement(IndexType index) const
@@ -373,6 +546,11 @@ namespace grb
                     throw IndexOutOfBoundsException();
                 }
 
+                if (m_is_sparse)
+                {
+                    return std::binary_search(m_indices.begin(),
+                                              m_indices.end(), index);
+                }
                 return m_bitmap[index];
             }
 
@@ -394,6 +572,17 @@ namespace grb
                     throw IndexOutOfBoundsException();
                 }
 
+                if (m_is_sparse)
+                {
+                    auto it(std::lower_bound(m_indices.begin(),
+                                             m_indices.end(), index));
+                    if ((it == m_indices.end()) || (*it != index))
+                    {
+                        throw NoValueException();
+                    }
+                    return m_sparse_vals[it - m_indices.begin()];
+                }
+
                 if (m_bitmap[index] == false)
                 {
                     throw NoValueException();
@@ -402,6 +591,35 @@ namespace grb
                 return m_vals[index];
             }
 
+            /**
+             * @brief Unchecked lookup for the parallel kernels: the caller
+             *        guarantees index < size().  Never throws, so it can be
+             *        used inside an OpenMP region.
+             *
+             * @return true (with the value in val) if the element is stored.
+             */
+            bool lookupElement(IndexType index, ScalarT &val) const
+            {
+                if (m_is_sparse)
+                {
+                    auto it(std::lower_bound(m_indices.begin(),
+                                             m_indices.end(), index));
+                    if ((it == m_indices.end()) || (*it != index))
+                    {
+                        return false;
+                    }
+                    val = m_sparse_vals[it - m_indices.begin()];
+                    return true;
+                }
+
+                if (!m_bitmap[index])
+                {
+                    return false;
+                }
+                val = m_vals[index];
+                return true;
+            }
+
             /// @todo Not certain about this implementation
             void setElement(IndexType      index,
                             ScalarT const &new_val)
@@ -410,6 +628,39 @@ namespace grb
                 {
                     throw IndexOutOfBoundsException();
                 }
+
+                if (m_is_sparse)
+                {
+                    auto it(std::lower_bound(m_indices.begin(),
+                                             m_indices.end(), index));
+                    IndexType pos(it - m_indices.begin());
+                    if ((it != m_indices.end()) && (*it == index))
+                    {
+                        m_sparse_vals[pos] = new_val;
+                        return;
+                    }
+
+                    // Inserts before the end shift the tail of the list: once
+                    // the shifting adds up to a full pass over the vector
+                    // (e.g. filling it in random order), switch to bitmap.
+                    IndexType num_moved(m_indices.end() - it);
+                    if (m_num_moved + num_moved <= m_size)
+                    {
+                        m_num_moved += num_moved;
+                        m_indices.insert(it, index);
+                        m_sparse_vals.insert(m_sparse_vals.begin() + pos,
+                                             new_val);
+                        ++m_nvals;
+
+                        if (m_nvals * SPARSE_DIVISOR > m_size)
+                        {
+                            to_bitmap();
+                        }
+                        return;
+                    }
+                    to_bitmap();
+                }
+
                 m_vals[index] = new_val;
                 if (m_bitmap[index] == false)
                 {
@@ -425,6 +676,20 @@ namespace grb
                     throw IndexOutOfBoundsException();
                 }
 
+                if (m_is_sparse)
+                {
+                    auto it(std::lower_bound(m_indices.begin(),
+                                             m_indices.end(), index));
+                    if ((it != m_indices.end()) && (*it == index))
+                    {
+                        m_sparse_vals.erase(m_sparse_vals.begin() +
+                                            (it - m_indices.begin()));
+                        m_indices.erase(it);
+                        --m_nvals;
+                    }
+                    return;
+                }
+
                 if (m_bitmap[index] == true)
                 {
                     --m_nvals;
@@ -437,6 +702,16 @@ namespace grb
             void extractTuples(RAIteratorIT        i_it,
                                RAIteratorVT        v_it) const
             {
+                if (m_is_sparse)
+                {
+                    for (IndexType ix = 0; ix < m_indices.size(); ++ix)
+                    {
+                        *i_it = m_indices[ix];     ++i_it;
+                        *v_it = m_sparse_vals[ix]; ++v_it;
+                    }
+                    return;
+                }
+
                 for (IndexType idx = 0; idx < m_size; ++idx)
                 {
                     if (m_bitmap[idx])
@@ -460,11 +735,21 @@ namespace grb
                 os << ", size  = " << m_size;
                 os << ", nvals = " << m_nvals << std::endl;
 
+                auto contents(this->contents());
+                auto it(contents.begin());
                 os << "[";
-                if (m_bitmap[0]) os << m_vals[0]; else os << "-";
-                for (IndexType idx = 1; idx < m_size; ++idx)
+                for (IndexType idx = 0; idx < m_size; ++idx)
                 {
-                    if (m_bitmap[idx]) os << ", " << m_vals[idx]; else os << ", -";
+                    if (idx > 0) os << ", ";
+                    if ((it != contents.end()) && (std::get<0>(*it) == idx))
+                    {
+                        os << std::get<1>(*it);
+                        ++it;
+                    }
+                    else
+                    {
+                        os << "-";
+                    }
                 }
                 os << "]";
             }
@@ -476,13 +761,21 @@ namespace grb
                 return os;
             }
 
-            std::vector<bool>    const &get_bitmap() const { return m_bitmap; }
-            std::vector<ScalarT> const &get_vals() const   { return m_vals; }
-
+            /// O(nvals) in sparse format, O(size) in bitmap format
             std::vector<std::tuple<IndexType,ScalarT> > getContents() const
             {
                 std::vector<std::tuple<IndexType,ScalarT> > contents;
                 contents.reserve(m_nvals);
+
+                if (m_is_sparse)
+                {
+                    for (IndexType ix = 0; ix < m_indices.size(); ++ix)
+                    {
+                        contents.emplace_back(m_indices[ix], m_sparse_vals[ix]);
+                    }
+                    return contents;
+                }
+
                 for (IndexType idx = 0; idx < m_size; ++idx)
                 {
                     if (m_bitmap[idx])
@@ -493,24 +786,210 @@ namespace grb
                 return contents;
             }
 
+            /**
+             * @brief Read-only view of the stored (index, value) pairs in
+             *        increasing index order, without copying them.
+             *
+             * Dereferencing an iterator yields a std::tuple<IndexType,ScalarT>
+             * by value, so the view can be used wherever the helpers accept
+             * the result of getContents().  Traversal is O(nvals) in sparse
+             * format; in bitmap format it stops after the last stored value.
+             *
+             * @note The view (and its iterators) are invalidated by any
+             *       modification of the vector.
+             */
+            class ContentsView
+            {
+            public:
+                class const_iterator
+                {
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type        = std::tuple<IndexType, ScalarT>;
+                    using difference_type   = std::ptrdiff_t;
+                    using pointer           = void;
+                    using reference         = value_type;
+
+                    const_iterator() = default;
+
+                    const_iterator(BitmapSparseVector const *vec,
+                                   IndexType                 pos,
+                                   IndexType                 remaining)
+                        : m_vec(vec), m_pos(pos), m_remaining(remaining)
+                    {
+                    }
+
+                    value_type operator*() const
+                    {
+                        if (m_vec->m_is_sparse)
+                        {
+                            return value_type(m_vec->m_indices[m_pos],
+                                              m_vec->m_sparse_vals[m_pos]);
+                        }
+                        return value_type(m_pos, m_vec->m_vals[m_pos]);
+                    }
+
+                    const_iterator &operator++()
+                    {
+                        ++m_pos;
+                        if (!m_vec->m_is_sparse)
+                        {
+                            // skip unset bits, but not past the last value
+                            if (--m_remaining == 0)
+                            {
+                                m_pos = m_vec->m_size;
+                            }
+                            else
+                            {
+                                while (!m_vec->m_bitmap[m_pos]) ++m_pos;
+                            }
+                        }
+                        return *this;
+                    }
+
+                    const_iterator operator++(int)
+                    {
+                        const_iterator tmp(*this);
+                        ++(*this);
+                        return tmp;
+                    }
+
+                    bool operator==(const_iterator const &rhs) const
+                    {
+                        return m_pos == rhs.m_pos;
+                    }
+
+                    bool operator!=(const_iterator const &rhs) const
+                    {
+                        return m_pos != rhs.m_pos;
+                    }
+
+                private:
+                    BitmapSparseVector const *m_vec       = nullptr;
+                    IndexType                 m_pos       = 0;
+                    IndexType                 m_remaining = 0;
+                };
+
+                explicit ContentsView(BitmapSparseVector const &vec)
+                    : m_vec(&vec)
+                {
+                }
+
+                const_iterator begin() const
+                {
+                    if (m_vec->m_nvals == 0)
+                    {
+                        return end();
+                    }
+                    if (m_vec->m_is_sparse)
+                    {
+                        return const_iterator(m_vec, 0, m_vec->m_nvals);
+                    }
+
+                    IndexType pos(0);
+                    while (!m_vec->m_bitmap[pos]) ++pos;
+                    return const_iterator(m_vec, pos, m_vec->m_nvals);
+                }
+
+                const_iterator end() const
+                {
+                    return const_iterator(
+                        m_vec,
+                        (m_vec->m_is_sparse ? m_vec->m_nvals : m_vec->m_size),
+                        0);
+                }
+
+                bool      empty() const { return m_vec->m_nvals == 0; }
+                IndexType size()  const { return m_vec->m_nvals; }
+
+            private:
+                BitmapSparseVector const *m_vec;
+            };
+
+            /// O(1): the stored values are traversed in place, use in
+            /// preference to getContents() for single pass algorithms.
+            ContentsView contents() const { return ContentsView(*this); }
+
+            /// @note contents must be sorted by index.  O(contents.size())
+            ///       when the result is sparse.
             template <typename OtherScalarT>
             void setContents(
                 std::vector<std::tuple<IndexType,OtherScalarT> > const &contents)
             {
                 clear();
+
+                if (contents.size() * SPARSE_DIVISOR <= m_size)
+                {
+                    m_indices.reserve(contents.size());
+                    m_sparse_vals.reserve(contents.size());
+                    for (auto&& [idx, val] : contents)
+                    {
+                        m_indices.push_back(idx);
+                        m_sparse_vals.push_back(static_cast<ScalarT>(val));
+                    }
+                    m_nvals = contents.size();
+                    return;
+                }
+
+                to_bitmap();
                 for (auto&& [idx, val] : contents)
                 {
                     m_bitmap[idx] = true;
                     m_vals[idx]   = static_cast<ScalarT>(val);
-                    ++m_nvals;
                 }
+                m_nvals = contents.size();
             }
 
         private:
-            IndexType             m_size;
-            IndexType             m_nvals;
-            std::vector<ScalarT>  m_vals;
-            std::vector<bool>     m_bitmap;
+            // Convert from sparse list to bitmap format: O(size)
+            void to_bitmap()
+            {
+                m_vals.resize(m_size);
+                m_bitmap.assign(m_size, false);
+                for (IndexType ix = 0; ix < m_indices.size(); ++ix)
+                {
+                    m_bitmap[m_indices[ix]] = true;
+                    m_vals[m_indices[ix]] = m_sparse_vals[ix];
+                }
+                m_indices.clear();
+                m_sparse_vals.clear();
+                m_is_sparse = false;
+                m_num_moved = 0;
+            }
+
+            // Convert from bitmap to sparse list format: O(size)
+            void to_sparse()
+            {
+                m_indices.clear();
+                m_sparse_vals.clear();
+                m_indices.reserve(m_nvals);
+                m_sparse_vals.reserve(m_nvals);
+                for (IndexType idx = 0; idx < m_size; ++idx)
+                {
+                    if (m_bitmap[idx])
+                    {
+                        m_indices.push_back(idx);
+                        m_sparse_vals.push_back(m_vals[idx]);
+                    }
+                }
+                m_is_sparse = true;
+                m_num_moved = 0;
+            }
+
+            IndexType              m_size;
+            IndexType              m_nvals;
+            bool                   m_is_sparse;
+
+            // Sparse list format (sorted by index)
+            std::vector<IndexType> m_indices;
+            std::vector<ScalarT>   m_sparse_vals;
+
+            // Elements shifted by setElement since the list was last built
+            IndexType              m_num_moved = 0;
+
+            // Bitmap format
+            std::vector<ScalarT>   m_vals;
+            std::vector<bool>      m_bitmap;
         };
     } // backend
 } // grb
@@ -29,9 +29,12 @@
 
 #include <iostream>
 #include <vector>
+#include <map>
 #include <typeinfo>
 #include <stdexcept>
 #include <algorithm>
+#include <numeric>
+#include <utility>
 
 #include <graphblas/graphblas.hpp>
 
@@ -50,12 +53,23 @@ namespace grb
             using ElementType = std::tuple<IndexType, ScalarT>;
             using RowType = std::vector<ElementType>;
 
-            // Constructor
+            // Matrices with at least HYPERSPARSE_MIN_ROWS rows may be stored
+            // hypersparse (only the non-empty rows are kept, keyed by row
+            // index) while they hold fewer than nrows/HYPERSPARSE_RATIO
+            // values, and switch back to one RowType per row once they hold
+            // more than 2*nrows/HYPERSPARSE_RATIO values.
+            static constexpr IndexType HYPERSPARSE_MIN_ROWS = 1024;
+            static constexpr IndexType HYPERSPARSE_RATIO    = 16;
+
+            // Constructor (one RowType per row: kernels fill new matrices
+            // through setRow, and filling a hypersparse matrix row by row
+            // would leave a large result in hypersparse storage)
             LilSparseMatrix(IndexType num_rows,
                             IndexType num_cols)
                 : m_num_rows(num_rows),
                   m_num_cols(num_cols),
-                  m_nvals(0)
+                  m_nvals(0),
+                  m_hypersparse(false)
             {
                 m_data.resize(m_num_rows);
             }
@@ -65,14 +79,35 @@ namespace grb
                 : m_num_rows(rhs.m_num_rows),
                   m_num_cols(rhs.m_num_cols),
                   m_nvals(rhs.m_nvals),
-                  m_data(rhs.m_data)
+                  m_hypersparse(rhs.m_hypersparse),
+                  m_data(rhs.m_data),
+                  m_hyper_rows(rhs.m_hyper_rows)
             {
             }
 
+            // Constructor - move (rhs is left with zero dimensions and can
+            // only be move-assigned to or destroyed)
+            LilSparseMatrix(LilSparseMatrix<ScalarT> &&rhs) noexcept
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_hypersparse(rhs.m_hypersparse),
+                  m_data(std::move(rhs.m_data)),
+                  m_hyper_rows(std::move(rhs.m_hyper_rows))
+            {
+                rhs.m_num_rows = 0;
+                rhs.m_num_cols = 0;
+                rhs.m_nvals = 0;
+                rhs.m_hypersparse = false;
+                rhs.m_data.clear();
+                rhs.m_hyper_rows.clear();
+            }
+
             // Constructor - dense from dense matrix
             LilSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
                 : m_num_rows(val.size()),
-                  m_num_cols(val[0].size())
+                  m_num_cols(val[0].size()),
+                  m_hypersparse(false)
             {
                 m_data.resize(m_num_rows);
                 m_nvals = 0;
@@ -95,7 +130,8 @@ namespace grb
             LilSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
                             ScalarT zero)
                 : m_num_rows(val.size()),
-                  m_num_cols(val[0].size())
+                  m_num_cols(val[0].size()),
+                  m_hypersparse(false)
             {
                 m_data.resize(m_num_rows);
                 m_nvals = 0;
@@ -115,6 +151,7 @@ namespace grb
                         }
                     }
                 }
+                chooseStorage();
             }
 
             // Destructor
@@ -134,7 +171,21 @@ namespace grb
                     }
 
                     m_nvals = rhs.m_nvals;
+                    m_hypersparse = rhs.m_hypersparse;
                     m_data = rhs.m_data;
+                    m_hyper_rows = rhs.m_hyper_rows;
+                }
+                return *this;
+            }
+
+            // Assignment - move (unlike copy, no dimension check: takes the
+            // dimensions of rhs, which receives the old contents of this matrix)
+            LilSparseMatrix<ScalarT> &operator=(
+                LilSparseMatrix<ScalarT> &&rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    swap(rhs);
                 }
                 return *this;
             }
@@ -147,10 +198,24 @@ namespace grb
              */
             bool operator==(LilSparseMatrix<ScalarT> const &rhs) const
             {
-                return ((m_num_rows == rhs.m_num_rows) &&
-                        (m_num_cols == rhs.m_num_cols) &&
-                        (m_nvals == rhs.m_nvals) &&
-                        (m_data == rhs.m_data));
+                if ((m_num_rows != rhs.m_num_rows) ||
+                    (m_num_cols != rhs.m_num_cols) ||
+                    (m_nvals != rhs.m_nvals))
+                {
+                    return false;
+                }
+
+                if (!m_hypersparse && !rhs.m_hypersparse)
+                {
+                    return (m_data == rhs.m_data);
+                }
+
+                // Same number of stored values, so it is enough to check
+                // that every non-empty row of this matrix matches rhs.
+                bool equal(true);
+                forEachRow([&](IndexType row_idx, RowType const &row)
+                           { equal = equal && (row == rhs[row_idx]); });
+                return equal;
             }
 
             /**
@@ -178,21 +243,161 @@ namespace grb
                 /// @todo should this function call clear?
                 //clear();
 
-                /// @todo DOING SOMETHING REALLY STUPID RIGHT NOW
+                // Bulk build: O(n log n) instead of one O(row length)
+                // setElement per tuple.  The results are the same as calling
+                // setElement(i, j, v, dup) for each tuple in order: values
+                // at the same location (including already stored ones) are
+                // combined with dup in input order.
+                bool input_sorted(true);
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    if ((i_it[ix] >= m_num_rows) || (j_it[ix] >= m_num_cols))
+                    {
+                        throw IndexOutOfBoundsException(
+                            "build: index out of bounds");
+                    }
+
+                    if ((ix > 0) &&
+                        ((i_it[ix] < i_it[ix - 1]) ||
+                         ((i_it[ix] == i_it[ix - 1]) &&
+                          (j_it[ix] < j_it[ix - 1]))))
+                    {
+                        input_sorted = false;
+                    }
+                }
+
+                // Few tuples for a hypersparse matrix: sort them by (row,
+                // col) instead of counting them into O(nrows) row offsets.
+                if (m_hypersparse && preferHypersparse(m_num_rows, m_nvals + n))
+                {
+                    std::vector<IndexType> perm(n);
+                    std::iota(perm.begin(), perm.end(), 0UL);
+                    if (!input_sorted)
+                    {
+                        // stable so duplicates keep input order
+                        std::stable_sort(
+                            perm.begin(), perm.end(),
+                            [&](IndexType a, IndexType b)
+                            { return ((i_it[a] < i_it[b]) ||
+                                      ((i_it[a] == i_it[b]) &&
+                                       (j_it[a] < j_it[b]))); });
+                    }
+
+                    RowType tuples;
+                    tuples.reserve(n);
+                    for (auto ix : perm)
+                    {
+                        tuples.emplace_back(j_it[ix],
+                                            static_cast<ScalarT>(v_it[ix]));
+                    }
+
+                    IndexType nvals_added(0);
+                    IndexType last(0);
+                    for (IndexType first = 0; first < n; first = last)
+                    {
+                        IndexType irow(i_it[perm[first]]);
+                        for (last = first + 1;
+                             (last < n) && (i_it[perm[last]] == irow);
+                             ++last)
+                        {
+                        }
+
+                        RowType &row(m_hyper_rows[irow]);
+                        IndexType old_size(row.size());
+                        buildRow(row, tuples.begin() + first,
+                                 tuples.begin() + last, dup);
+                        nvals_added += row.size() - old_size;
+                    }
+                    m_nvals += nvals_added;
+                    return;
+                }
+                setHypersparse(false);
+
+                // row_ptr[i] is the offset of row i's tuples in 'tuples'
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0UL);
                 for (IndexType ix = 0; ix < n; ++ix)
                 {
-                    setElement(*i_it, *j_it, *v_it, dup);
-                    ++i_it; ++j_it; ++v_it;
+                    ++row_ptr[i_it[ix] + 1];
+                }
+                for (IndexType irow = 0; irow < m_num_rows; ++irow)
+                {
+                    row_ptr[irow + 1] += row_ptr[irow];
+                }
+
+                RowType tuples;
+                if (input_sorted)
+                {
+                    // fast path: tuples are already grouped by row and
+                    // ordered by column within each row
+                    tuples.reserve(n);
+                    for (IndexType ix = 0; ix < n; ++ix)
+                    {
+                        tuples.emplace_back(j_it[ix],
+                                            static_cast<ScalarT>(v_it[ix]));
+                    }
+                }
+                else
+                {
+                    // counting sort by row (stable), then sort each row by
+                    // column (stable so duplicates keep input order)
+                    tuples.resize(n);
+                    std::vector<IndexType> pos(row_ptr.begin(),
+                                               row_ptr.end() - 1);
+                    for (IndexType ix = 0; ix < n; ++ix)
+                    {
+                        tuples[pos[i_it[ix]]++] =
+                            std::make_tuple(IndexType(j_it[ix]),
+                                            static_cast<ScalarT>(v_it[ix]));
+                    }
+                }
+
+                // rows are independent (built concurrently by the openmp
+                // platform)
+                IndexType nvals_added(0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:nvals_added)
+#endif
+                for (IndexType irow = 0; irow < m_num_rows; ++irow)
+                {
+                    if (row_ptr[irow] == row_ptr[irow + 1]) continue;
+
+                    auto first(tuples.begin() + row_ptr[irow]);
+                    auto last(tuples.begin() + row_ptr[irow + 1]);
+                    if (!input_sorted)
+                    {
+                        std::stable_sort(
+                            first, last,
+                            [](ElementType const &a, ElementType const &b)
+                            { return std::get<0>(a) < std::get<0>(b); });
+                    }
+
+                    IndexType old_size(m_data[irow].size());
+                    buildRow(m_data[irow], first, last, dup);
+                    nvals_added += m_data[irow].size() - old_size;
                 }
+                m_nvals += nvals_added;
+                chooseStorage();
             }
 
             void clear()
             {
                 /// @todo make atomic? transactional?
                 m_nvals = 0;
-                for (IndexType row = 0; row < m_data.size(); ++row)
+                if (m_hypersparse)
+                {
+                    m_hyper_rows.clear();
+                }
+                else if (preferHypersparse(m_num_rows, 0))
                 {
-                    m_data[row].clear();
+                    std::vector<RowType>().swap(m_data);
+                    m_hypersparse = true;
+                }
+                else
+                {
+                    for (IndexType row = 0; row < m_data.size(); ++row)
+                    {
+                        m_data[row].clear();
+                    }
                 }
             }
 
@@ -215,14 +420,22 @@ namespace grb
 
                 // *******************************************
                 // Step 1: Deal with number of rows
-                m_data.resize(new_num_rows);
+                if (m_hypersparse)
+                {
+                    m_hyper_rows.erase(m_hyper_rows.lower_bound(new_num_rows),
+                                       m_hyper_rows.end());
+                }
+                else
+                {
+                    m_data.resize(new_num_rows);
+                }
 
                 // Count how many elements are left when num_rows reduces
                 if (new_num_rows < m_num_rows)
                 {
                     m_nvals = 0UL;
-                    for (auto const &row : m_data)
-                        m_nvals += row.size();
+                    forEachRow([&](IndexType, RowType const &row)
+                               { m_nvals += row.size(); });
                 }
                 m_num_rows = new_num_rows;
 
@@ -233,26 +446,25 @@ namespace grb
                 {
                     // Need to eliminate any entries beyond new limit
                     // when decreasing
-                    for (auto &row : m_data)
+                    forEachRow([&](IndexType, RowType &row)
                     {
-                        if (!row.empty())
+                        auto it(row.begin());
+                        for ( ; ((it != row.end()) &&
+                                 (std::get<0>(*it) < new_num_cols)); ++it)
                         {
-                            auto it(row.begin());
-                            for ( ; ((it != row.end()) &&
-                                     (std::get<0>(*it) < new_num_cols)); ++it)
-                            {
-                            }
+                        }
 
-                            if (it != row.end())
-                            {
-                                IndexType nval(row.size());
-                                row.erase(it, row.end());
-                                m_nvals -= (nval - row.size()); // adjust nvals
-                            }
+                        if (it != row.end())
+                        {
+                            IndexType nval(row.size());
+                            row.erase(it, row.end());
+                            m_nvals -= (nval - row.size()); // adjust nvals
                         }
-                    }
+                    });
                 }
                 m_num_cols = new_num_cols;
+
+                chooseStorage();
             }
 
             bool hasElement(IndexType irow, IndexType icol) const
@@ -262,16 +474,8 @@ namespace grb
                     throw IndexOutOfBoundsException(
                         "get_value_at: index out of bounds");
                 }
-                if (m_data.empty())
-                {
-                    return false;
-                }
-                if (m_data[irow].empty())
-                {
-                    return false;
-                }
 
-                for (auto tupl : m_data[irow])// Range-based loop, access by value
+                for (auto tupl : (*this)[irow])// Range-based loop, access by value
                 {
                     if (std::get<0>(tupl) == icol)
                     {
@@ -289,16 +493,14 @@ namespace grb
                     throw IndexOutOfBoundsException(
                         "extractElement: index out of bounds");
                 }
-                if (m_data.empty())
-                {
-                    throw NoValueException("extractElement: no data");
-                }
-                if (m_data[irow].empty())
+
+                RowType const &row((*this)[irow]);
+                if (row.empty())
                 {
                     throw NoValueException("extractElement: no data in row");
                 }
 
-                for (auto&& [idx, val] : m_data[irow])
+                for (auto&& [idx, val] : row)
                 {
                     if (idx == icol)
                     {
@@ -311,22 +513,20 @@ namespace grb
             // Set value at index
             void setElement(IndexType irow, IndexType icol, ScalarT const &val)
             {
-                //m_data[irow].reserve(m_data[irow].capacity() + 10);
                 if (irow >= m_num_rows || icol >= m_num_cols)
                 {
                     throw IndexOutOfBoundsException("setElement: index out of bounds");
                 }
 
-                if (m_data[irow].empty())
+                RowType &row(mutableRow(irow));
+                if (row.empty())
                 {
-                    m_data[irow].emplace_back(icol, val);
+                    row.emplace_back(icol, val);
                     ++m_nvals;
                 }
                 else
                 {
-                    for (auto it = m_data[irow].begin();
-                         it != m_data[irow].end();
-                         ++it)
+                    for (auto it = row.begin(); it != row.end(); ++it)
                     {
                         if (std::get<0>(*it) == icol)
                         {
@@ -336,12 +536,12 @@ namespace grb
                         }
                         else if (std::get<0>(*it) > icol)
                         {
-                            m_data[irow].emplace(it, icol, val);
+                            row.emplace(it, icol, val);
                             ++m_nvals;
                             return;
                         }
                     }
-                    m_data[irow].emplace_back(icol, val);
+                    row.emplace_back(icol, val);
                     ++m_nvals;
                 }
             }
@@ -358,16 +558,15 @@ namespace grb
                         "setElement(merge): index out of bounds");
                 }
 
-                if (m_data[irow].empty())
+                RowType &row(mutableRow(irow));
+                if (row.empty())
                 {
-                    m_data[irow].emplace_back(icol, val);
+                    row.emplace_back(icol, val);
                     ++m_nvals;
                 }
                 else
                 {
-                    for (auto it = m_data[irow].begin();
-                         it != m_data[irow].end();
-                         ++it)
+                    for (auto it = row.begin(); it != row.end(); ++it)
                     {
                         if (std::get<0>(*it) == icol)
                         {
@@ -377,12 +576,12 @@ namespace grb
                         }
                         else if (std::get<0>(*it) > icol)
                         {
-                            m_data[irow].emplace(it, icol, val);
+                            row.emplace(it, icol, val);
                             ++m_nvals;
                             return;
                         }
                     }
-                    m_data[irow].emplace_back(icol, val);
+                    row.emplace_back(icol, val);
                     ++m_nvals;
                 }
             }
@@ -394,46 +593,172 @@ namespace grb
                     throw IndexOutOfBoundsException("removeElement: index out of bounds");
                 }
 
+                if ((*this)[irow].empty())
+                {
+                    return;
+                }
+
                 /// @todo Replace with binary_search
+                RowType &row(mutableRow(irow));
                 auto it = std::find_if(
-                    m_data[irow].begin(), m_data[irow].end(),
+                    row.begin(), row.end(),
                     [&icol](ElementType const &elt) { return icol == std::get<0>(elt); });
 
-                if (it != m_data[irow].end())
+                if (it != row.end())
                 {
                     --m_nvals;
-                    m_data[irow].erase(it);
+                    row.erase(it);
+                    if (m_hypersparse && row.empty())
+                    {
+                        m_hyper_rows.erase(irow);
+                    }
                 }
             }
 
+            // Also drops the empty rows of a hypersparse matrix and switches
+            // between hypersparse and per-row storage if the number of
+            // non-empty rows calls for it, so references to rows obtained
+            // earlier may be invalidated.
             void recomputeNvals()
             {
                 IndexType nvals(0);
 
-                for (auto const &elt : m_data)
+                if (m_hypersparse)
                 {
-                    nvals += elt.size();
+                    for (auto it = m_hyper_rows.begin();
+                         it != m_hyper_rows.end(); )
+                    {
+                        nvals += it->second.size();
+                        it = (it->second.empty() ? m_hyper_rows.erase(it)
+                                                 : std::next(it));
+                    }
+                }
+                else
+                {
+                    for (auto const &elt : m_data)
+                    {
+                        nvals += elt.size();
+                    }
                 }
                 m_nvals = nvals;
+                chooseStorage();
+            }
+
+            // O(1) exchange of contents and dimensions
+            void swap(LilSparseMatrix<ScalarT> &rhs) noexcept
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                std::swap(m_hypersparse, rhs.m_hypersparse);
+                m_data.swap(rhs.m_data);
+                m_hyper_rows.swap(rhs.m_hyper_rows);
             }
 
-            // TODO: add error checking on dimensions?
-            void swap(LilSparseMatrix<ScalarT> &rhs)
+            // Hypersparse storage keeps only the non-empty rows, keyed by
+            // row index, so the matrix costs O(non-empty rows) instead of
+            // O(nrows).  The storage is picked from nvals (see
+            // HYPERSPARSE_MIN_ROWS) by build, clear, resize and
+            // recomputeNvals, and from the caller's bound by reserveRows,
+            // never by row access.  Kernels that write rows into an existing
+            // matrix call reserveRows first, so that a large result is not
+            // built in (and left in) hypersparse storage.
+            // setHypersparse(false) is needed before rows are written
+            // concurrently, since mutableRow() inserts the rows of a
+            // hypersparse matrix.
+            bool hypersparse() const { return m_hypersparse; }
+
+            void setHypersparse(bool flag)
             {
-                for (IndexType idx = 0; idx < m_data.size(); ++idx)
+                if (flag == m_hypersparse) return;
+
+                if (flag)
                 {
-                    m_data[idx].swap(rhs.m_data[idx]);
+                    for (IndexType row_idx = 0; row_idx < m_data.size(); ++row_idx)
+                    {
+                        if (!m_data[row_idx].empty())
+                        {
+                            m_hyper_rows.emplace_hint(
+                                m_hyper_rows.end(), row_idx,
+                                std::move(m_data[row_idx]));
+                        }
+                    }
+                    std::vector<RowType>().swap(m_data);
                 }
-                m_nvals = rhs.m_nvals;
+                else
+                {
+                    m_data.resize(m_num_rows);
+                    for (auto &&[row_idx, row] : m_hyper_rows)
+                    {
+                        m_data[row_idx] = std::move(row);
+                    }
+                    m_hyper_rows.clear();
+                }
+                m_hypersparse = flag;
+            }
+
+            // Storage hint for a matrix that is about to hold at most
+            // num_rows non-empty rows (counting the rows it already holds).
+            void reserveRows(IndexType num_rows)
+            {
+                setHypersparse(preferHypersparse(m_num_rows, num_rows));
             }
 
-            // Row access
-            // Warning if you use this non-const row accessor then you should
-            // call recomputeNvals() at some point to fix it
-            RowType &operator[](IndexType row_index) { return m_data[row_index]; }
+            /**
+             * @brief Call f(row_index, row) for the non-empty rows in
+             *        increasing row order.
+             *
+             * Only the stored rows are visited for hypersparse matrices.
+             * f must not add or remove rows of this matrix.
+             */
+            template <typename FunctionT>
+            void forEachRow(FunctionT f) const
+            {
+                if (m_hypersparse)
+                {
+                    for (auto const &[row_idx, row] : m_hyper_rows)
+                    {
+                        if (!row.empty()) f(row_idx, row);
+                    }
+                }
+                else
+                {
+                    for (IndexType row_idx = 0; row_idx < m_data.size(); ++row_idx)
+                    {
+                        if (!m_data[row_idx].empty()) f(row_idx, m_data[row_idx]);
+                    }
+                }
+            }
+
+            template <typename FunctionT>
+            void forEachRow(FunctionT f)
+            {
+                if (m_hypersparse)
+                {
+                    for (auto &[row_idx, row] : m_hyper_rows)
+                    {
+                        if (!row.empty()) f(row_idx, row);
+                    }
+                }
+                else
+                {
+                    for (IndexType row_idx = 0; row_idx < m_data.size(); ++row_idx)
+                    {
+                        if (!m_data[row_idx].empty()) f(row_idx, m_data[row_idx]);
+                    }
+                }
+            }
 
+            // Row access (read only: an absent row of a hypersparse matrix
+            // is returned as a shared empty row and is not inserted)
             RowType const &operator[](IndexType row_index) const
             {
+                if (m_hypersparse)
+                {
+                    auto it(m_hyper_rows.find(row_index));
+                    return ((it == m_hyper_rows.end()) ? emptyRow()
+                                                       : it->second);
+                }
                 return m_data[row_index];
             }
 
@@ -442,21 +767,39 @@ namespace grb
             //     return m_data[row_index];
             // }
 
+            // Writable row access, which inserts the row of a hypersparse
+            // matrix.  Warning if you use this row accessor then you should
+            // call recomputeNvals() at some point to fix it (which also
+            // drops rows left empty).  It never switches the storage, so
+            // references to other rows stay valid.
+            RowType &mutableRow(IndexType row_index)
+            {
+                return (m_hypersparse ? m_hyper_rows[row_index]
+                                      : m_data[row_index]);
+            }
+
             // Allow casting
             template <typename OtherScalarT>
             void setRow(
                 IndexType row_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
             {
-                IndexType old_nvals = m_data[row_index].size();
+                if (m_hypersparse && row_data.empty())
+                {
+                    eraseHypersparseRow(row_index);
+                    return;
+                }
+
+                RowType &row(mutableRow(row_index));
+                IndexType old_nvals = row.size();
                 IndexType new_nvals = row_data.size();
 
                 m_nvals = m_nvals + new_nvals - old_nvals;
                 //m_data[row_index] = row_data;   // swap here?
-                m_data[row_index].clear();
+                row.clear();
                 for (auto&& [idx, val] : row_data)
                 {
-                    m_data[row_index].emplace_back(idx, static_cast<ScalarT>(val));
+                    row.emplace_back(idx, static_cast<ScalarT>(val));
                 }
             }
 
@@ -465,11 +808,18 @@ namespace grb
                 IndexType row_index,
                 std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
             {
-                IndexType old_nvals = m_data[row_index].size();
+                if (m_hypersparse && row_data.empty())
+                {
+                    eraseHypersparseRow(row_index);
+                    return;
+                }
+
+                RowType &row(mutableRow(row_index));
+                IndexType old_nvals = row.size();
                 IndexType new_nvals = row_data.size();
 
                 m_nvals = m_nvals + new_nvals - old_nvals;
-                m_data[row_index].swap(row_data); // = row_data;
+                row.swap(row_data); // = row_data;
             }
 
 
@@ -478,7 +828,7 @@ namespace grb
             template <typename OtherScalarT, typename AccumT>
             void mergeRow(
                 IndexType row_index,
-                std::vector<std::tuple<IndexType, OtherScalarT> > &row_data,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data,
                 NoAccumulate const &op)
             {
                 setRow(row_index, row_data);
@@ -489,20 +839,22 @@ namespace grb
             template <typename OtherScalarT, typename AccumT>
             void mergeRow(
                 IndexType row_index,
-                std::vector<std::tuple<IndexType, OtherScalarT> > &row_data,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data,
                 AccumT const &op)
             {
                 if (row_data.empty()) return;
-                if (m_data[row_index].empty())
+
+                RowType const &row((*this)[row_index]);
+                if (row.empty())
                 {
                     setRow(row_index, row_data);
                     return;
                 }
 
                 std::vector<std::tuple<IndexType, ScalarT> > tmp;
-                auto l_it(m_data[row_index].begin());
+                auto l_it(row.begin());
                 auto r_it(row_data.begin());
-                while ((l_it != m_data[row_index].end()) &&
+                while ((l_it != row.end()) &&
                        (r_it != row_data.end()))
                 {
                     IndexType li = std::get<0>(*l_it);
@@ -528,7 +880,7 @@ namespace grb
                     }
                 }
 
-                while (l_it != m_data[row_index].end())
+                while (l_it != row.end())
                 {
                     tmp.emplace_back(*l_it);  ++l_it;
                 }
@@ -548,20 +900,17 @@ namespace grb
             {
                 std::vector<std::tuple<IndexType, ScalarT> > data;
 
-                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                forEachRow([&](IndexType ii, RowType const &row)
                 {
-                    if (!m_data[ii].empty())
+                    auto it(std::lower_bound(
+                                row.begin(), row.end(), col_index,
+                                [](ElementType const &elt, IndexType idx)
+                                { return std::get<0>(elt) < idx; }));
+                    if ((it != row.end()) && (std::get<0>(*it) == col_index))
                     {
-                        /// @todo replace with binary_search
-                        for (auto&& [idx, val] : m_data[ii])
-                        {
-                            if (idx == col_index)
-                            {
-                                data.emplace_back(ii, val);
-                            }
-                        }
+                        data.emplace_back(ii, std::get<1>(*it));
                     }
-                }
+                });
 
                 return data;  // hopefully compiles to a move
             }
@@ -574,79 +923,73 @@ namespace grb
                 IndexType col_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
             {
+                // Clear the column in the rows that get no value.  Only the
+                // non-empty rows can hold one.
                 auto it = col_data.begin();
-                for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
+                forEachRow([&](IndexType row_index, RowType &row)
                 {
-                    // Check for any values to clear: either there are column entries
-                    // left to examine, or the index is less than the next one to
-                    // insert
+                    while ((it != col_data.end()) &&
+                           (std::get<0>(*it) < row_index))
+                    {
+                        ++it;
+                    }
 
                     // No value to insert in this row.
                     if ((it == col_data.end()) || (row_index < std::get<0>(*it)))
                     {
-                        for (auto row_it = m_data[row_index].begin();
-                             row_it != m_data[row_index].end();
-                             ++row_it)
+                        for (auto row_it = row.begin(); row_it != row.end(); ++row_it)
                         {
                             if (std::get<0>(*row_it) == col_index)
                             {
-                                //std::cerr << "Erasing row element" << std::endl;
-                                m_data[row_index].erase(row_it);
+                                row.erase(row_it);
                                 --m_nvals;
                                 break;
                             }
                         }
                     }
-                    // replace existing or insert
-                    else if (row_index == std::get<0>(*it))
+                });
+
+                // replace existing or insert
+                for (it = col_data.begin(); it != col_data.end(); ++it)
+                {
+                    IndexType row_index(std::get<0>(*it));
+                    if ((row_index >= m_num_rows) ||
+                        ((it != col_data.begin()) &&
+                         (std::get<0>(*std::prev(it)) >= row_index)))
                     {
-                        //std::cerr << "Row index matches col_data row" << std::endl;
-                        bool inserted=false;
-                        for (auto row_it = m_data[row_index].begin();
-                             row_it != m_data[row_index].end();
-                             ++row_it)
+                        // This should not happen
+                        throw grb::PanicException(
+                            "LilSparseMatrix::setCol() INTERNAL ERROR");
+                    }
+
+                    RowType &row(mutableRow(row_index));
+                    bool inserted=false;
+                    for (auto row_it = row.begin(); row_it != row.end(); ++row_it)
+                    {
+                        if (std::get<0>(*row_it) == col_index)
                         {
-                            if (std::get<0>(*row_it) == col_index)
-                            {
-                                //std::cerr << "Found row element to replace" << std::endl;
-                                // replace
-                                std::get<1>(*row_it) =
-                                    static_cast<ScalarT>(std::get<1>(*it));
-                                ++it;
-                                inserted = true;
-                                break;
-                            }
-                            else if (std::get<0>(*row_it) > col_index)
-                            {
-                                //std::cerr << "Inserting new row element" << std::endl;
-                                m_data[row_index].emplace(
-                                    row_it,
-                                    col_index,
-                                    static_cast<ScalarT>(std::get<1>(*it)));
-                                ++m_nvals;
-                                ++it;
-                                inserted = true;
-                                break;
-                            }
+                            // replace
+                            std::get<1>(*row_it) =
+                                static_cast<ScalarT>(std::get<1>(*it));
+                            inserted = true;
+                            break;
                         }
-                        if (!inserted)
+                        else if (std::get<0>(*row_it) > col_index)
                         {
-                            //std::cerr << "Appending new row element" << std::endl;
-                            m_data[row_index].emplace_back(
-                                col_index,
-                                static_cast<ScalarT>(std::get<1>(*it)));
+                            row.emplace(row_it, col_index,
+                                        static_cast<ScalarT>(std::get<1>(*it)));
                             ++m_nvals;
-                            ++it;
+                            inserted = true;
+                            break;
                         }
                     }
-                    else // row_index > next entry to insert
+                    if (!inserted)
                     {
-                        // This should not happen
-                        throw grb::PanicException(
-                            "LilSparseMatrix::setCol() INTERNAL ERROR");
+                        row.emplace_back(col_index,
+                                         static_cast<ScalarT>(std::get<1>(*it)));
+                        ++m_nvals;
                     }
                 }
-
             }
 
             // Get column indices for a given row
@@ -708,15 +1051,15 @@ namespace grb
                                RAIteratorJT        col_it,
                                RAIteratorVT        values) const
             {
-                for (IndexType row = 0; row < m_data.size(); ++row)
+                forEachRow([&](IndexType row, RowType const &row_data)
                 {
-                    for (auto&& [col_idx, val] : m_data[row])
+                    for (auto&& [col_idx, val] : row_data)
                     {
                         *row_it = row;     ++row_it;
                         *col_it = col_idx; ++col_it;
                         *values = val;     ++values;
                     }
-                }
+                });
             }
 
             // output specific to the storage layout of this type of matrix
@@ -724,26 +1067,27 @@ namespace grb
             {
                 os << "backend::LilSparseMatrix<" << typeid(ScalarT).name() << "> ";
                 os << "(" << m_num_rows << " x " << m_num_cols << "), nvals = "
-                   << nvals() << std::endl;
+                   << nvals() << (m_hypersparse ? ", hypersparse" : "")
+                   << std::endl;
 
                 // Used to print data in storage format instead of like a matrix
                 #ifdef GRB_MATRIX_PRINT_RAW_STORAGE
-                    for (IndexType row = 0; row < m_data.size(); ++row)
+                    forEachRow([&](IndexType row, RowType const &row_data)
                     {
                         os << row << " :";
-                        for (auto&& [idx, val] : m_data[row])
+                        for (auto&& [idx, val] : row_data)
                         {
                             os << " " << idx << ":" << val;
                         }
                         os << std::endl;
-                    }
+                    });
                 #else
                     for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
                     {
                         // We like to start with a little whitespace indent
                         os << ((row_idx == 0) ? "  [[" : "   [");
 
-                        RowType const &row(m_data[row_idx]);
+                        RowType const &row((*this)[row_idx]);
                         IndexType curr_idx = 0;
 
                         if (row.empty())
@@ -795,12 +1139,104 @@ namespace grb
             }
 
         private:
+            // Merge column-sorted (col, val) tuples into a row, combining
+            // values at the same column with dup in order:
+            // stored = dup(stored, val).
+            template <typename IteratorT, typename DupT>
+            static void buildRow(RowType   &row,
+                                 IteratorT  first,
+                                 IteratorT  last,
+                                 DupT       dup)
+            {
+                RowType merged;
+                merged.reserve(row.size() + (last - first));
+
+                auto row_it(row.begin());
+                while (first != last)
+                {
+                    IndexType icol(std::get<0>(*first));
+                    while ((row_it != row.end()) &&
+                           (std::get<0>(*row_it) < icol))
+                    {
+                        merged.push_back(*row_it);
+                        ++row_it;
+                    }
+
+                    ScalarT val;
+                    if ((row_it != row.end()) && (std::get<0>(*row_it) == icol))
+                    {
+                        val = dup(std::get<1>(*row_it), std::get<1>(*first));
+                        ++row_it;
+                    }
+                    else
+                    {
+                        val = std::get<1>(*first);
+                    }
+
+                    for (++first;
+                         (first != last) && (std::get<0>(*first) == icol);
+                         ++first)
+                    {
+                        val = dup(val, std::get<1>(*first));
+                    }
+                    merged.emplace_back(icol, val);
+                }
+                merged.insert(merged.end(), row_it, row.end());
+                row.swap(merged);
+            }
+
+            static RowType const &emptyRow()
+            {
+                static RowType const empty_row;
+                return empty_row;
+            }
+
+            void eraseHypersparseRow(IndexType row_index)
+            {
+                auto it(m_hyper_rows.find(row_index));
+                if (it != m_hyper_rows.end())
+                {
+                    m_nvals -= it->second.size();
+                    m_hyper_rows.erase(it);
+                }
+            }
+
+            static bool preferHypersparse(IndexType num_rows,
+                                          IndexType num_vals)
+            {
+                return ((num_rows >= HYPERSPARSE_MIN_ROWS) &&
+                        (num_vals * HYPERSPARSE_RATIO < num_rows));
+            }
+
+            // Switch storage when nvals crosses the thresholds (only at
+            // points where no row references are held: build, clear, resize
+            // and recomputeNvals).
+            void chooseStorage()
+            {
+                if (m_hypersparse)
+                {
+                    if ((m_num_rows < HYPERSPARSE_MIN_ROWS) ||
+                        (m_nvals * HYPERSPARSE_RATIO > 2 * m_num_rows))
+                    {
+                        setHypersparse(false);
+                    }
+                }
+                else if (preferHypersparse(m_num_rows, m_nvals))
+                {
+                    setHypersparse(true);
+                }
+            }
+
             IndexType m_num_rows;
             IndexType m_num_cols;
             IndexType m_nvals;
+            bool      m_hypersparse;
 
             // List-of-lists storage (LIL) really VOV
             std::vector<RowType> m_data;
+
+            // Hypersparse storage: the non-empty rows keyed by row index
+            std::map<IndexType, RowType> m_hyper_rows;
         };
 
     } // namespace backend
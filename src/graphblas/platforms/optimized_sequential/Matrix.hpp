@@ -59,6 +59,24 @@ namespace grb
             {
             }
 
+            // move construct
+            Matrix(Matrix &&rhs) noexcept
+                : ParentMatrixType(std::move(rhs))
+            {
+            }
+
+            Matrix &operator=(Matrix const &rhs)
+            {
+                ParentMatrixType::operator=(rhs);
+                return *this;
+            }
+
+            Matrix &operator=(Matrix &&rhs) noexcept
+            {
+                ParentMatrixType::operator=(std::move(rhs));
+                return *this;
+            }
+
             // construct a dense matrix from dense data.
             Matrix(std::vector<std::vector<ScalarT> > const &values)
                 : ParentMatrixType(values)
@@ -88,7 +106,7 @@ namespace grb
 
             void printInfo(std::ostream &os) const
             {
-                os << "Optimized_Sequential Backend: ";
+                os << GB_BACKEND_LABEL << " Backend: ";
                 ParentMatrixType::printInfo(os);
             }
         };
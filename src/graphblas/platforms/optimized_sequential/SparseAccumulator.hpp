@@ -0,0 +1,324 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <algorithm>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Row accumulator for Gustavson style (row-by-row axpy) SpGEMM.
+        ///
+        /// Each row of the answer is accumulated in one of two structures,
+        /// chosen by the caller's estimate of the number of products (flops)
+        /// that will be generated for that row:
+        ///
+        /// - a dense sparse accumulator (SPA): a dense value array of length
+        ///   ncols with a "stamp" array marking the occupied entries.  Used
+        ///   when the row is expected to be relatively dense.
+        /// - an open addressing hash table sized to the flop count.  Used
+        ///   for the (typically many) short rows so that the cost does not
+        ///   depend on ncols.
+        ///
+        /// Either way each product costs O(1) instead of the O(row length)
+        /// vector::insert performed by axpy(), and gathering a row costs
+        /// O(nnz log nnz) for the sort (or O(ncols) for a dense scan).
+        ///
+        /// An optional (complemented) mask can be loaded for each row, in
+        /// which case products that the mask does not allow are discarded
+        /// before being accumulated.
+        template<typename ScalarT>
+        class SparseAccumulator
+        {
+        public:
+            using ScalarType = ScalarT;
+
+            /// Use the dense SPA for rows with at least ncols/DENSE_DIVISOR
+            /// flops, otherwise use the hash table.
+            static constexpr IndexType DENSE_DIVISOR = 16;
+
+            SparseAccumulator(IndexType num_cols)
+                : m_num_cols(num_cols),
+                  m_use_dense(false),
+                  m_stamp(0),
+                  m_hash_shift(std::numeric_limits<IndexType>::digits),
+                  m_mask_stamp(0),
+                  m_mask_active(false),
+                  m_mask_complement(false)
+            {
+            }
+
+            IndexType ncols() const { return m_num_cols; }
+
+            /// Number of entries accumulated so far in the current row
+            IndexType nvals() const { return m_nz.size(); }
+
+            bool empty() const { return m_nz.empty(); }
+
+            //******************************************************************
+            /// Prepare for a new row where at most 'flops' products will be
+            /// accumulated.  Any previous row must have been gathered.
+            void start_row(IndexType flops)
+            {
+                m_nz.clear();
+                m_use_dense = (flops * DENSE_DIVISOR >= m_num_cols);
+
+                if (m_use_dense)
+                {
+                    if (m_dense_stamp.empty())
+                    {
+                        m_dense_vals.resize(m_num_cols);
+                        m_dense_stamp.resize(m_num_cols, 0);
+                    }
+                    ++m_stamp;
+                }
+                else
+                {
+                    // power of two, at least twice the number of products
+                    IndexType capacity(4);
+                    IndexType log2_capacity(2);
+                    while (capacity < 2*flops)
+                    {
+                        capacity <<= 1;
+                        ++log2_capacity;
+                    }
+
+                    if (capacity > m_hash_keys.size())
+                    {
+                        m_hash_keys.assign(capacity, EMPTY_KEY);
+                        m_hash_vals.resize(capacity);
+                    }
+                    m_hash_shift = std::numeric_limits<IndexType>::digits -
+                                   log2_capacity;
+                }
+            }
+
+            //******************************************************************
+            /// Raise the bound on the products of the current row to 'flops',
+            /// for callers that only learn it while accumulating (a streamed
+            /// operand).  The entries accumulated so far are kept: the hash
+            /// table is enlarged, or the row moves to the dense form once
+            /// flops reaches the dense threshold.  The table at least
+            /// doubles each time it is rebuilt, so the rebuilds cost O(1)
+            /// amortized per entry.
+            void grow_row(IndexType flops)
+            {
+                if (m_use_dense || (2*flops <= hash_mask() + 1)) return;
+
+                std::vector<std::tuple<IndexType, ScalarT>> entries;
+                entries.reserve(m_nz.size());
+                for (auto slot : m_nz)
+                {
+                    entries.emplace_back(m_hash_keys[slot], m_hash_vals[slot]);
+                    m_hash_keys[slot] = EMPTY_KEY;
+                }
+
+                start_row(flops);
+                for (auto&& [j, val] : entries)
+                {
+                    accumulate(j, val, [](auto lhs, auto) { return lhs; });
+                }
+            }
+
+            //******************************************************************
+            /// Only allow accumulation at the stored (or true) locations of m,
+            /// or at all other locations if complement_flag is set.  Remains
+            /// in effect until clear_mask() is called.
+            template <typename MScalarT>
+            void set_mask(std::vector<std::tuple<IndexType, MScalarT>> const &m,
+                          bool structure_flag,
+                          bool complement_flag)
+            {
+                if (m_mask_marker.empty())
+                {
+                    m_mask_marker.resize(m_num_cols, 0);
+                }
+
+                ++m_mask_stamp;
+                m_mask_active = true;
+                m_mask_complement = complement_flag;
+
+                for (auto&& [idx, val] : m)
+                {
+                    if (structure_flag || static_cast<bool>(val))
+                    {
+                        m_mask_marker[idx] = m_mask_stamp;
+                    }
+                }
+            }
+
+            void clear_mask() { m_mask_active = false; }
+
+            /// @return true if the current mask allows a write to index j
+            bool allows(IndexType j) const
+            {
+                return (!m_mask_active ||
+                        ((m_mask_marker[j] == m_mask_stamp) != m_mask_complement));
+            }
+
+            //******************************************************************
+            /// acc[j] = add(acc[j], t_j), or acc[j] = t_j if acc[j] is empty.
+            /// The mask (if any) is NOT checked here; see allows().
+            template <typename ValueT, typename AddOpT>
+            void accumulate(IndexType j, ValueT const &t_j, AddOpT add)
+            {
+                if (m_use_dense)
+                {
+                    if (m_dense_stamp[j] == m_stamp)
+                    {
+                        m_dense_vals[j] = add(m_dense_vals[j], t_j);
+                    }
+                    else
+                    {
+                        m_dense_stamp[j] = m_stamp;
+                        m_dense_vals[j] = static_cast<ScalarT>(t_j);
+                        m_nz.push_back(j);
+                    }
+                }
+                else
+                {
+                    IndexType slot(hash(j));
+                    while (true)
+                    {
+                        if (m_hash_keys[slot] == j)
+                        {
+                            m_hash_vals[slot] = add(m_hash_vals[slot], t_j);
+                            return;
+                        }
+                        else if (m_hash_keys[slot] == EMPTY_KEY)
+                        {
+                            m_hash_keys[slot] = j;
+                            m_hash_vals[slot] = static_cast<ScalarT>(t_j);
+                            m_nz.push_back(slot);
+                            return;
+                        }
+                        slot = (slot + 1) & hash_mask();
+                    }
+                }
+            }
+
+            //******************************************************************
+            /// Append the accumulated row (sorted by index) to 'row' and
+            /// reset the accumulator for the next row.
+            template <typename RScalarT>
+            void gather(std::vector<std::tuple<IndexType, RScalarT>> &row)
+            {
+                row.reserve(row.size() + m_nz.size());
+
+                if (m_use_dense)
+                {
+                    // scan the dense array when sorting would cost more
+                    if (m_nz.size() * DENSE_DIVISOR >= m_num_cols)
+                    {
+                        for (IndexType j = 0; j < m_num_cols; ++j)
+                        {
+                            if (m_dense_stamp[j] == m_stamp)
+                            {
+                                row.emplace_back(
+                                    j, static_cast<RScalarT>(m_dense_vals[j]));
+                            }
+                        }
+                    }
+                    else
+                    {
+                        std::sort(m_nz.begin(), m_nz.end());
+                        for (auto j : m_nz)
+                        {
+                            row.emplace_back(
+                                j, static_cast<RScalarT>(m_dense_vals[j]));
+                        }
+                    }
+                }
+                else
+                {
+                    std::sort(m_nz.begin(), m_nz.end(),
+                              [this](IndexType a, IndexType b)
+                              { return m_hash_keys[a] < m_hash_keys[b]; });
+                    for (auto slot : m_nz)
+                    {
+                        row.emplace_back(
+                            m_hash_keys[slot],
+                            static_cast<RScalarT>(m_hash_vals[slot]));
+                        m_hash_keys[slot] = EMPTY_KEY;
+                    }
+                }
+
+                m_nz.clear();
+            }
+
+        private:
+            static constexpr IndexType EMPTY_KEY =
+                std::numeric_limits<IndexType>::max();
+
+            IndexType hash(IndexType j) const
+            {
+                // Fibonacci hashing: the high bits of the product depend on
+                // all the bits of j, whereas the low bits only depend on the
+                // low bits of j (indices with a common stride would collide)
+                return (j * 0x9E3779B97F4A7C15ULL) >> m_hash_shift;
+            }
+
+            IndexType hash_mask() const
+            {
+                return (~IndexType(0)) >> m_hash_shift;
+            }
+
+            IndexType              m_num_cols;
+            bool                   m_use_dense;
+
+            // Dense SPA
+            std::vector<ScalarT>   m_dense_vals;
+            std::vector<IndexType> m_dense_stamp;
+            IndexType              m_stamp;
+
+            // Hash accumulator (linear probing)
+            std::vector<IndexType> m_hash_keys;
+            std::vector<ScalarT>   m_hash_vals;
+            IndexType              m_hash_shift;   // digits - log2(capacity)
+
+            // Indices (dense) or slots (hash) of the occupied entries
+            std::vector<IndexType> m_nz;
+
+            // Mask marker
+            std::vector<IndexType> m_mask_marker;
+            IndexType              m_mask_stamp;
+            bool                   m_mask_active;
+            bool                   m_mask_complement;
+        };
+
+    } // backend
+} // grb
@@ -40,7 +40,8 @@ namespace grb
     {
         //**********************************************************************
         /// @note ignoring all tags here, there is currently only one
-        ///       implementation of vector: dense+bitmap.
+        ///       implementation of vector: sparse list or dense+bitmap,
+        ///       selected automatically by density.
         template<typename ScalarT, typename... TagsT>
         class Vector : public BitmapSparseVector<ScalarT>
         {
@@ -63,6 +64,23 @@ namespace grb
             Vector(std::vector<ScalarT> const &values, ScalarT const &zero)
                 : ParentVectorType(values, zero) {}
 
+            Vector(Vector const &rhs) : ParentVectorType(rhs) {}
+
+            Vector(Vector &&rhs) noexcept
+                : ParentVectorType(std::move(rhs)) {}
+
+            Vector &operator=(Vector const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
+            Vector &operator=(Vector &&rhs) noexcept
+            {
+                ParentVectorType::operator=(std::move(rhs));
+                return *this;
+            }
+
             ~Vector() {}  // virtual?
 
             // necessary?
@@ -79,7 +97,7 @@ namespace grb
 
             void printInfo(std::ostream &os) const
             {
-                os << "Optimized Sequential Backend: ";
+                os << GB_BACKEND_LABEL << " Backend: ";
                 ParentVectorType::printInfo(os);
             }
         };
@@ -30,6 +30,12 @@
 // This file is a dispatch mechanism to allow us to include different
 // sets of files as specified by the user.
 
+// Name printed by printInfo() of the backend Matrix and Vector (the openmp
+// platform shares this backend and defines its own)
+#ifndef GB_BACKEND_LABEL
+#define GB_BACKEND_LABEL "Optimized Sequential"
+#endif
+
 #if(GB_INCLUDE_BACKEND_ALL)
 #include <graphblas/platforms/optimized_sequential/optimized_sequential.hpp>
 #endif
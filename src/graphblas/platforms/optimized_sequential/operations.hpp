@@ -48,6 +48,8 @@
 #include <graphblas/platforms/optimized_sequential/sparse_extract.hpp>
 #include <graphblas/platforms/optimized_sequential/sparse_assign.hpp>
 #include <graphblas/platforms/optimized_sequential/sparse_apply.hpp>
+#include <graphblas/platforms/optimized_sequential/sparse_select.hpp>
 #include <graphblas/platforms/optimized_sequential/sparse_reduce.hpp>
 #include <graphblas/platforms/optimized_sequential/sparse_transpose.hpp>
 #include <graphblas/platforms/optimized_sequential/sparse_kronecker.hpp>
+#include <graphblas/platforms/optimized_sequential/sparse_csr.hpp>
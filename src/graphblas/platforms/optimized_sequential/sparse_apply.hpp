@@ -39,6 +39,9 @@
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_kernels.hpp>
+
 //******************************************************************************
 
 namespace grb
@@ -70,7 +73,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                for (auto&& [idx, val] : u.getContents()) {
+                for (auto&& [idx, val] : u.contents()) {
                     t_contents.emplace_back(idx, op(val));
                 }
             }
@@ -120,14 +123,15 @@ namespace grb
             using AScalarType = typename AMatrixT::ScalarType;
             using TScalarType = decltype(op(std::declval<AScalarType>()));
             LilSparseMatrix<TScalarType> T(nrows, ncols);
+            T.reserveRows(max_nonempty_rows(A));
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
             {
-                for (auto&& [a_idx, a_val] : A[row_idx])
+                for (auto&& [a_idx, a_val] : a_row)
                 {
-                    T[row_idx].emplace_back(a_idx, op(a_val));
+                    T.mutableRow(row_idx).emplace_back(a_idx, op(a_val));
                 }
-            }
+            });
             T.recomputeNvals();
 
             GRB_LOG_VERBOSE("T: " << T);
@@ -176,14 +180,15 @@ namespace grb
             using AScalarType = typename AMatrixT::ScalarType;
             using TScalarType = decltype(op(std::declval<AScalarType>()));
             LilSparseMatrix<TScalarType> T(ncols, nrows);
+            T.reserveRows(A.nvals());
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
             {
-                for (auto&& [a_idx, a_val] : A[row_idx])
+                for (auto&& [a_idx, a_val] : a_row)
                 {
-                    T[a_idx].emplace_back(row_idx, op(a_val)); // idx's swapped
+                    T.mutableRow(a_idx).emplace_back(row_idx, op(a_val)); // idx's swapped
                 }
-            }
+            });
             T.recomputeNvals();
 
             GRB_LOG_VERBOSE("T: " << T);
@@ -236,7 +241,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                for (auto&& [idx, u_val] : u.getContents()) {
+                for (auto&& [idx, u_val] : u.contents()) {
                     t_contents.emplace_back(idx, op(val, u_val));
                 }
             }
@@ -292,7 +297,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                for (auto&& [idx, u_val] : u.getContents()) {
+                for (auto&& [idx, u_val] : u.contents()) {
                     t_contents.emplace_back(idx, op(u_val, val));
                 }
             }
@@ -349,14 +354,15 @@ namespace grb
             using TScalarType = decltype(op(std::declval<ValueT>(),
                                             std::declval<AScalarType>()));
             LilSparseMatrix<TScalarType> T(nrows, ncols);
+            T.reserveRows(max_nonempty_rows(A));
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
             {
-                for (auto&& [a_idx, a_val] : A[row_idx])
+                for (auto&& [a_idx, a_val] : a_row)
                 {
-                    T[row_idx].emplace_back(a_idx, op(val, a_val));
+                    T.mutableRow(row_idx).emplace_back(a_idx, op(val, a_val));
                 }
-            }
+            });
             T.recomputeNvals();
 
             GRB_LOG_VERBOSE("T: " << T);
@@ -410,14 +416,15 @@ namespace grb
             using TScalarType = decltype(op(std::declval<ValueT>(),
                                             std::declval<AScalarType>()));
             LilSparseMatrix<TScalarType> T(ncols, nrows);
+            T.reserveRows(A.nvals());
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
             {
-                for (auto&& [a_idx, a_val] : A[row_idx])
+                for (auto&& [a_idx, a_val] : a_row)
                 {
-                    T[a_idx].emplace_back(row_idx, op(val, a_val)); // idx's swapped
+                    T.mutableRow(a_idx).emplace_back(row_idx, op(val, a_val)); // idx's swapped
                 }
-            }
+            });
             T.recomputeNvals();
 
             GRB_LOG_VERBOSE("T: " << T);
@@ -472,14 +479,15 @@ namespace grb
             using TScalarType = decltype(op(std::declval<AScalarType>(),
                                             std::declval<ValueT>()));
             LilSparseMatrix<TScalarType> T(nrows, ncols);
+            T.reserveRows(max_nonempty_rows(A));
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
             {
-                for (auto&& [a_idx, a_val] : A[row_idx])
+                for (auto&& [a_idx, a_val] : a_row)
                 {
-                    T[row_idx].emplace_back(a_idx, op(a_val, val));
+                    T.mutableRow(row_idx).emplace_back(a_idx, op(a_val, val));
                 }
-            }
+            });
             T.recomputeNvals();
 
             GRB_LOG_VERBOSE("T: " << T);
@@ -535,14 +543,15 @@ namespace grb
             using TScalarType = decltype(op(std::declval<AScalarType>(),
                                             std::declval<ValueT>()));
             LilSparseMatrix<TScalarType> T(ncols, nrows);
+            T.reserveRows(A.nvals());
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
             {
-                for (auto&& [a_idx, a_val] : A[row_idx])
+                for (auto&& [a_idx, a_val] : a_row)
                 {
-                    T[a_idx].emplace_back(row_idx, op(a_val, val)); // idx's swapped
+                    T.mutableRow(a_idx).emplace_back(row_idx, op(a_val, val)); // idx's swapped
                 }
-            }
+            });
             T.recomputeNvals();
 
             GRB_LOG_VERBOSE("T: " << T);
@@ -564,5 +573,82 @@ namespace grb
             // Copy Z into the final output considering mask and replace/merge
             write_with_opt_mask(C, Z, Mask, outp);
         }
+
+        //**********************************************************************
+        // Diagonal scaling (in place): A := diag(d) * A and A := A * diag(d)
+        //**********************************************************************
+
+        /**
+         * @brief A(i,j) := op(d(i), A(i,j)) for every stored element.  Rows
+         *        without a stored d(i) are cleared, as they are in diag(d)*A.
+         *
+         * d(i) is looked up for each stored row (O(1) for a bitmap d), so
+         * the rows are independent and are updated in place.
+         */
+        template<typename AScalarT,
+                 typename DScalarT,
+                 typename BinaryOpT,
+                 typename ...ATagsT,
+                 typename ...DTagsT>
+        inline void scale_rows(
+            grb::backend::Matrix<AScalarT, ATagsT...>       &A,
+            grb::backend::Vector<DScalarT, DTagsT...> const &d,
+            BinaryOpT                                        op)
+        {
+            GRB_LOG_VERBOSE("A := diag(d) op A");
+            update_rows(A, [&op, &d](IndexType row_idx, auto &row)
+            {
+                DScalarT d_val;
+                if (!d.lookupElement(row_idx, d_val))
+                {
+                    row.clear();
+                    return;
+                }
+
+                for (auto &&[col_idx, val] : row)
+                {
+                    val = static_cast<AScalarT>(op(d_val, val));
+                }
+            });
+
+            // also drops the rows cleared above
+            A.recomputeNvals();
+        }
+
+        //**********************************************************************
+        /**
+         * @brief A(i,j) := op(A(i,j), d(j)) for every stored element.
+         *        Elements without a stored d(j) are removed, as they are in
+         *        A*diag(d).
+         */
+        template<typename AScalarT,
+                 typename DScalarT,
+                 typename BinaryOpT,
+                 typename ...ATagsT,
+                 typename ...DTagsT>
+        inline void scale_cols(
+            grb::backend::Matrix<AScalarT, ATagsT...>       &A,
+            grb::backend::Vector<DScalarT, DTagsT...> const &d,
+            BinaryOpT                                        op)
+        {
+            GRB_LOG_VERBOSE("A := A op diag(d)");
+            update_rows(A, [&op, &d](IndexType, auto &row)
+            {
+                auto out_it(row.begin());
+                for (auto &&[col_idx, val] : row)
+                {
+                    if (d.hasElement(col_idx))
+                    {
+                        *out_it = std::make_tuple(
+                            col_idx,
+                            static_cast<AScalarT>(
+                                op(val, d.extractElement(col_idx))));
+                        ++out_it;
+                    }
+                }
+                row.erase(out_it, row.end());
+            });
+            A.recomputeNvals();
+        }
     }
 }
@@ -210,7 +210,7 @@ namespace grb
 
                 for (auto&& [out_row_index, val] : out_col)
                 {
-                    T[out_row_index].emplace_back(out_col_index, val);
+                    T.mutableRow(out_row_index).emplace_back(out_col_index, val);
                 }
             }
             T.recomputeNvals();
@@ -75,7 +75,7 @@ namespace grb
 
             if ((u.nvals() > 0) || (v.nvals() > 0))
             {
-                ewise_or(t_contents, u.getContents(), v.getContents(), op);
+                ewise_or(t_contents, u.contents(), v.contents(), op);
             }
 
             // =================================================================
@@ -123,12 +123,13 @@ namespace grb
                             std::declval<typename BMatrixT::ScalarType>()));
             using TRowType = std::vector<std::tuple<IndexType,D3ScalarType> >;
             LilSparseMatrix<D3ScalarType> T(num_rows, num_cols);
+            T.reserveRows(max_nonempty_rows(A) + max_nonempty_rows(B));
 
             if ((A.nvals() > 0) || (B.nvals() > 0))
             {
                 // create one row of result at a time
                 TRowType T_row;
-                for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                for_each_row_union([&](IndexType row_idx)
                 {
                     if (B[row_idx].empty())
                     {
@@ -148,7 +149,7 @@ namespace grb
                             T_row.clear();
                         }
                     }
-                }
+                }, A, B);
             }
 
             // =================================================================
@@ -252,26 +253,27 @@ namespace grb
                             std::declval<typename BMatrixT::ScalarType>()));
             using TRowType = std::vector<std::tuple<IndexType,D3ScalarType> >;
             LilSparseMatrix<D3ScalarType> T(num_cols, num_rows);
+            T.reserveRows(A.nvals() + B.nvals());
 
             if ((A.nvals() > 0) || (B.nvals() > 0))
             {
                 // create one column of result at a time
                 TRowType T_col;
-                for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                for_each_row_union([&](IndexType row_idx)
                 {
                     T_col.clear();
                     if (B[row_idx].empty())
                     {
                         for (auto && [col_idx, val] : A[row_idx])
                         {
-                            T[col_idx].emplace_back(row_idx, val);
+                            T.mutableRow(col_idx).emplace_back(row_idx, val);
                         }
                     }
                     else if (A[row_idx].empty())
                     {
                         for (auto && [col_idx, val] : B[row_idx])
                         {
-                            T[col_idx].emplace_back(row_idx, val);
+                            T.mutableRow(col_idx).emplace_back(row_idx, val);
                         }
                     }
                     else
@@ -280,10 +282,10 @@ namespace grb
 
                         for (auto && [col_idx, val] : T_col)
                         {
-                            T[col_idx].emplace_back(row_idx, val);
+                            T.mutableRow(col_idx).emplace_back(row_idx, val);
                         }
                     }
-                }
+                }, A, B);
                 T.recomputeNvals();
             }
 
@@ -31,6 +31,7 @@
 #include <utility>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 #include <type_traits>
 #include <iostream>
 
@@ -43,6 +44,9 @@
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_kernels.hpp>
+
 //******************************************************************************
 
 namespace grb
@@ -51,147 +55,259 @@ namespace grb
     {
         //**********************************************************************
         /**
-         * Extracts a series of values from the vector based on the passed in
-         * indices.
-         * @tparam CScalarT  The type of the output scalar.
-         * @tparam AScalarT  The type of the input scalar.
-         * @tparam SequenceT A random access iterator into a container of indices
+         * The index list of an extract, prepared once per call and then
+         * matched against every (sorted) row or vector that is extracted
+         * from:
          *
-         * @param vec_dest The output vector.
-         * @param vec_src The input vector.
-         * @param begin   Iterator at begining of sequence of indices to extract.
-         * @param end     Iterator at end of sequence of indices to extract.
+         *  - a contiguous range (AllIndices, or a list like 5,6,7) is one
+         *    binary search followed by a copy of the elements in range,
+         *  - a non-decreasing list is merged with the input,
+         *  - any other list is turned into an inverse map, (index, output
+         *    position) pairs sorted by index, that is merged with the input
+         *    and the output sorted by position afterwards.
+         *
+         * When one side of a merge is much shorter than the other the longer
+         * side is searched (binary search) instead of walked, so the cost per
+         * row is O(min(|row|, |indices|) log max(|row|, |indices|)) at worst.
          */
-        template<typename CScalarT,
-                 typename AScalarT,
-                 typename IteratorT>
-        void vectorExtract(
-                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
-                std::vector<std::tuple<IndexType, AScalarT> > const &vec_src,
-                IteratorT           begin,
-                IteratorT           end)
+        class IndexLookup
         {
-            // This is expensive but the indices can be duplicates and
-            // out of order.
+        public:
+            IndexLookup(IndexSequenceRange const &range)
+                : m_kind(CONTIGUOUS),
+                  m_first(range.m_begin),
+                  m_size(range.size())
+            {
+            }
 
-            vec_dest.clear();
+            template <typename IteratorT>
+            IndexLookup(IteratorT begin, IteratorT end)
+                : m_kind(CONTIGUOUS),
+                  m_first(0),
+                  m_size(0)
+            {
+                bool sorted(true);
+                for (auto it = begin; it != end; ++it, ++m_size)
+                {
+                    IndexType idx(*it);
+                    if (m_size == 0)
+                    {
+                        m_first = idx;
+                    }
+                    else
+                    {
+                        IndexType prev(m_inverse.back().first);
+                        if (idx != m_first + m_size) m_kind = SORTED;
+                        if (idx < prev) sorted = false;
+                    }
+                    m_inverse.emplace_back(idx, m_size);
+                }
 
-            GRB_LOG_VERBOSE("vectorExtract: sizeof(vec_src): " << vec_src.size());
+                if (m_kind == CONTIGUOUS)
+                {
+                    m_inverse.clear();
+                }
+                else if (!sorted)
+                {
+                    m_kind = INVERSE_MAP;
+                    std::stable_sort(
+                        m_inverse.begin(), m_inverse.end(),
+                        [](auto const &a, auto const &b)
+                        { return a.first < b.first; });
+                }
+            }
+
+            IndexType size() const { return m_size; }
 
-            IndexType out_idx = 0;
-            for (auto col_it = begin; col_it != end; ++col_it, ++out_idx)
+            /**
+             * dest := the (output position, value) pairs of the elements of
+             * src whose index was requested, in increasing position order.
+             */
+            template <typename CScalarT, typename SrcT>
+            void extract(std::vector<std::tuple<IndexType, CScalarT>> &dest,
+                         SrcT const                                   &src) const
             {
-                GRB_LOG_VERBOSE("out_idx = " << out_idx);
-                IndexType wanted_idx = *col_it;
+                dest.clear();
+                if (src.empty() || (m_size == 0)) return;
 
-                // Search through the outputs find one that matches.
-                auto A_it = vec_src.begin();
-                if (increment_while_below(A_it, vec_src.end(), wanted_idx))
+                if (m_kind == CONTIGUOUS)
                 {
-                    vec_dest.emplace_back(
-                        out_idx, static_cast<CScalarT>(std::get<1>(*A_it)));
+                    auto it(std::lower_bound(
+                                src.begin(), src.end(), m_first,
+                                [](auto const &elt, IndexType idx)
+                                { return std::get<0>(elt) < idx; }));
+                    for (; (it != src.end()) &&
+                             (std::get<0>(*it) < m_first + m_size); ++it)
+                    {
+                        dest.emplace_back(
+                            std::get<0>(*it) - m_first,
+                            static_cast<CScalarT>(std::get<1>(*it)));
+                    }
+                    return;
+                }
+
+                merge(src, [&dest](IndexType pos, auto const &val)
+                      { dest.emplace_back(pos, static_cast<CScalarT>(val)); });
+
+                if (m_kind == INVERSE_MAP)
+                {
+                    std::sort(dest.begin(), dest.end(),
+                              [](auto const &a, auto const &b)
+                              { return std::get<0>(a) < std::get<0>(b); });
                 }
             }
+
+            /**
+             * Call f(output position, value) for the elements of src whose
+             * index was requested (in input order, not position order).
+             */
+            template <typename SrcT, typename FunctionT>
+            void forEachMatch(SrcT const &src, FunctionT f) const
+            {
+                if (src.empty() || (m_size == 0)) return;
+
+                if (m_kind == CONTIGUOUS)
+                {
+                    auto it(std::lower_bound(
+                                src.begin(), src.end(), m_first,
+                                [](auto const &elt, IndexType idx)
+                                { return std::get<0>(elt) < idx; }));
+                    for (; (it != src.end()) &&
+                             (std::get<0>(*it) < m_first + m_size); ++it)
+                    {
+                        f(std::get<0>(*it) - m_first, std::get<1>(*it));
+                    }
+                    return;
+                }
+                merge(src, f);
+            }
+
+        private:
+            // Merge the sorted (index, position) pairs with the sorted src;
+            // duplicate indices each match the same element of src.
+            template <typename SrcT, typename FunctionT>
+            void merge(SrcT const &src, FunctionT f) const
+            {
+                static constexpr size_t SEARCH_RATIO = 8;
+                bool const search_src(src.size() > SEARCH_RATIO * m_inverse.size());
+                bool const search_inv(m_inverse.size() > SEARCH_RATIO * src.size());
+
+                auto inv_it(m_inverse.begin());
+                auto src_it(src.begin());
+                while ((inv_it != m_inverse.end()) && (src_it != src.end()))
+                {
+                    IndexType inv_idx(inv_it->first);
+                    IndexType src_idx(std::get<0>(*src_it));
+                    if (inv_idx == src_idx)
+                    {
+                        f(inv_it->second, std::get<1>(*src_it));
+                        ++inv_it;
+                    }
+                    else if (inv_idx < src_idx)
+                    {
+                        inv_it = (search_inv
+                                  ? std::lower_bound(
+                                      inv_it + 1, m_inverse.end(), src_idx,
+                                      [](auto const &elt, IndexType idx)
+                                      { return elt.first < idx; })
+                                  : inv_it + 1);
+                    }
+                    else
+                    {
+                        src_it = (search_src
+                                  ? std::lower_bound(
+                                      src_it + 1, src.end(), inv_idx,
+                                      [](auto const &elt, IndexType idx)
+                                      { return std::get<0>(elt) < idx; })
+                                  : src_it + 1);
+                    }
+                }
+            }
+
+            enum { CONTIGUOUS, SORTED, INVERSE_MAP } m_kind;
+            IndexType                                  m_first;
+            IndexType                                  m_size;
+            std::vector<std::pair<IndexType, IndexType>> m_inverse;
+        };
+
+        template <typename SequenceT>
+        inline IndexLookup make_index_lookup(SequenceT const &indices)
+        {
+            return IndexLookup(indices.begin(), indices.end());
         }
 
-        // *******************************************************************
+        inline IndexLookup make_index_lookup(IndexSequenceRange const &indices)
+        {
+            return IndexLookup(indices);
+        }
+
+        //**********************************************************************
+        /**
+         * Extracts a series of values from the vector based on the passed in
+         * indices.
+         * @tparam CScalarT  The type of the output scalar.
+         * @tparam AScalarT  The type of the input scalar.
+         * @tparam SequenceT A container of indices (or IndexSequenceRange)
+         *
+         * @param vec_dest The output vector.
+         * @param vec_src  The input vector.
+         * @param indices  Sequence of indices to extract (can be out of order
+         *                 and contain duplicates).
+         */
         template<typename CScalarT,
                  typename AScalarT,
                  typename SequenceT>
         void vectorExtract(
                 std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
                 std::vector<std::tuple<IndexType, AScalarT> > const &vec_src,
-                SequenceT                                            indices)
+                SequenceT                                     const &indices)
         {
-            vectorExtract(vec_dest, vec_src, indices.begin(), indices.end());
+            GRB_LOG_VERBOSE("vectorExtract: sizeof(vec_src): " << vec_src.size());
+            make_index_lookup(indices).extract(vec_dest, vec_src);
         }
 
         // *******************************************************************
+        // w = u(indices) for a range of indices: merged with the stored
+        // values of u.  (An explicit index list is gathered by vectorGather()
+        // in the platform's kernels.)
         template<typename CScalarT,
-                 typename AScalarT,
-                 typename RowIteratorT,
-                 typename ColIteratorT>
-        void matrixExtract(LilSparseMatrix<CScalarT>          &C,
-                           LilSparseMatrix<AScalarT>  const   &A,
-                           RowIteratorT                        row_begin,
-                           RowIteratorT                        row_end,
-                           ColIteratorT                        col_begin,
-                           ColIteratorT                        col_end)
+                 typename UVectorT>
+        void vectorGather(
+                std::vector<std::tuple<IndexType, CScalarT> > &vec_dest,
+                UVectorT                                const &u,
+                IndexSequenceRange                      const &indices)
         {
-            std::vector<std::tuple<IndexType,CScalarT> > out_row;
-            C.clear();
-
-            // Walk the rows
-            IndexType out_row_index = 0;
-
-            for (auto row_it = row_begin;
-                 row_it != row_end;
-                 ++row_it, ++out_row_index)
-            {
-                auto row(A[*row_it]);
-
-                // Extract the values from the row
-                vectorExtract(out_row, row, col_begin, col_end);
-
-                if (!out_row.empty())
-                    C.setRow(out_row_index, out_row);
-            }
+            vectorExtract(vec_dest, u.getContents(), indices);
         }
 
         // *******************************************************************
+        // C = AT(rows, cols) = A(cols, rows)': the rows of A named by the
+        // column list are matched against the row list and scattered into
+        // the columns of C (in increasing column order).
         template<typename CScalarT,
                  typename AMatrixT,
-                 typename RowIteratorT,
-                 typename ColIteratorT>
-        void matrixExtract(LilSparseMatrix<CScalarT>     &C,
-                           TransposeView<AMatrixT> const &AT,
-                           RowIteratorT                   row_begin, // of AT
-                           RowIteratorT                   row_end,
-                           ColIteratorT                   col_begin, // of AT
-                           ColIteratorT                   col_end)
+                 typename ColSequenceT>
+        void matrixExtractTransposed(
+            LilSparseMatrix<CScalarT>     &C,
+            TransposeView<AMatrixT> const &AT,
+            IndexLookup             const &rows, // of AT
+            ColSequenceT            const &col_indices)
         {
             auto const &A(AT.m_mat);
             C.clear();
 
-            // Walk the rows of A (cols of AT) and put into columns of C.
-            IndexType out_row_idx = 0;
-
-            for (auto col_it = col_begin;  col_it != col_end;
-                 ++col_it, ++out_row_idx)
+            IndexType out_col_idx = 0;
+            for (auto col_it = col_indices.begin();
+                 col_it != col_indices.end();
+                 ++col_it, ++out_col_idx)
             {
-                GRB_LOG_VERBOSE("matrixExtract(AT): out_row(C)=" << out_row_idx
-                                << ", in_col(AT): " << *col_it);
-
-                // Extract the values from the rows of A (cols of AT) and place
-                // them into the *colums* of C
-                //
-                // Emplace_back version of:
-                //    vectorExtract(out_row, A[*col_it], row_begin, row_end);
-
-                IndexType out_col_idx = 0;
-                for (auto row_it = row_begin; row_it != row_end;
-                     ++row_it, ++out_col_idx)
-                {
-                    GRB_LOG_VERBOSE("matrixExtract(AT): out_col(C)=" << out_col_idx
-                                    << ", in_row(AT): " << *row_it);
-
-                    IndexType wanted_idx = *row_it;
-
-                    // Search through from the beginning of the row each to find
-                    // indices that match. This is expensive but the indices can
-                    // be duplicates and out of order.
-                    auto A_it = A[*col_it].begin();
-                    if (increment_while_below(A_it, A[*col_it].end(), wanted_idx))
+                rows.forEachMatch(
+                    A[*col_it],
+                    [&](IndexType out_row_idx, auto const &val)
                     {
-                        GRB_LOG_VERBOSE("C["<<out_row_idx << ","
-                                        << out_col_idx << "] := "
-                                        << std::get<1>(*A_it));
-
-                        C[out_col_idx].emplace_back(
-                            out_row_idx,
-                            static_cast<CScalarT>(std::get<1>(*A_it)));
-                    }
-                }
+                        C.mutableRow(out_row_idx).emplace_back(
+                            out_col_idx, static_cast<CScalarT>(val));
+                    });
             }
             C.recomputeNvals();
         }
@@ -217,11 +333,16 @@ namespace grb
         {
             // NOTE!! Backend code. We expect that all dimension checks done elsewhere.
 
-            matrixExtract(C, A,
-                          row_indices.begin(), row_indices.end(),
-                          col_indices.begin(), col_indices.end());
-
-
+            if constexpr (is_transpose_v<AMatrixT>)
+            {
+                matrixExtractTransposed(C, A, make_index_lookup(row_indices),
+                                        col_indices);
+            }
+            else
+            {
+                matrixExtractRows(C, A, row_indices,
+                                  make_index_lookup(col_indices));
+            }
         }
 
         //********************************************************************
@@ -235,23 +356,19 @@ namespace grb
         {
             vec_dest.clear();
 
-            // Walk the rows, extracting the cell if it exists
+            // Walk the rows, binary searching each for the column
             IndexType out_row_index = 0;
             for (IteratorT it = row_begin; it != row_end; ++it, ++out_row_index)
             {
-                // Find the column within the row
-                for (auto&& [tmp_idx, tmp_value] : A[*it])
+                auto const &row(A[*it]);
+                auto row_it(std::lower_bound(
+                                row.begin(), row.end(), col_index,
+                                [](auto const &elt, IndexType idx)
+                                { return std::get<0>(elt) < idx; }));
+                if ((row_it != row.end()) && (std::get<0>(*row_it) == col_index))
                 {
-                    if (tmp_idx == col_index)
-                    {
-                        vec_dest.emplace_back(out_row_index,
-                                              static_cast<WScalarT>(tmp_value));
-                        break;
-                    }
-                    else if (tmp_idx > col_index)
-                    {
-                        break;
-                    }
+                    vec_dest.emplace_back(out_row_index,
+                                          static_cast<WScalarT>(std::get<1>(*row_it)));
                 }
             }
         };
@@ -266,34 +383,8 @@ namespace grb
             IteratorT                                              row_end,
             IndexType                                              col_index)
         {
-            auto const &row(AT.m_mat[col_index]);
-            vec_dest.clear();
-
-            // Walk the row, extracting the cell if it exists and is in row_indices
-
-            /// @todo Perf. can be improved for 'in order' row_indices
-            /// with "continuation"
-            IndexType out_row_index = 0;
-
-            for (IteratorT it = row_begin; it != row_end; ++it, ++out_row_index)
-            {
-                /// @todo Perf: replace this scan with a binary search
-
-                // Costly: keep rewalking same row due to duplicates
-                // and/or out of order indices
-                for (auto&& [in_row_index, in_val] : row)
-                {
-                    if (in_row_index == *it)
-                    {
-                        vec_dest.emplace_back(
-                            out_row_index, static_cast<WScalarT>(in_val));
-                    }
-                    else if (in_row_index > *it)
-                    {
-                        break;
-                    }
-                }
-            }
+            IndexLookup(row_begin, row_end).extract(vec_dest,
+                                                    AT.m_mat[col_index]);
         }
 
         //**********************************************************************
@@ -330,9 +421,9 @@ namespace grb
             // Extract to T
             using UScalarType =typename UVectorT::ScalarType;
             std::vector<std::tuple<IndexType, UScalarType> > t;
-            vectorExtract(t, u.getContents(),
-                          setupIndices(indices,
-                                       std::min(w.size(), u.size())));
+            vectorGather(t, u,
+                         setupIndices(indices,
+                                      std::min(w.size(), u.size())));
 
             GRB_LOG_VERBOSE("t: " << t);
 
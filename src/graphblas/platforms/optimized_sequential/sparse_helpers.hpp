@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -41,6 +42,8 @@
 #include <graphblas/algebra.hpp>
 #include <graphblas/indices.hpp>
 
+#include "SparseAccumulator.hpp"
+
 //****************************************************************************
 
 namespace grb
@@ -62,6 +65,66 @@ namespace grb
             os << std::endl;
         }
 
+        //**********************************************************************
+        /// Call f(row_idx) for each row that may be non-empty in any of the
+        /// given matrices (in increasing order).  Only the stored rows are
+        /// visited when all of the matrices are hypersparse, otherwise all
+        /// rows are.  f may modify the matrices.
+        template <typename FunctionT,
+                  typename MatrixT,
+                  typename... MatrixTs>
+        void for_each_row_union(FunctionT           f,
+                                MatrixT      const &mat,
+                                MatrixTs     const &... mats)
+        {
+            if (!(mat.hypersparse() && (mats.hypersparse() && ...)))
+            {
+                for (IndexType row_idx = 0; row_idx < mat.nrows(); ++row_idx)
+                {
+                    f(row_idx);
+                }
+                return;
+            }
+
+            IndexArrayType rows;
+            auto add_row([&rows](IndexType row_idx, auto const &)
+                         { rows.push_back(row_idx); });
+            mat.forEachRow(add_row);
+            (mats.forEachRow(add_row), ...);
+
+            if (sizeof...(MatrixTs) > 0)
+            {
+                std::sort(rows.begin(), rows.end());
+                rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+            }
+
+            for (auto row_idx : rows)
+            {
+                f(row_idx);
+            }
+        }
+
+        //**********************************************************************
+        /// Upper bound on the number of non-empty rows in a matrix, for
+        /// sizing the storage of results with reserveRows().
+        template <typename MatrixT>
+        IndexType max_nonempty_rows(MatrixT const &mat)
+        {
+            return (mat.hypersparse() ? std::min(mat.nvals(), mat.nrows())
+                                      : mat.nrows());
+        }
+
+        //**********************************************************************
+        /// Pick the storage of C before writing into it rows that may be
+        /// non-empty in any of the given matrices, so that a large result
+        /// is not built in (and left in) hypersparse storage.
+        template <typename CMatrixT,
+                  typename... MatrixTs>
+        void reserve_row_union(CMatrixT &C, MatrixTs const &... mats)
+        {
+            C.reserveRows(max_nonempty_rows(C) + (max_nonempty_rows(mats) + ...));
+        }
+
         //**********************************************************************
 
         template <typename DstMatrixT,
@@ -74,11 +137,10 @@ namespace grb
 
             // Copying removes the contents of the other matrix so clear it first.
             dstMatrix.clear();
+            dstMatrix.reserveRows(max_nonempty_rows(srcMatrix));
 
-            IndexType nrows(dstMatrix.nrows());
-            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            srcMatrix.forEachRow([&](IndexType row_idx, auto const &srcRow)
             {
-                auto&& srcRow = srcMatrix[row_idx];
                 dstRow.clear();
 
                 // We need to construct a new row with the appropriate cast!
@@ -87,9 +149,8 @@ namespace grb
                     dstRow.emplace_back(idx, static_cast<DstScalarType>(srcVal));
                 }
 
-                if (!dstRow.empty())
-                    dstMatrix.setRow(row_idx, dstRow);
-            }
+                dstMatrix.setRow(row_idx, dstRow);
+            });
         }
 
         // @todo: Make a sparse copy where they are the same type for efficiency
@@ -184,6 +245,9 @@ namespace grb
                         value_set = true;
                     }
 
+                    // nothing can change a terminal value (e.g. logical or)
+                    if (is_terminal(op, ans)) break;
+
                     do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
                     ++A_iter;
                 }
@@ -236,6 +300,8 @@ namespace grb
                         value_set = true;
                     }
 
+                    if (is_terminal(op, ans)) break;
+
                     ++v2_it;
                     ++v1_it;
                 }
@@ -253,12 +319,14 @@ namespace grb
         }
 
         //************************************************************************
-        /// A dot product of two sparse vectors (vectors<tuple(index,value)>)
-        template <typename D1, typename D2, typename D3, typename SemiringT>
-        bool dot_rev(D3                                                &ans,
-                     std::vector<std::tuple<grb::IndexType,D1> > const &vec2,
-                     std::vector<std::tuple<grb::IndexType,D2> > const &vec1,
-                     SemiringT                                          op)
+        /// A dot product of two sparse vectors (vectors<tuple(index,value)>
+        /// or any other forward range of sorted tuples, e.g., a vector's
+        /// contents() view)
+        template <typename Seq2T, typename Seq1T, typename D3, typename SemiringT>
+        bool dot_rev(D3                &ans,
+                     Seq2T       const &vec2,
+                     Seq1T       const &vec1,
+                     SemiringT          op)
         {
             bool value_set(false);
 
@@ -288,6 +356,8 @@ namespace grb
                         value_set = true;
                     }
 
+                    if (is_terminal(op, ans)) break;
+
                     ++v2_it;
                     ++v1_it;
                 }
@@ -305,37 +375,43 @@ namespace grb
         }
 
         //************************************************************************
-        /// A reduction of a sparse vector (vector<tuple(index,value)>) using a
-        /// binary op or a monoid.
-        template <typename D1, typename D3, typename BinaryOpT>
+        /// A reduction of a sparse vector (vector<tuple(index,value)> or a
+        /// vector's contents() view) using a binary op or a monoid.
+        template <typename SequenceT, typename D3, typename BinaryOpT>
         bool reduction(
-            D3                                                &ans,
-            std::vector<std::tuple<grb::IndexType,D1> > const &vec,
-            BinaryOpT                                          op)
+            D3                &ans,
+            SequenceT   const &vec,
+            BinaryOpT          op)
         {
             if (vec.empty())
             {
                 return false;
             }
 
+            using D1 = std::tuple_element_t<
+                1, typename std::iterator_traits<
+                       decltype(vec.begin())>::value_type>;
             using D3ScalarType =
                 decltype(op(std::declval<D1>(), std::declval<D1>()));
             D3ScalarType tmp;
 
-            if (vec.size() == 1)
+            auto it = vec.begin();
+            D1 first(std::get<1>(*it));
+            if (++it == vec.end())
             {
-                tmp = static_cast<D3ScalarType>(std::get<1>(vec[0]));
+                tmp = static_cast<D3ScalarType>(first);
             }
             else
             {
                 /// @note Since op is associative and commutative left to right
                 /// ordering is not strictly required.
-                tmp = op(std::get<1>(vec[0]), std::get<1>(vec[1]));
+                tmp = op(first, std::get<1>(*it));
 
                 /// @todo replace with call to std::reduce?
-                for (size_t idx = 2; idx < vec.size(); ++idx)
+                for (++it; it != vec.end(); ++it)
                 {
-                    tmp = op(tmp, std::get<1>(vec[idx]));
+                    if (is_terminal(op, tmp)) break;
+                    tmp = op(tmp, std::get<1>(*it));
                 }
             }
 
@@ -348,10 +424,12 @@ namespace grb
         /// ans = op(vec1, vec2)
         ///
         /// @note ans must be a unique vector from either vec1 or vec2
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// @note vec1 and vec2 may be any forward ranges of tuples sorted by
+        ///       index (e.g., a vector's contents() view).
+        template <typename Seq1T, typename Seq2T, typename D3, typename BinaryOpT>
         void ewise_or(std::vector<std::tuple<grb::IndexType,D3> >       &ans,
-                      std::vector<std::tuple<grb::IndexType,D1> > const &vec1,
-                      std::vector<std::tuple<grb::IndexType,D2> > const &vec2,
+                      Seq1T                                       const &vec1,
+                      Seq2T                                       const &vec2,
                       BinaryOpT                                          op)
         {
             if (((void*)&ans == (void*)&vec1) || ((void*)&ans == (void*)&vec2))
@@ -549,7 +627,7 @@ namespace grb
             BinaryOpT                                               accum)
         {
             // If there is an accumulate operations, do nothing with the stencil
-            ewise_or(z, w.getContents(), t, accum);
+            ewise_or(z, w.contents(), t, accum);
         }
 
         //**********************************************************************
@@ -651,13 +729,16 @@ namespace grb
             using ZRowType = std::vector<std::tuple<IndexType,ZScalarType> >;
 
             ZRowType tmp_row;
-            IndexType nRows(Z.nrows());
 
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                ewise_or(tmp_row, C[row_idx], T[row_idx], accum);
-                Z.setRow(row_idx, tmp_row);
-            }
+            // Z is empty on entry
+            Z.reserveRows(max_nonempty_rows(C) + max_nonempty_rows(T));
+            for_each_row_union(
+                [&](IndexType row_idx)
+                {
+                    ewise_or(tmp_row, C[row_idx], T[row_idx], accum);
+                    Z.setRow(row_idx, tmp_row);
+                },
+                Z, C, T);
         }
 
         //**********************************************************************
@@ -686,7 +767,7 @@ namespace grb
             BinaryOpT                                               accum)
         {
             //z.clear();
-            ewise_or(z, w.getContents(), t, accum);
+            ewise_or(z, w.contents(), t, accum);
         }
 
         //**********************************************************************
@@ -735,11 +816,12 @@ namespace grb
         }
 
         //************************************************************************
-        /// Apply element-wise operation to intersection of sparse vectors.
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// Apply element-wise operation to intersection of sparse vectors
+        /// (any forward ranges of tuples sorted by index).
+        template <typename Seq1T, typename Seq2T, typename D3, typename BinaryOpT>
         void ewise_and(std::vector<std::tuple<grb::IndexType,D3> >       &ans,
-                       std::vector<std::tuple<grb::IndexType,D1> > const &vec1,
-                       std::vector<std::tuple<grb::IndexType,D2> > const &vec2,
+                       Seq1T                                       const &vec1,
+                       Seq2T                                       const &vec2,
                        BinaryOpT                                          op)
         {
             ans.clear();
@@ -788,9 +870,11 @@ namespace grb
          * \f[ L(C) = {(i,j,Zij):(i,j) \in (ind(C) \cap ind(\neg M))} \cup
          *            {(i,j,Zij):(i,j) \in (ind(Z) \cap ind(\neg M))} \f]
          *
-         * @tparam CScalarT The scalar type of the C vector input AND result.
-         * @tparam ZScalarT The scalar type of the Z vector input.
-         * @tparam MScalarT The scalar type of the mask vector.
+         * @tparam CScalarT   The scalar type of the C vector input AND result.
+         * @tparam CSequenceT Sorted (index, CScalarT) tuples, e.g., the
+         *                    contents() view of the C vector.
+         * @tparam ZScalarT   The scalar type of the Z vector input.
+         * @tparam MSequenceT Sorted (index, value) tuples of the mask.
          *
          * @param result   Result vector.  We clear this first.
          * @param c_vec    The original c values that may be carried through.
@@ -800,13 +884,14 @@ namespace grb
          *                 by the mask regardless if they are overlayed.
          */
         template < typename CScalarT,
+                   typename CSequenceT,
                    typename ZScalarT,
-                   typename MScalarT>
+                   typename MSequenceT>
         void apply_with_mask(
             std::vector<std::tuple<IndexType, CScalarT> >          &result,
-            std::vector<std::tuple<IndexType, CScalarT> > const    &c_vec,
+            CSequenceT                                      const  &c_vec,
             std::vector<std::tuple<IndexType, ZScalarT> > const    &z_vec,
-            std::vector<std::tuple<IndexType, MScalarT> > const    &mask_vec,
+            MSequenceT                                      const  &mask_vec,
             OutputControlEnum                                       outp)
         {
             auto c_it = c_vec.begin();
@@ -964,16 +1049,21 @@ namespace grb
             using CScalarType = typename CMatrixT::ScalarType;
             using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
 
+            // Rows that are empty in both C and Z stay empty
             CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                Mask[row_idx], outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            reserve_row_union(C, Z);
+            for_each_row_union(
+                [&](IndexType row_idx)
+                {
+                    apply_with_mask(tmp_row, std::as_const(C)[row_idx],
+                                    Z[row_idx],
+                                    Mask[row_idx],
+                                    outp);
+
+                    // Now, set the new one.  Yes, we can optimize this later
+                    C.setRow(row_idx, tmp_row);
+                },
+                C, Z);
         }
 
         //**********************************************************************
@@ -990,17 +1080,21 @@ namespace grb
             using CScalarType = typename CMatrixT::ScalarType;
             using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
 
+            // Rows that are empty in both C and Z stay empty
             CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                get_complement_row(Mask.m_mat, row_idx),
-                                outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            reserve_row_union(C, Z);
+            for_each_row_union(
+                [&](IndexType row_idx)
+                {
+                    apply_with_mask(tmp_row, std::as_const(C)[row_idx],
+                                    Z[row_idx],
+                                    get_complement_row(Mask.m_mat, row_idx),
+                                    outp);
+
+                    // Now, set the new one.  Yes, we can optimize this later
+                    C.setRow(row_idx, tmp_row);
+                },
+                C, Z);
         }
 
         //**********************************************************************
@@ -1017,17 +1111,21 @@ namespace grb
             using CScalarType = typename CMatrixT::ScalarType;
             using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
 
+            // Rows that are empty in both C and Z stay empty
             CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                get_structure_row(Mask.m_mat, row_idx),
-                                outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            reserve_row_union(C, Z);
+            for_each_row_union(
+                [&](IndexType row_idx)
+                {
+                    apply_with_mask(tmp_row, std::as_const(C)[row_idx],
+                                    Z[row_idx],
+                                    get_structure_row(Mask.m_mat, row_idx),
+                                    outp);
+
+                    // Now, set the new one.  Yes, we can optimize this later
+                    C.setRow(row_idx, tmp_row);
+                },
+                C, Z);
         }
 
         //**********************************************************************
@@ -1044,17 +1142,21 @@ namespace grb
             using CScalarType = typename CMatrixT::ScalarType;
             using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
 
+            // Rows that are empty in both C and Z stay empty
             CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                get_structural_complement_row(Mask.m_mat, row_idx),
-                                outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            reserve_row_union(C, Z);
+            for_each_row_union(
+                [&](IndexType row_idx)
+                {
+                    apply_with_mask(tmp_row, std::as_const(C)[row_idx],
+                                    Z[row_idx],
+                                    get_structural_complement_row(Mask.m_mat, row_idx),
+                                    outp);
+
+                    // Now, set the new one.  Yes, we can optimize this later
+                    C.setRow(row_idx, tmp_row);
+                },
+                C, Z);
         }
 
         //**********************************************************************
@@ -1081,7 +1183,8 @@ namespace grb
         {
             std::vector<std::tuple<IndexType, bool> > mask_tuples;
 
-            for (auto [ix, val] : vec.getContents())
+            mask_tuples.reserve(vec.nvals());
+            for (auto [ix, val] : vec.contents())
             {
                 mask_tuples.emplace_back(ix, true);
             }
@@ -1096,7 +1199,7 @@ namespace grb
         get_complement_contents(VectorT const &vec)
         {
             std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            auto row_tuples(vec.getContents());
+            auto row_tuples(vec.contents());
             auto it = row_tuples.begin();
 
             for (IndexType ix = 0; ix < vec.size(); ++ix)
@@ -1125,7 +1228,7 @@ namespace grb
         get_structural_complement_contents(VectorT const &vec)
         {
             std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            auto row_tuples(vec.getContents());
+            auto row_tuples(vec.contents());
             auto it = row_tuples.begin();
 
             for (IndexType ix = 0; ix < vec.size(); ++ix)
@@ -1157,8 +1260,8 @@ namespace grb
             using WScalarType = typename WVectorT::ScalarType;
             std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
 
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            mask.getContents(),
+            apply_with_mask(tmp_row, w.contents(), z,
+                            mask.contents(),
                             outp);
 
             // Now, set the new one.  Yes, we can optimize this later
@@ -1179,7 +1282,7 @@ namespace grb
             using WScalarType = typename WVectorT::ScalarType;
             std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
 
-            apply_with_mask(tmp_row, w.getContents(), z,
+            apply_with_mask(tmp_row, w.contents(), z,
                             get_complement_contents(mask.m_vec),
                             outp);
 
@@ -1201,7 +1304,7 @@ namespace grb
             using WScalarType = typename WVectorT::ScalarType;
             std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
 
-            apply_with_mask(tmp_row, w.getContents(), z,
+            apply_with_mask(tmp_row, w.contents(), z,
                             get_structure_contents(mask.m_vec),
                             outp);
 
@@ -1224,7 +1327,7 @@ namespace grb
             using WScalarType = typename WVectorT::ScalarType;
             std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
 
-            apply_with_mask(tmp_row, w.getContents(), z,
+            apply_with_mask(tmp_row, w.contents(), z,
                             get_structural_complement_contents(mask.m_vec),
                             outp);
 
@@ -1474,6 +1577,336 @@ namespace grb
             GRB_LOG_FN_END("masked_axpy");
         }
 
+        // *******************************************************************
+        /// @return the number of products generated computing a +.* B
+        template<typename ASequenceT, typename BMatrixT>
+        IndexType axpy_flops(
+            ASequenceT                                   const &a,
+            BMatrixT                                     const &B)
+        {
+            IndexType flops(0);
+            for (auto const &a_elt : a)
+            {
+                flops += B[std::get<0>(a_elt)].size();
+            }
+            return flops;
+        }
+
+        // *******************************************************************
+        /// Compute one row of a sparse matrix product using Gustavson's
+        /// algorithm (sum of a_k*B[k] over the stored a_k).  The sum is
+        /// formed in the accumulator (dense SPA or hash table as chosen by
+        /// the flop count) instead of by repeated merges into t.
+        ///
+        /// t = a +.* B, t is overwritten
+        template<typename TScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BMatrixT>
+        void spa_axpy_row(
+            std::vector<std::tuple<IndexType, TScalarT>>       &t,
+            SparseAccumulator<TScalarT>                        &spa,
+            SemiringT                                           semiring,
+            std::vector<std::tuple<IndexType, AScalarT>> const &a,
+            BMatrixT                                     const &B)
+        {
+            t.clear();
+
+            IndexType flops(0);
+            IndexType num_rows(0);
+            for (auto const &a_elt : a)
+            {
+                IndexType b_size(B[std::get<0>(a_elt)].size());
+                flops += b_size;
+                num_rows += (b_size > 0) ? 1 : 0;
+            }
+
+            if (num_rows <= 1)
+            {
+                // a single contribution (no merging required)
+                for (auto&& [k, a_k] : a)
+                {
+                    if (!B[k].empty()) axpy(t, semiring, a_k, B[k]);
+                }
+                return;
+            }
+
+            auto add_op([&semiring](auto lhs, auto rhs)
+                        { return semiring.add(lhs, rhs); });
+
+            spa.start_row(flops);
+            for (auto&& [k, a_k] : a)
+            {
+                for (auto&& [j, b_kj] : B[k])
+                {
+                    spa.accumulate(j, semiring.mult(a_k, b_kj), add_op);
+                }
+            }
+            spa.gather(t);
+        }
+
+        // *******************************************************************
+        /// Masked version of spa_axpy_row: products are only formed for
+        /// locations allowed by the mask.
+        ///
+        /// t<[!]m> = a +.* B, t is overwritten
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BMatrixT>
+        void spa_masked_axpy_row(
+            std::vector<std::tuple<IndexType, TScalarT>>       &t,
+            SparseAccumulator<TScalarT>                        &spa,
+            std::vector<std::tuple<IndexType, MScalarT>> const &m,
+            bool                                                structure_flag,
+            bool                                                complement_flag,
+            SemiringT                                           semiring,
+            std::vector<std::tuple<IndexType, AScalarT>> const &a,
+            BMatrixT                                     const &B)
+        {
+            if (m.empty())
+            {
+                if (complement_flag)
+                {
+                    spa_axpy_row(t, spa, semiring, a, B);
+                }
+                else
+                {
+                    t.clear();
+                }
+                return;
+            }
+
+            t.clear();
+
+            IndexType flops(axpy_flops(a, B));
+            if (flops == 0) return;
+
+            // the answer cannot have more entries than the mask
+            if (!complement_flag)
+            {
+                flops = std::min<IndexType>(flops, m.size());
+            }
+
+            auto add_op([&semiring](auto lhs, auto rhs)
+                        { return semiring.add(lhs, rhs); });
+
+            spa.start_row(flops);
+            spa.set_mask(m, structure_flag, complement_flag);
+            for (auto&& [k, a_k] : a)
+            {
+                for (auto&& [j, b_kj] : B[k])
+                {
+                    if (spa.allows(j))
+                    {
+                        spa.accumulate(j, semiring.mult(a_k, b_kj), add_op);
+                    }
+                }
+            }
+            spa.clear_mask();
+            spa.gather(t);
+        }
+
+        //**********************************************************************
+        // Vector mask queries, used to push the mask into the mxv/vxm kernels
+        // so that masked out locations are never computed.
+        //**********************************************************************
+
+        /// @return true if the mask allows a value to be written at index
+        inline bool mask_allows(grb::NoMask const &, IndexType)
+        {
+            return true;
+        }
+
+        template <typename MaskT>
+        bool mask_allows(MaskT const &mask, IndexType index)
+        {
+            return (mask.hasElement(index) &&
+                    static_cast<bool>(mask.extractElement(index)));
+        }
+
+        template <typename MaskT>
+        bool mask_allows(grb::VectorStructureView<MaskT> const &mask,
+                         IndexType                              index)
+        {
+            return mask.m_vec.hasElement(index);
+        }
+
+        template <typename MaskT>
+        bool mask_allows(grb::VectorComplementView<MaskT> const &mask,
+                         IndexType                               index)
+        {
+            return !mask_allows(mask.m_vec, index);
+        }
+
+        template <typename MaskT>
+        bool mask_allows(grb::VectorStructuralComplementView<MaskT> const &mask,
+                         IndexType                                         index)
+        {
+            return !mask.m_vec.hasElement(index);
+        }
+
+        //**********************************************************************
+        /// Call fn(index) in increasing order for every index in [0, n) that
+        /// the mask allows.  O(nvals) for value and structure masks, O(n) for
+        /// complemented masks and NoMask.
+        template <typename MaskT, typename FnT>
+        void for_each_allowed(MaskT const &mask, IndexType n, FnT fn)
+        {
+            for (auto&& [idx, val] : mask.contents())
+            {
+                if (static_cast<bool>(val)) fn(idx);
+            }
+        }
+
+        template <typename FnT>
+        void for_each_allowed(grb::NoMask const &, IndexType n, FnT fn)
+        {
+            for (IndexType idx = 0; idx < n; ++idx) fn(idx);
+        }
+
+        template <typename MaskT, typename FnT>
+        void for_each_allowed(grb::VectorStructureView<MaskT> const &mask,
+                              IndexType n, FnT fn)
+        {
+            for (auto&& [idx, val] : mask.m_vec.contents()) fn(idx);
+        }
+
+        template <typename MaskT, typename FnT>
+        void for_each_allowed(grb::VectorComplementView<MaskT> const &mask,
+                              IndexType n, FnT fn)
+        {
+            for (IndexType idx = 0; idx < n; ++idx)
+            {
+                if (mask_allows(mask, idx)) fn(idx);
+            }
+        }
+
+        template <typename MaskT, typename FnT>
+        void for_each_allowed(
+            grb::VectorStructuralComplementView<MaskT> const &mask,
+            IndexType n, FnT fn)
+        {
+            for (IndexType idx = 0; idx < n; ++idx)
+            {
+                if (mask_allows(mask, idx)) fn(idx);
+            }
+        }
+
+        //************************************************************************
+        /// Pull (dot product) formulation of one element of u*A': instead of
+        /// merging with the contents of u, each stored A[i][k] looks up u[k]
+        /// directly so the cost is O(|A[i]|) rather than O(|A[i]| + nvals(u)).
+        ///
+        /// ans = sum_k op.mult(u[k], a[k])
+        template <typename D3ScalarT,
+                  typename UVectorT,
+                  typename AScalarT,
+                  typename SemiringT>
+        bool dot_lookup(
+            D3ScalarT                                            &ans,
+            UVectorT                                       const &u,
+            std::vector<std::tuple<IndexType, AScalarT> >  const &a,
+            SemiringT                                             op)
+        {
+            bool value_set(false);
+            for (auto&& [k, a_k] : a)
+            {
+                if (u.hasElement(k))
+                {
+                    if (value_set)
+                    {
+                        ans = op.add(ans, op.mult(u.extractElement(k), a_k));
+                    }
+                    else
+                    {
+                        ans = op.mult(u.extractElement(k), a_k);
+                        value_set = true;
+                    }
+
+                    if (is_terminal(op, ans)) break;
+                }
+            }
+            return value_set;
+        }
+
+        //************************************************************************
+        /// Pull formulation of one element of A*u (operands of mult are in
+        /// the A*u order).
+        ///
+        /// ans = sum_k op.mult(a[k], u[k])
+        template <typename D3ScalarT,
+                  typename AScalarT,
+                  typename UVectorT,
+                  typename SemiringT>
+        bool dot_rev_lookup(
+            D3ScalarT                                            &ans,
+            std::vector<std::tuple<IndexType, AScalarT> >  const &a,
+            UVectorT                                       const &u,
+            SemiringT                                             op)
+        {
+            bool value_set(false);
+            for (auto&& [k, a_k] : a)
+            {
+                if (u.hasElement(k))
+                {
+                    if (value_set)
+                    {
+                        ans = op.add(ans, op.mult(a_k, u.extractElement(k)));
+                    }
+                    else
+                    {
+                        ans = op.mult(a_k, u.extractElement(k));
+                        value_set = true;
+                    }
+
+                    if (is_terminal(op, ans)) break;
+                }
+            }
+            return value_set;
+        }
+
+        // *******************************************************************
+        /// Push (axpy) formulation of u*A with a vector mask: products are
+        /// only formed for the output locations the mask allows.
+        ///
+        /// t<mask> = u +.* A, t is overwritten
+        template<typename TScalarT,
+                 typename MaskT,
+                 typename SemiringT,
+                 typename USequenceT,
+                 typename AMatrixT>
+        void spa_vector_masked_axpy(
+            std::vector<std::tuple<IndexType, TScalarT>>       &t,
+            SparseAccumulator<TScalarT>                        &spa,
+            MaskT                                        const &mask,
+            SemiringT                                           semiring,
+            USequenceT                                   const &u,
+            AMatrixT                                     const &A)
+        {
+            t.clear();
+
+            IndexType flops(axpy_flops(u, A));
+            if (flops == 0) return;
+
+            auto add_op([&semiring](auto lhs, auto rhs)
+                        { return semiring.add(lhs, rhs); });
+
+            spa.start_row(flops);
+            for (auto&& [k, u_k] : u)
+            {
+                for (auto&& [j, a_kj] : A[k])
+                {
+                    if (mask_allows(mask, j))
+                    {
+                        spa.accumulate(j, semiring.mult(u_k, a_kj), add_op);
+                    }
+                }
+            }
+            spa.gather(t);
+        }
+
         // *******************************************************************
         /// Perform the following operation on sparse vectors implemented as
         /// vector<tuple<Index, value>> (t assumed to be masked already)
@@ -1574,7 +2007,6 @@ namespace grb
             GRB_LOG_FN_BEGIN("masked_merge.v2");
             auto m_it = m.begin();
             auto c_it = ci.begin();
-            auto z_it = z.begin();
 
             c.clear();
 
@@ -1615,5 +2047,23 @@ namespace grb
             GRB_LOG_FN_END("masked_merge.v2");
         }
 
+        //**********************************************************************
+        // Build the rows of A' (the columns of A), for the A'*B kernels
+        template<typename AScalarT>
+        inline LilSparseMatrix<AScalarT> ATB_transpose(
+            LilSparseMatrix<AScalarT> const &A)
+        {
+            LilSparseMatrix<AScalarT> AT(A.ncols(), A.nrows());
+            for (IndexType k = 0; k < A.nrows(); ++k)
+            {
+                for (auto&& [i, a_ki] : A[k])
+                {
+                    AT.mutableRow(i).emplace_back(k, a_ki);
+                }
+            }
+            AT.recomputeNvals();
+            return AT;
+        }
+
     } // backend
 } // grb
@@ -0,0 +1,222 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+/**
+ * Row loop kernels of the optimized backend, in their sequential form.
+ *
+ * The operations in this directory are shared with the openmp platform and
+ * include this file as <sparse_kernels.hpp> (angle brackets, not quotes) so
+ * that it resolves to the configured platform's directory; openmp provides
+ * multithreaded versions of the same functions with the same signatures.
+ */
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include "sparse_helpers.hpp"
+#include "LilSparseMatrix.hpp"
+
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Compute t = [(i, dot(A[i]))] for every non-empty row of A that the
+        /// mask allows (pull formulation of mxv and vxm).  dot_fn(t_val, A[i])
+        /// returns true when the result is stored.
+        template <typename TScalarT,
+                  typename MatrixT,
+                  typename MaskT,
+                  typename DotFnT>
+        void masked_row_dots(
+            std::vector<std::tuple<IndexType, TScalarT> > &t,
+            MatrixT                                 const &A,
+            MaskT                                   const &mask,
+            DotFnT                                         dot_fn)
+        {
+            for_each_allowed(
+                mask, A.nrows(),
+                [&](IndexType row_idx)
+                {
+                    TScalarT t_val;
+                    if (!A[row_idx].empty() && dot_fn(t_val, A[row_idx]))
+                    {
+                        t.emplace_back(row_idx, t_val);
+                    }
+                });
+        }
+
+        //**********************************************************************
+        /// Compute t<mask> = sum_k u[k]*A[k] over the stored values of u
+        /// (push formulation of mxv and vxm), only forming the products that
+        /// the mask allows.
+        template <typename TScalarT,
+                  typename SemiringT,
+                  typename USequenceT,
+                  typename MatrixT,
+                  typename MaskT>
+        void masked_vector_axpy(
+            std::vector<std::tuple<IndexType, TScalarT> > &t,
+            SemiringT                                      op,
+            USequenceT                              const &u_contents,
+            MatrixT                                 const &A,
+            MaskT                                   const &mask)
+        {
+            SparseAccumulator<TScalarT> spa(A.ncols());
+            spa_vector_masked_axpy(t, spa, mask, op, u_contents, A);
+        }
+
+        //**********************************************************************
+        /// Compute t = [(i, op_j(A[i][j]))] for the non-empty rows of A.
+        template <typename TScalarT,
+                  typename MatrixT,
+                  typename BinaryOpT>
+        void reduce_rows(
+            std::vector<std::tuple<IndexType, TScalarT> > &t,
+            MatrixT                                 const &A,
+            BinaryOpT                                      op)
+        {
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
+            {
+                /// @todo There is something hinky with domains here.  How
+                /// does one perform the reduction in A domain but produce
+                /// partial results in D3(op)?
+                TScalarT t_val;
+                if (reduction(t_val, a_row, op))
+                {
+                    t.emplace_back(row_idx, t_val);
+                }
+            });
+        }
+
+        //**********************************************************************
+        /// T := the elements A(i, j) of A for which op(A(i, j), i, j, val)
+        /// is true.  T must be empty; the caller recomputes T's nvals.
+        template <typename TScalarT,
+                  typename MatrixT,
+                  typename IndexUnaryOpT,
+                  typename ValueT>
+        void select_rows(LilSparseMatrix<TScalarT>       &T,
+                         MatrixT                   const &A,
+                         IndexUnaryOpT                    op,
+                         ValueT                    const &val)
+        {
+            T.reserveRows(max_nonempty_rows(A));
+
+            A.forEachRow([&](IndexType row_idx, auto const &a_row)
+            {
+                for (auto&& [a_idx, a_val] : a_row)
+                {
+                    if (op(a_val, row_idx, a_idx, val))
+                    {
+                        T.mutableRow(row_idx).emplace_back(a_idx, a_val);
+                    }
+                }
+            });
+        }
+
+        //**********************************************************************
+        /// Call f(row_idx, row) for the non-empty rows of A, where f may
+        /// modify (or clear) the row it is given but no other row of A.  The
+        /// caller recomputes A's nvals.
+        template <typename MatrixT,
+                  typename FunctionT>
+        void update_rows(MatrixT &A, FunctionT f)
+        {
+            A.forEachRow(f);
+        }
+
+        // *******************************************************************
+        // w = u(indices) for an explicit index list: every index is looked
+        // up in u directly, O(|indices|) (times log(nvals) when u is stored
+        // sparse), instead of sorting the list to merge it with the stored
+        // values.  This is the gather f(f) of pointer jumping.  The indices
+        // must already have been checked against u.size().
+        template<typename CScalarT,
+                 typename UVectorT,
+                 typename SequenceT>
+        void vectorGather(
+                std::vector<std::tuple<IndexType, CScalarT> > &vec_dest,
+                UVectorT                                const &u,
+                SequenceT                               const &indices)
+        {
+            vec_dest.clear();
+            if (u.nvals() == 0) return;
+
+            IndexType pos(0);
+            typename UVectorT::ScalarType u_val;
+            for (auto it = indices.begin(); it != indices.end(); ++it, ++pos)
+            {
+                if (u.lookupElement(*it, u_val))
+                {
+                    vec_dest.emplace_back(pos, static_cast<CScalarT>(u_val));
+                }
+            }
+        }
+
+        // *******************************************************************
+        // C = A(rows, cols): the column list is prepared once and matched
+        // against each requested row, so the cost is proportional to the
+        // requested rows and the output (see IndexLookup).
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename RowSequenceT,
+                 typename ColLookupT>
+        void matrixExtractRows(LilSparseMatrix<CScalarT>        &C,
+                               LilSparseMatrix<AScalarT> const  &A,
+                               RowSequenceT              const  &row_indices,
+                               ColLookupT                const  &cols)
+        {
+            std::vector<std::tuple<IndexType,CScalarT> > out_row;
+            C.clear();
+
+            // Walk the rows
+            IndexType out_row_index = 0;
+            for (auto row_it = row_indices.begin();
+                 row_it != row_indices.end();
+                 ++row_it, ++out_row_index)
+            {
+                auto const &row(A[*row_it]);
+                if (row.empty()) continue;
+
+                // Extract the values from the row
+                cols.extract(out_row, row);
+
+                if (!out_row.empty())
+                    C.setRow(out_row_index, out_row);
+            }
+        }
+
+    } // backend
+} // grb
@@ -102,7 +102,7 @@ namespace grb
                             for (auto&& [col_idxB, val_B] : B[row_idxB])
                             {
                                 TScalarType T_val(op(val_A, val_B));
-                                T[T_row_idx].emplace_back(
+                                T.mutableRow(T_row_idx).emplace_back(
                                     (col_idxA*ncol_B + col_idxB), T_val);
                             }
                         }
@@ -189,7 +189,7 @@ namespace grb
                             for (auto&& [col_idxB, val_B] : B[row_idxB])
                             {
                                 TScalarType T_val(op(val_A, val_B));
-                                T[T_row_idx].emplace_back(
+                                T.mutableRow(T_row_idx).emplace_back(
                                     (row_idxA*ncol_B + col_idxB), T_val);
                             }
                         }
@@ -275,7 +275,7 @@ namespace grb
                             {
                                 TScalarType T_val(op(val_A, val_B));
                                 IndexType T_row_idx(row_idxA*ncol_B + col_idxB);
-                                T[T_row_idx].emplace_back(T_col_idx, T_val);
+                                T.mutableRow(T_row_idx).emplace_back(T_col_idx, T_val);
                             }
                         }
                     }
@@ -360,7 +360,7 @@ namespace grb
                             {
                                 TScalarType T_val(op(val_A, val_B));
                                 IndexType T_row_idx(col_idxA*ncol_B + col_idxB);
-                                T[T_row_idx].emplace_back(T_col_idx, T_val);
+                                T.mutableRow(T_row_idx).emplace_back(T_col_idx, T_val);
                             }
                         }
                     }
@@ -41,6 +41,8 @@
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_mxm_kernels.hpp>
 
 //****************************************************************************
 
@@ -48,337 +50,6 @@ namespace grb
 {
     namespace backend
     {
-
-        //**********************************************************************
-        //**********************************************************************
-
-        //**********************************************************************
-        // Perform C = A*B where C, A and B must all be unique
-        template<typename CScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void AB_NoMask_NoAccum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                T_row.clear();
-                for (auto const &Ai_elt : A[i])
-                {
-                    IndexType    k(std::get<0>(Ai_elt));
-                    AScalarT  a_ik(std::get<1>(Ai_elt));
-
-                    if (B[k].empty()) continue;
-
-                    // T[i] += (a_ik*B[k])  // must reduce in D3
-                    axpy(T_row, semiring, a_ik, B[k]);
-                }
-
-                // C[i] = T[i]
-                C.setRow(i, T_row);  // set even if it is empty.
-            }
-        }
-
-        //**********************************************************************
-        // Perform C = C + AB, where C, A, and B must all be unique
-        template<typename CScalarT,
-                 typename AccumT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void AB_NoMask_Accum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            AccumT                    const &accum,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                T_row.clear();
-                for (auto const &Ai_elt : A[i])
-                {
-                    IndexType    k(std::get<0>(Ai_elt));
-                    AScalarT  a_ik(std::get<1>(Ai_elt));
-
-                    if (B[k].empty()) continue;
-
-                    // T[i] += (a_ik*B[k])  // must reduce in D3
-                    axpy(T_row, semiring, a_ik, B[k]);
-                }
-
-                if (!T_row.empty())
-                {
-                    // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T_row, accum);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<M,z> = A +.* B where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void AB_Mask_NoAccum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<CScalarT>::RowType C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i) // compute row i of answer
-            {
-                bool const complement_flag = false;
-                T_row.clear();
-
-                // don't compute row if mask row is empty
-                if (!M[i].empty())
-                {
-                    for (auto const &Ai_elt : A[i])
-                    {
-                        IndexType    k(std::get<0>(Ai_elt));
-                        AScalarT  a_ik(std::get<1>(Ai_elt));
-
-                        if (B[k].empty()) continue;
-
-                        // T[i] += M[i] .* a_ik*B[k]
-                        masked_axpy(T_row,
-                                    M[i], structure_flag, complement_flag,
-                                    semiring, a_ik, B[k]);
-                    }
-                }
-
-                if (outp == REPLACE)
-                {
-                    // C[i] = T[i], z = "replace"
-                    C.setRow(i, T_row);  // set even if it is empty.
-                }
-                else
-                {
-                    // C[i] = [!M .* C]  U  T[i], z = "merge"
-                    C_row.clear();
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], T_row);
-                    C.setRow(i, C_row);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<M,z> = C + (A +.* B) where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename AccumT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void AB_Mask_Accum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            AccumT                    const &accum,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
-                                               std::declval<TScalarType>()));
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<ZScalarType>::RowType Z_row;
-            typename LilSparseMatrix<CScalarT>::RowType    C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i) // compute row i of answer
-            {
-                bool const complement_flag = false;  /// @todo constexpr?
-                T_row.clear();
-
-                if (!M[i].empty())
-                {
-                    for (auto const &Ai_elt : A[i])
-                    {
-                        IndexType    k(std::get<0>(Ai_elt));
-                        AScalarT  a_ik(std::get<1>(Ai_elt));
-
-                        if (B[k].empty()) continue;
-
-                        // T[i] += M[i] .* a_ik*B[k]
-                        masked_axpy(T_row,
-                                    M[i], structure_flag, complement_flag,
-                                    semiring, a_ik, B[k]);
-                    }
-                }
-
-                // Z[i] = (M .* C) + T[i]
-                Z_row.clear();
-                masked_accum(Z_row,
-                             M[i], structure_flag, complement_flag,
-                             accum, C[i], T_row);
-
-                if (outp == MERGE)
-                {
-                    // C[i]  = [!M .* C]  U  Z[i]
-                    C_row.clear();
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], Z_row);
-                    C.setRow(i, C_row);  // set even if it is empty.
-                }
-                else // z = replace
-                {
-                    // C[i] = Z[i]
-                    C.setRow(i, Z_row);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<!M,z> = (A +.* B) where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void AB_CompMask_NoAccum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<CScalarT>::RowType    Z_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i) // compute row i of answer
-            {
-                // if M[i] is empty it is like NoMask_NoAccum
-
-                bool const complement_flag = true;
-
-                T_row.clear();
-                for (auto const &Ai_elt : A[i])
-                {
-                    IndexType    k(std::get<0>(Ai_elt));
-                    AScalarT  a_ik(std::get<1>(Ai_elt));
-
-                    if (B[k].empty()) continue;
-
-                    // T[i] += !M[i] .* (a_ik*B[k])  // must reduce in D3
-                    masked_axpy(T_row,
-                                M[i], structure_flag, complement_flag,
-                                semiring, a_ik, B[k]);
-                }
-
-                if ((outp == REPLACE) || M[i].empty())
-                {
-                    // C[i] = T[i]
-                    C.setRow(i, T_row);  // set even if it is empty.
-                }
-                else
-                {
-                    Z_row.clear();
-                    // Z[i] = (M[i] .* C[i]) U T[i]
-                    masked_merge(Z_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], T_row);
-                    C.setRow(i, Z_row);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<!M,z> = C + (A +.* B) where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename AccumT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void AB_CompMask_Accum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            AccumT                    const &accum,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
-                                               std::declval<TScalarType>()));
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<ZScalarType>::RowType Z_row;
-            typename LilSparseMatrix<CScalarT>::RowType    C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i) // compute row i of answer
-            {
-                // if M[i] is empty it is like NoMask_NoAccum
-
-                bool const complement_flag = true;
-
-                T_row.clear();
-                for (auto const &Ai_elt : A[i])
-                {
-                    IndexType    k(std::get<0>(Ai_elt));
-                    AScalarT  a_ik(std::get<1>(Ai_elt));
-
-                    if (B[k].empty()) continue;
-
-                    // T[i] += !M[i] .* (a_ik*B[k])  // must reduce in D3
-                    masked_axpy(T_row,
-                                M[i], structure_flag, complement_flag,
-                                semiring, a_ik, B[k]);
-                }
-
-                // Z[i] = (!M[i] .* C[i]) + T[i], where T[i] is masked by !M[i]
-                Z_row.clear();
-                masked_accum(Z_row,
-                             M[i], structure_flag, complement_flag,
-                             accum, C[i], T_row);
-
-                if ((outp == REPLACE) || M[i].empty())
-                {
-                    C.setRow(i, Z_row);
-                }
-                else /* merge */
-                {
-                    // C[i] = [M[i] .* C[i]]  U  Z[i], where Z is disjoint from M
-                    C_row.clear();  // TODO: is an extra vector necessary?
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], Z_row);
-                    C.setRow(i, C_row);
-                }
-
-            }
-        }
-
         //**********************************************************************
         //**********************************************************************
         //**********************************************************************
@@ -446,10 +117,11 @@ namespace grb
                 // create temporary to prevent overwrite of inputs
                 LilSparseMatrix<CScalarT> Ctmp(C.nrows(), C.ncols());
                 AB_NoMask_NoAccum_kernel(Ctmp, semiring, A, B);
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                reserve_row_union(C, Ctmp);
+                for_each_row_union([&](IndexType i)
                 {
                     C.mergeRow(i, Ctmp[i], accum);
-                }
+                }, Ctmp);
             }
             else
             {
@@ -508,7 +180,8 @@ namespace grb
                 else
                 {
                     typename LilSparseMatrix<CScalarT>::RowType C_row;
-                    for (IndexType i = 0; i < C.nrows(); ++i)
+                    reserve_row_union(C, Ctmp);
+                    for_each_row_union([&](IndexType i)
                     {
                         // C[i] = [!M .* C]  U  T[i], z = "merge"
                         C_row.clear();
@@ -516,7 +189,7 @@ namespace grb
                                      M[i], structure_flag, complement_flag,
                                      C[i], Ctmp[i]);
                         C.setRow(i, C_row);
-                    }
+                    }, C, Ctmp);
                 }
             }
             else
@@ -578,7 +251,8 @@ namespace grb
 
                 typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
 
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                reserve_row_union(C, Ctmp);
+                for_each_row_union([&](IndexType i)
                 {
                     Z_row.clear();
                     // Z[i] = (M .* C) + Ctmp[i]
@@ -600,7 +274,7 @@ namespace grb
                                      C[i], Z_row);
                         C.setRow(i, C_row);
                     }
-                }
+                }, C, Ctmp);
             }
             else
             {
@@ -656,7 +330,8 @@ namespace grb
                 else
                 {
                     typename LilSparseMatrix<CScalarT>::RowType C_row;
-                    for (IndexType i = 0; i < C.nrows(); ++i)
+                    reserve_row_union(C, Ctmp);
+                    for_each_row_union([&](IndexType i)
                     {
                         // C[i] = [!M .* C]  U  T[i], z = "merge"
                         C_row.clear();
@@ -664,7 +339,7 @@ namespace grb
                                      M[i], structure_flag, complement_flag,
                                      C[i], Ctmp[i]);
                         C.setRow(i, C_row);
-                    }
+                    }, C, Ctmp);
                 }
             }
             else
@@ -723,7 +398,8 @@ namespace grb
 
                 typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
 
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                reserve_row_union(C, Ctmp);
+                for_each_row_union([&](IndexType i)
                 {
                     Z_row.clear();
                     // Z[i] = (M .* C) + Ctmp[i]
@@ -745,7 +421,7 @@ namespace grb
                                      C[i], Z_row);
                         C.setRow(i, C_row);
                     }
-                }
+                }, C, Ctmp);
             }
             else
             {
@@ -41,6 +41,8 @@
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_mxm_kernels.hpp>
 
 //****************************************************************************
 
@@ -48,375 +50,6 @@ namespace grb
 {
     namespace backend
     {
-
-        //**********************************************************************
-        //**********************************************************************
-
-        //**********************************************************************
-        // Perform C = A +.* B' where C, A, and B are all unique
-        template<typename CScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ABT_NoMask_NoAccum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<CScalarT>::RowType C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                C_row.clear();
-                if (A[i].empty()) continue;
-
-                // fill row i of T
-                for (IndexType j = 0; j < B.nrows(); ++j)
-                {
-                    if (B[j].empty()) continue;
-
-                    TScalarType t_ij;
-
-                    // Perform the dot product
-                    // C[i][j] = T_ij = (CScalarT) (A[i] . B[j])
-                    if (dot(t_ij, A[i], B[j], semiring))
-                    {
-                        C_row.emplace_back(j, static_cast<CScalarT>(t_ij));
-                    }
-                }
-
-                C.setRow(i, C_row);  // set even if it is empty.
-            }
-        }
-
-        //**********************************************************************
-        // Perform C = C + AB', where C, A, and B must all be unique
-        template<typename CScalarT,
-                 typename AccumT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ABT_NoMask_Accum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            AccumT                    const &accum,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            std::vector<std::tuple<IndexType,TScalarType> > T_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                if (A[i].empty()) continue;
-
-                T_row.clear();
-
-                // Compute row i of T
-                // T[i] = (CScalarT) (A[i] *.+ B')
-                for (IndexType j = 0; j < B.nrows(); ++j)
-                {
-                    if (B[j].empty()) continue;
-
-                    TScalarType t_ij;
-
-                    // Perform the dot product
-                    // T[i][j] = (CScalarT) (A[i] . B[j])
-                    if (dot(t_ij, A[i], B[j], semiring))
-                    {
-                        T_row.emplace_back(j, t_ij);
-                    }
-                }
-
-                if (!T_row.empty())
-                {
-                    // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T_row, accum);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<M,z> = A +.* B' where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ABT_Mask_NoAccum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<CScalarT>::RowType C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                bool const complement_flag = false;
-                T_row.clear();
-
-                // T[i] = M[i] .* (A[i] dot B[j])
-                if (!A[i].empty() && !M[i].empty())
-                {
-                    auto M_iter(M[i].begin());
-                    for (IndexType j = 0; j < B.nrows(); ++j)
-                    {
-                        if (B[j].empty() ||
-                            !advance_and_check_mask_iterator(
-                                M_iter, M[i].end(), structure_flag, j))
-                            continue;
-
-                        // Perform the dot product
-                        TScalarType t_ij;
-                        if (dot(t_ij, A[i], B[j], semiring))
-                        {
-                            T_row.emplace_back(j, t_ij);
-                        }
-                    }
-                }
-
-                if (outp == REPLACE)
-                {
-                    // C[i] = T[i], z = "replace"
-                    C.setRow(i, T_row);
-                }
-                else /* merge */
-                {
-                    // C[i] = [!M .* C]  U  T[i], z = "merge"
-                    C_row.clear();
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], T_row);
-                    C.setRow(i, C_row);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<M,z> = C + (A +.* B') where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename AccumT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ABT_Mask_Accum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            AccumT                    const &accum,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
-                                               std::declval<TScalarType>()));
-            typename LilSparseMatrix<TScalarType>::RowType  T_row;
-            typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
-            typename LilSparseMatrix<CScalarT>::RowType     C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                bool const complement_flag = false;  /// @todo constexpr?
-                T_row.clear();
-
-                if (!A[i].empty() && !M[i].empty())
-                {
-                    auto m_it(M[i].begin());
-
-                    // Compute: T[i] = M[i] .* {C[i] + (A +.* B')[i]}
-                    for (IndexType j = 0; j < B.nrows(); ++j)
-                    {
-                        // See if B[j] has data and M[i] allows write.
-                        if (B[j].empty() ||
-                            !advance_and_check_mask_iterator(
-                                m_it, M[i].end(), structure_flag, j))
-                        {
-                            continue;
-                        }
-
-                        // Perform the dot product and accum if necessary
-                        TScalarType t_ij;
-                        if (dot(t_ij, A[i], B[j], semiring))
-                        {
-                            T_row.emplace_back(j, t_ij);
-                        }
-                    }
-                }
-
-                // Z[i] = (M .* C) + T[i]
-                Z_row.clear();
-                masked_accum(Z_row,
-                             M[i], structure_flag, complement_flag,
-                             accum, C[i], T_row);
-
-                if (outp == REPLACE)
-                {
-                    C.setRow(i, Z_row);
-                }
-                else /* merge */
-                {
-                    // C[i] := (!M[i] .* C[i])  U  Z[i]
-                    C_row.clear();
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], Z_row);
-                    C.setRow(i, C_row);  // set even if it is empty.
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<!M,z> = (A +.* B') where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ABT_CompMask_NoAccum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<CScalarT>::RowType    C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                bool const complement_flag = true;
-
-                T_row.clear();
-
-                // T[i] = !M[i] .* (A[i] dot B[j])
-                if (!A[i].empty()) // && !M[i].empty()) cannot do mask shortcut
-                {
-                    auto M_iter(M[i].begin());
-                    for (IndexType j = 0; j < B.nrows(); ++j)
-                    {
-                        if (B[j].empty() ||
-                            advance_and_check_mask_iterator(
-                                M_iter, M[i].end(), structure_flag, j))
-                            continue;
-
-                        // Perform the dot product
-                        TScalarType t_ij;
-                        if (dot(t_ij, A[i], B[j], semiring))
-                        {
-                            T_row.emplace_back(j, t_ij);
-                        }
-                    }
-                }
-
-                if (outp == REPLACE)
-                {
-                    // C[i] = T[i], z = "replace"
-                    C.setRow(i, T_row);
-                }
-                else /* merge */
-                {
-                    // C[i] = [M .* C]  U  T[i], z = "merge"
-                    C_row.clear();
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], T_row);
-                    C.setRow(i, C_row);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C<!M,z> = C + (A +.* B) where A, B, M, and C are all unique
-        template<typename CScalarT,
-                 typename MScalarT,
-                 typename AccumT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ABT_CompMask_Accum_kernel(
-            LilSparseMatrix<CScalarT>       &C,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            AccumT                    const &accum,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B,
-            OutputControlEnum                outp)
-        {
-            using TScalarType = typename SemiringT::result_type;
-            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
-                                               std::declval<TScalarType>()));
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-            typename LilSparseMatrix<ZScalarType>::RowType Z_row;
-            typename LilSparseMatrix<CScalarT>::RowType    C_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                bool const complement_flag = true;
-
-                T_row.clear();
-
-                if (!A[i].empty()) // && !M[i].empty()) cannot do mask shortcut
-                {
-                    auto m_it(M[i].begin());
-
-                    // Compute: T[i] = M[i] .* {C[i] + (A +.* B')[i]}
-                    for (IndexType j = 0; j < B.nrows(); ++j)
-                    {
-                        // See if B[j] has data and M[i] allows write.
-                        if (B[j].empty() ||
-                            advance_and_check_mask_iterator(
-                                m_it, M[i].end(), structure_flag, j))
-                        {
-                            continue;
-                        }
-
-                        // Perform the dot product and accum if necessary
-                        TScalarType t_ij;
-                        if (dot(t_ij, A[i], B[j], semiring))
-                        {
-                            T_row.emplace_back(j, t_ij);
-                        }
-                    }
-                }
-
-                // Z[i] = (M .* C) + T[i]
-                Z_row.clear();
-                masked_accum(Z_row,
-                             M[i], structure_flag, complement_flag,
-                             accum, C[i], T_row);
-
-
-                if (outp == REPLACE)
-                {
-                    C.setRow(i, Z_row);
-                }
-                else /* merge */
-                {
-                    // T[i] := (M[i] .* C[i])  U  Z[i]
-                    C_row.clear();
-                    masked_merge(C_row,
-                                 M[i], structure_flag, complement_flag,
-                                 C[i], Z_row);
-                    C.setRow(i, C_row);  // set even if it is empty.
-                }
-            }
-        }
-
         //**********************************************************************
         //**********************************************************************
         //**********************************************************************
@@ -487,10 +120,11 @@ namespace grb
                 // create temporary to prevent overwrite of inputs
                 LilSparseMatrix<CScalarT> Ctmp(C.nrows(), C.ncols());
                 ABT_NoMask_NoAccum_kernel(Ctmp, semiring, A, B);
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                reserve_row_union(C, Ctmp);
+                for_each_row_union([&](IndexType i)
                 {
                     C.mergeRow(i, Ctmp[i], accum);
-                }
+                }, C, Ctmp);
             }
             else
             {
@@ -551,7 +185,8 @@ namespace grb
                 else
                 {
                     typename LilSparseMatrix<CScalarT>::RowType C_row;
-                    for (IndexType i = 0; i < C.nrows(); ++i)
+                    reserve_row_union(C, Ctmp);
+                    for_each_row_union([&](IndexType i)
                     {
                         // C[i] = [!M .* C]  U  T[i], z = "merge"
                         C_row.clear();
@@ -559,7 +194,7 @@ namespace grb
                                      M[i], structure_flag, complement_flag,
                                      C[i], Ctmp[i]);
                         C.setRow(i, C_row);
-                    }
+                    }, C, Ctmp);
                 }
             }
             else
@@ -623,7 +258,8 @@ namespace grb
 
                 typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
 
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                reserve_row_union(C, Ctmp);
+                for_each_row_union([&](IndexType i)
                 {
                     Z_row.clear();
                     // Z[i] = (M .* C) + Ctmp[i]
@@ -645,7 +281,7 @@ namespace grb
                                      C[i], Z_row);
                         C.setRow(i, C_row);
                     }
-                }
+                }, C, Ctmp);
             }
             else
             {
@@ -704,7 +340,8 @@ namespace grb
                 else
                 {
                     typename LilSparseMatrix<CScalarT>::RowType C_row;
-                    for (IndexType i = 0; i < C.nrows(); ++i)
+                    reserve_row_union(C, Ctmp);
+                    for_each_row_union([&](IndexType i)
                     {
                         // C[i] = [!M .* C]  U  T[i], z = "merge"
                         C_row.clear();
@@ -712,7 +349,7 @@ namespace grb
                                      M[i], structure_flag, complement_flag,
                                      C[i], Ctmp[i]);
                         C.setRow(i, C_row);
-                    }
+                    }, C, Ctmp);
                 }
             }
             else
@@ -767,7 +404,8 @@ namespace grb
 
                 typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
 
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                reserve_row_union(C, Ctmp);
+                for_each_row_union([&](IndexType i)
                 {
                     Z_row.clear();
                     // Z[i] = (M .* C) + Ctmp[i]
@@ -789,7 +427,7 @@ namespace grb
                                      C[i], Z_row);
                         C.setRow(i, C_row);
                     }
-                }
+                }, C, Ctmp);
             }
             else
             {
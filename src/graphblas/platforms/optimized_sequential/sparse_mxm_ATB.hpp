@@ -41,6 +41,8 @@
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_mxm_kernels.hpp>
 
 //****************************************************************************
 
@@ -48,103 +50,6 @@ namespace grb
 {
     namespace backend
     {
-
-        //**********************************************************************
-        //**********************************************************************
-
-        //**********************************************************************
-        // Perform C = A*B where C, A and B must all be unique
-        template<typename TScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ATB_NoMask_kernel(
-            LilSparseMatrix<TScalarT>       &T,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            for (IndexType k = 0; k < A.nrows(); ++k)
-            {
-                if (A[k].empty() || B[k].empty()) continue;
-
-                for (auto const &Ak_elt : A[k])
-                {
-                    IndexType    i(std::get<0>(Ak_elt));
-                    AScalarT  a_ki(std::get<1>(Ak_elt));
-
-                    // T[i] += (a_ki*B[k])  // must reduce in D3, hence T.
-                    axpy(T[i], semiring, a_ki, B[k]);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C = A*B where C, A and B must all be unique
-        template<typename TScalarT,
-                 typename MScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ATB_Mask_kernel(
-            LilSparseMatrix<TScalarT>       &T,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            for (IndexType k = 0; k < A.nrows(); ++k)
-            {
-                if (A[k].empty() || B[k].empty()) continue;
-
-                for (auto const &Ak_elt : A[k])
-                {
-                    IndexType    i(std::get<0>(Ak_elt));
-                    AScalarT  a_ki(std::get<1>(Ak_elt));
-
-                    if (M[i].empty()) continue;
-
-                    // T[i] += M[i] .* (a_ki*B[k])  // must reduce in D3, hence T.
-                    masked_axpy(T[i],
-                                M[i], structure_flag, false,
-                                semiring, a_ki, B[k]);
-                }
-            }
-        }
-
-        //**********************************************************************
-        // Perform C = A*B where C, A and B must all be unique
-        template<typename TScalarT,
-                 typename MScalarT,
-                 typename SemiringT,
-                 typename AScalarT,
-                 typename BScalarT>
-        inline void ATB_CompMask_kernel(
-            LilSparseMatrix<TScalarT>       &T,
-            LilSparseMatrix<MScalarT> const &M,
-            bool                             structure_flag,
-            SemiringT                        semiring,
-            LilSparseMatrix<AScalarT> const &A,
-            LilSparseMatrix<BScalarT> const &B)
-        {
-            for (IndexType k = 0; k < A.nrows(); ++k)
-            {
-                if (A[k].empty() || B[k].empty()) continue;
-
-                for (auto const &Ak_elt : A[k])
-                {
-                    IndexType    i(std::get<0>(Ak_elt));
-                    AScalarT  a_ki(std::get<1>(Ak_elt));
-
-                    // T[i] += !M[i] .* (a_ki*B[k])  // must reduce in D3, hence T.
-                    masked_axpy(T[i],
-                                M[i], structure_flag, true,
-                                semiring, a_ki, B[k]);
-                }
-            }
-        }
-
         //**********************************************************************
         //**********************************************************************
         //**********************************************************************
@@ -174,11 +79,11 @@ namespace grb
 
             ATB_NoMask_kernel(T, semiring, A, B);
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // C[i] = T[i]
                 C.setRow(i, T[i]);
-            }
+            }, C, T);
 
             GRB_LOG_VERBOSE("C: " << C);
         }
@@ -210,12 +115,12 @@ namespace grb
 
             ATB_NoMask_kernel(T, semiring, A, B);
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 if (!T[i].empty())
                     // C[i] = C[i] + T[i]
                     C.mergeRow(i, T[i], accum);
-            }
+            }, C, T);
 
             GRB_LOG_VERBOSE("C: " << C);
         }
@@ -260,7 +165,7 @@ namespace grb
 
             if (outp == MERGE)
             {
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                for_each_row_union([&](IndexType i)
                 {
                     // C[i] = (!M[i] .* C[i])  U  T[i], z = "merge"
                     C_row.clear();
@@ -268,14 +173,14 @@ namespace grb
                                  M[i], structure_flag, false,
                                  C[i], T[i]);
                     C.setRow(i, C_row);
-                }
+                }, C, T);
             }
             else
             {
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                for_each_row_union([&](IndexType i)
                 {
                     C.setRow(i, T[i]);
-                }
+                }, C, T);
             }
 
             GRB_LOG_VERBOSE("C: " << C);
@@ -322,7 +227,7 @@ namespace grb
 
             ATB_Mask_kernel(T, M, structure_flag, semiring, A, B);
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // Z[i] = (M[i] .* C[i]) + T[i]
                 Z_row.clear();
@@ -344,7 +249,7 @@ namespace grb
                     // C[i] = Z[i]
                     C.setRow(i, Z_row);
                 }
-            }
+            }, C, T);
 
             GRB_LOG_VERBOSE("C: " << C);
         }
@@ -382,7 +287,7 @@ namespace grb
 
             ATB_CompMask_kernel(T, M, structure_flag, semiring, A, B);
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 if ((outp == REPLACE) || M[i].empty())
                 {
@@ -396,7 +301,7 @@ namespace grb
                     masked_merge(C_row, M[i], structure_flag, true, C[i], T[i]);
                     C.setRow(i, C_row);
                 }
-            }
+            }, C, T);
 
             GRB_LOG_VERBOSE("C: " << C);
         }
@@ -438,7 +343,7 @@ namespace grb
 
             ATB_CompMask_kernel(T, M, structure_flag, semiring, A, B);
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // Z[i] = (!M .* C) + T[i]
                 Z_row.clear();
@@ -460,7 +365,7 @@ namespace grb
                                  C[i], Z_row);
                     C.setRow(i, C_row);
                 }
-            }
+            }, C, T);
 
             GRB_LOG_VERBOSE("C: " << C);
         }
@@ -41,6 +41,8 @@
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_mxm_kernels.hpp>
 
 //****************************************************************************
 
@@ -65,7 +67,7 @@ namespace grb
             typename LilSparseMatrix<TScalarType>::RowType T_row;
 
             // compute transpose T = B +.* A (one row at a time and transpose)
-            for (IndexType i = 0; i < B.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // this part is same as sparse_mxm_NoMask_NoAccum_AB
                 T_row.clear();
@@ -85,9 +87,9 @@ namespace grb
                 {
                     IndexType j(std::get<0>(t));
 
-                    C[j].emplace_back(i, static_cast<CScalarT>(std::get<1>(t)));
+                    C.mutableRow(j).emplace_back(i, static_cast<CScalarT>(std::get<1>(t)));
                 }
-            }
+            }, B);
             C.recomputeNvals();
         }
 
@@ -123,10 +125,10 @@ namespace grb
                 LilSparseMatrix<CScalarT> Ctmp(C.nrows(), C.ncols());
                 ATBT_NoMask_NoAccum_kernel(Ctmp, semiring, A, B);
 
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                for_each_row_union([&](IndexType i)
                 {
                     C.setRow(i, Ctmp[i]);
-                }
+                }, C, Ctmp);
             }
             else
             {
@@ -166,11 +168,11 @@ namespace grb
                 // T = A' +.* B'
                 LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
                 ATBT_NoMask_NoAccum_kernel(T, semiring, A, B);
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                for_each_row_union([&](IndexType i)
                 {
                     // C[i] = C[i] + T[i]
                     C.mergeRow(i, T[i], accum);
-                }
+                }, C, T);
             }
             else
             {
@@ -179,11 +181,11 @@ namespace grb
                 ATBT_NoMask_NoAccum_kernel(T, semiring, A, B);
 
                 // accumulate
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                for_each_row_union([&](IndexType i)
                 {
                     // C[i] = C[i] + T[i]
                     C.mergeRow(i, T[i], accum);
-                }
+                }, C, T);
             }
         }
 
@@ -223,7 +225,7 @@ namespace grb
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
 
             // compute transpose T = B +.* A (one row at a time and transpose)
-            for (IndexType i = 0; i < B.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // this part is same as sparse_mxm_NoMask_NoAccum_AB swapping
                 // A and B and computing the transpose of C.
@@ -245,12 +247,12 @@ namespace grb
                 for (auto const &t : T_row)
                 {
                     IndexType j(std::get<0>(t));
-                    T[j].push_back(std::make_pair(i, std::get<1>(t)));
+                    T.mutableRow(j).push_back(std::make_pair(i, std::get<1>(t)));
                 }
-            }
+            }, B);
 
             typename LilSparseMatrix<CScalarT>::RowType Z_row, C_row;
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // Z = M[i] .* T[i]
                 Z_row.clear();
@@ -278,7 +280,7 @@ namespace grb
                     masked_merge(C_row, M[i], structure_flag, false, C[i], Z_row);
                     C.setRow(i, C_row);
                 }
-            }
+            }, C, T);
         }
 
         //**********************************************************************
@@ -322,7 +324,7 @@ namespace grb
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
 
             // compute transpose T' = B +.* A (one row at a time and transpose)
-            for (IndexType i = 0; i < B.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // this part is same as sparse_mxm_NoMask_NoAccum_AB swapping
                 // A and B and computing the transpose of C.
@@ -344,13 +346,13 @@ namespace grb
                 for (auto const &t : T_row)
                 {
                     IndexType j(std::get<0>(t));
-                    T[j].push_back(std::make_pair(i, std::get<1>(t)));
+                    T.mutableRow(j).push_back(std::make_pair(i, std::get<1>(t)));
                 }
-            }
+            }, B);
 
             bool const complement_flag = false;
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
                 // T_row = M[i] .* T[i]
                 T_row.clear();
@@ -385,7 +387,7 @@ namespace grb
                     // C[i] = Z[i]
                     C.setRow(i, Z_row);
                 }
-            }
+            }, C, T);
         }
 
         //**********************************************************************
@@ -415,52 +417,19 @@ namespace grb
 
             // =================================================================
             using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
 
-            // compute transpose T = B +.* A (one row at a time and transpose)
-            for (IndexType i = 0; i < B.nrows(); ++i)
-            {
-                // this part is same as sparse_mxm_NoMask_NoAccum_AB swapping
-                // A and B and computing the transpose of C.
-                T_row.clear();
-
-                for (auto const &Bi_elt : B[i])
-                {
-                    IndexType    k(std::get<0>(Bi_elt));
-                    AScalarT  b_ik(std::get<1>(Bi_elt));
-
-                    if (A[k].empty()) continue;
-
-                    // T[i] += (b_ik*A[k])  // must reduce in D3
-                    axpy(T_row, semiring, b_ik, A[k]);
-                }
-
-                // Transpose the result
-                //T.setCol(i, T_row); // this is a push_back form of setCol
-                for (auto const &t : T_row)
-                {
-                    IndexType j(std::get<0>(t));
-                    T[j].push_back(std::make_pair(i, std::get<1>(t)));
-                }
-            }
+            // T = !M .* (A' +.* B')
+            ATBT_CompMask_kernel(T, M, structure_flag, semiring, A, B);
 
             typename LilSparseMatrix<CScalarT>::RowType Z_row, C_row;
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
-                // Z = !M[i] .* T[i]
+                // Z = T[i], already masked
                 Z_row.clear();
-                auto m_it = M[i].begin();
-                for (auto t_ij : T[i])
+                for (auto&& [j, t_ij] : T[i])
                 {
-                    IndexType j(std::get<0>(t_ij));
-                    if (!advance_and_check_mask_iterator(
-                            m_it, M[i].end(), structure_flag, j))
-                    {
-                        Z_row.push_back(
-                            std::make_tuple(
-                                j, static_cast<CScalarT>(std::get<1>(t_ij))));
-                    }
+                    Z_row.emplace_back(j, static_cast<CScalarT>(t_ij));
                 }
 
                 if (outp == REPLACE)
@@ -476,7 +445,7 @@ namespace grb
                                  C[i], Z_row);
                     C.setRow(i, C_row);
                 }
-            }
+            }, C, T);
         }
 
         //**********************************************************************
@@ -511,60 +480,22 @@ namespace grb
             using TScalarType = typename SemiringT::result_type;
             using ZScalarType = decltype(accum(std::declval<CScalarT>(),
                                                std::declval<TScalarType>()));
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
             typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
             typename LilSparseMatrix<CScalarT>::RowType C_row;
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
 
-            // compute transpose T' = B +.* A (one row at a time and transpose)
-            for (IndexType i = 0; i < B.nrows(); ++i)
-            {
-                // this part is same as sparse_mxm_NoMask_NoAccum_AB swapping
-                // A and B and computing the transpose of C.
-                T_row.clear();
-
-                for (auto const &Bi_elt : B[i])
-                {
-                    IndexType    k(std::get<0>(Bi_elt));
-                    AScalarT  b_ik(std::get<1>(Bi_elt));
-
-                    if (A[k].empty()) continue;
-
-                    // T[i] += (b_ik*A[k])  // must reduce in D3
-                    axpy(T_row, semiring, b_ik, A[k]);
-                }
-
-                // Transpose the result
-                //T.setCol(i, T_row); // this is a push_back form of setCol
-                for (auto const &t : T_row)
-                {
-                    IndexType j(std::get<0>(t));
-                    T[j].push_back(std::make_pair(i, std::get<1>(t)));
-                }
-            }
+            // T = !M .* (A' +.* B')
+            ATBT_CompMask_kernel(T, M, structure_flag, semiring, A, B);
 
             bool const complement_flag = true;
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+            for_each_row_union([&](IndexType i)
             {
-                // T_row = M[i] .* T[i]
-                T_row.clear();
-                auto m_it = M[i].begin();
-                for (auto t_ij : T[i])
-                {
-                    IndexType j(std::get<0>(t_ij));
-                    if (!advance_and_check_mask_iterator(
-                            m_it, M[i].end(), structure_flag, j))
-                    {
-                        T_row.push_back(t_ij);
-                    }
-                }
-
                 // Z[i] = (M[i] .* C[i]) + T[i]
                 Z_row.clear();
                 masked_accum(Z_row,
                              M[i], structure_flag, complement_flag,
-                             accum, C[i], T_row);
+                             accum, C[i], T[i]);
 
                 if (outp == REPLACE)
                 {
@@ -580,7 +511,7 @@ namespace grb
                                  C[i], Z_row);
                     C.setRow(i, C_row);  // set even if it is empty.
                 }
-            }
+            }, C, T);
         }
 
     } // backend
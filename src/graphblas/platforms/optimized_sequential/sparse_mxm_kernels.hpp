@@ -0,0 +1,857 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+/**
+ * Row loop kernels of the mxm variants, in their sequential form.  Included
+ * as <sparse_mxm_kernels.hpp> by the shared sparse_mxm_*.hpp files so that
+ * the configured platform's version is used (see sparse_kernels.hpp).
+ */
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include "sparse_helpers.hpp"
+#include "LilSparseMatrix.hpp"
+
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        // A * B
+        //**********************************************************************
+
+        //**********************************************************************
+        // Perform C = A*B where C, A and B must all be unique
+        template<typename CScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_NoMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType>                 spa(B.ncols());
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                // T[i] = A[i] +.* B
+                spa_axpy_row(T_row, spa, semiring, A[i], B);
+
+                // C[i] = T[i]
+                C.setRow(i, T_row);  // set even if it is empty.
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C = C + AB, where C, A, and B must all be unique
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_NoMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType>                 spa(B.ncols());
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                // T[i] = A[i] +.* B
+                spa_axpy_row(T_row, spa, semiring, A[i], B);
+
+                if (!T_row.empty())
+                {
+                    // C[i] = C[i] + T[i]
+                    C.mergeRow(i, T_row, accum);
+                }
+            }, A);
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = A +.* B where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_Mask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType>                 spa(B.ncols());
+            typename LilSparseMatrix<CScalarT>::RowType C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i) // compute row i of answer
+            {
+                bool const complement_flag = false;
+
+                // T[i] = M[i] .* (A[i] +.* B)
+                spa_masked_axpy_row(T_row, spa,
+                                    M[i], structure_flag, complement_flag,
+                                    semiring, A[i], B);
+
+                if (outp == REPLACE)
+                {
+                    // C[i] = T[i], z = "replace"
+                    C.setRow(i, T_row);  // set even if it is empty.
+                }
+                else
+                {
+                    // C[i] = [!M .* C]  U  T[i], z = "merge"
+                    C_row.clear();
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], T_row);
+                    C.setRow(i, C_row);
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = C + (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_Mask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType>                 spa(B.ncols());
+            typename LilSparseMatrix<ZScalarType>::RowType Z_row;
+            typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i) // compute row i of answer
+            {
+                bool const complement_flag = false;  /// @todo constexpr?
+
+                // T[i] = M[i] .* (A[i] +.* B)
+                spa_masked_axpy_row(T_row, spa,
+                                    M[i], structure_flag, complement_flag,
+                                    semiring, A[i], B);
+
+                // Z[i] = (M .* C) + T[i]
+                Z_row.clear();
+                masked_accum(Z_row,
+                             M[i], structure_flag, complement_flag,
+                             accum, C[i], T_row);
+
+                if (outp == MERGE)
+                {
+                    // C[i]  = [!M .* C]  U  Z[i]
+                    C_row.clear();
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], Z_row);
+                    C.setRow(i, C_row);  // set even if it is empty.
+                }
+                else // z = replace
+                {
+                    // C[i] = Z[i]
+                    C.setRow(i, Z_row);
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_CompMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType>                 spa(B.ncols());
+            typename LilSparseMatrix<CScalarT>::RowType    Z_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i) // compute row i of answer
+            {
+                // if M[i] is empty it is like NoMask_NoAccum
+
+                bool const complement_flag = true;
+
+                // T[i] = !M[i] .* (A[i] +.* B)
+                spa_masked_axpy_row(T_row, spa,
+                                    M[i], structure_flag, complement_flag,
+                                    semiring, A[i], B);
+
+                if ((outp == REPLACE) || M[i].empty())
+                {
+                    // C[i] = T[i]
+                    C.setRow(i, T_row);  // set even if it is empty.
+                }
+                else
+                {
+                    Z_row.clear();
+                    // Z[i] = (M[i] .* C[i]) U T[i]
+                    masked_merge(Z_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], T_row);
+                    C.setRow(i, Z_row);
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = C + (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void AB_CompMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType>                 spa(B.ncols());
+            typename LilSparseMatrix<ZScalarType>::RowType Z_row;
+            typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i) // compute row i of answer
+            {
+                // if M[i] is empty it is like NoMask_NoAccum
+
+                bool const complement_flag = true;
+
+                // T[i] = !M[i] .* (A[i] +.* B)
+                spa_masked_axpy_row(T_row, spa,
+                                    M[i], structure_flag, complement_flag,
+                                    semiring, A[i], B);
+
+                // Z[i] = (!M[i] .* C[i]) + T[i], where T[i] is masked by !M[i]
+                Z_row.clear();
+                masked_accum(Z_row,
+                             M[i], structure_flag, complement_flag,
+                             accum, C[i], T_row);
+
+                if ((outp == REPLACE) || M[i].empty())
+                {
+                    C.setRow(i, Z_row);
+                }
+                else /* merge */
+                {
+                    // C[i] = [M[i] .* C[i]]  U  Z[i], where Z is disjoint from M
+                    C_row.clear();  // TODO: is an extra vector necessary?
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], Z_row);
+                    C.setRow(i, C_row);
+                }
+
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // A * B'
+        //**********************************************************************
+
+        //**********************************************************************
+        // Perform C = A +.* B' where C, A, and B are all unique
+        template<typename CScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_NoMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<CScalarT>::RowType C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                C_row.clear();
+
+                // fill row i of T
+                auto const &A_i(A[i]);
+                if (!A_i.empty())
+                {
+                    B.forEachRow([&](IndexType j, auto const &B_j)
+                    {
+                        TScalarType t_ij;
+
+                        // Perform the dot product
+                        // C[i][j] = T_ij = (CScalarT) (A[i] . B[j])
+                        if (dot(t_ij, A_i, B_j, semiring))
+                        {
+                            C_row.emplace_back(j, static_cast<CScalarT>(t_ij));
+                        }
+                    });
+                }
+
+                C.setRow(i, C_row);  // set even if it is empty.
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C = C + AB', where C, A, and B must all be unique
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_NoMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            std::vector<std::tuple<IndexType,TScalarType> > T_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                if (A[i].empty()) return;
+
+                T_row.clear();
+
+                // Compute row i of T
+                // T[i] = (CScalarT) (A[i] *.+ B')
+                auto const &A_i(A[i]);
+                B.forEachRow([&](IndexType j, auto const &B_j)
+                {
+                    TScalarType t_ij;
+
+                    // Perform the dot product
+                    // T[i][j] = (CScalarT) (A[i] . B[j])
+                    if (dot(t_ij, A_i, B_j, semiring))
+                    {
+                        T_row.emplace_back(j, t_ij);
+                    }
+                });
+
+                if (!T_row.empty())
+                {
+                    // C[i] = C[i] + T[i]
+                    C.mergeRow(i, T_row, accum);
+                }
+            }, A);
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = A +.* B' where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_Mask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            typename LilSparseMatrix<CScalarT>::RowType C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                bool const complement_flag = false;
+                T_row.clear();
+
+                // T[i] = M[i] .* (A[i] dot B[j])
+                if (!A[i].empty() && !M[i].empty())
+                {
+                    auto const &M_i(M[i]);
+                    auto M_iter(M_i.begin());
+                    auto const &A_i(A[i]);
+                    B.forEachRow([&](IndexType j, auto const &B_j)
+                    {
+                        if (!advance_and_check_mask_iterator(
+                                M_iter, M_i.end(), structure_flag, j))
+                            return;
+
+                        // Perform the dot product
+                        TScalarType t_ij;
+                        if (dot(t_ij, A_i, B_j, semiring))
+                        {
+                            T_row.emplace_back(j, t_ij);
+                        }
+                    });
+                }
+
+                if (outp == REPLACE)
+                {
+                    // C[i] = T[i], z = "replace"
+                    C.setRow(i, T_row);
+                }
+                else /* merge */
+                {
+                    // C[i] = [!M .* C]  U  T[i], z = "merge"
+                    C_row.clear();
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], T_row);
+                    C.setRow(i, C_row);
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C<M,z> = C + (A +.* B') where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_Mask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            typename LilSparseMatrix<TScalarType>::RowType  T_row;
+            typename LilSparseMatrix<ZScalarType>::RowType  Z_row;
+            typename LilSparseMatrix<CScalarT>::RowType     C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                bool const complement_flag = false;  /// @todo constexpr?
+                T_row.clear();
+
+                if (!A[i].empty() && !M[i].empty())
+                {
+                    auto const &M_i(M[i]);
+                    auto m_it(M_i.begin());
+
+                    // Compute: T[i] = M[i] .* {C[i] + (A +.* B')[i]}
+                    auto const &A_i(A[i]);
+                    B.forEachRow([&](IndexType j, auto const &B_j)
+                    {
+                        // See if M[i] allows write.
+                        if (!advance_and_check_mask_iterator(
+                                m_it, M_i.end(), structure_flag, j))
+                        {
+                            return;
+                        }
+
+                        // Perform the dot product and accum if necessary
+                        TScalarType t_ij;
+                        if (dot(t_ij, A_i, B_j, semiring))
+                        {
+                            T_row.emplace_back(j, t_ij);
+                        }
+                    });
+                }
+
+                // Z[i] = (M .* C) + T[i]
+                Z_row.clear();
+                masked_accum(Z_row,
+                             M[i], structure_flag, complement_flag,
+                             accum, C[i], T_row);
+
+                if (outp == REPLACE)
+                {
+                    C.setRow(i, Z_row);
+                }
+                else /* merge */
+                {
+                    // C[i] := (!M[i] .* C[i])  U  Z[i]
+                    C_row.clear();
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], Z_row);
+                    C.setRow(i, C_row);  // set even if it is empty.
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = (A +.* B') where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_CompMask_NoAccum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                bool const complement_flag = true;
+
+                T_row.clear();
+
+                // T[i] = !M[i] .* (A[i] dot B[j])
+                if (!A[i].empty()) // && !M[i].empty()) cannot do mask shortcut
+                {
+                    auto const &M_i(M[i]);
+                    auto M_iter(M_i.begin());
+                    auto const &A_i(A[i]);
+                    B.forEachRow([&](IndexType j, auto const &B_j)
+                    {
+                        if (advance_and_check_mask_iterator(
+                                M_iter, M_i.end(), structure_flag, j))
+                            return;
+
+                        // Perform the dot product
+                        TScalarType t_ij;
+                        if (dot(t_ij, A_i, B_j, semiring))
+                        {
+                            T_row.emplace_back(j, t_ij);
+                        }
+                    });
+                }
+
+                if (outp == REPLACE)
+                {
+                    // C[i] = T[i], z = "replace"
+                    C.setRow(i, T_row);
+                }
+                else /* merge */
+                {
+                    // C[i] = [M .* C]  U  T[i], z = "merge"
+                    C_row.clear();
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], T_row);
+                    C.setRow(i, C_row);
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // Perform C<!M,z> = C + (A +.* B) where A, B, M, and C are all unique
+        template<typename CScalarT,
+                 typename MScalarT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ABT_CompMask_Accum_kernel(
+            LilSparseMatrix<CScalarT>       &C,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            AccumT                    const &accum,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B,
+            OutputControlEnum                outp)
+        {
+            using TScalarType = typename SemiringT::result_type;
+            using ZScalarType = decltype(accum(std::declval<CScalarT>(),
+                                               std::declval<TScalarType>()));
+            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            typename LilSparseMatrix<ZScalarType>::RowType Z_row;
+            typename LilSparseMatrix<CScalarT>::RowType    C_row;
+
+            reserve_row_union(C, A);
+            for_each_row_union([&](IndexType i)
+            {
+                bool const complement_flag = true;
+
+                T_row.clear();
+
+                if (!A[i].empty()) // && !M[i].empty()) cannot do mask shortcut
+                {
+                    auto const &M_i(M[i]);
+                    auto m_it(M_i.begin());
+
+                    // Compute: T[i] = M[i] .* {C[i] + (A +.* B')[i]}
+                    auto const &A_i(A[i]);
+                    B.forEachRow([&](IndexType j, auto const &B_j)
+                    {
+                        // See if M[i] allows write.
+                        if (advance_and_check_mask_iterator(
+                                m_it, M_i.end(), structure_flag, j))
+                        {
+                            return;
+                        }
+
+                        // Perform the dot product and accum if necessary
+                        TScalarType t_ij;
+                        if (dot(t_ij, A_i, B_j, semiring))
+                        {
+                            T_row.emplace_back(j, t_ij);
+                        }
+                    });
+                }
+
+                // Z[i] = (M .* C) + T[i]
+                Z_row.clear();
+                masked_accum(Z_row,
+                             M[i], structure_flag, complement_flag,
+                             accum, C[i], T_row);
+
+
+                if (outp == REPLACE)
+                {
+                    C.setRow(i, Z_row);
+                }
+                else /* merge */
+                {
+                    // T[i] := (M[i] .* C[i])  U  Z[i]
+                    C_row.clear();
+                    masked_merge(C_row,
+                                 M[i], structure_flag, complement_flag,
+                                 C[i], Z_row);
+                    C.setRow(i, C_row);  // set even if it is empty.
+                }
+            }, C, A);
+        }
+
+        //**********************************************************************
+        // A' * B
+        //**********************************************************************
+
+        // The A'*B kernels first form the rows of A' (O(nnz(A))) so that each
+        // row of T can be computed independently with a row accumulator:
+        // T[i] = A'[i] +.* B.  Row i of A' lists k in increasing order, so
+        // the products are reduced in the same order as scattering
+        // a_ki*B[k] into T[i] for k = 0, 1, ...
+
+        //**********************************************************************
+        // Perform T = A'*B where T, A and B must all be unique
+        template<typename TScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATB_NoMask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            auto AT(ATB_transpose(A));
+            SparseAccumulator<TScalarT> spa(B.ncols());
+
+            for_each_row_union([&](IndexType i)
+            {
+                if (AT[i].empty()) return;
+
+                // T[i] = A'[i] +.* B  // must reduce in D3, hence T.
+                spa_axpy_row(T.mutableRow(i), spa, semiring, AT[i], B);
+            }, AT);
+        }
+
+        //**********************************************************************
+        // Perform T<M> = A'*B where T, A and B must all be unique
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATB_Mask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            auto AT(ATB_transpose(A));
+            SparseAccumulator<TScalarT> spa(B.ncols());
+
+            for_each_row_union([&](IndexType i)
+            {
+                if (AT[i].empty() || M[i].empty()) return;
+
+                // T[i] = M[i] .* (A'[i] +.* B)  // must reduce in D3, hence T.
+                spa_masked_axpy_row(T.mutableRow(i), spa,
+                                    M[i], structure_flag, false,
+                                    semiring, AT[i], B);
+            }, AT);
+        }
+
+        //**********************************************************************
+        // Perform T<!M> = A'*B where T, A and B must all be unique
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATB_CompMask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            auto AT(ATB_transpose(A));
+            SparseAccumulator<TScalarT> spa(B.ncols());
+
+            for_each_row_union([&](IndexType i)
+            {
+                if (AT[i].empty()) return;
+
+                // T[i] = !M[i] .* (A'[i] +.* B)  // must reduce in D3, hence T.
+                spa_masked_axpy_row(T.mutableRow(i), spa,
+                                    M[i], structure_flag, true,
+                                    semiring, AT[i], B);
+            }, AT);
+        }
+
+        //**********************************************************************
+        // A' * B'
+        //**********************************************************************
+
+        //**********************************************************************
+        // Compute T<!M> = (A'*B') = (B*A)', assuming T, B, and A are unique.
+        // Row i of B*A is column i of T, so the complemented mask is applied
+        // from the corresponding column of M: masked locations are skipped
+        // during accumulation and never computed.
+        template<typename TScalarT,
+                 typename MScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BScalarT>
+        inline void ATBT_CompMask_kernel(
+            LilSparseMatrix<TScalarT>       &T,
+            LilSparseMatrix<MScalarT> const &M,
+            bool                             structure_flag,
+            SemiringT                        semiring,
+            LilSparseMatrix<AScalarT> const &A,
+            LilSparseMatrix<BScalarT> const &B)
+        {
+            // MT[i] = M(:,i)
+            LilSparseMatrix<MScalarT> MT(M.ncols(), M.nrows());
+            for_each_row_union([&](IndexType j)
+            {
+                for (auto&& [i, m_ji] : M[j])
+                {
+                    MT.mutableRow(i).emplace_back(j, m_ji);
+                }
+            }, M);
+
+            typename LilSparseMatrix<TScalarT>::RowType T_row;
+            SparseAccumulator<TScalarT> spa(A.ncols());
+
+            for_each_row_union([&](IndexType i)
+            {
+                if (B[i].empty()) return;
+
+                // T'[i] = !M'[i] .* (B[i] +.* A)  // must reduce in D3
+                spa_masked_axpy_row(T_row, spa,
+                                    MT[i], structure_flag, true,
+                                    semiring, B[i], A);
+
+                // T.setCol(i, T_row) in push_back form
+                for (auto&& [j, t_ji] : T_row)
+                {
+                    T.mutableRow(j).emplace_back(i, t_ji);
+                }
+            }, B);
+        }
+
+    } // backend
+} // grb
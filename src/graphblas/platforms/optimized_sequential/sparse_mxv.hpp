@@ -36,6 +36,9 @@
 
 #include "sparse_helpers.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_kernels.hpp>
+
 
 //****************************************************************************
 
@@ -63,31 +66,29 @@ namespace grb
             GRB_LOG_VERBOSE("w<M,z> := A +.* u");
 
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
+            // Pull: dot products of the rows of A with u, only for the rows
+            // that the mask allows.  Elements of u are looked up directly
+            // (O(1) for bitmap vectors) instead of merged with each row.
             using TScalarType = typename SemiringT::result_type;
             std::vector<std::tuple<IndexType, TScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
+                masked_row_dots(
+                    t, A, mask,
+                    [&u, &op](TScalarType &t_val, auto const &A_row)
+                    { return dot_rev_lookup(t_val, A_row, u, op); });
+            }
+
+            // =================================================================
+            // t is already restricted to the mask, so without accumulation
+            // and with replace it is the final result.
+            if constexpr (std::is_same_v<AccumT, NoAccumulate>)
+            {
+                if (outp == REPLACE)
                 {
-                    if (!A[row_idx].empty())
-                    {
-                        TScalarType t_val;
-                        /// @note In mxv_timing_test, if I reverse u_contents and
-                        /// A[row_idx], the performance improves by a factor of 2.
-                        /// But I cannot reorder in case op is not commutative.
-                        ///
-                        /// I have added dot_rev() helper that reverses the two
-                        /// vectors but keeps the order correct for op.
-                        ///
-                        /// I suspect this is strictly data dependent performance
-                        if (dot_rev(t_val, A[row_idx], u_contents, op))
-                        {
-                            t.emplace_back(row_idx, t_val);
-                        }
-                    }
+                    w.setContents(t);
+                    return;
                 }
             }
 
@@ -132,18 +133,25 @@ namespace grb
             auto const &A(AT.m_mat);
 
             // =================================================================
-            // Use axpy approach with the semi-ring.
+            // Push: accumulate u[k]*A[k] over the stored values of u, only
+            // forming the products that the mask allows.
             using TScalarType = typename SemiringT::result_type;
             std::vector<std::tuple<IndexType, TScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                for (IndexType row_idx = 0; row_idx < u.size(); ++row_idx)
+                masked_vector_axpy(t, op, u.contents(), A, mask);
+            }
+
+            // =================================================================
+            // t is already restricted to the mask, so without accumulation
+            // and with replace it is the final result.
+            if constexpr (std::is_same_v<AccumT, NoAccumulate>)
+            {
+                if (outp == REPLACE)
                 {
-                    if (u.hasElement(row_idx) && !A[row_idx].empty())
-                    {
-                        axpy(t, op, u.extractElement(row_idx), A[row_idx]);
-                    }
+                    w.setContents(t);
+                    return;
                 }
             }
 
@@ -36,6 +36,9 @@
 
 #include "sparse_helpers.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_kernels.hpp>
+
 //****************************************************************************
 
 namespace grb
@@ -68,17 +71,7 @@ namespace grb
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
-                {
-                    /// @todo There is something hinky with domains here.  How
-                    /// does one perform the reduction in A domain but produce
-                    /// partial results in D3(op)?
-                    TScalarType t_val;
-                    if (reduction(t_val, A[row_idx], op))
-                    {
-                        t.emplace_back(row_idx, t_val);
-                    }
-                }
+                reduce_rows(t, A, op);
             }
 
             // =================================================================
@@ -124,14 +117,14 @@ namespace grb
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                for_each_row_union([&](IndexType row_idx)
                 {
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
                     /// partial results in D3(op)?
                     if (!A[row_idx].empty())
                         xpey(t, A[row_idx], op);
-                }
+                }, A);
             }
 
             // =================================================================
@@ -171,7 +164,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                reduction(t, u.getContents(), op);
+                reduction(t, u.contents(), op);
             }
 
             // =================================================================
@@ -210,7 +203,7 @@ namespace grb
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                for_each_row_union([&](IndexType row_idx)
                 {
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
@@ -224,7 +217,7 @@ namespace grb
                             t = op(t, tmp); // reduce across rows
                         }
                     }
-                }
+                }, A);
             }
 
             // =================================================================
@@ -266,7 +259,7 @@ namespace grb
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                for_each_row_union([&](IndexType row_idx)
                 {
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
@@ -280,7 +273,7 @@ namespace grb
                             t = op(t, tmp); // reduce across rows
                         }
                     }
-                }
+                }, A);
             }
 
             // =================================================================
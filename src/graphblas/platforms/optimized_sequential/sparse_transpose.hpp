@@ -64,15 +64,16 @@ namespace grb
             // =================================================================
             // Transpose A into T.
             LilSparseMatrix<typename AMatrixT::ScalarType> T(ncols, nrows);
+            T.reserveRows(A.nvals());
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                A.forEachRow([&](IndexType row_idx, auto const &a_row)
                 {
-                    for (auto && [col_idx, val] : A[row_idx])
+                    for (auto && [col_idx, val] : a_row)
                     {
-                        T[col_idx].emplace_back(row_idx, val);
+                        T.mutableRow(col_idx).emplace_back(row_idx, val);
                     }
-                }
+                });
                 T.recomputeNvals();
             }
             // =================================================================
@@ -36,6 +36,9 @@
 
 #include "sparse_helpers.hpp"
 
+// the configured platform's row loop kernels (not necessarily this directory)
+#include <sparse_kernels.hpp>
+
 //****************************************************************************
 
 namespace grb
@@ -62,18 +65,25 @@ namespace grb
             GRB_LOG_VERBOSE("w<M,z> := u +.* A");
 
             // =================================================================
-            // Use axpy approach with the semi-ring.
+            // Push: accumulate u[k]*A[k] over the stored values of u, only
+            // forming the products that the mask allows.
             using TScalarType = typename SemiringT::result_type;
             std::vector<std::tuple<IndexType, TScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                for (IndexType row_idx = 0; row_idx < u.size(); ++row_idx)
+                masked_vector_axpy(t, op, u.contents(), A, mask);
+            }
+
+            // =================================================================
+            // t is already restricted to the mask, so without accumulation
+            // and with replace it is the final result.
+            if constexpr (std::is_same_v<AccumT, NoAccumulate>)
+            {
+                if (outp == REPLACE)
                 {
-                    if (u.hasElement(row_idx) && !A[row_idx].empty())
-                    {
-                        axpy(t, op, u.extractElement(row_idx), A[row_idx]);
-                    }
+                    w.setContents(t);
+                    return;
                 }
             }
 
@@ -118,23 +128,116 @@ namespace grb
             auto const &A(AT.m_mat);
 
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
+            // Pull: dot products of u with the rows of A, only for the rows
+            // that the mask allows.
             using TScalarType = typename SemiringT::result_type;
             std::vector<std::tuple<IndexType, TScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
+                masked_row_dots(
+                    t, A, mask,
+                    [&u, &op](TScalarType &t_val, auto const &A_row)
+                    { return dot_lookup(t_val, u, A_row, op); });
+            }
+
+            // =================================================================
+            // t is already restricted to the mask, so without accumulation
+            // and with replace it is the final result.
+            if constexpr (std::is_same_v<AccumT, NoAccumulate>)
+            {
+                if (outp == REPLACE)
+                {
+                    w.setContents(t);
+                    return;
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            using ZScalarType = typename std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                TScalarType,
+                decltype(accum(std::declval<typename WVectorT::ScalarType>(),
+                               std::declval<TScalarType>()))>;
+
+            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace/merge
+            write_with_opt_mask_1D(w, z, mask, outp);
+        }
+
+        //**********************************************************************
+        //**********************************************************************
+        //**********************************************************************
+
+        //********************************************************************
+        /// Fused form of 4.3.2 vxm: u * A, where the stored values of u are
+        /// not materialized but produced on the fly: source(emit) calls
+        /// emit(k, u_k) for each stored value of u in increasing k.  Used by
+        /// the nonblocking mode to run an element-wise producer of u and the
+        /// multiply that consumes it in a single pass.
+        //********************************************************************
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename SourceT,
+                 typename AMatrixT>
+        inline void vxm_fused(WVectorT          &w,
+                              MaskT       const &mask,
+                              AccumT      const &accum,
+                              SemiringT          op,
+                              SourceT            source,
+                              AMatrixT    const &A,
+                              OutputControlEnum  outp)
+        {
+            GRB_LOG_VERBOSE("w<M,z> := f(...) +.* A (fused)");
+
+            // =================================================================
+            // Push each produced u[k] straight into the accumulator.  The
+            // flops are not known up front (u is not stored), so they are
+            // counted as the rows of A are reached and the accumulator grows
+            // with the count, as it would be sized by the unfused vxm.
+            using TScalarType = typename SemiringT::result_type;
+            std::vector<std::tuple<IndexType, TScalarType> > t;
+
+            if (A.nvals() > 0)
+            {
+                auto add_op([&op](auto lhs, auto rhs)
+                            { return op.add(lhs, rhs); });
+
+                SparseAccumulator<TScalarType> spa(w.size());
+                IndexType flops(0);
+                spa.start_row(flops);
+                source([&](IndexType k, auto const &u_k)
+                       {
+                           auto const &A_k(A[k]);
+                           flops += A_k.size();
+                           spa.grow_row(flops);
+                           for (auto&& [j, a_kj] : A_k)
+                           {
+                               if (mask_allows(mask, j))
+                               {
+                                   spa.accumulate(j, op.mult(u_k, a_kj),
+                                                  add_op);
+                               }
+                           }
+                       });
+                spa.gather(t);
+            }
+
+            // =================================================================
+            // t is already restricted to the mask, so without accumulation
+            // and with replace it is the final result.
+            if constexpr (std::is_same_v<AccumT, NoAccumulate>)
+            {
+                if (outp == REPLACE)
                 {
-                    if (!A[row_idx].empty())
-                    {
-                        TScalarType t_val;
-                        if (dot(t_val, u_contents, A[row_idx], op))
-                        {
-                            t.emplace_back(row_idx, t_val);
-                        }
-                    }
+                    w.setContents(t);
+                    return;
                 }
             }
 
@@ -0,0 +1,323 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE bitmap_sparse_vector_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+using VectorType = grb::backend::BitmapSparseVector<double>;
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_construction_formats)
+{
+    grb::IndexType M = 64;
+    VectorType v1(M);
+    BOOST_CHECK(v1.isSparse());
+    BOOST_CHECK_EQUAL(v1.nvals(), 0);
+    BOOST_CHECK_THROW(v1.extractElement(M-1), NoValueException);
+    BOOST_CHECK_THROW(v1.extractElement(M), IndexOutOfBoundsException);
+
+    VectorType v2(M, 3.0);
+    BOOST_CHECK(!v2.isSparse());
+    BOOST_CHECK_EQUAL(v2.nvals(), M);
+    BOOST_CHECK_EQUAL(v2.extractElement(M-1), 3.0);
+
+    std::vector<double> dense(M, 0.0);
+    dense[5] = 1.0;
+    dense[40] = 2.0;
+    VectorType v3(dense, 0.0);
+    BOOST_CHECK(v3.isSparse());
+    BOOST_CHECK_EQUAL(v3.nvals(), 2);
+    BOOST_CHECK_EQUAL(v3.extractElement(40), 2.0);
+    BOOST_CHECK(!v3.hasElement(6));
+
+    VectorType v4(dense);
+    BOOST_CHECK(!v4.isSparse());
+    BOOST_CHECK_EQUAL(v4.nvals(), M);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_set_element_converts_to_bitmap)
+{
+    grb::IndexType M = 32;
+    VectorType v(M);
+
+    // M/SPARSE_DIVISOR = 2 values fit in the sparse list format
+    v.setElement(20, 2.0);
+    v.setElement(3, 1.0);
+    BOOST_CHECK(v.isSparse());
+    v.setElement(3, 5.0);
+    BOOST_CHECK(v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), 2);
+
+    v.setElement(11, 3.0);
+    BOOST_CHECK(!v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), 3);
+    BOOST_CHECK_EQUAL(v.extractElement(3), 5.0);
+    BOOST_CHECK_EQUAL(v.extractElement(11), 3.0);
+    BOOST_CHECK_EQUAL(v.extractElement(20), 2.0);
+
+    std::vector<std::tuple<IndexType, double>> ans = {{3, 5.0}, {11, 3.0},
+                                                      {20, 2.0}};
+    BOOST_CHECK(v.getContents() == ans);
+
+    v.removeElement(11);
+    v.removeElement(12);
+    BOOST_CHECK_EQUAL(v.nvals(), 2);
+    BOOST_CHECK(!v.hasElement(11));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_set_element_out_of_order_converts_to_bitmap)
+{
+    grb::IndexType M = 4096;
+
+    // appends do not shift the list: sparse up to M/SPARSE_DIVISOR values
+    VectorType up(M);
+    for (grb::IndexType idx = 0; idx < M/VectorType::SPARSE_DIVISOR; ++idx)
+    {
+        up.setElement(idx, 1.0);
+    }
+    BOOST_CHECK(up.isSparse());
+
+    // inserting at the front shifts the whole list each time: switch to
+    // bitmap once M elements have been shifted
+    VectorType down(M);
+    grb::IndexType num_sparse(0);
+    for (grb::IndexType idx = M/VectorType::SPARSE_DIVISOR; idx-- > 0; )
+    {
+        down.setElement(idx, double(idx));
+        if (down.isSparse()) ++num_sparse;
+    }
+    BOOST_CHECK(!down.isSparse());
+    BOOST_CHECK(num_sparse * (num_sparse - 1)/2 <= M);
+    BOOST_CHECK(num_sparse * (num_sparse + 1)/2 > M);
+    BOOST_CHECK_EQUAL(down.nvals(), M/VectorType::SPARSE_DIVISOR);
+    for (grb::IndexType idx = 0; idx < M/VectorType::SPARSE_DIVISOR; ++idx)
+    {
+        BOOST_CHECK_EQUAL(down.extractElement(idx), double(idx));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_set_contents_and_clear)
+{
+    grb::IndexType M = 100;
+    VectorType v(M, 1.0);
+
+    // a small frontier replaces a full vector: stale bitmap must not leak
+    std::vector<std::tuple<IndexType, double>> small = {{7, 7.0}, {42, 4.2}};
+    v.setContents(small);
+    BOOST_CHECK(v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), 2);
+    BOOST_CHECK(!v.hasElement(8));
+    BOOST_CHECK(v.getContents() == small);
+
+    std::vector<std::tuple<IndexType, double>> big;
+    for (IndexType i = 0; i < M; i += 2)
+    {
+        big.emplace_back(i, double(i));
+    }
+    v.setContents(big);
+    BOOST_CHECK(!v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), big.size());
+    BOOST_CHECK(!v.hasElement(7));
+    BOOST_CHECK_EQUAL(v.extractElement(42), 42.0);
+    BOOST_CHECK(v.getContents() == big);
+
+    v.clear();
+    BOOST_CHECK(v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), 0);
+    BOOST_CHECK(!v.hasElement(0));
+
+    // going back to bitmap after clear() must reset the old bitmap
+    v.setContents(small);
+    for (IndexType i = 0; i < 10; ++i)
+    {
+        v.setElement(50 + i, 1.0);
+    }
+    BOOST_CHECK(!v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), 12);
+    BOOST_CHECK(!v.hasElement(0));
+    BOOST_CHECK_EQUAL(v.extractElement(42), 4.2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_build_counts_duplicates_once)
+{
+    grb::IndexType M = 64;
+    VectorType v(M);
+
+    std::vector<IndexType> idx = {9, 3, 9, 60};
+    std::vector<double>    val = {1., 2., 3., 4.};
+    v.build(idx.begin(), val.begin(), idx.size(), grb::Plus<double>());
+    BOOST_CHECK(v.isSparse());
+    BOOST_CHECK_EQUAL(v.nvals(), 3);
+    BOOST_CHECK_EQUAL(v.extractElement(9), 4.0);
+
+    std::vector<IndexType> bad = {64};
+    BOOST_CHECK_THROW(v.build(bad.begin(), val.begin(), 1),
+                      IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_equality_across_formats)
+{
+    grb::IndexType M = 64;
+    std::vector<std::tuple<IndexType, double>> contents = {{2, 1.0}, {5, 2.0}};
+
+    VectorType sp(M);
+    sp.setContents(contents);
+
+    VectorType bm(M, 0.0);
+    for (IndexType i = 0; i < M; ++i)
+    {
+        bm.removeElement(i);
+    }
+    bm.setElement(2, 1.0);
+    bm.setElement(5, 2.0);
+
+    BOOST_CHECK(sp.isSparse());
+    BOOST_CHECK(!bm.isSparse());
+    BOOST_CHECK_EQUAL(sp, bm);
+    BOOST_CHECK_EQUAL(bm, sp);
+
+    bm.setElement(5, 3.0);
+    BOOST_CHECK_NE(sp, bm);
+
+    VectorType sp2(sp);
+    BOOST_CHECK(sp2.isSparse());
+    BOOST_CHECK_EQUAL(sp2, sp);
+    sp2 = bm;
+    BOOST_CHECK_EQUAL(sp2, bm);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_resize_sparse)
+{
+    VectorType v(100);
+    v.setElement(10, 1.0);
+    v.setElement(60, 2.0);
+    BOOST_CHECK(v.isSparse());
+
+    v.resize(50);
+    BOOST_CHECK_EQUAL(v.size(), 50);
+    BOOST_CHECK_EQUAL(v.nvals(), 1);
+    BOOST_CHECK_THROW(v.extractElement(60), IndexOutOfBoundsException);
+
+    v.resize(200);
+    BOOST_CHECK_EQUAL(v.nvals(), 1);
+    BOOST_CHECK_EQUAL(v.extractElement(10), 1.0);
+    v.setElement(150, 3.0);
+    BOOST_CHECK_EQUAL(v.nvals(), 2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_vxm_mxv_sparse_frontier)
+{
+    grb::IndexType N = 64;
+    std::vector<IndexType> rows, cols;
+    for (IndexType i = 0; i < N; ++i)
+    {
+        rows.push_back(i); cols.push_back((i + 1) % N);
+        rows.push_back(i); cols.push_back((i + 7) % N);
+    }
+    std::vector<double> vals(rows.size(), 1.0);
+    grb::Matrix<double> A(N, N);
+    A.build(rows, cols, vals);
+
+    grb::Vector<double> u(N);
+    u.setElement(0, 1.0);
+    u.setElement(30, 1.0);
+
+    grb::Vector<double> w(N);
+    grb::vxm(w, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), u, A);
+
+    grb::Vector<double> ans(N);
+    ans.setElement(1, 1.0);
+    ans.setElement(7, 1.0);
+    ans.setElement(31, 1.0);
+    ans.setElement(37, 1.0);
+    BOOST_CHECK_EQUAL(w, ans);
+
+    grb::Vector<double> w2(N);
+    grb::mxv(w2, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), grb::transpose(A), u);
+    BOOST_CHECK_EQUAL(w2, ans);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_contents_view_matches_get_contents)
+{
+    // sparse list format
+    VectorType v(100);
+    BOOST_CHECK(v.contents().empty());
+    BOOST_CHECK(v.contents().begin() == v.contents().end());
+
+    v.setElement(3, 1.0);
+    v.setElement(42, 2.0);
+    v.setElement(99, 3.0);
+    BOOST_CHECK(v.isSparse());
+    BOOST_CHECK_EQUAL(v.contents().size(), 3);
+    std::vector<std::tuple<IndexType, double> > seen(v.contents().begin(),
+                                                     v.contents().end());
+    BOOST_CHECK(seen == v.getContents());
+
+    // bitmap format, including the first and last elements
+    VectorType bm(20);
+    for (IndexType idx = 0; idx < 20; idx += 3) bm.setElement(idx, idx);
+    bm.setElement(19, 19.0);
+    BOOST_CHECK(!bm.isSparse());
+    seen.assign(bm.contents().begin(), bm.contents().end());
+    BOOST_CHECK(seen == bm.getContents());
+
+    bm.clear();
+    BOOST_CHECK(bm.contents().begin() == bm.contents().end());
+
+    // the views feed the helpers directly
+    std::vector<std::tuple<IndexType, double> > sum;
+    grb::backend::ewise_or(sum, v.contents(), v.contents(), grb::Plus<double>());
+    BOOST_CHECK_EQUAL(sum.size(), 3);
+    BOOST_CHECK_EQUAL(std::get<1>(sum[1]), 4.0);
+
+    double total(0);
+    BOOST_CHECK(grb::backend::reduction(total, v.contents(),
+                                        grb::Plus<double>()));
+    BOOST_CHECK_EQUAL(total, 6.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,271 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE hypersparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    using LilType = backend::LilSparseMatrix<double>;
+
+    IndexType const N = 64 * LilType::HYPERSPARSE_MIN_ROWS;
+
+    // A few entries in rows far apart (unsorted, with a duplicate)
+    IndexArrayType      i_few = {N - 1, 7, 300, 7, 7};
+    IndexArrayType      j_few = {0,     5, N - 2, 1, 5};
+    std::vector<double> v_few = {1,     2, 3,     4, 5};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hyper_test_construction)
+{
+    // new matrices get one row per row; clearing a tall matrix drops them
+    LilType m1(N, N);
+    BOOST_CHECK(!m1.hypersparse());
+    m1.clear();
+    BOOST_CHECK(m1.hypersparse());
+    BOOST_CHECK_EQUAL(m1.nrows(), N);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK(m1[N - 1].empty());
+
+    LilType m2(LilType::HYPERSPARSE_MIN_ROWS - 1, N);
+    m2.clear();
+    BOOST_CHECK(!m2.hypersparse());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hyper_test_build_and_access)
+{
+    LilType m1(N, N);
+    m1.build(i_few.begin(), j_few.begin(), v_few.begin(), i_few.size(),
+             grb::Plus<double>());
+
+    BOOST_CHECK(m1.hypersparse());
+    BOOST_CHECK_EQUAL(m1.nvals(), 4);
+    BOOST_CHECK_EQUAL(m1.extractElement(7, 5), 7.);
+    BOOST_CHECK_EQUAL(m1.extractElement(7, 1), 4.);
+    BOOST_CHECK_EQUAL(m1.extractElement(300, N - 2), 3.);
+    BOOST_CHECK_EQUAL(m1.extractElement(N - 1, 0), 1.);
+    BOOST_CHECK(!m1.hasElement(8, 5));
+    BOOST_CHECK_THROW(m1.extractElement(8, 5), NoValueException);
+
+    IndexArrayType      i(m1.nvals()), j(m1.nvals());
+    std::vector<double> v(m1.nvals());
+    m1.extractTuples(i.begin(), j.begin(), v.begin());
+    BOOST_CHECK(i == IndexArrayType({7, 7, 300, N - 1}));
+    BOOST_CHECK(j == IndexArrayType({1, 5, N - 2, 0}));
+    BOOST_CHECK(v == std::vector<double>({4, 7, 3, 1}));
+
+    IndexArrayType rows;
+    m1.forEachRow([&rows](IndexType row_idx, LilType::RowType const &)
+                  { rows.push_back(row_idx); });
+    BOOST_CHECK(rows == IndexArrayType({7, 300, N - 1}));
+
+    BOOST_CHECK_EQUAL(m1.getCol(5).size(), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hyper_test_set_remove)
+{
+    LilType m1(N, N);
+    m1.clear();
+    m1.setElement(12, 3, 1.);
+    m1.setElement(12, 1, 2.);
+    m1.setElement(N - 1, 3, 3.);
+    BOOST_CHECK_EQUAL(m1.nvals(), 3);
+    BOOST_CHECK_EQUAL(m1.extractElement(12, 1), 2.);
+
+    m1.removeElement(12, 3);
+    m1.removeElement(12, 1);
+    m1.removeElement(13, 1);
+    BOOST_CHECK_EQUAL(m1.nvals(), 1);
+    BOOST_CHECK(m1[12].empty());
+
+    m1.setRow(N - 1, LilType::RowType());
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK(m1.hypersparse());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hyper_test_storage_switch)
+{
+    IndexType const M = 2 * LilType::HYPERSPARSE_MIN_ROWS;
+    IndexArrayType      i, j;
+    std::vector<double> v;
+    for (IndexType ix = 0; ix < M; ix += 2)
+    {
+        i.push_back(ix);  j.push_back(ix % 10);  v.push_back(ix);
+    }
+
+    // half of the rows are non-empty
+    LilType m1(M, M);
+    m1.clear();
+    BOOST_CHECK(m1.hypersparse());
+    m1.build(i.begin(), j.begin(), v.begin(), i.size(), grb::Second<double>());
+    BOOST_CHECK(!m1.hypersparse());
+    BOOST_CHECK_EQUAL(m1.nvals(), M / 2);
+
+    // same contents in the other storage are equal
+    LilType m2(m1);
+    m2.setHypersparse(true);
+    BOOST_CHECK(m2.hypersparse());
+    BOOST_CHECK_EQUAL(m1, m2);
+    BOOST_CHECK_EQUAL(m2.extractElement(M - 2, (M - 2) % 10), M - 2);
+
+    // dropping most of the rows goes back to hypersparse
+    m1.resize(M / 64, M);
+    BOOST_CHECK(!m1.hypersparse());   // fewer than HYPERSPARSE_MIN_ROWS rows
+    m2.clear();
+    BOOST_CHECK(m2.hypersparse());
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+
+    m2.setRow(5, LilType::RowType{{1, 2.}});
+    m2.recomputeNvals();
+    BOOST_CHECK(m2.hypersparse());
+    BOOST_CHECK_EQUAL(m2.nvals(), 1);
+
+    // filling rows one at a time keeps the storage (and references to
+    // rows) until recomputeNvals
+    LilType m3(M, M);
+    m3.clear();
+    LilType::RowType &row0(m3.mutableRow(0));
+    for (IndexType ix = 0; ix < M; ++ix)
+    {
+        BOOST_CHECK(m3[ix].empty());
+        m3.setRow(ix, LilType::RowType{{ix % 10, 1.}});
+    }
+    BOOST_CHECK(m3.hypersparse());
+    BOOST_CHECK_EQUAL(row0.size(), 1);
+    m3.recomputeNvals();
+    BOOST_CHECK(!m3.hypersparse());
+    BOOST_CHECK_EQUAL(m3.nvals(), M);
+    BOOST_CHECK_EQUAL(m3.extractElement(M - 1, (M - 1) % 10), 1.);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hyper_test_operations)
+{
+    grb::Matrix<double> A(N, N);
+    A.build(i_few, j_few, v_few, grb::Plus<double>());
+
+    // C = A'
+    grb::Matrix<double> C(N, N);
+    grb::transpose(C, grb::NoMask(), grb::NoAccumulate(), A);
+    BOOST_CHECK_EQUAL(C.nvals(), 4);
+    BOOST_CHECK_EQUAL(C.extractElement(N - 2, 300), 3.);
+    BOOST_CHECK_EQUAL(C.extractElement(0, N - 1), 1.);
+
+    // C += A
+    grb::eWiseAdd(C, grb::NoMask(), grb::NoAccumulate(),
+                  grb::Plus<double>(), C, A);
+    BOOST_CHECK_EQUAL(C.nvals(), 8);
+
+    // C<A> = 2*A
+    grb::apply(C, A, grb::NoAccumulate(),
+               std::bind(grb::Times<double>(), std::placeholders::_1, 2.),
+               A, grb::REPLACE);
+    BOOST_CHECK_EQUAL(C.nvals(), 4);
+    BOOST_CHECK_EQUAL(C.extractElement(7, 5), 14.);
+
+    // D = A +.* A: the rows of A that would be scaled (1, 5, N-2 and 0)
+    // are all empty
+    grb::Matrix<double> D(N, N);
+    grb::mxm(D, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(D.nvals(), 0);
+
+    // D = A +.* A'
+    grb::mxm(D, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, grb::transpose(A));
+    BOOST_CHECK_EQUAL(D.nvals(), 3);
+    BOOST_CHECK_EQUAL(D.extractElement(7, 7), 4. * 4. + 7. * 7.);
+
+    // w = row sums of A
+    grb::Vector<double> w(N);
+    grb::reduce(w, grb::NoMask(), grb::NoAccumulate(),
+                grb::Plus<double>(), A);
+    BOOST_CHECK_EQUAL(w.nvals(), 3);
+    BOOST_CHECK_EQUAL(w.extractElement(7), 11.);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(hyper_test_mxm_fills_per_row_storage)
+{
+    // A has 4 values in every row, so A*A has 16
+    IndexArrayType      i, j;
+    std::vector<double> v;
+    for (IndexType row = 0; row < N; ++row)
+    {
+        for (IndexType k = 0; k < 4; ++k)
+        {
+            i.push_back(row);
+            j.push_back((row * 7 + k * 1031) % N);
+            v.push_back(1.);
+        }
+    }
+    grb::Matrix<double> A(N, N);
+    A.build(i, j, v);
+    BOOST_CHECK(!get_internal_matrix(A).hypersparse());
+
+    grb::Matrix<double> C(N, N);
+    grb::mxm(C, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK(!get_internal_matrix(C).hypersparse());
+
+    // an output that is hypersparse on entry (built with a few values)
+    // is switched before the rows are written, not left as a map
+    grb::Matrix<double> D(N, N);
+    D.build(i_few, j_few, v_few, grb::Plus<double>());
+    BOOST_CHECK(get_internal_matrix(D).hypersparse());
+    grb::mxm(D, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK(!get_internal_matrix(D).hypersparse());
+    BOOST_CHECK_EQUAL(D, C);
+
+    // same with an accumulated result
+    grb::Matrix<double> E(N, N);
+    E.build(i_few, j_few, v_few, grb::Plus<double>());
+    grb::Matrix<double> E_ans(N, N);
+    grb::eWiseAdd(E_ans, grb::NoMask(), grb::NoAccumulate(),
+                  grb::Plus<double>(), E, C);
+    grb::mxm(E, grb::NoMask(), grb::Plus<double>(),
+             grb::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK(!get_internal_matrix(E).hypersparse());
+    BOOST_CHECK_EQUAL(E, E_ans);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@
 #include <vector>
 #include <typeinfo>
 #include <numeric>
+#include <utility>
 
 namespace grb
 {
@@ -178,6 +179,25 @@ namespace grb
             {
             }
 
+            /**
+             * @brief Move constructor for BitmapSparseVector.
+             *
+             * @param[in] rhs  The BitmapSparseVector to move from.  It is left
+             *                 with size zero and can only be move-assigned
+             *                 to or destroyed.
+             */
+            BitmapSparseVector(BitmapSparseVector<ScalarT> &&rhs) noexcept
+                : m_size(rhs.m_size),
+                  m_nvals(rhs.m_nvals),
+                  m_vals(std::move(rhs.m_vals)),
+                  m_bitmap(std::move(rhs.m_bitmap))
+            {
+                rhs.m_size = 0;
+                rhs.m_nvals = 0;
+                rhs.m_vals.clear();
+                rhs.m_bitmap.clear();
+            }
+
             ~BitmapSparseVector() {}
 
             /**
@@ -204,6 +224,33 @@ namespace grb
                 return *this;
             }
 
+            /**
+             * @brief Move assignment (takes the size of rhs, which receives
+             *        the old contents of this vector).
+             *
+             * @param[in] rhs  The BitmapSparseVector to move from
+             *
+             * @return *this.
+             */
+            BitmapSparseVector<ScalarT>& operator=(
+                BitmapSparseVector<ScalarT> &&rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    swap(rhs);
+                }
+                return *this;
+            }
+
+            /// O(1) exchange of contents and size
+            void swap(BitmapSparseVector<ScalarT> &rhs) noexcept
+            {
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+            }
+
             /**
              * @brief Assignment from a dense vector.
              *
@@ -32,6 +32,7 @@
 #include <typeinfo>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
 
 #include <graphblas/graphblas.hpp>
 
@@ -69,6 +70,20 @@ namespace grb
             {
             }
 
+            // Constructor - move (rhs is left with zero dimensions and can
+            // only be move-assigned to or destroyed)
+            LilSparseMatrix(LilSparseMatrix<ScalarT> &&rhs) noexcept
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_data(std::move(rhs.m_data))
+            {
+                rhs.m_num_rows = 0;
+                rhs.m_num_cols = 0;
+                rhs.m_nvals = 0;
+                rhs.m_data.clear();
+            }
+
             // Constructor - dense from dense matrix
             LilSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
                 : m_num_rows(val.size()),
@@ -139,6 +154,18 @@ namespace grb
                 return *this;
             }
 
+            // Assignment - move (unlike copy, no dimension check: takes the
+            // dimensions of rhs, which receives the old contents of this matrix)
+            LilSparseMatrix<ScalarT> &operator=(
+                LilSparseMatrix<ScalarT> &&rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    swap(rhs);
+                }
+                return *this;
+            }
+
             // EQUALITY OPERATORS
             /**
              * @brief Equality testing for LilMatrix.
@@ -417,14 +444,13 @@ namespace grb
                 m_nvals = nvals;
             }
 
-            // TODO: add error checking on dimensions?
-            void swap(LilSparseMatrix<ScalarT> &rhs)
+            // O(1) exchange of contents and dimensions
+            void swap(LilSparseMatrix<ScalarT> &rhs) noexcept
             {
-                for (IndexType idx = 0; idx < m_data.size(); ++idx)
-                {
-                    m_data[idx].swap(rhs.m_data[idx]);
-                }
-                m_nvals = rhs.m_nvals;
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_data.swap(rhs.m_data);
             }
 
             // Row access
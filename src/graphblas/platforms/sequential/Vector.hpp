@@ -63,6 +63,23 @@ namespace grb
             Vector(std::vector<ScalarT> const &values, ScalarT const &zero)
                 : ParentVectorType(values, zero) {}
 
+            Vector(Vector const &rhs) : ParentVectorType(rhs) {}
+
+            Vector(Vector &&rhs) noexcept
+                : ParentVectorType(std::move(rhs)) {}
+
+            Vector &operator=(Vector const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
+            Vector &operator=(Vector &&rhs) noexcept
+            {
+                ParentVectorType::operator=(std::move(rhs));
+                return *this;
+            }
+
             ~Vector() {}  // virtual?
 
             // necessary?
@@ -564,5 +564,81 @@ namespace grb
             // Copy Z into the final output considering mask and replace/merge
             write_with_opt_mask(C, Z, Mask, outp);
         }
+
+        //**********************************************************************
+        // Diagonal scaling (in place): A := diag(d) * A and A := A * diag(d)
+        //**********************************************************************
+
+        /**
+         * @brief A(i,j) := op(d(i), A(i,j)) for every stored element.  Rows
+         *        without a stored d(i) are cleared, as they are in diag(d)*A.
+         */
+        template<typename AScalarT,
+                 typename DScalarT,
+                 typename BinaryOpT,
+                 typename ...ATagsT,
+                 typename ...DTagsT>
+        inline void scale_rows(
+            grb::backend::Matrix<AScalarT, ATagsT...>       &A,
+            grb::backend::Vector<DScalarT, DTagsT...> const &d,
+            BinaryOpT                                        op)
+        {
+            GRB_LOG_VERBOSE("A := diag(d) op A");
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                auto &row(A[row_idx]);
+                if (row.empty()) continue;
+
+                if (!d.hasElement(row_idx))
+                {
+                    row.clear();
+                    continue;
+                }
+
+                DScalarT d_val(d.extractElement(row_idx));
+                for (auto &&[col_idx, val] : row)
+                {
+                    val = static_cast<AScalarT>(op(d_val, val));
+                }
+            }
+            A.recomputeNvals();
+        }
+
+        //**********************************************************************
+        /**
+         * @brief A(i,j) := op(A(i,j), d(j)) for every stored element.
+         *        Elements without a stored d(j) are removed, as they are in
+         *        A*diag(d).
+         */
+        template<typename AScalarT,
+                 typename DScalarT,
+                 typename BinaryOpT,
+                 typename ...ATagsT,
+                 typename ...DTagsT>
+        inline void scale_cols(
+            grb::backend::Matrix<AScalarT, ATagsT...>       &A,
+            grb::backend::Vector<DScalarT, DTagsT...> const &d,
+            BinaryOpT                                        op)
+        {
+            GRB_LOG_VERBOSE("A := A op diag(d)");
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                auto &row(A[row_idx]);
+                auto out_it(row.begin());
+                for (auto &&[col_idx, val] : row)
+                {
+                    if (d.hasElement(col_idx))
+                    {
+                        *out_it = std::make_tuple(
+                            col_idx,
+                            static_cast<AScalarT>(
+                                op(val, d.extractElement(col_idx))));
+                        ++out_it;
+                    }
+                }
+                row.erase(out_it, row.end());
+            }
+            A.recomputeNvals();
+        }
     }
 }
@@ -0,0 +1,209 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+/**
+ * mxm and mxv with a CsrMatrix as the A operand: the rows of A are read
+ * directly from its compressed arrays (no conversion to a LilSparseMatrix).
+ */
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <tuple>
+
+#include <graphblas/detail/logging.h>
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+#include <graphblas/CsrMatrix.hpp>
+
+#include "sparse_helpers.hpp"
+#include "LilSparseMatrix.hpp"
+
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Row k of B as a sorted vector of (index, value) tuples.
+        template<typename BScalarT>
+        inline typename LilSparseMatrix<BScalarT>::RowType const &
+        csr_get_row(LilSparseMatrix<BScalarT> const &B, IndexType k)
+        {
+            return B[k];
+        }
+
+        template<typename BScalarT>
+        inline std::vector<std::tuple<IndexType, BScalarT> >
+        csr_get_row(CsrMatrix<BScalarT> const &B, IndexType k)
+        {
+            std::vector<std::tuple<IndexType, BScalarT> > row;
+            row.reserve(B.rowSize(k));
+            for (IndexType b_pos = B.rowPointers()[k];
+                 b_pos < B.rowPointers()[k + 1]; ++b_pos)
+            {
+                row.emplace_back(B.colIndices()[b_pos], B.values()[b_pos]);
+            }
+            return row;
+        }
+
+        //**********************************************************************
+        /// Implementation of 4.3.1 mxm: A * B for a CsrMatrix A and a
+        /// LilSparseMatrix or CsrMatrix B.
+        //**********************************************************************
+        template<typename CMatrixT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BMatrixT>
+        inline void mxm_csr(CMatrixT                  &C,
+                            MaskT               const &Mask,
+                            AccumT              const &accum,
+                            SemiringT                  op,
+                            CsrMatrix<AScalarT> const &A,
+                            BMatrixT            const &B,
+                            OutputControlEnum          outp)
+        {
+            GRB_LOG_VERBOSE("C<M,z> := csr(A) +.* B");
+
+            // =================================================================
+            // T = A +.* B, one axpy per stored element of A
+            using TScalarType = typename SemiringT::result_type;
+            LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
+
+            if ((A.nvals() > 0) && (B.nvals() > 0))
+            {
+                auto const &a_ptr(A.rowPointers());
+                auto const &a_idx(A.colIndices());
+                auto const &a_val(A.values());
+
+                std::vector<std::tuple<IndexType, TScalarType> > T_row;
+                for (IndexType i = 0; i < A.nrows(); ++i)
+                {
+                    T_row.clear();
+                    for (IndexType a_pos = a_ptr[i]; a_pos < a_ptr[i + 1]; ++a_pos)
+                    {
+                        axpy(T_row, op, a_val[a_pos],
+                             csr_get_row(B, a_idx[a_pos]));
+                    }
+
+                    if (!T_row.empty()) T.setRow(i, T_row);
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            using ZScalarType = typename std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                TScalarType,
+                decltype(accum(std::declval<typename CMatrixT::ScalarType>(),
+                               std::declval<TScalarType>()))>;
+
+            LilSparseMatrix<ZScalarType> Z(C.nrows(), C.ncols());
+            ewise_or_opt_accum(Z, C, T, accum);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace/merge
+            write_with_opt_mask(C, Z, Mask, outp);
+        }
+
+        //**********************************************************************
+        /// Implementation of 4.3.3 mxv: A * u for a CsrMatrix A.
+        //**********************************************************************
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename UVectorT>
+        inline void mxv_csr(WVectorT                  &w,
+                            MaskT               const &mask,
+                            AccumT              const &accum,
+                            SemiringT                  op,
+                            CsrMatrix<AScalarT> const &A,
+                            UVectorT            const &u,
+                            OutputControlEnum          outp)
+        {
+            GRB_LOG_VERBOSE("w<M,z> := csr(A) +.* u");
+
+            // =================================================================
+            // Do the basic dot-product work with the semi-ring.
+            using TScalarType = typename SemiringT::result_type;
+            std::vector<std::tuple<IndexType, TScalarType> > t;
+
+            if ((A.nvals() > 0) && (u.nvals() > 0))
+            {
+                auto const &a_ptr(A.rowPointers());
+                auto const &a_idx(A.colIndices());
+                auto const &a_val(A.values());
+
+                for (IndexType i = 0; i < A.nrows(); ++i)
+                {
+                    TScalarType t_i;
+                    bool value_set(false);
+                    for (IndexType a_pos = a_ptr[i]; a_pos < a_ptr[i + 1]; ++a_pos)
+                    {
+                        IndexType k(a_idx[a_pos]);
+                        if (!u.hasElement(k)) continue;
+
+                        if (value_set)
+                        {
+                            t_i = op.add(t_i, op.mult(a_val[a_pos],
+                                                      u.extractElement(k)));
+                        }
+                        else
+                        {
+                            t_i = op.mult(a_val[a_pos], u.extractElement(k));
+                            value_set = true;
+                        }
+                    }
+
+                    if (value_set) t.emplace_back(i, t_i);
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            using ZScalarType = typename std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                TScalarType,
+                decltype(accum(std::declval<typename WVectorT::ScalarType>(),
+                               std::declval<TScalarType>()))>;
+
+            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace/merge
+            write_with_opt_mask_1D(w, z, mask, outp);
+        }
+    } // backend
+} // grb
@@ -184,6 +184,9 @@ namespace grb
                         value_set = true;
                     }
 
+                    // nothing can change a terminal value (e.g. logical or)
+                    if (is_terminal(op, ans)) break;
+
                     do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
                     ++A_iter;
                 }
@@ -236,6 +239,8 @@ namespace grb
                         value_set = true;
                     }
 
+                    if (is_terminal(op, ans)) break;
+
                     ++v2_it;
                     ++v1_it;
                 }
@@ -288,6 +293,8 @@ namespace grb
                         value_set = true;
                     }
 
+                    if (is_terminal(op, ans)) break;
+
                     ++v2_it;
                     ++v1_it;
                 }
@@ -335,6 +342,7 @@ namespace grb
                 /// @todo replace with call to std::reduce?
                 for (size_t idx = 2; idx < vec.size(); ++idx)
                 {
+                    if (is_terminal(op, tmp)) break;
                     tmp = op(tmp, std::get<1>(vec[idx]));
                 }
             }
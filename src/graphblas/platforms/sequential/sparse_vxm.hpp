@@ -154,5 +154,64 @@ namespace grb
             write_with_opt_mask_1D(w, z, mask, outp);
         }
 
+        //**********************************************************************
+        //**********************************************************************
+        //**********************************************************************
+
+        //********************************************************************
+        /// Fused form of 4.3.2 vxm: u * A, where the stored values of u are
+        /// not materialized but produced on the fly: source(emit) calls
+        /// emit(k, u_k) for each stored value of u in increasing k.  Used by
+        /// the nonblocking mode to run an element-wise producer of u and the
+        /// multiply that consumes it in a single pass.
+        //********************************************************************
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename SourceT,
+                 typename AMatrixT>
+        inline void vxm_fused(WVectorT          &w,
+                              MaskT       const &mask,
+                              AccumT      const &accum,
+                              SemiringT          op,
+                              SourceT            source,
+                              AMatrixT    const &A,
+                              OutputControlEnum  outp)
+        {
+            GRB_LOG_VERBOSE("w<M,z> := f(...) +.* A (fused)");
+
+            // =================================================================
+            // Use axpy approach with the semi-ring.
+            using TScalarType = typename SemiringT::result_type;
+            std::vector<std::tuple<IndexType, TScalarType> > t;
+
+            if (A.nvals() > 0)
+            {
+                source([&](IndexType k, auto const &u_k)
+                       {
+                           if (!A[k].empty())
+                           {
+                               axpy(t, op, u_k, A[k]);
+                           }
+                       });
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            using ZScalarType = typename std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                TScalarType,
+                decltype(accum(std::declval<typename WVectorT::ScalarType>(),
+                               std::declval<TScalarType>()))>;
+
+            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace/merge
+            write_with_opt_mask_1D(w, z, mask, outp);
+        }
+
     } // backend
 } // grb
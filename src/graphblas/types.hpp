@@ -108,6 +108,8 @@ namespace grb
     template<class MatrixT> class MatrixStructureView;
     template<class MatrixT> class MatrixStructuralComplementView;
 
+    template<class VectorT> class DiagonalView;
+
     template <class MatrixT>
     inline constexpr bool is_matrix_v<TransposeView<MatrixT>> = true;
 
@@ -149,4 +151,11 @@ namespace grb
 
     template <class MatrixT>
     inline constexpr bool is_transpose_v<TransposeView<MatrixT>> = true;
+
+
+    template <class>
+    inline constexpr bool is_diagonal_v = false;
+
+    template <class VectorT>
+    inline constexpr bool is_diagonal_v<DiagonalView<VectorT>> = true;
 }
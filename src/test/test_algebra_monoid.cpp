@@ -471,4 +471,39 @@ BOOST_AUTO_TEST_CASE(logical_xnor_monoid_test)
     BOOST_CHECK_EQUAL(LogicalXnorMonoid<bool>()(true, true),  true);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(monoid_terminal_test)
+{
+    BOOST_CHECK(has_terminal_v<LogicalOrMonoid<bool>>);
+    BOOST_CHECK(has_terminal_v<LogicalAndMonoid<bool>>);
+    BOOST_CHECK(has_terminal_v<MinMonoid<int>>);
+    BOOST_CHECK(has_terminal_v<MaxMonoid<double>>);
+    BOOST_CHECK(!has_terminal_v<PlusMonoid<int>>);
+    BOOST_CHECK(!has_terminal_v<TimesMonoid<double>>);
+    BOOST_CHECK(!has_terminal_v<LogicalXorMonoid<bool>>);
+    BOOST_CHECK(!has_terminal_v<Plus<int>>);
+
+    BOOST_CHECK_EQUAL(LogicalOrMonoid<bool>().terminal(), true);
+    BOOST_CHECK_EQUAL(LogicalOrMonoid<uint32_t>().terminal(), 1U);
+    BOOST_CHECK_EQUAL(LogicalAndMonoid<bool>().terminal(), false);
+
+    BOOST_CHECK_EQUAL(MinMonoid<int32_t>().terminal(),
+                      std::numeric_limits<int32_t>::min());
+    BOOST_CHECK_EQUAL(MinMonoid<uint64_t>().terminal(), 0UL);
+    BOOST_CHECK_EQUAL(MinMonoid<double>().terminal(),
+                      -std::numeric_limits<double>::infinity());
+    BOOST_CHECK_EQUAL(MaxMonoid<uint8_t>().terminal(), 255U);
+    BOOST_CHECK_EQUAL(MaxMonoid<float>().terminal(),
+                      std::numeric_limits<float>::infinity());
+
+    // the terminal value annihilates
+    BOOST_CHECK_EQUAL(MinMonoid<int8_t>()(MinMonoid<int8_t>().terminal(), 5),
+                      MinMonoid<int8_t>().terminal());
+    BOOST_CHECK_EQUAL(LogicalAndMonoid<bool>()(false, true), false);
+
+    BOOST_CHECK(is_terminal(LogicalOrMonoid<bool>(), true));
+    BOOST_CHECK(!is_terminal(LogicalOrMonoid<bool>(), false));
+    BOOST_CHECK(!is_terminal(PlusMonoid<int>(), 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1189,4 +1189,27 @@ BOOST_AUTO_TEST_CASE(max_second_test)
     BOOST_CHECK_EQUAL(MaxSecondSemiring<bool>().mult(true, false), false);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(semiring_terminal_test)
+{
+    BOOST_CHECK(has_terminal_v<LogicalSemiring<bool>>);
+    BOOST_CHECK(has_terminal_v<MinPlusSemiring<int>>);
+    BOOST_CHECK(has_terminal_v<MinFirstSemiring<uint64_t>>);
+    BOOST_CHECK(!has_terminal_v<ArithmeticSemiring<double>>);
+    BOOST_CHECK(!has_terminal_v<XorAndSemiring<bool>>);
+
+    BOOST_CHECK_EQUAL(LogicalSemiring<bool>().terminal(), true);
+    BOOST_CHECK_EQUAL(AndOrSemiring<bool>().terminal(), false);
+    BOOST_CHECK_EQUAL(MinPlusSemiring<int>().terminal(),
+                      std::numeric_limits<int>::min());
+    BOOST_CHECK_EQUAL(MaxTimesSemiring<double>().terminal(),
+                      std::numeric_limits<double>::infinity());
+
+    // also visible through the additive monoid of the semiring
+    BOOST_CHECK(has_terminal_v<decltype(add_monoid(LogicalSemiring<bool>()))>);
+    BOOST_CHECK_EQUAL(add_monoid(LogicalSemiring<bool>()).terminal(), true);
+    BOOST_CHECK(!has_terminal_v<
+                decltype(add_monoid(ArithmeticSemiring<double>()))>);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -465,4 +465,75 @@ BOOST_AUTO_TEST_CASE(bc_test_batch_alt_trans_v2)
 }
 
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bc_test_vertex_betweennes_centrality_parallel)
+{
+    Matrix<double, DirectedMatrixTag> betweenness(8,8);
+    betweenness.build(br.begin(), bc.begin(), bv.begin(), bv.size());
+
+    IndexArrayType seed_set={0};
+    std::vector<float> answer = {0.0, 4.0/3, 4.0/3, 4.0/3, 3.0, 0.5, 0.5, 0.0};
+
+    std::vector<float> result =
+        vertex_betweenness_centrality_parallel(betweenness, seed_set);
+
+    BOOST_CHECK_EQUAL(result.size(), answer.size());
+    for (unsigned int ix = 0; ix < result.size(); ++ix)
+        BOOST_CHECK_CLOSE(result[ix], answer[ix], 0.0001);
+
+    //========== batches of 3 sources
+    IndexArrayType seed_set_all={0,1,2,3,4,5,6,7};
+    std::vector<double> answer_all = {0.0, 4.0/3, 4.0/3, 4.0/3, 12.0, 2.5, 2.5, 0.0};
+
+    std::vector<float> result_all =
+        vertex_betweenness_centrality_parallel(betweenness, seed_set_all, 3);
+
+    BOOST_CHECK_EQUAL(result_all.size(), answer_all.size());
+    for (unsigned int ix = 0; ix < result_all.size(); ++ix)
+        BOOST_CHECK_CLOSE(result_all[ix], answer_all[ix], 0.0001);
+
+    //========== sampling every source is exact
+    std::vector<float> result_approx =
+        approximate_betweenness_centrality(betweenness, 8);
+    for (unsigned int ix = 0; ix < result_approx.size(); ++ix)
+        BOOST_CHECK_CLOSE(result_approx[ix], answer_all[ix], 0.0001);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bc_test_vertex_betweennes_centrality_parallel_deep)
+{
+    // a path deeper than the old 10 level limit: BC(v) = v*(N-1-v)
+    IndexType const N(25);
+    IndexArrayType rows, cols;
+    for (IndexType v = 0; v + 1 < N; ++v)
+    {
+        rows.push_back(v);      cols.push_back(v + 1);
+        rows.push_back(v + 1);  cols.push_back(v);
+    }
+    Matrix<double> path(N, N);
+    path.build(rows, cols, std::vector<double>(rows.size(), 1.0));
+
+    IndexArrayType seed_set(N);
+    std::iota(seed_set.begin(), seed_set.end(), 0);
+
+    std::vector<float> result =
+        vertex_betweenness_centrality_parallel(path, seed_set, 4);
+    std::vector<float> result_v2 =
+        vertex_betweenness_centrality_batch_alt_trans_v2(path, seed_set);
+
+    for (IndexType v = 0; v < N; ++v)
+    {
+        float answer(2.0f*v*(N - 1 - v));
+        BOOST_CHECK_CLOSE(result[v] + 1.0f, answer + 1.0f, 0.0001);
+        BOOST_CHECK_CLOSE(result_v2[v] + 1.0f, answer + 1.0f, 0.0001);
+    }
+
+    // a sample of half the sources gives an unbiased estimate (a fixed seed
+    // keeps this deterministic); check the total and the endpoints
+    std::vector<float> approx = approximate_betweenness_centrality(path, 12, 7);
+    BOOST_CHECK_EQUAL(approx[0], 0.0f);
+    BOOST_CHECK_EQUAL(approx[N - 1], 0.0f);
+    for (IndexType v = 1; v + 1 < N; ++v) BOOST_CHECK(approx[v] > 0.0f);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
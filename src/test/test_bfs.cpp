@@ -752,4 +752,72 @@ BOOST_AUTO_TEST_CASE(bfs_level_masked_v2_test_one_root_integer)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(vxm_push_pull_matches_vxm)
+{
+    using T = grb::IndexType;
+    grb::IndexType const NUM_NODES(9);
+
+    grb::IndexArrayType i = {0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                             4, 4, 4, 5, 6, 6, 6, 8, 8};
+    grb::IndexArrayType j = {3, 3, 6, 4, 5, 6, 8, 0, 1, 4, 6,
+                             2, 3, 8, 2, 1, 2, 3, 2, 4};
+    std::vector<T> v(i.size(), 1);
+
+    grb::Matrix<T> G_tn(NUM_NODES, NUM_NODES);
+    G_tn.build(i, j, v);
+
+    grb::Vector<T> visited(NUM_NODES);
+    visited.setElement(2, 2);
+    visited.setElement(3, 3);
+
+    // frontiers of increasing size exercise both directions
+    std::unique_ptr<grb::Matrix<T>> G_tnT;
+    for (grb::IndexType num_front = 1; num_front <= NUM_NODES; num_front += 2)
+    {
+        grb::Vector<T> frontier(NUM_NODES);
+        for (grb::IndexType ix = 0; ix < num_front; ++ix)
+        {
+            frontier.setElement(ix, ix + 1);
+        }
+
+        grb::Vector<T> answer(NUM_NODES);
+        grb::vxm(answer,
+                 grb::complement(grb::structure(visited)),
+                 grb::NoAccumulate(),
+                 grb::MinFirstSemiring<T>(),
+                 frontier, G_tn, grb::REPLACE);
+
+        grb::Vector<T> result(NUM_NODES);
+        algorithms::vxm_push_pull(result,
+                                  grb::complement(grb::structure(visited)),
+                                  grb::NoAccumulate(),
+                                  grb::MinFirstSemiring<T>(),
+                                  frontier, G_tn, G_tnT, grb::REPLACE);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        // with the counts tracked by the caller
+        grb::Vector<T> result_counts(NUM_NODES);
+        algorithms::vxm_push_pull(result_counts,
+                                  grb::complement(grb::structure(visited)),
+                                  grb::NoAccumulate(),
+                                  grb::MinFirstSemiring<T>(),
+                                  frontier, num_front, NUM_NODES - 2,
+                                  G_tn, G_tnT, grb::REPLACE);
+        BOOST_CHECK_EQUAL(result_counts, answer);
+
+        // merge with a value mask
+        grb::Vector<T> answer2(visited);
+        grb::vxm(answer2, visited, grb::Plus<T>(),
+                 grb::ArithmeticSemiring<T>(), frontier, G_tn);
+
+        grb::Vector<T> result2(visited);
+        algorithms::vxm_push_pull(result2, visited, grb::Plus<T>(),
+                                  grb::ArithmeticSemiring<T>(),
+                                  frontier, G_tn, G_tnT);
+        BOOST_CHECK_EQUAL(result2, answer2);
+    }
+    BOOST_CHECK(G_tnT);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
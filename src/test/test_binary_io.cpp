@@ -0,0 +1,284 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE binary_io_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    std::string temp_path(std::string const &name)
+    {
+        return (std::filesystem::temp_directory_path() /
+                ("gbtl_" + name + ".bin")).string();
+    }
+
+    // overwrite the 64-bit word at the given byte offset of a file
+    void patch_word(std::string const &path, size_t offset, uint64_t word)
+    {
+        std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(offset);
+        fs.write(reinterpret_cast<char const *>(&word), sizeof(word));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_io_round_trip)
+{
+    // unsorted input
+    IndexArrayType i = {2, 0, 1, 0, 2, 1, 0, 2};
+    IndexArrayType j = {1, 3, 0, 1, 0, 3, 2, 3};
+    std::vector<double> v = {9, 3, 4, 1, 8, 7, 2, 5};
+
+    Matrix<double> A(3, 5);
+    A.build(i, j, v);
+
+    std::string path(temp_path("round_trip"));
+    save_binary(path, A);
+
+    Matrix<double> B(1, 1);
+    B.setElement(0, 0, 42.0);
+    load_binary(path, B);
+    BOOST_CHECK_EQUAL(B, A);
+
+    std::remove(path.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_io_mapped_matrix)
+{
+    std::vector<std::vector<double>> mat = {{0, 1, 2, 0},
+                                            {0, 0, 0, 0},
+                                            {8, 0, 0, 3}};
+    Matrix<double> A(mat, 0.);
+
+    std::string path(temp_path("mapped"));
+    save_binary(path, A);
+
+    auto M(load_binary<double>(path));
+    BOOST_CHECK_EQUAL(M.nrows(), 3);
+    BOOST_CHECK_EQUAL(M.ncols(), 4);
+    BOOST_CHECK_EQUAL(M.nvals(), 4);
+
+    BOOST_CHECK_EQUAL(M.rowSize(0), 2);
+    BOOST_CHECK_EQUAL(M.rowSize(1), 0);
+    BOOST_CHECK_EQUAL(M.rowSize(2), 2);
+    BOOST_CHECK_EQUAL(M.colIndices()[M.rowBegin(2)], 0);
+    BOOST_CHECK_EQUAL(M.values()[M.rowBegin(2) + 1], 3.0);
+
+    BOOST_CHECK(M.hasElement(0, 2));
+    BOOST_CHECK(!M.hasElement(1, 2));
+    BOOST_CHECK_EQUAL(M.extractElement(2, 3), 3.0);
+    BOOST_CHECK_THROW(M.extractElement(1, 1), NoValueException);
+    BOOST_CHECK_THROW(M.hasElement(3, 0), IndexOutOfBoundsException);
+
+    IndexArrayType rows(M.nvals()), cols(M.nvals());
+    std::vector<double> vals(M.nvals());
+    M.extractTuples(rows.begin(), cols.begin(), vals.begin());
+    Matrix<double> B(M.nrows(), M.ncols());
+    B.build(rows, cols, vals);
+    BOOST_CHECK_EQUAL(B, A);
+
+    // copies share the mapping
+    auto M2(M);
+    BOOST_CHECK_EQUAL(M2.values(), M.values());
+
+    std::remove(path.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_io_bool_and_empty)
+{
+    Matrix<bool> A(4, 4);
+    A.setElement(0, 1, true);
+    A.setElement(3, 2, false);  // stored false
+
+    std::string path(temp_path("bool"));
+    save_binary(path, A);
+
+    Matrix<bool> B(4, 4);
+    load_binary(path, B);
+    BOOST_CHECK_EQUAL(B, A);
+    BOOST_CHECK_EQUAL(load_binary<bool>(path).extractElement(3, 2), false);
+
+    Matrix<int32_t> E(7, 3);
+    save_binary(path, E);
+    Matrix<int32_t> F(2, 2);
+    load_binary(path, F);
+    BOOST_CHECK_EQUAL(F, E);
+    BOOST_CHECK_EQUAL(F.nrows(), 7);
+    BOOST_CHECK_EQUAL(F.nvals(), 0);
+
+    std::remove(path.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_io_errors)
+{
+    Matrix<int32_t> A(2, 2);
+    A.setElement(1, 0, 5);
+
+    std::string path(temp_path("errors"));
+    save_binary(path, A);
+
+    // wrong scalar type
+    BOOST_CHECK_THROW(load_binary<uint32_t>(path), InvalidValueException);
+    BOOST_CHECK_THROW(load_binary<double>(path), InvalidValueException);
+    BOOST_CHECK_NO_THROW(load_binary<int32_t>(path));
+
+    // not a matrix file
+    {
+        std::ofstream ofs(path, std::ios::trunc);
+        ofs << "0 1\n1 0\n";
+    }
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), InvalidValueException);
+
+    std::remove(path.c_str());
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), PanicException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_io_corrupt_files)
+{
+    // 3x3, row pointers {0, 1, 2, 3}, column indices {1, 0, 2}
+    Matrix<int32_t> A(3, 3);
+    A.setElement(0, 1, 1);
+    A.setElement(1, 0, 2);
+    A.setElement(2, 2, 3);
+
+    using Header = grb::detail::BinaryMatrixHeader;
+    size_t const nrows_at(offsetof(Header, nrows));
+    size_t const nvals_at(offsetof(Header, nvals));
+    size_t const row_ptr_at(sizeof(Header));
+    size_t const col_idx_at(row_ptr_at + 4*sizeof(IndexType));
+
+    std::string path(temp_path("corrupt"));
+    Matrix<int32_t> B(1, 1);
+
+    // row_ptr[0] != 0
+    save_binary(path, A);
+    patch_word(path, row_ptr_at, 1);
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), InvalidValueException);
+
+    // decreasing row pointers
+    save_binary(path, A);
+    patch_word(path, row_ptr_at + 2*sizeof(IndexType), 0);
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), InvalidValueException);
+    BOOST_CHECK_THROW(load_binary(path, B), InvalidValueException);
+
+    // row pointer beyond nvals
+    save_binary(path, A);
+    patch_word(path, row_ptr_at + sizeof(IndexType), 1000000);
+    BOOST_CHECK_THROW(load_binary(path, B), InvalidValueException);
+
+    // sizes whose byte counts overflow (8 * 2^61 wraps to 0)
+    save_binary(path, A);
+    patch_word(path, nvals_at, uint64_t(1) << 61);
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), InvalidValueException);
+    save_binary(path, A);
+    patch_word(path, nrows_at, ~uint64_t(0));
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), InvalidValueException);
+
+    // column index out of range
+    save_binary(path, A);
+    patch_word(path, col_idx_at + sizeof(IndexType), 3);
+    BOOST_CHECK_THROW(load_binary<int32_t>(path), InvalidValueException);
+    BOOST_CHECK_THROW(load_binary(path, B), InvalidValueException);
+
+    save_binary(path, A);
+    BOOST_CHECK_NO_THROW(load_binary(path, B));
+    BOOST_CHECK_EQUAL(A, B);
+
+    std::remove(path.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_io_unsorted_columns_and_bad_bools)
+{
+    // 2x3, row pointers {0, 2, 3}, column indices {0, 2, 1}
+    Matrix<bool> A(2, 3);
+    A.setElement(0, 0, true);
+    A.setElement(0, 2, false);
+    A.setElement(1, 1, true);
+
+    using Header = grb::detail::BinaryMatrixHeader;
+    size_t const col_idx_at(sizeof(Header) + 3*sizeof(IndexType));
+    size_t const vals_at(col_idx_at + 3*sizeof(IndexType));
+
+    std::string path(temp_path("unsorted"));
+    Matrix<bool> B(1, 1);
+
+    // repeated column in a row
+    save_binary(path, A);
+    patch_word(path, col_idx_at + sizeof(IndexType), 0);
+    BOOST_CHECK_THROW(load_binary<bool>(path), InvalidValueException);
+    BOOST_CHECK_THROW(load_binary(path, B), InvalidValueException);
+
+    // decreasing columns in a row
+    save_binary(path, A);
+    patch_word(path, col_idx_at, 2);
+    patch_word(path, col_idx_at + sizeof(IndexType), 1);
+    BOOST_CHECK_THROW(load_binary<bool>(path), InvalidValueException);
+
+    // a bool byte that is neither 0 nor 1
+    save_binary(path, A);
+    {
+        std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(vals_at + 1);
+        fs.put(char(2));
+    }
+    BOOST_CHECK_THROW(load_binary<bool>(path), InvalidValueException);
+    BOOST_CHECK_THROW(load_binary(path, B), InvalidValueException);
+
+    save_binary(path, A);
+    BOOST_CHECK_NO_THROW(load_binary(path, B));
+    BOOST_CHECK_EQUAL(A, B);
+
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -322,4 +322,148 @@ BOOST_AUTO_TEST_CASE(cluster_test_peer_pressure_karate)
     // }
     // std::cout << "]" << std::endl;
 }
+//****************************************************************************
+namespace
+{
+    // Two 4-cliques (0-3 and 4-7) joined by the edge 3-4, with self loops
+    grb::Matrix<double> two_cliques()
+    {
+        grb::IndexArrayType i, j;
+        for (grb::IndexType base : {0UL, 4UL})
+        {
+            for (grb::IndexType u = base; u < base + 4; ++u)
+            {
+                for (grb::IndexType v = base; v < base + 4; ++v)
+                {
+                    i.push_back(u);
+                    j.push_back(v);
+                }
+            }
+        }
+        i.push_back(3); j.push_back(4);
+        i.push_back(4); j.push_back(3);
+
+        std::vector<double> v(i.size(), 1.0);
+        grb::Matrix<double> A(8, 8);
+        A.build(i, j, v);
+        return A;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_markov_pruned)
+{
+    auto A(two_cliques());
+
+    algorithms::MarkovClusterOptions opts;
+    auto C(algorithms::markov_cluster(A, opts));
+
+    // converged: one stored element (the attractor) per column
+    BOOST_CHECK_EQUAL(C.nvals(), 8);
+    auto assignments(get_cluster_assignments(C));
+    for (grb::IndexType v = 1; v < 4; ++v)
+    {
+        BOOST_CHECK_EQUAL(assignments[v], assignments[0]);
+        BOOST_CHECK_EQUAL(assignments[v + 4], assignments[4]);
+    }
+    BOOST_CHECK(assignments[0] != assignments[4]);
+
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_markov_legacy_unpruned)
+{
+    auto A(two_cliques());
+
+    // reference: three unpruned iterations of M<M> = normalize((M*M).^2)
+    grb::Matrix<double> M(8, 8);
+    grb::apply(M, grb::NoMask(), grb::NoAccumulate(),
+               grb::Identity<double>(), A);
+    grb::normalize_cols(M);
+    for (int iter = 0; iter < 3; ++iter)
+    {
+        grb::mxm(M, M, grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<double>(), M, M, grb::REPLACE);
+        grb::eWiseMult(M, grb::NoMask(), grb::NoAccumulate(),
+                       grb::Times<double>(), M, M);
+        grb::normalize_cols(M);
+    }
+
+    // the legacy signature keeps every element of the graph's structure
+    auto C(algorithms::markov_cluster(A, 2, 2, 0.0, 3));
+    BOOST_CHECK_EQUAL(C.nvals(), A.nvals());
+    BOOST_CHECK_EQUAL(C.nvals(), M.nvals());
+
+    grb::IndexArrayType ri(M.nvals()), rj(M.nvals());
+    std::vector<double> rv(M.nvals());
+    M.extractTuples(ri.begin(), rj.begin(), rv.begin());
+    for (grb::IndexType ix = 0; ix < rv.size(); ++ix)
+    {
+        BOOST_REQUIRE(C.hasElement(ri[ix], rj[ix]));
+        BOOST_CHECK_CLOSE(C.extractElement(ri[ix], rj[ix]), rv[ix], 1e-9);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_markov_select_k)
+{
+    auto A(two_cliques());
+
+    // at most two elements per column after every iteration
+    algorithms::MarkovClusterOptions opts;
+    opts.select_k = 2;
+    opts.recover_k = 0;
+    opts.max_iters = 1;
+    auto C(algorithms::markov_cluster(A, opts));
+    BOOST_CHECK(C.nvals() <= 16);
+
+    // the columns stay stochastic
+    grb::Vector<double> col_sums(8);
+    grb::reduce(col_sums, grb::NoMask(), grb::NoAccumulate(),
+                grb::Plus<double>(), grb::transpose(C));
+    for (grb::IndexType v = 0; v < 8; ++v)
+    {
+        BOOST_CHECK_CLOSE(col_sums.extractElement(v), 1.0, 1e-9);
+    }
+
+    // no pruning at all: one iteration keeps the full expansion
+    opts.prune_threshold = 0.0;
+    opts.select_k = 0;
+    auto D(algorithms::markov_cluster(A, opts));
+    grb::Matrix<double> A2(8, 8);
+    grb::mxm(A2, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(D.nvals(), A2.nvals());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_markov_select_k_recover)
+{
+    auto A(two_cliques());
+
+    // two elements hold about half the mass of a clique column, so the
+    // recovery after selection puts the next largest elements back
+    algorithms::MarkovClusterOptions opts;
+    opts.select_k = 2;
+    opts.max_iters = 1;
+    auto C(algorithms::markov_cluster(A, opts));
+    BOOST_CHECK(C.nvals() > 16);
+
+    for (grb::IndexType v = 0; v < 8; ++v)
+    {
+        grb::IndexType col_nvals(0);
+        double col_sum(0.0);
+        for (grb::IndexType u = 0; u < 8; ++u)
+        {
+            if (C.hasElement(u, v))
+            {
+                ++col_nvals;
+                col_sum += C.extractElement(u, v);
+            }
+        }
+        BOOST_CHECK(col_nvals > 2);
+        BOOST_CHECK_CLOSE(col_sum, 1.0, 1e-9);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -145,4 +145,102 @@ BOOST_AUTO_TEST_CASE(cluster_test_louvain_masked)
                 cluster_assignments.extractElement(1));
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_louvain_multilevel)
+{
+    grb::IndexArrayType i_m1 = {0, 0, 0, 0,
+                                1, 1, 1, 1,
+                                2, 2, 2, 2,
+                                3, 3, 3, 3,
+                                4, 4, 4, 4,
+                                5, 5, 5, 5, 5,
+                                6, 6, 6,
+                                7, 7, 7, 7};
+    grb::IndexArrayType j_m1 = {0, 2, 3, 6,
+                                1, 2, 3, 7,
+                                0, 2, 4, 6,
+                                0, 1, 3, 5,
+                                0, 2, 4, 6,
+                                1, 3, 5, 6, 7,
+                                0, 4, 6,
+                                1, 3, 5, 7};
+    std::vector<double> v_m1(i_m1.size(), 1.0);
+    Matrix<double> m1(8, 8);
+    m1.build(i_m1, j_m1, v_m1);
+
+    grb::Vector<grb::IndexType> cluster_assignments(8);
+    auto modularity =
+        algorithms::louvain_cluster_multilevel(m1, cluster_assignments);
+
+    BOOST_CHECK(!modularity.empty());
+    BOOST_CHECK_EQUAL(cluster_assignments.nvals(), 8);
+
+    BOOST_CHECK_EQUAL(cluster_assignments.extractElement(0),
+                      cluster_assignments.extractElement(2));
+    BOOST_CHECK_EQUAL(cluster_assignments.extractElement(0),
+                      cluster_assignments.extractElement(4));
+    BOOST_CHECK_EQUAL(cluster_assignments.extractElement(0),
+                      cluster_assignments.extractElement(6));
+
+    BOOST_CHECK_EQUAL(cluster_assignments.extractElement(1),
+                      cluster_assignments.extractElement(3));
+    BOOST_CHECK_EQUAL(cluster_assignments.extractElement(1),
+                      cluster_assignments.extractElement(5));
+    BOOST_CHECK_EQUAL(cluster_assignments.extractElement(1),
+                      cluster_assignments.extractElement(7));
+
+    BOOST_CHECK(cluster_assignments.extractElement(0) !=
+                cluster_assignments.extractElement(1));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_louvain_multilevel_ring_of_cliques)
+{
+    // 6 cliques of 5 vertices, consecutive cliques joined by one edge
+    grb::IndexType const num_cliques(6), clique_size(5);
+    grb::IndexType const n(num_cliques*clique_size);
+    grb::IndexArrayType rows, cols;
+    for (grb::IndexType c = 0; c < num_cliques; ++c)
+    {
+        grb::IndexType base(c*clique_size);
+        for (grb::IndexType u = 0; u < clique_size; ++u)
+            for (grb::IndexType v = 0; v < clique_size; ++v)
+                if (u != v)
+                {
+                    rows.push_back(base + u);
+                    cols.push_back(base + v);
+                }
+
+        grb::IndexType next(((c + 1) % num_cliques)*clique_size);
+        rows.push_back(base);  cols.push_back(next + 1);
+        rows.push_back(next + 1);  cols.push_back(base);
+    }
+    Matrix<double> graph(n, n);
+    graph.build(rows, cols, std::vector<double>(rows.size(), 1.0));
+
+    grb::Vector<grb::IndexType> communities(n);
+    auto modularity =
+        algorithms::louvain_cluster_multilevel(graph, communities);
+
+    for (grb::IndexType c = 0; c < num_cliques; ++c)
+    {
+        for (grb::IndexType u = 1; u < clique_size; ++u)
+        {
+            BOOST_CHECK_EQUAL(communities.extractElement(c*clique_size),
+                              communities.extractElement(c*clique_size + u));
+        }
+        BOOST_CHECK(communities.extractElement(c*clique_size) !=
+                    communities.extractElement(
+                        ((c + 1) % num_cliques)*clique_size));
+    }
+
+    // Q = 6*(10/66 - (22/132)^2)
+    BOOST_REQUIRE(!modularity.empty());
+    BOOST_CHECK_CLOSE(modularity.back(), 6.*(10./66. - 1./36.), 1.e-6);
+    for (size_t idx = 1; idx < modularity.size(); ++idx)
+    {
+        BOOST_CHECK(modularity[idx] >= modularity[idx - 1]);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,193 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+
+#include <algorithms/connected_components.hpp>
+#include <algorithms/bfs.hpp>
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+using namespace algorithms;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE connected_components_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    //************************************************************************
+    // Reference labeling: one bfs_level per component, from its smallest
+    // vertex
+    template <typename MatrixT>
+    IndexType bfs_components(MatrixT const &A, std::vector<IndexType> &labels)
+    {
+        IndexType num_nodes(A.nrows());
+        IndexType num_components(0);
+        labels.assign(num_nodes, num_nodes);
+        for (IndexType src = 0; src < num_nodes; ++src)
+        {
+            if (labels[src] != num_nodes) continue;
+
+            ++num_components;
+            Vector<IndexType> levels(num_nodes);
+            bfs_level(A, src, levels);
+
+            IndexArrayType idx(levels.nvals());
+            std::vector<IndexType> vals(levels.nvals());
+            levels.extractTuples(idx.begin(), vals.begin());
+            for (auto v : idx) labels[v] = src;
+        }
+        return num_components;
+    }
+
+    //************************************************************************
+    // Symmetric graph with n vertices and m pseudo-random edges
+    Matrix<bool> random_graph(IndexType n, IndexType m, uint64_t seed)
+    {
+        IndexArrayType rows, cols;
+        for (IndexType e = 0; e < m; ++e)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            IndexType u = (seed >> 33) % n;
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            IndexType v = (seed >> 33) % n;
+            if (u == v) continue;
+            rows.push_back(u); cols.push_back(v);
+            rows.push_back(v); cols.push_back(u);
+        }
+        Matrix<bool> A(n, n);
+        A.build(rows, cols, std::vector<bool>(rows.size(), true),
+                grb::LogicalOr<bool>());
+        return A;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_test_disconnected)
+{
+    // {0,3,5}, {1,6,7} (a path), {2} and {4} isolated, {8,9} with self loop
+    IndexType const NUM_NODES = 10;
+    IndexArrayType i = {0, 3, 3, 5, 7, 6, 6, 1, 8, 9, 9};
+    IndexArrayType j = {3, 0, 5, 3, 6, 7, 1, 6, 9, 8, 9};
+    std::vector<double> v(i.size(), 1.0);
+    Matrix<double> A(NUM_NODES, NUM_NODES);
+    A.build(i, j, v);
+
+    Vector<IndexType> components(NUM_NODES);
+    auto num_components = connected_components(A, components);
+
+    std::vector<IndexType> ans = {0, 1, 2, 0, 4, 0, 1, 1, 8, 8};
+    BOOST_CHECK_EQUAL(num_components, 5);
+    BOOST_CHECK_EQUAL(components, Vector<IndexType>(ans));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_test_long_path)
+{
+    // a path visited in a scrambled vertex order needs several hooks
+    IndexType const NUM_NODES = 1000;
+    IndexArrayType i, j;
+    for (IndexType ix = 0; ix + 1 < NUM_NODES; ++ix)
+    {
+        IndexType u = (ix*389) % NUM_NODES, w = ((ix + 1)*389) % NUM_NODES;
+        i.push_back(u); j.push_back(w);
+        i.push_back(w); j.push_back(u);
+    }
+    Matrix<bool> A(NUM_NODES, NUM_NODES);
+    A.build(i, j, std::vector<bool>(i.size(), true));
+
+    Vector<IndexType> components(NUM_NODES);
+    BOOST_CHECK_EQUAL(connected_components(A, components), 1);
+    BOOST_CHECK_EQUAL(components,
+                      Vector<IndexType>(std::vector<IndexType>(NUM_NODES, 0)));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_test_matches_bfs)
+{
+    // average degree ~1.6: a giant component and many small ones
+    IndexType const NUM_NODES = 2000;
+    auto A(random_graph(NUM_NODES, 1600, 42));
+
+    std::vector<IndexType> bfs_labels;
+    auto bfs_count = bfs_components(A, bfs_labels);
+
+    Vector<IndexType> components(NUM_NODES);
+    auto num_components = connected_components(A, components);
+
+    BOOST_CHECK_EQUAL(num_components, bfs_count);
+    BOOST_CHECK_EQUAL(components, Vector<IndexType>(bfs_labels));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_test_batch)
+{
+    IndexType const NUM_NODES = 10;
+    IndexArrayType i = {0, 3, 3, 5, 7, 6, 6, 1, 8, 9};
+    IndexArrayType j = {3, 0, 5, 3, 6, 7, 1, 6, 9, 8};
+    Matrix<bool> A(NUM_NODES, NUM_NODES);
+    A.build(i, j, std::vector<bool>(i.size(), true));
+
+    IndexArrayType sources = {5, 4, 7, 0};
+    Matrix<bool> members(sources.size(), NUM_NODES);
+    auto num_components = batch_connected_components(A, sources, members);
+
+    IndexArrayType i_ans = {0, 0, 0, 1, 2, 2, 2, 3, 3, 3};
+    IndexArrayType j_ans = {0, 3, 5, 4, 1, 6, 7, 0, 3, 5};
+    Matrix<bool> answer(sources.size(), NUM_NODES);
+    answer.build(i_ans, j_ans, std::vector<bool>(i_ans.size(), true));
+
+    BOOST_CHECK_EQUAL(num_components, 5);
+    BOOST_CHECK_EQUAL(members, answer);
+
+    // the same as a batch of reachability BFS's
+    for (IndexType k = 0; k < sources.size(); ++k)
+    {
+        Vector<IndexType> levels(NUM_NODES);
+        bfs_level(A, sources[k], levels);
+
+        Vector<bool> reached(NUM_NODES), row(NUM_NODES);
+        apply(reached, NoMask(), NoAccumulate(),
+              [](IndexType) { return true; }, levels);
+        extract(row, NoMask(), NoAccumulate(),
+                transpose(members), AllIndices(), k);
+        BOOST_CHECK_EQUAL(row, reached);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <graphblas/graphblas.hpp>
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE csr_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+
+namespace
+{
+    std::vector<std::vector<double> > m3x4_dense = {{5, 0, 1, 2},
+                                                    {6, 7, 0, 0},
+                                                    {4, 5, 0, 1}};
+
+    std::vector<std::vector<double> > m4x3_dense = {{1, 0, 2},
+                                                    {0, 3, 0},
+                                                    {0, 0, 0},
+                                                    {4, 0, 1}};
+
+    std::vector<double> u4_dense = {0, 1, 1, 1};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_csr_construction)
+{
+    grb::Matrix<double> mA(m3x4_dense, 0.);
+    grb::CsrMatrix<double> A(mA);
+
+    BOOST_CHECK_EQUAL(A.nrows(), 3);
+    BOOST_CHECK_EQUAL(A.ncols(), 4);
+    BOOST_CHECK_EQUAL(A.nvals(), mA.nvals());
+
+    std::vector<grb::IndexType> ptr = {0, 3, 5, 8};
+    std::vector<grb::IndexType> idx = {0, 2, 3, 0, 1, 0, 1, 3};
+    std::vector<double>         val = {5, 1, 2, 6, 7, 4, 5, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS(A.rowPointers().begin(), A.rowPointers().end(),
+                                  ptr.begin(), ptr.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(A.colIndices().begin(), A.colIndices().end(),
+                                  idx.begin(), idx.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(A.values().begin(), A.values().end(),
+                                  val.begin(), val.end());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_csr_construction_from_unordered_tuples)
+{
+    grb::IndexArrayType i = {2, 0, 2, 1, 0};
+    grb::IndexArrayType j = {3, 2, 0, 1, 0};
+    std::vector<int>    v = {1, 2, 3, 4, 5};
+    grb::CsrMatrix<double> A(3, 4, i.begin(), j.begin(), v.begin(), i.size());
+
+    std::vector<grb::IndexType> ptr = {0, 2, 3, 5};
+    std::vector<grb::IndexType> idx = {0, 2, 1, 0, 3};
+    std::vector<double>         val = {5, 2, 4, 3, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS(A.rowPointers().begin(), A.rowPointers().end(),
+                                  ptr.begin(), ptr.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(A.colIndices().begin(), A.colIndices().end(),
+                                  idx.begin(), idx.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(A.values().begin(), A.values().end(),
+                                  val.begin(), val.end());
+    BOOST_CHECK_EQUAL(A.rowSize(1), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_csr_construction_bad_tuples)
+{
+    grb::IndexArrayType i = {0, 3};
+    grb::IndexArrayType j = {0, 0};
+    std::vector<double> v = {1, 1};
+    BOOST_CHECK_THROW(
+        (grb::CsrMatrix<double>(3, 3, i.begin(), j.begin(), v.begin(), 2)),
+        grb::IndexOutOfBoundsException);
+
+    grb::IndexArrayType i2 = {1, 1};
+    grb::IndexArrayType j2 = {2, 2};
+    BOOST_CHECK_THROW(
+        (grb::CsrMatrix<double>(3, 3, i2.begin(), j2.begin(), v.begin(), 2)),
+        grb::InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_csr_mxv)
+{
+    grb::Matrix<double> mA(m3x4_dense, 0.);
+    grb::CsrMatrix<double> A(mA);
+    grb::Vector<double> u(u4_dense, 0.);
+
+    grb::Vector<double> ans(3), result(3);
+    grb::mxv(ans, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, u);
+    grb::mxv(result, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, u);
+    BOOST_CHECK_EQUAL(result, ans);
+
+    // masked, accumulated
+    grb::Vector<bool> m(std::vector<bool>{true, false, true}, false);
+    grb::Vector<double> w(std::vector<double>{1, 1, 0}, 0.);
+    grb::Vector<double> w_ans(w);
+    grb::mxv(w_ans, m, grb::Plus<double>(),
+             grb::ArithmeticSemiring<double>(), mA, u, grb::REPLACE);
+    grb::mxv(w, m, grb::Plus<double>(),
+             grb::ArithmeticSemiring<double>(), A, u, grb::REPLACE);
+    BOOST_CHECK_EQUAL(w, w_ans);
+
+    grb::Vector<double> w4(4);
+    BOOST_CHECK_THROW(
+        (grb::mxv(w4, grb::NoMask(), grb::NoAccumulate(),
+                  grb::ArithmeticSemiring<double>(), A, u)),
+        grb::DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_csr_mxm)
+{
+    grb::Matrix<double> mA(m3x4_dense, 0.);
+    grb::Matrix<double> mB(m4x3_dense, 0.);
+    grb::CsrMatrix<double> A(mA);
+    grb::CsrMatrix<double> B(mB);
+
+    grb::Matrix<double> ans(3, 3);
+    grb::mxm(ans, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, mB);
+
+    grb::Matrix<double> result(3, 3);
+    grb::mxm(result, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, mB);
+    BOOST_CHECK_EQUAL(result, ans);
+
+    grb::Matrix<double> result2(3, 3);
+    grb::mxm(result2, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), A, B);
+    BOOST_CHECK_EQUAL(result2, ans);
+
+    // masked, accumulated
+    grb::Matrix<bool> M(std::vector<std::vector<bool>>{{true, false, true},
+                                                       {false, true, false},
+                                                       {true, true, false}},
+                        false);
+    grb::Matrix<double> C_ans(mA.nrows(), mB.ncols());
+    grb::mxm(C_ans, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, mB);
+    grb::Matrix<double> C(C_ans);
+    grb::mxm(C_ans, M, grb::Plus<double>(),
+             grb::ArithmeticSemiring<double>(), mA, mB, grb::REPLACE);
+    grb::mxm(C, M, grb::Plus<double>(),
+             grb::ArithmeticSemiring<double>(), A, B, grb::REPLACE);
+    BOOST_CHECK_EQUAL(C, C_ans);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_csr_move_completes_queued_reads)
+{
+    grb::Matrix<double> mA(m3x4_dense, 0.);
+    grb::Vector<double> u(u4_dense, 0.);
+    grb::Vector<double> ans(3);
+    grb::mxv(ans, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, u);
+
+    grb::init(grb::NONBLOCKING);
+    {
+        grb::CsrMatrix<double> A(mA);
+        grb::Vector<double> w(3);
+
+        // the queued mxv holds A by reference: moving from A runs it first
+        grb::mxv(w, grb::NoMask(), grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<double>(), A, u);
+        grb::CsrMatrix<double> B(std::move(A));
+        BOOST_CHECK_EQUAL(A.nrows(), 0);
+        BOOST_CHECK_EQUAL(B.nvals(), mA.nvals());
+        BOOST_CHECK_EQUAL(w, ans);
+    }
+    grb::finalize();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1865,4 +1865,91 @@ BOOST_AUTO_TEST_CASE(extract_stdmat_test_scmp_accum_trans)
     }
 }
 
+//****************************************************************************
+namespace
+{
+    // Reference C = A(rows, cols) (or A'(rows, cols)) one element at a time
+    template <typename MatrixT>
+    Matrix<double> extract_elementwise(MatrixT              const &A,
+                                       IndexArrayType       const &rows,
+                                       IndexArrayType       const &cols,
+                                       bool                        trans)
+    {
+        Matrix<double> C(rows.size(), cols.size());
+        for (IndexType ix = 0; ix < rows.size(); ++ix)
+        {
+            for (IndexType jx = 0; jx < cols.size(); ++jx)
+            {
+                IndexType i(trans ? cols[jx] : rows[ix]);
+                IndexType j(trans ? rows[ix] : cols[jx]);
+                if (A.hasElement(i, j))
+                {
+                    C.setElement(ix, jx, A.extractElement(i, j));
+                }
+            }
+        }
+        return C;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(extract_stdmat_test_index_list_kinds)
+{
+    // 60 x 500, dense-ish first rows and sparse rest
+    IndexType const M = 60, N = 500;
+    IndexArrayType i, j;
+    std::vector<double> v;
+    for (IndexType r = 0; r < M; ++r)
+    {
+        IndexType stride = (r < 5) ? 1 : (r % 7) + 3;
+        for (IndexType c = r % 5; c < N; c += stride)
+        {
+            i.push_back(r);
+            j.push_back(c);
+            v.push_back(double(r * N + c));
+        }
+    }
+    Matrix<double> A(M, N);
+    A.build(i, j, v);
+
+    std::vector<IndexArrayType> row_lists = {
+        {0, 1, 2, 3, 4, 5},                 // contiguous
+        {7, 8, 9, 10},                      // contiguous, offset
+        {0, 3, 3, 12, 40, 59},              // sorted, duplicates
+        {59, 2, 17, 2, 0},                  // unsorted, duplicates
+        {33}};
+    std::vector<IndexArrayType> col_lists = {
+        {100, 101, 102, 103, 104},          // contiguous
+        {0, 10, 200, 450, 499},             // sorted, few (binary search)
+        {499, 3, 3, 250, 0, 251},           // unsorted, duplicates
+        {}};
+
+    // a long sorted list against short rows
+    IndexArrayType long_cols;
+    for (IndexType c = 0; c < N; c += 2) long_cols.push_back(c);
+    col_lists.push_back(long_cols);
+
+    for (auto const &rows : row_lists)
+    {
+        for (auto const &cols : col_lists)
+        {
+            Matrix<double> C(rows.size(), cols.size());
+            extract(C, NoMask(), NoAccumulate(), A, rows, cols);
+            BOOST_CHECK_EQUAL(C, extract_elementwise(A, rows, cols, false));
+
+            // transposed: rows index columns of A (all lists are < M)
+            Matrix<double> CT(cols.size(), rows.size());
+            extract(CT, NoMask(), NoAccumulate(), transpose(A), cols, rows);
+            BOOST_CHECK_EQUAL(CT, extract_elementwise(A, cols, rows, true));
+        }
+    }
+
+    // AllIndices against a subset of rows
+    Matrix<double> C(2, N);
+    extract(C, NoMask(), NoAccumulate(), A, IndexArrayType({4, 6}), AllIndices());
+    IndexArrayType all_cols;
+    for (IndexType c = 0; c < N; ++c) all_cols.push_back(c);
+    BOOST_CHECK_EQUAL(C, extract_elementwise(A, {4, 6}, all_cols, false));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -164,6 +164,30 @@ BOOST_AUTO_TEST_CASE(extract_stdvec_test_index_out_of_bounds)
                      indices)),
             IndexOutOfBoundsException);
     }
+
+    // =======
+    // Long index list into a sparsely stored vector, one bad index at the end
+    {
+        Vector<double> u(10000);
+        u.setElement(3, 1.);
+        u.setElement(5000, 2.);
+
+        IndexArrayType long_indices(1000);
+        for (IndexType ix = 0; ix < long_indices.size(); ++ix)
+        {
+            long_indices[ix] = 10*ix;
+        }
+        Vector<double> w(long_indices.size());
+        BOOST_CHECK_NO_THROW(
+            extract(w, NoMask(), NoAccumulate(), u, long_indices));
+        BOOST_CHECK_EQUAL(w.nvals(), 1);
+        BOOST_CHECK_EQUAL(w.extractElement(500), 2.);
+
+        long_indices.back() = 10000;
+        BOOST_CHECK_THROW(
+            extract(w, NoMask(), NoAccumulate(), u, long_indices),
+            IndexOutOfBoundsException);
+    }
 }
 
 //****************************************************************************
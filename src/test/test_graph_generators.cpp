@@ -0,0 +1,124 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+
+#include <iostream>
+#include <set>
+
+#include <graphblas/graphblas.hpp>
+#include <benchmarks/graph_generators.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE graph_generators_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+namespace
+{
+    bool is_symmetric_without_loops(IndexArrayType const &rows,
+                                    IndexArrayType const &cols)
+    {
+        std::set<std::pair<IndexType, IndexType>> edges;
+        for (IndexType idx = 0; idx < rows.size(); ++idx)
+        {
+            if (rows[idx] == cols[idx]) return false;
+            edges.emplace(rows[idx], cols[idx]);
+        }
+        for (auto [i, j] : edges)
+        {
+            if (edges.count({j, i}) == 0) return false;
+        }
+        return true;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_rmat_edges)
+{
+    IndexArrayType rows, cols, rows2, cols2;
+    IndexType n(benchmarks::rmat_edges(8, 4, rows, cols, 42));
+    benchmarks::rmat_edges(8, 4, rows2, cols2, 42);
+
+    BOOST_CHECK_EQUAL(n, 256);
+    BOOST_CHECK(rows == rows2);
+    BOOST_CHECK(cols == cols2);
+    BOOST_CHECK(rows.size() <= 2*4*256);
+    BOOST_CHECK(is_symmetric_without_loops(rows, cols));
+    for (auto i : rows) BOOST_CHECK(i < n);
+
+    auto A(benchmarks::build_graph<double>(n, rows, cols));
+    BOOST_CHECK_EQUAL(A.nrows(), n);
+    BOOST_CHECK(A.nvals() <= rows.size());
+
+    BOOST_CHECK_THROW(benchmarks::rmat_edges(4, 1, rows, cols, 0,
+                                             0.6, 0.3, 0.3),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_erdos_renyi_edges)
+{
+    IndexArrayType rows, cols;
+    IndexType n(benchmarks::erdos_renyi_edges(100, 6.0, rows, cols, 1));
+
+    BOOST_CHECK_EQUAL(n, 100);
+    BOOST_CHECK_EQUAL(rows.size(), 600);
+    BOOST_CHECK(is_symmetric_without_loops(rows, cols));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_grid_edges)
+{
+    IndexArrayType rows, cols;
+    IndexType n(benchmarks::grid_edges(4, 3, rows, cols));
+
+    BOOST_CHECK_EQUAL(n, 12);
+    // 3*3 horizontal + 4*2 vertical edges, both directions
+    BOOST_CHECK_EQUAL(rows.size(), 2*(9 + 8));
+    BOOST_CHECK(is_symmetric_without_loops(rows, cols));
+
+    auto A(benchmarks::build_graph<int>(n, rows, cols));
+    Vector<int> degree(n);
+    reduce(degree, NoMask(), NoAccumulate(), Plus<int>(), A);
+    BOOST_CHECK_EQUAL(degree.extractElement(0), 2);   // corner
+    BOOST_CHECK_EQUAL(degree.extractElement(1), 3);   // edge
+    BOOST_CHECK_EQUAL(degree.extractElement(5), 4);   // interior
+}
+
+BOOST_AUTO_TEST_SUITE_END()
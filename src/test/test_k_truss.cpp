@@ -380,4 +380,72 @@ BOOST_AUTO_TEST_CASE(k_truss2_test_peer_pressure2)
     BOOST_CHECK_EQUAL(0, Aout4.nvals());
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(k_truss_incremental_test2)
+{
+    grb::IndexArrayType i = {
+        0, 0, 0, 0,   1, 1, 1,   2, 2, 2,   3, 3, 3, 3,   4, 4, 4, 4,
+        5, 5,   6, 6, 6,   7, 7, 7, 7,   8, 8, 8, 8,   9, 9, 9,
+        10,10,10,10,   11,11};
+    grb::IndexArrayType j = {
+        1, 5, 6, 9,   0, 2, 4,   1, 3, 4,   2, 7, 8, 10,  1, 2, 6, 7,
+        0, 9,   0, 4, 9,   3, 4, 8, 10,  3, 7, 10, 11,  0, 5, 6,
+        3, 7, 8, 11,   8, 10};
+
+    Matrix<int> A(12, 12);
+    A.build(i, j, std::vector<int>(i.size(), 1));
+
+    // same answers as k_truss2, with or without peeling in stages
+    auto A3out = algorithms::k_truss_incremental(A, 3);
+    BOOST_CHECK_EQUAL(A3out.nvals(), 32);
+    BOOST_CHECK_EQUAL(A3out, algorithms::k_truss2(A, 3));
+
+    auto A4out = algorithms::k_truss_incremental(A3out, 4);
+    BOOST_CHECK_EQUAL(A4out.nvals(), 12);
+    BOOST_CHECK_EQUAL(algorithms::k_truss_incremental(A, 4), A4out);
+
+    BOOST_CHECK_EQUAL(algorithms::k_truss_incremental(A, 5).nvals(), 0);
+
+    // every edge is in the 2-truss
+    BOOST_CHECK_EQUAL(algorithms::k_truss_incremental(A, 2), A);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(truss_decomposition_test2)
+{
+    grb::IndexArrayType i = {
+        0, 0, 0, 0,   1, 1, 1,   2, 2, 2,   3, 3, 3, 3,   4, 4, 4, 4,
+        5, 5,   6, 6, 6,   7, 7, 7, 7,   8, 8, 8, 8,   9, 9, 9,
+        10,10,10,10,   11,11};
+    grb::IndexArrayType j = {
+        1, 5, 6, 9,   0, 2, 4,   1, 3, 4,   2, 7, 8, 10,  1, 2, 6, 7,
+        0, 9,   0, 4, 9,   3, 4, 8, 10,  3, 7, 10, 11,  0, 5, 6,
+        3, 7, 8, 11,   8, 10};
+
+    Matrix<int> A(12, 12);
+    A.build(i, j, std::vector<int>(i.size(), 1));
+
+    auto T = algorithms::truss_decomposition(A);
+    BOOST_CHECK_EQUAL(T.nvals(), A.nvals());
+
+    // the k-truss is exactly the edges with truss number >= k
+    for (IndexType k = 3; k <= 5; ++k)
+    {
+        Matrix<bool> Tk(12, 12);
+        grb::select(Tk, NoMask(), NoAccumulate(),
+                    grb::ValueGreaterEqual<IndexType>(), T, k);
+        auto Ak = algorithms::k_truss2(A, k);
+        BOOST_CHECK_EQUAL(Tk.nvals(), Ak.nvals());
+
+        Matrix<int> Ak_masked(12, 12);
+        grb::apply(Ak_masked, Tk, NoAccumulate(), Identity<int>(), A, REPLACE);
+        BOOST_CHECK_EQUAL(Ak_masked, Ak);
+    }
+
+    // {3,7,8,10} is a 4-clique: truss number 4; 0-1 closes no triangle
+    BOOST_CHECK_EQUAL(T.extractElement(3, 7), 4);
+    BOOST_CHECK_EQUAL(T.extractElement(10, 8), 4);
+    BOOST_CHECK_EQUAL(T.extractElement(0, 1), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -107,4 +107,52 @@ BOOST_AUTO_TEST_CASE(matrix_build_test_iterators)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_build_test_unsorted_duplicates)
+{
+    // duplicates are combined with dup in input order
+    IndexArrayType i = {2, 1, 0, 1, 2, 1, 0, 1};
+    IndexArrayType j = {1, 2, 3, 0, 0, 2, 1, 2};
+    std::vector<double> v = {9, 10, 3, 4, 8, 3, 1, 2};
+
+    std::vector<std::vector<double> > mat = {{0, 1, 0, 3},
+                                             {4, 0, 5, 0},
+                                             {8, 9, 0, 0}};
+
+    Matrix<double, DirectedMatrixTag> m1(3, 4);
+    m1.build(i, j, v, grb::Minus<double>());
+
+    Matrix<double, DirectedMatrixTag> answer(mat, 0.);
+    BOOST_CHECK_EQUAL(m1.nvals(), 6);
+    BOOST_CHECK_EQUAL(m1, answer);
+
+    // building into a non-empty matrix combines with the stored values
+    IndexArrayType i2 = {1, 0, 2};
+    IndexArrayType j2 = {2, 0, 1};
+    std::vector<double> v2 = {1, 7, 4};
+    m1.build(i2, j2, v2, grb::Minus<double>());
+
+    std::vector<std::vector<double> > mat2 = {{7, 1, 0, 3},
+                                              {4, 0, 4, 0},
+                                              {8, 5, 0, 0}};
+    Matrix<double, DirectedMatrixTag> answer2(mat2, 0.);
+    BOOST_CHECK_EQUAL(m1.nvals(), 7);
+    BOOST_CHECK_EQUAL(m1, answer2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_build_test_index_out_of_bounds)
+{
+    IndexArrayType i = {0, 3};
+    IndexArrayType j = {1, 0};
+    std::vector<double> v = {1, 2};
+
+    Matrix<double, DirectedMatrixTag> m1(3, 4);
+    BOOST_CHECK_THROW(m1.build(i, j, v), IndexOutOfBoundsException);
+
+    IndexArrayType i2 = {0, 2};
+    IndexArrayType j2 = {1, 4};
+    BOOST_CHECK_THROW(m1.build(i2, j2, v), IndexOutOfBoundsException);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,274 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE matrix_io_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    std::string write_temp(std::string const &name, std::string const &text)
+    {
+        std::string path((std::filesystem::temp_directory_path() /
+                          ("gbtl_" + name)).string());
+        std::ofstream ofs(path, std::ios::trunc);
+        ofs << text;
+        return path;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(read_edge_list_basic)
+{
+    std::string path(write_temp("edges.tsv",
+                                "# comment line\n"
+                                "0\t1\n"
+                                "1 2 2.5\n"
+                                "\n"
+                                "3 3\n"
+                                "2\t0\t-4"));   // no trailing newline
+
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    IndexType n(read_edge_list(path, rows, cols, vals));
+    BOOST_CHECK_EQUAL(n, 4);
+    BOOST_CHECK(rows == (IndexArrayType{0, 1, 3, 2}));
+    BOOST_CHECK(cols == (IndexArrayType{1, 2, 3, 0}));
+    BOOST_CHECK(vals == (std::vector<double>{1, 2.5, 1, -4}));
+
+    auto A(read_edge_list<Matrix<double>>(path));
+    Matrix<double> answer(4, 4);
+    answer.build(IndexArrayType{0, 1, 3, 2}, IndexArrayType{1, 2, 3, 0},
+                 std::vector<double>{1, 2.5, 1, -4});
+    BOOST_CHECK_EQUAL(A, answer);
+
+    std::remove(path.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(read_edge_list_options)
+{
+    std::string path(write_temp("edges1.tsv",
+                                "1 2\n"
+                                "2 3\n"
+                                "3 3\n"
+                                "1 2\n"));
+
+    ReadOptions options;
+    options.index_base = 1;
+    options.remove_self_loops = true;
+    options.symmetrize = true;
+
+    auto A(read_edge_list<Matrix<int>>(path, options, Plus<int>()));
+    std::vector<std::vector<int>> ans = {{0, 2, 0},
+                                         {2, 0, 1},
+                                         {0, 1, 0}};
+    BOOST_CHECK_EQUAL(A, Matrix<int>(ans, 0));
+
+    // index 0 is invalid in a 1-based file
+    std::string bad(write_temp("edges_bad.tsv", "0 1\n"));
+    BOOST_CHECK_THROW(read_edge_list<Matrix<int>>(bad, options),
+                      InvalidValueException);
+    std::string bad2(write_temp("edges_bad2.tsv", "1 x\n"));
+    BOOST_CHECK_THROW(read_edge_list<Matrix<int>>(bad2),
+                      InvalidValueException);
+
+    std::remove(path.c_str());
+    std::remove(bad.c_str());
+    std::remove(bad2.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(read_edge_list_strict_numbers)
+{
+    // indices must be unsigned integers followed by a blank or end of line
+    for (std::string text : {"-1 2\n", "1.5 2\n", "1 2.0\n", "1x 2\n",
+                             "1 2x\n", "1 2 3.5y\n"})
+    {
+        std::string bad(write_temp("edges_strict.tsv", text));
+        BOOST_CHECK_THROW(read_edge_list<Matrix<double>>(bad),
+                          InvalidValueException);
+        std::remove(bad.c_str());
+    }
+
+    // integer values may be written as floating point when in range
+    std::string path(write_temp("edges_int_vals.tsv",
+                                "0 1 3.0\n"
+                                "+1 0, 2\r\n"));
+    auto A(read_edge_list<Matrix<int>>(path));
+    std::vector<std::vector<int>> ans = {{0, 3},
+                                         {2, 0}};
+    BOOST_CHECK_EQUAL(A, Matrix<int>(ans, 0));
+    std::remove(path.c_str());
+
+    std::string neg(write_temp("edges_neg_val.tsv", "0 1 -1.0\n"));
+    BOOST_CHECK_THROW(read_edge_list<Matrix<unsigned int>>(neg),
+                      InvalidValueException);
+    std::remove(neg.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(read_edge_list_many_chunks)
+{
+    // same result regardless of how the file is split
+    std::string text;
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    for (IndexType ix = 0; ix < 5000; ++ix)
+    {
+        IndexType i((ix*37) % 301), j((ix*101) % 293);
+        text += std::to_string(i) + " " + std::to_string(j) + " " +
+            std::to_string(ix % 7) + "\n";
+        rows.push_back(i);
+        cols.push_back(j);
+        vals.push_back(static_cast<double>(ix % 7));
+    }
+    std::string path(write_temp("edges_big.tsv", text));
+
+    Matrix<double> answer(301, 301);
+    answer.build(rows, cols, vals, Plus<double>());
+
+    for (size_t chunk_bytes : {1UL, 17UL, 1000UL, (1UL << 20)})
+    {
+        ReadOptions options;
+        options.chunk_bytes = chunk_bytes;
+        auto A(read_edge_list<Matrix<double>>(path, options, Plus<double>()));
+        BOOST_CHECK_EQUAL(A, answer);
+    }
+
+    std::remove(path.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(read_matrix_market_general)
+{
+    std::string path(write_temp("general.mtx",
+                                "%%MatrixMarket matrix coordinate real general\n"
+                                "% a comment\n"
+                                "%\n"
+                                "3 4 4\n"
+                                "1 1 1.5\n"
+                                "2 4 -2e1\n"
+                                "3 2 3\n"
+                                "1 3 .25\n"));
+
+    auto A(read_matrix_market<Matrix<double>>(path));
+    std::vector<std::vector<double>> ans = {{1.5, 0, 0.25,   0},
+                                            {  0, 0,    0, -20},
+                                            {  0, 3,    0,   0}};
+    BOOST_CHECK_EQUAL(A, Matrix<double>(ans, 0.));
+
+    std::string oob(write_temp("oob.mtx",
+                               "%%MatrixMarket matrix coordinate real general\n"
+                               "2 2 1\n"
+                               "3 1 1.0\n"));
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double>>(oob),
+                      IndexOutOfBoundsException);
+
+    std::string arr(write_temp("array.mtx",
+                               "%%MatrixMarket matrix array real general\n"
+                               "1 1\n"
+                               "1.0\n"));
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double>>(arr),
+                      InvalidValueException);
+
+    // more entries than the matrix has elements
+    std::string big(write_temp("big_nnz.mtx",
+                               "%%MatrixMarket matrix coordinate real general\n"
+                               "2 2 5\n"
+                               "1 1 1.0\n"));
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double>>(big),
+                      InvalidValueException);
+
+    // a bool value that is not a number
+    std::string bad_bool(write_temp("bad_bool.mtx",
+                                    "%%MatrixMarket matrix coordinate real general\n"
+                                    "2 2 1\n"
+                                    "1 1 x\n"));
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<bool>>(bad_bool),
+                      InvalidValueException);
+
+    std::remove(path.c_str());
+    std::remove(oob.c_str());
+    std::remove(arr.c_str());
+    std::remove(big.c_str());
+    std::remove(bad_bool.c_str());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(read_matrix_market_symmetric)
+{
+    std::string path(write_temp("pattern.mtx",
+                                "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                                "3 3 3\n"
+                                "2 1\n"
+                                "3 2\n"
+                                "3 3\n"));
+
+    auto A(read_matrix_market<Matrix<bool>>(path));
+    std::vector<std::vector<bool>> ans = {{false, true, false},
+                                          {true, false, true},
+                                          {false, true, true}};
+    BOOST_CHECK_EQUAL(A, Matrix<bool>(ans, false));
+
+    ReadOptions options;
+    options.remove_self_loops = true;
+    auto B(read_matrix_market<Matrix<bool>>(path, options));
+    BOOST_CHECK_EQUAL(B.nvals(), 4);
+
+    std::string skew(write_temp("skew.mtx",
+                                "%%MatrixMarket matrix coordinate integer skew-symmetric\n"
+                                "2 2 1\n"
+                                "2 1 5\n"));
+    auto S(read_matrix_market<Matrix<int>>(skew));
+    std::vector<std::vector<int>> sans = {{0, -5}, {5, 0}};
+    BOOST_CHECK_EQUAL(S, Matrix<int>(sans, 0));
+
+    std::remove(path.c_str());
+    std::remove(skew.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
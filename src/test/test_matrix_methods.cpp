@@ -138,4 +138,75 @@ BOOST_AUTO_TEST_CASE(matrix_removeElement_test)
     BOOST_CHECK(!m1.hasElement(1, 2));
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_move_and_swap_test)
+{
+    std::vector<std::vector<double>> mat = {{0, 1, 2},
+                                            {4, 0, 6},
+                                            {8, 9, 0}};
+    Matrix<double> m1(mat, 0.);
+    Matrix<double> answer(m1);
+
+    static_assert(std::is_nothrow_move_constructible_v<Matrix<double>>);
+    static_assert(std::is_nothrow_move_assignable_v<Matrix<double>>);
+
+    Matrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, answer);
+
+    // move assignment takes the dimensions of the source
+    Matrix<double> m3(2, 5);
+    m3.setElement(1, 4, 3.);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3.nrows(), 3);
+    BOOST_CHECK_EQUAL(m3.ncols(), 3);
+    BOOST_CHECK_EQUAL(m3, answer);
+
+    Matrix<double> m4(4, 2);
+    m4.setElement(3, 1, 5.);
+    swap(m3, m4);
+    BOOST_CHECK_EQUAL(m4, answer);
+    BOOST_CHECK_EQUAL(m3.nrows(), 4);
+    BOOST_CHECK_EQUAL(m3.ncols(), 2);
+    BOOST_CHECK_EQUAL(m3.nvals(), 1);
+    BOOST_CHECK_EQUAL(m3.extractElement(3, 1), 5.);
+
+    m3.swap(m4);
+    BOOST_CHECK_EQUAL(m3, answer);
+    BOOST_CHECK_EQUAL(m4.nvals(), 1);
+}
+
+//****************************************************************************
+// Copy assignment checks dimensions, move assignment replaces them
+BOOST_AUTO_TEST_CASE(matrix_copy_vs_move_assignment_dimensions)
+{
+    std::vector<std::vector<double>> mat = {{0, 1, 2},
+                                            {4, 0, 6},
+                                            {8, 9, 0}};
+    Matrix<double> const answer(mat, 0.);
+
+    Matrix<double> m1(2, 5);
+    m1.setElement(1, 4, 3.);
+    Matrix<double> const m1_orig(m1);
+
+    // copy: mismatched dimensions throw and leave the target untouched
+    BOOST_CHECK_THROW(m1 = answer, DimensionException);
+    BOOST_CHECK_EQUAL(m1, m1_orig);
+
+    // move: the target takes the source's dimensions, the source the
+    // target's old contents
+    Matrix<double> m2(answer);
+    m1 = std::move(m2);
+    BOOST_CHECK_EQUAL(m1, answer);
+    BOOST_CHECK_EQUAL(m2, m1_orig);
+
+    // a moved-from matrix is 0x0: it accepts move assignment, but copy
+    // assignment of a non-empty matrix is a dimension mismatch
+    Matrix<double> m3(std::move(m1));
+    BOOST_CHECK_EQUAL(m1.nrows(), 0);
+    BOOST_CHECK_EQUAL(m1.ncols(), 0);
+    BOOST_CHECK_THROW(m1 = answer, DimensionException);
+    m1 = std::move(m3);
+    BOOST_CHECK_EQUAL(m1, answer);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -140,4 +140,123 @@ BOOST_AUTO_TEST_CASE(mst_test_with_weights)
     grb::print_vector(std::cout, parents, "MST parent list");
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_with_weights)
+{
+    IndexType const NUM_NODES = 9;
+    IndexArrayType i_m1 = {0, 0, 1, 1, 1, 2, 2, 2, 2,
+                           3, 3, 3, 4, 4, 5, 5, 5, 5,
+                           6, 6, 6, 7, 7, 7, 7, 8, 8, 8};
+    IndexArrayType j_m1 = {1, 7, 0, 2, 7, 1, 3, 5, 8,
+                           2, 4, 5, 3, 5, 2, 3, 4, 6,
+                           5, 7, 8, 0, 1, 6, 8, 2, 6, 7};
+    std::vector<double> v_m1 = {4, 8, 4, 8,11, 8, 7, 4, 2,
+                                7, 9,14, 9,10, 4,14,10, 2,
+                                2, 1, 6, 8,11, 1, 7, 2, 6, 7};
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1);
+
+    // {0,7} and {1,2} both weigh 8; ties go to the lower vertex ids so
+    // this uses {0,7} where Prim's tree (above) uses {1,2}
+    IndexArrayType i_ans = {0, 0, 1, 2, 2, 2, 3, 3, 4, 5, 5, 6, 6, 7, 7, 8};
+    IndexArrayType j_ans = {1, 7, 0, 3, 5, 8, 2, 4, 3, 2, 6, 5, 7, 0, 6, 2};
+    std::vector<double> v_ans = {4, 8, 4, 7, 4, 2, 7, 9, 9, 4, 2, 2, 1, 8, 1, 2};
+    Matrix<double> answer(NUM_NODES, NUM_NODES);
+    answer.build(i_ans, j_ans, v_ans);
+
+    Matrix<double> forest(NUM_NODES, NUM_NODES);
+    auto result = msf(m1, forest);
+
+    BOOST_CHECK_EQUAL(result, 37);
+    BOOST_CHECK_EQUAL(forest, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_equal_weights)
+{
+    // every edge has the same weight: the tie breaking must still produce
+    // a tree (N-1 edges)
+    IndexType const NUM_NODES = 6;
+    IndexArrayType i_m1 = {0, 0, 0, 1, 1, 1, 2, 2, 3, 3, 3,
+                           4, 4, 4, 4, 4, 5, 5};
+    IndexArrayType j_m1 = {1, 3, 4, 0, 3, 4, 4, 5, 0, 1, 4,
+                           0, 1, 2, 3, 5, 2, 4};
+    std::vector<double> v_m1(i_m1.size(), 1);
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1);
+
+    Matrix<double> forest(NUM_NODES, NUM_NODES);
+    auto result = msf(m1, forest);
+
+    BOOST_CHECK_EQUAL(result, NUM_NODES - 1.0);
+    BOOST_CHECK_EQUAL(forest.nvals(), 2*(NUM_NODES - 1));
+
+    grb::Vector<IndexType> parents(NUM_NODES);
+    BOOST_CHECK_EQUAL(result, mst(m1, parents));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_disconnected)
+{
+    // triangle {0,1,2}, triangle {3,4,5} stored in one direction only,
+    // a self loop on 6 and isolated vertex 7
+    IndexType const NUM_NODES = 8;
+    IndexArrayType i_m1 = {0, 1, 1, 2, 0, 2, 3, 4, 3, 6};
+    IndexArrayType j_m1 = {1, 0, 2, 1, 2, 0, 4, 5, 5, 6};
+    std::vector<unsigned int> v_m1 = {1, 1, 2, 2, 3, 3, 6, 5, 4, 1};
+    Matrix<unsigned int> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1);
+
+    IndexArrayType i_ans = {0, 1, 1, 2, 3, 5, 4, 5};
+    IndexArrayType j_ans = {1, 0, 2, 1, 5, 3, 5, 4};
+    std::vector<unsigned int> v_ans = {1, 1, 2, 2, 4, 4, 5, 5};
+    Matrix<unsigned int> answer(NUM_NODES, NUM_NODES);
+    answer.build(i_ans, j_ans, v_ans);
+
+    Matrix<unsigned int> forest(NUM_NODES, NUM_NODES);
+    auto result = msf(m1, forest);
+
+    BOOST_CHECK_EQUAL(result, 12);
+    BOOST_CHECK_EQUAL(forest, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_matches_prim)
+{
+    // ring (to keep it connected) plus pseudo-random chords
+    IndexType const NUM_NODES = 500;
+    IndexArrayType i_m1, j_m1;
+    std::vector<double> v_m1;
+    uint64_t seed = 12345;
+    auto next([&seed]() {
+                  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                  return seed >> 33; });
+    auto add_edge([&](IndexType u, IndexType v, double w) {
+                      i_m1.push_back(u); j_m1.push_back(v); v_m1.push_back(w);
+                      i_m1.push_back(v); j_m1.push_back(u); v_m1.push_back(w);
+                  });
+
+    for (IndexType u = 0; u < NUM_NODES; ++u)
+    {
+        add_edge(u, (u + 1) % NUM_NODES, 1 + next() % 100);
+    }
+    for (IndexType ix = 0; ix < 4*NUM_NODES; ++ix)
+    {
+        IndexType u = next() % NUM_NODES, v = next() % NUM_NODES;
+        if (u != v) add_edge(u, v, 1 + next() % 100);
+    }
+
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1, grb::Min<double>());
+
+    grb::Vector<IndexType> parents(NUM_NODES);
+    auto prim_weight = mst(m1, parents);
+
+    Matrix<double> forest(NUM_NODES, NUM_NODES);
+    auto result = msf(m1, forest);
+
+    BOOST_CHECK_EQUAL(result, prim_weight);
+    BOOST_CHECK_EQUAL(forest.nvals(), 2*(NUM_NODES - 1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2263,4 +2263,171 @@ BOOST_AUTO_TEST_CASE(test_mxm_CompMask_Accum_ATBT_Merge)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// Skewed (hub) rows exercise the row accumulators used by the axpy-based
+// kernels; compare against the dot-product (ABT) formulation.
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_skewed_rows_AB_ATB_vs_ABT)
+{
+    grb::IndexType const N = 200;
+    grb::IndexArrayType rows, cols;
+    std::vector<double> vals;
+    for (grb::IndexType i = 0; i < N; ++i)
+    {
+        // rows 0 and 1 are hubs, other rows have a few entries
+        grb::IndexType degree = (i < 2) ? N : (i % 5);
+        for (grb::IndexType k = 0; k < degree; ++k)
+        {
+            rows.push_back(i);
+            cols.push_back((i*31 + k*7) % N);
+            vals.push_back(static_cast<double>((i + k) % 3 + 1));
+        }
+    }
+    grb::Matrix<double> mA(N, N);
+    mA.build(rows, cols, vals, grb::Plus<double>());
+
+    grb::Matrix<double> mAT(N, N);
+    grb::transpose(mAT, grb::NoMask(), grb::NoAccumulate(), mA);
+
+    grb::Matrix<double> mMask(N, N);
+    grb::mxm(mMask, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mAT, mAT);
+
+    grb::Matrix<double> answer(N, N), result(N, N);
+
+    // unmasked
+    grb::mxm(answer, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, grb::transpose(mA));
+    grb::mxm(result, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, mAT);
+    BOOST_CHECK_EQUAL(result, answer);
+    grb::mxm(result, grb::NoMask(), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), grb::transpose(mAT), mAT);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // masked
+    grb::mxm(answer, mMask, grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, grb::transpose(mA),
+             grb::REPLACE);
+    grb::mxm(result, mMask, grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, mAT, grb::REPLACE);
+    BOOST_CHECK_EQUAL(result, answer);
+    grb::mxm(result, mMask, grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), grb::transpose(mAT), mAT,
+             grb::REPLACE);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // complemented mask
+    grb::mxm(answer, grb::complement(mMask), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, grb::transpose(mA),
+             grb::REPLACE);
+    grb::mxm(result, grb::complement(mMask), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), mA, mAT, grb::REPLACE);
+    BOOST_CHECK_EQUAL(result, answer);
+    grb::mxm(result, grb::complement(mMask), grb::NoAccumulate(),
+             grb::ArithmeticSemiring<double>(), grb::transpose(mAT), mAT,
+             grb::REPLACE);
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+// Rectangular operands with a complemented mask (including stored falses):
+// all four transpose variants must agree.
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_complement_mask_all_transpose_variants)
+{
+    grb::IndexType const M = 40, K = 30, N = 50;
+    grb::IndexArrayType ar, ac, br, bc, mr, mc;
+    std::vector<double> av, bv;
+    std::vector<bool> mv;
+    for (grb::IndexType i = 0; i < M; ++i)
+        for (grb::IndexType k = 0; k < K; ++k)
+            if ((i*7 + k*3) % 5 == 0)
+            {
+                ar.push_back(i); ac.push_back(k);
+                av.push_back(static_cast<double>((i + 2*k) % 4 + 1));
+            }
+    for (grb::IndexType k = 0; k < K; ++k)
+        for (grb::IndexType j = 0; j < N; ++j)
+            if ((k*5 + j) % 4 == 0)
+            {
+                br.push_back(k); bc.push_back(j);
+                bv.push_back(static_cast<double>((k + j) % 3 + 1));
+            }
+    for (grb::IndexType i = 0; i < M; ++i)
+        for (grb::IndexType j = 0; j < N; ++j)
+            if ((i + j) % 3 == 0)
+            {
+                mr.push_back(i); mc.push_back(j);
+                mv.push_back((i % 2) == 0);  // stored falses included
+            }
+
+    grb::Matrix<double> mA(M, K), mB(K, N);
+    grb::Matrix<bool>   mMask(M, N);
+    mA.build(ar, ac, av);
+    mB.build(br, bc, bv);
+    mMask.build(mr, mc, mv);
+
+    grb::Matrix<double> mAT(K, M), mBT(N, K);
+    grb::transpose(mAT, grb::NoMask(), grb::NoAccumulate(), mA);
+    grb::transpose(mBT, grb::NoMask(), grb::NoAccumulate(), mB);
+
+    grb::Matrix<double> C0(M, N);
+    for (grb::IndexType i = 0; i < M; ++i)
+        C0.setElement(i, (i*3) % N, 100.0);
+
+    for (auto outp : {grb::REPLACE, grb::MERGE})
+    {
+        // value mask, no accumulate
+        grb::Matrix<double> answer(C0), result(C0);
+        grb::mxm(answer, grb::complement(mMask), grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<double>(), mA, mB, outp);
+
+        result = C0;
+        grb::mxm(result, grb::complement(mMask), grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<double>(),
+                 grb::transpose(mAT), mB, outp);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        result = C0;
+        grb::mxm(result, grb::complement(mMask), grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<double>(),
+                 mA, grb::transpose(mBT), outp);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        result = C0;
+        grb::mxm(result, grb::complement(mMask), grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<double>(),
+                 grb::transpose(mAT), grb::transpose(mBT), outp);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        // structural mask, accumulate
+        answer = C0;
+        grb::mxm(answer, grb::complement(grb::structure(mMask)),
+                 grb::Plus<double>(),
+                 grb::ArithmeticSemiring<double>(), mA, mB, outp);
+
+        result = C0;
+        grb::mxm(result, grb::complement(grb::structure(mMask)),
+                 grb::Plus<double>(),
+                 grb::ArithmeticSemiring<double>(),
+                 grb::transpose(mAT), mB, outp);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        result = C0;
+        grb::mxm(result, grb::complement(grb::structure(mMask)),
+                 grb::Plus<double>(),
+                 grb::ArithmeticSemiring<double>(),
+                 mA, grb::transpose(mBT), outp);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        result = C0;
+        grb::mxm(result, grb::complement(grb::structure(mMask)),
+                 grb::Plus<double>(),
+                 grb::ArithmeticSemiring<double>(),
+                 grb::transpose(mAT), grb::transpose(mBT), outp);
+        BOOST_CHECK_EQUAL(result, answer);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -779,4 +779,37 @@ BOOST_AUTO_TEST_CASE(mxv_reg)
 }
 
 
+//****************************************************************************
+namespace
+{
+    // Counts the products formed, to observe early exit on the terminal
+    struct CountingLogicalSemiring : public grb::LogicalSemiring<bool>
+    {
+        static inline size_t mult_calls = 0;
+
+        bool mult(bool a, bool b) const
+        {
+            ++mult_calls;
+            return a && b;
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(mxv_logical_semiring_stops_at_terminal)
+{
+    grb::IndexType const N(50);
+    grb::Matrix<bool> A(std::vector<std::vector<bool>>(
+                            4, std::vector<bool>(N, true)));
+    grb::Vector<bool> u(std::vector<bool>(N, true));
+    grb::Vector<bool> w(4);
+
+    CountingLogicalSemiring::mult_calls = 0;
+    grb::mxv(w, grb::NoMask(), grb::NoAccumulate(),
+             CountingLogicalSemiring(), A, u);
+
+    BOOST_CHECK_EQUAL(w, grb::Vector<bool>(std::vector<bool>(4, true)));
+    // one product per row: the first one reaches the terminal (true)
+    BOOST_CHECK_EQUAL(CountingLogicalSemiring::mult_calls, 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,399 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+#include <algorithms/bfs.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE nonblocking_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    /// Run a test case in nonblocking mode with fresh statistics
+    struct NonblockingScope
+    {
+        NonblockingScope()
+        {
+            init(NONBLOCKING);
+            detail::execution_context().reset_stats();
+        }
+        ~NonblockingScope() { finalize(); }
+
+        detail::ExecutionStats const &stats() const
+        {
+            return detail::execution_context().stats();
+        }
+    };
+
+    /// Unary op that fails when it is applied
+    struct ThrowingOp
+    {
+        int operator()(int) const { throw PanicException("ThrowingOp"); }
+    };
+
+    // Example graph from the bfs tests
+    IndexArrayType i_m1 = {0, 0, 0, 1, 1, 1, 2, 2, 3, 3, 3, 4, 5, 5, 6, 6, 7, 8};
+    IndexArrayType j_m1 = {3, 4, 6, 6, 7, 8, 3, 4, 0, 2, 7, 0, 7, 8, 0, 1, 3, 1};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_default_mode_is_blocking)
+{
+    BOOST_CHECK_EQUAL(getExecutionMode(), BLOCKING);
+
+    detail::execution_context().reset_stats();
+    Vector<int> u(std::vector<int>{1, 2, 3});
+    Vector<int> w(3);
+    apply(w, NoMask(), NoAccumulate(), AdditiveInverse<int>(), u);
+    BOOST_CHECK_EQUAL(detail::execution_context().stats().deferred, 0);
+    BOOST_CHECK_EQUAL(w, Vector<int>(std::vector<int>{-1, -2, -3}));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_defers_until_observed)
+{
+    NonblockingScope scope;
+    BOOST_CHECK_EQUAL(getExecutionMode(), NONBLOCKING);
+
+    Vector<int> u(std::vector<int>{1, 0, 3, 0}, 0);
+    Vector<int> v(std::vector<int>{0, 2, 5, 0}, 0);
+    Vector<int> w(4);
+
+    eWiseAdd(w, NoMask(), NoAccumulate(), Plus<int>(), u, v);
+    BOOST_CHECK_EQUAL(scope.stats().deferred, 1);
+    BOOST_CHECK_EQUAL(scope.stats().executed, 0);
+
+    // size does not wait
+    BOOST_CHECK_EQUAL(w.size(), 4);
+    BOOST_CHECK_EQUAL(scope.stats().executed, 0);
+
+    BOOST_CHECK_EQUAL(w.nvals(), 3);
+    BOOST_CHECK_EQUAL(scope.stats().executed, 1);
+    BOOST_CHECK_EQUAL(w.extractElement(2), 8);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_observation_runs_only_dependencies)
+{
+    NonblockingScope scope;
+
+    Matrix<double> A(std::vector<std::vector<double>>{{1, 2}, {0, 3}}, 0.);
+    Matrix<double> B(2, 2), C(2, 2);
+    Vector<double> u(std::vector<double>{1, 1}), w(2);
+
+    mxm(B, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    mxv(w, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    transpose(C, NoMask(), NoAccumulate(), B);
+
+    // C needs B (mxm) and the transpose, but not the mxv
+    BOOST_CHECK_EQUAL(C.extractElement(1, 0), 8.);
+    BOOST_CHECK_EQUAL(scope.stats().executed, 2);
+
+    wait();
+    BOOST_CHECK_EQUAL(scope.stats().executed, 3);
+    BOOST_CHECK_EQUAL(w, Vector<double>(std::vector<double>{3, 3}));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_respects_write_after_read)
+{
+    NonblockingScope scope;
+
+    Vector<int> x(std::vector<int>{1, 2, 3});
+    Vector<int> y(3), z(3);
+
+    apply(y, NoMask(), NoAccumulate(), AdditiveInverse<int>(), x);  // reads x
+    apply(x, NoMask(), NoAccumulate(), Identity<int>(), z);         // clears x
+    BOOST_CHECK_EQUAL(y, Vector<int>(std::vector<int>{-1, -2, -3}));
+    BOOST_CHECK_EQUAL(x.nvals(), 0);
+
+    // modifying an input completes the ops reading it first
+    apply(y, NoMask(), Plus<int>(), Identity<int>(), y);
+    y.setElement(0, 100);
+    BOOST_CHECK_EQUAL(y.extractElement(0), 100);
+    BOOST_CHECK_EQUAL(y.extractElement(1), -4);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_eliminates_dead_writes)
+{
+    NonblockingScope scope;
+
+    Vector<int> u(std::vector<int>{1, 2, 3});
+    Vector<int> w(3);
+
+    apply(w, NoMask(), NoAccumulate(), AdditiveInverse<int>(), u);
+    apply(w, NoMask(), NoAccumulate(), Identity<int>(), u);
+    wait(w);
+
+    BOOST_CHECK_EQUAL(scope.stats().eliminated, 1);
+    BOOST_CHECK_EQUAL(scope.stats().executed, 1);
+    BOOST_CHECK_EQUAL(w, u);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_fuses_ewise_into_vxm)
+{
+    Matrix<unsigned int> A(9, 9);
+    A.build(i_m1, j_m1, std::vector<unsigned int>(i_m1.size(), 1));
+
+    Vector<unsigned int> ramp(9), visited(9);
+    for (IndexType ix = 0; ix < 9; ++ix) ramp.setElement(ix, ix);
+    visited.setElement(0, 1);
+    visited.setElement(3, 1);
+
+    auto step([&](Vector<unsigned int> &w)
+              {
+                  eWiseMult(w, NoMask(), NoAccumulate(),
+                            First<unsigned int>(), ramp, w);
+                  vxm(w, complement(structure(visited)), NoAccumulate(),
+                      MinFirstSemiring<unsigned int>(), w, A, REPLACE);
+              });
+
+    Vector<unsigned int> expected(9);
+    expected.setElement(0, 1);
+    expected.setElement(3, 1);
+    step(expected);
+
+    NonblockingScope scope;
+    Vector<unsigned int> w(9);
+    w.setElement(0, 1);
+    w.setElement(3, 1);
+    step(w);
+    BOOST_CHECK_EQUAL(w, expected);
+    BOOST_CHECK_EQUAL(scope.stats().fused, 1);
+    BOOST_CHECK_EQUAL(scope.stats().executed, 1);
+
+    // apply and eWiseAdd producers, accumulating consumer into another vector
+    Vector<unsigned int> a(std::vector<unsigned int>{0, 1, 0, 2, 0, 0, 0, 0, 3}, 0);
+    Vector<unsigned int> b(std::vector<unsigned int>{4, 0, 0, 1, 0, 0, 0, 0, 0}, 0);
+    Vector<unsigned int> t(9), r(9), t2(9), r2(9);
+    r.setElement(7, 5);
+    r2.setElement(7, 5);
+
+    eWiseAdd(t, NoMask(), NoAccumulate(), Plus<unsigned int>(), a, b);
+    vxm(r, NoMask(), Plus<unsigned int>(),
+        ArithmeticSemiring<unsigned int>(), t, A);
+    apply(t, NoMask(), NoAccumulate(), Identity<unsigned int>(), t2); // kills t
+    wait();
+    BOOST_CHECK_EQUAL(scope.stats().fused, 2);
+    BOOST_CHECK_EQUAL(t.nvals(), 0);
+
+    init(BLOCKING);
+    eWiseAdd(t2, NoMask(), NoAccumulate(), Plus<unsigned int>(), a, b);
+    vxm(r2, NoMask(), Plus<unsigned int>(),
+        ArithmeticSemiring<unsigned int>(), t2, A);
+    BOOST_CHECK_EQUAL(r, r2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_fuses_select_into_vxm)
+{
+    Matrix<unsigned int> A(9, 9);
+    A.build(i_m1, j_m1, std::vector<unsigned int>(i_m1.size(), 1));
+    Vector<unsigned int> u(std::vector<unsigned int>{5, 1, 0, 2, 7, 0, 0, 0, 3}, 0);
+
+    auto step([&](Vector<unsigned int> &t, Vector<unsigned int> &r)
+              {
+                  select(t, NoMask(), NoAccumulate(),
+                         ValueGreaterThan<unsigned int>(), u, 2U);
+                  vxm(r, NoMask(), NoAccumulate(),
+                      ArithmeticSemiring<unsigned int>(), t, A);
+              });
+
+    Vector<unsigned int> t1(9), expected(9);
+    step(t1, expected);
+
+    NonblockingScope scope;
+    Vector<unsigned int> t(9), r(9);
+    step(t, r);
+    apply(t, NoMask(), NoAccumulate(), Identity<unsigned int>(), u); // kills t
+    BOOST_CHECK_EQUAL(r, expected);
+    BOOST_CHECK_EQUAL(scope.stats().fused, 1);
+}
+
+//****************************************************************************
+// The fused vxm sizes its accumulator while u is streamed: from a few
+// products in a small table, through larger tables, to the dense form
+BOOST_AUTO_TEST_CASE(nonblocking_fused_vxm_grows_accumulator)
+{
+    IndexType const N = 4096;
+    IndexArrayType i, j;
+    for (IndexType row = 0; row < N; ++row)
+    {
+        for (IndexType k = 0; k < 1 + row % 5; ++k)
+        {
+            i.push_back(row);
+            j.push_back((row*31 + k*577) % N);
+        }
+    }
+    Matrix<double> A(N, N);
+    A.build(i, j, std::vector<double>(i.size(), 1.), Plus<double>());
+
+    for (IndexType stride : {1024, 64, 1})
+    {
+        Vector<double> u(N), ones(N);
+        for (IndexType ix = 0; ix < N; ix += stride)
+        {
+            u.setElement(ix, static_cast<double>(ix % 3 + 1));
+        }
+        assign(ones, NoMask(), NoAccumulate(), 1., AllIndices());
+
+        auto step([&](Vector<double> &t, Vector<double> &w)
+                  {
+                      eWiseMult(t, NoMask(), NoAccumulate(), Times<double>(),
+                                u, ones);
+                      vxm(w, NoMask(), NoAccumulate(),
+                          ArithmeticSemiring<double>(), t, A);
+                  });
+
+        Vector<double> t1(N), expected(N);
+        step(t1, expected);
+
+        NonblockingScope scope;
+        Vector<double> t(N), w(N);
+        step(t, w);
+        apply(t, NoMask(), NoAccumulate(), Identity<double>(), u); // kills t
+        BOOST_CHECK_EQUAL(w, expected);
+        BOOST_CHECK_EQUAL(scope.stats().fused, 1);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_does_not_fuse_live_intermediate)
+{
+    NonblockingScope scope;
+
+    Matrix<double> A(std::vector<std::vector<double>>{{1, 2}, {0, 3}}, 0.);
+    Vector<double> u(std::vector<double>{1, 2}), t(2), w(2);
+
+    apply(t, NoMask(), NoAccumulate(), AdditiveInverse<double>(), u);
+    vxm(w, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), t, A);
+
+    BOOST_CHECK_EQUAL(w, Vector<double>(std::vector<double>{-1, -8}));
+    BOOST_CHECK_EQUAL(t, Vector<double>(std::vector<double>{-1, -2}));
+    BOOST_CHECK_EQUAL(scope.stats().fused, 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_completes_before_destruction)
+{
+    NonblockingScope scope;
+
+    Vector<int> w(3);
+    {
+        Vector<int> u(std::vector<int>{1, 2, 3});
+        apply(w, NoMask(), NoAccumulate(), AdditiveInverse<int>(), u);
+        BOOST_CHECK_EQUAL(scope.stats().executed, 0);
+    }
+    BOOST_CHECK_EQUAL(scope.stats().executed, 1);
+    BOOST_CHECK_EQUAL(w, Vector<int>(std::vector<int>{-1, -2, -3}));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_execution_error_at_wait)
+{
+    NonblockingScope scope;
+
+    Vector<int> u(std::vector<int>{1, 2, 3});
+    Vector<int> w(3);
+
+    // errors raised by an op are reported when it executes
+    apply(w, NoMask(), NoAccumulate(), ThrowingOp(), u);
+    BOOST_CHECK_THROW(wait(), PanicException);
+
+    // the queue was dropped, later ops work
+    extract(w, NoMask(), NoAccumulate(), u, IndexArrayType{2, 0, 1});
+    BOOST_CHECK_EQUAL(w, Vector<int>(std::vector<int>{3, 1, 2}));
+
+    // errors raised while destroying an input are reported by wait()
+    {
+        Vector<int> v(std::vector<int>{1, 2, 3});
+        apply(w, NoMask(), NoAccumulate(), ThrowingOp(), v);
+    }
+    BOOST_CHECK_THROW(wait(), PanicException);
+    BOOST_CHECK_NO_THROW(wait());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_index_errors_when_queued)
+{
+    NonblockingScope scope;
+
+    Vector<int> u(std::vector<int>{1, 2, 3});
+    Vector<int> w(2);
+
+    // index arrays are checked before the op is queued...
+    BOOST_CHECK_THROW(
+        extract(w, NoMask(), NoAccumulate(), u, IndexArrayType{0, 7}),
+        IndexOutOfBoundsException);
+
+    // ...so the error is not lost when the write is dead
+    Vector<int> t(3);
+    BOOST_CHECK_THROW(
+        assign(t, NoMask(), NoAccumulate(), w, IndexArrayType{0, 3}),
+        IndexOutOfBoundsException);
+    apply(t, NoMask(), NoAccumulate(), Identity<int>(), u);
+    wait(t);
+
+    BOOST_CHECK_EQUAL(scope.stats().eliminated, 0);
+    BOOST_CHECK_EQUAL(t, u);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_bfs_matches_blocking)
+{
+    Matrix<unsigned int> A(9, 9);
+    A.build(i_m1, j_m1, std::vector<unsigned int>(i_m1.size(), 1));
+
+    Vector<IndexType> expected(9);
+    algorithms::bfs(A, 0UL, expected);
+
+    NonblockingScope scope;
+    Vector<IndexType> parents(9);
+    algorithms::bfs(A, 0UL, parents);
+
+    BOOST_CHECK_EQUAL(parents, expected);
+    BOOST_CHECK(scope.stats().fused > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,297 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE select_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    // | 1 1 - - |
+    // | 1 2 2 - |
+    // | - 2 3 3 |
+    // | - - 3 4 |
+    std::vector<std::vector<double>> const matA = {{1, 1, 0, 0},
+                                                   {1, 2, 2, 0},
+                                                   {0, 2, 3, 3},
+                                                   {0, 0, 3, 4}};
+}
+
+//****************************************************************************
+// select matrix
+//****************************************************************************
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_bad_dimension)
+{
+    Matrix<double> A(matA, 0.);
+
+    {
+        Matrix<double> C(3, 4);
+        BOOST_CHECK_THROW(
+            (select(C, NoMask(), NoAccumulate(), TriL<double>(), A, 0)),
+            DimensionException);
+    }
+    {
+        Matrix<double> C(4, 3);
+        BOOST_CHECK_THROW(
+            (select(C, NoMask(), NoAccumulate(), TriL<double>(), A, 0)),
+            DimensionException);
+    }
+    {
+        Matrix<double> C(4, 4);
+        Matrix<bool> M(3, 4);
+        BOOST_CHECK_THROW(
+            (select(C, M, NoAccumulate(), TriL<double>(), A, 0)),
+            DimensionException);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_positional)
+{
+    Matrix<double> A(matA, 0.);
+    Matrix<double> C(4, 4);
+
+    std::vector<std::vector<double>> matL = {{1, 0, 0, 0},
+                                             {1, 2, 0, 0},
+                                             {0, 2, 3, 0},
+                                             {0, 0, 3, 4}};
+    select(C, NoMask(), NoAccumulate(), TriL<double>(), A, 0);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matL, 0.));
+
+    std::vector<std::vector<double>> matU1 = {{0, 1, 0, 0},
+                                              {0, 0, 2, 0},
+                                              {0, 0, 0, 3},
+                                              {0, 0, 0, 0}};
+    select(C, NoMask(), NoAccumulate(), TriU<double>(), A, 1);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matU1, 0.));
+
+    std::vector<std::vector<double>> matL1 = {{0, 0, 0, 0},
+                                              {1, 0, 0, 0},
+                                              {0, 2, 0, 0},
+                                              {0, 0, 3, 0}};
+    select(C, NoMask(), NoAccumulate(), TriL<double>(), A, -1);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matL1, 0.));
+
+    std::vector<std::vector<double>> matD = {{1, 0, 0, 0},
+                                             {0, 2, 0, 0},
+                                             {0, 0, 3, 0},
+                                             {0, 0, 0, 4}};
+    select(C, NoMask(), NoAccumulate(), Diag<double>(), A, 0);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matD, 0.));
+
+    std::vector<std::vector<double>> matOff = {{0, 1, 0, 0},
+                                               {1, 0, 2, 0},
+                                               {0, 2, 0, 3},
+                                               {0, 0, 3, 0}};
+    select(C, NoMask(), NoAccumulate(), OffDiag<double>(), A, 0);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matOff, 0.));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_value)
+{
+    Matrix<double> A(matA, 0.);
+    Matrix<double> C(4, 4);
+
+    std::vector<std::vector<double>> matGT = {{0, 0, 0, 0},
+                                              {0, 2, 2, 0},
+                                              {0, 2, 3, 3},
+                                              {0, 0, 3, 4}};
+    select(C, NoMask(), NoAccumulate(), ValueGreaterThan<double>(), A, 1.);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matGT, 0.));
+
+    std::vector<std::vector<double>> matLE = {{1, 1, 0, 0},
+                                              {1, 2, 2, 0},
+                                              {0, 2, 0, 0},
+                                              {0, 0, 0, 0}};
+    select(C, NoMask(), NoAccumulate(), ValueLessEqual<double>(), A, 2.);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matLE, 0.));
+
+    // in place
+    select(C, NoMask(), NoAccumulate(), ValueEqual<double>(), C, 2.);
+    BOOST_CHECK_EQUAL(C.nvals(), 3);
+
+    // user defined predicate
+    select(C, NoMask(), NoAccumulate(),
+           [](double a, IndexType i, IndexType j, double s)
+           { return (i + j == 3) && (a >= s); },
+           A, 2.);
+    BOOST_CHECK_EQUAL(C.nvals(), 2);
+    BOOST_CHECK_EQUAL(C.extractElement(2, 1), 2.);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_mask_accum)
+{
+    Matrix<double> A(matA, 0.);
+
+    std::vector<std::vector<double>> matC = {{9, 0, 0, 9},
+                                             {0, 9, 0, 0},
+                                             {0, 0, 9, 0},
+                                             {9, 0, 0, 9}};
+    std::vector<std::vector<bool>> matM = {{1, 1, 0, 0},
+                                           {1, 1, 0, 0},
+                                           {0, 0, 1, 1},
+                                           {0, 0, 1, 1}};
+    Matrix<bool> M(matM, false);
+
+    // C<M> += triu(A): only the upper triangle of the masked blocks changes
+    {
+        Matrix<double> C(matC, 0.);
+        std::vector<std::vector<double>> matAnswer = {{10,  1, 0, 9},
+                                                      { 0, 11, 0, 0},
+                                                      { 0,  0, 12, 3},
+                                                      { 9,  0, 0, 13}};
+        select(C, M, Plus<double>(), TriU<double>(), A, 0);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(matAnswer, 0.));
+    }
+
+    // C<M,replace> = triu(A)
+    {
+        Matrix<double> C(matC, 0.);
+        std::vector<std::vector<double>> matAnswer = {{1, 1, 0, 0},
+                                                      {0, 2, 0, 0},
+                                                      {0, 0, 3, 3},
+                                                      {0, 0, 0, 4}};
+        select(C, M, NoAccumulate(), TriU<double>(), A, 0, REPLACE);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(matAnswer, 0.));
+    }
+
+    // C<!M> = triu(A), merge
+    {
+        Matrix<double> C(matC, 0.);
+        std::vector<std::vector<double>> matAnswer = {{9, 0, 0, 0},
+                                                      {0, 9, 2, 0},
+                                                      {0, 0, 9, 0},
+                                                      {0, 0, 0, 9}};
+        select(C, complement(M), NoAccumulate(), TriU<double>(), A, 0);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(matAnswer, 0.));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_transpose)
+{
+    std::vector<std::vector<double>> matB = {{1, 2, 0},
+                                             {0, 3, 4},
+                                             {5, 0, 6},
+                                             {0, 0, 7}};
+    Matrix<double> B(matB, 0.);
+    Matrix<double> C(3, 4);
+
+    // strictly lower part of B' (positions are those of B')
+    std::vector<std::vector<double>> matAnswer = {{0, 0, 0, 0},
+                                                  {2, 0, 0, 0},
+                                                  {0, 4, 0, 0}};
+    select(C, NoMask(), NoAccumulate(), TriL<double>(), transpose(B), -1);
+    BOOST_CHECK_EQUAL(C, Matrix<double>(matAnswer, 0.));
+}
+
+//****************************************************************************
+// select vector
+//****************************************************************************
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdvec_test_bad_dimension)
+{
+    Vector<double> u(std::vector<double>{1, 0, 3, 4}, 0.);
+    Vector<double> w(3);
+    BOOST_CHECK_THROW(
+        (select(w, NoMask(), NoAccumulate(), ValueGreaterThan<double>(), u, 1.)),
+        DimensionException);
+
+    Vector<double> w4(4);
+    Vector<bool> m(3);
+    BOOST_CHECK_THROW(
+        (select(w4, m, NoAccumulate(), ValueGreaterThan<double>(), u, 1.)),
+        DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdvec_test)
+{
+    Vector<double> u(std::vector<double>{1, 0, 3, 4, 2, 5}, 0.);
+
+    {
+        Vector<double> w(6);
+        select(w, NoMask(), NoAccumulate(), ValueGreaterThan<double>(), u, 2.);
+        BOOST_CHECK_EQUAL(
+            w, Vector<double>(std::vector<double>{0, 0, 3, 4, 0, 5}, 0.));
+    }
+
+    // positional: indices up to 2 (j is always 0 for vectors)
+    {
+        Vector<double> w(6);
+        select(w, NoMask(), NoAccumulate(), TriU<double>(), u, -2);
+        BOOST_CHECK_EQUAL(
+            w, Vector<double>(std::vector<double>{1, 0, 3, 0, 0, 0}, 0.));
+    }
+
+    // w<m,replace> += (u <= 3)
+    {
+        Vector<double> w(std::vector<double>{9, 9, 9, 0, 9, 9}, 0.);
+        Vector<bool> m(std::vector<bool>{1, 1, 0, 1, 1, 0}, false);
+        select(w, m, Plus<double>(), ValueLessEqual<double>(), u, 3.,
+               REPLACE);
+        BOOST_CHECK_EQUAL(
+            w, Vector<double>(std::vector<double>{10, 9, 0, 0, 11, 0}, 0.));
+    }
+
+    // stored zeros are selected like any other value
+    {
+        u.setElement(1, 0.);
+        Vector<bool> w(6);
+        select(w, NoMask(), NoAccumulate(), ValueLessThan<double>(), u, 3.);
+        BOOST_CHECK_EQUAL(w.nvals(), 3);
+        BOOST_CHECK(w.hasElement(1));
+        BOOST_CHECK_EQUAL(w.extractElement(1), false);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
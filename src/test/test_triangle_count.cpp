@@ -32,7 +32,9 @@
  * DM20-0442
  */
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include <graphblas/graphblas.hpp>
 #include <algorithms/triangle_count.hpp>
@@ -174,4 +176,85 @@ BOOST_AUTO_TEST_CASE(test_triangle_counting_newGBTL)
     BOOST_CHECK_EQUAL(result, 4);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_triangle_count_fused)
+{
+    std::vector<double> ar={0, 0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4};
+    std::vector<double> ac={1, 2, 3, 0, 2, 4, 0, 1, 3, 4, 0, 2, 4, 1, 2, 3};
+    std::vector<double> av={1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    Matrix<double, DirectedMatrixTag> testtriangle(5,5), L(5,5), U(5,5);
+    testtriangle.build(ar.begin(), ac.begin(), av.begin(), av.size());
+    grb::split(testtriangle, L, U);
+
+    IndexType result = triangle_count_fused(L);
+    BOOST_CHECK_EQUAL(result, 4);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_triangle_count_fused_matches_masked)
+{
+    // a dense block (long, similar rows) plus a hub connected to every
+    // vertex (row lengths differ widely), plus sparse pseudo-random edges
+    IndexType const N(300);
+    IndexArrayType rows, cols;
+    auto add_edge = [&](IndexType i, IndexType j)
+    {
+        if (i == j) return;
+        rows.push_back(i);  cols.push_back(j);
+        rows.push_back(j);  cols.push_back(i);
+    };
+    for (IndexType i = 0; i < 40; ++i)
+        for (IndexType j = i + 1; j < 40; ++j)
+            if ((i*7 + j*3) % 5 != 0) add_edge(i, j);
+    for (IndexType i = 0; i < N - 1; ++i) add_edge(N - 1, i);
+    for (IndexType k = 0; k < 2000; ++k) add_edge((k*37) % N, (k*101 + 13) % N);
+
+    Matrix<int64_t, DirectedMatrixTag> A(N, N), L(N, N), U(N, N);
+    A.build(rows.begin(), cols.begin(),
+            std::vector<int64_t>(rows.size(), 1).begin(), rows.size(),
+            grb::Second<int64_t>());
+    grb::split(A, L, U);
+
+    BOOST_CHECK_EQUAL(triangle_count_fused(L), triangle_count_masked(L));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_merge_intersect_count_matches_scalar)
+{
+#if defined(__AVX2__)
+    BOOST_TEST_MESSAGE("merge_intersect_count: AVX2 path");
+#else
+    BOOST_TEST_MESSAGE("merge_intersect_count: scalar path");
+#endif
+
+    // sorted, duplicate free lists of every length up to 40, with strides
+    // that give no, some and full overlap (and both block advance cases)
+    for (IndexType na = 0; na <= 40; ++na)
+    {
+        for (IndexType nb = 0; nb <= 40; nb += 3)
+        {
+            for (IndexType stride : {1UL, 2UL, 3UL})
+            {
+                IndexArrayType a(na), b(nb);
+                for (IndexType k = 0; k < na; ++k) a[k] = 2*k + (k % 3 == 0);
+                for (IndexType k = 0; k < nb; ++k) b[k] = stride*k + 1;
+
+                IndexArrayType common;
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                      std::back_inserter(common));
+
+                BOOST_CHECK_EQUAL(
+                    merge_intersect_count_scalar(a.data(), na, b.data(), nb),
+                    common.size());
+                BOOST_CHECK_EQUAL(
+                    merge_intersect_count(a.data(), na, b.data(), nb),
+                    common.size());
+                BOOST_CHECK_EQUAL(
+                    merge_intersect_count(b.data(), nb, a.data(), na),
+                    common.size());
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -108,4 +108,70 @@ BOOST_AUTO_TEST_CASE(vector_removeElement_test)
     BOOST_CHECK(!v1.hasElement(1));
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(vector_move_and_swap_test)
+{
+    IndexArrayType      i = {1, 2, 3};
+    std::vector<double> v = {1, 2, 3};
+
+    Vector<double> v1(6);
+    v1.build(i, v);
+    Vector<double> answer(v1);
+
+    static_assert(std::is_nothrow_move_constructible_v<Vector<double>>);
+    static_assert(std::is_nothrow_move_assignable_v<Vector<double>>);
+
+    Vector<double> v2(std::move(v1));
+    BOOST_CHECK_EQUAL(v2, answer);
+
+    // move assignment takes the size of the source
+    Vector<double> v3(4);
+    v3.setElement(0, 7);
+    v3 = std::move(v2);
+    BOOST_CHECK_EQUAL(v3.size(), 6);
+    BOOST_CHECK_EQUAL(v3, answer);
+
+    Vector<double> v4(10);
+    v4.setElement(9, 9);
+    swap(v3, v4);
+    BOOST_CHECK_EQUAL(v4, answer);
+    BOOST_CHECK_EQUAL(v3.size(), 10);
+    BOOST_CHECK_EQUAL(v3.nvals(), 1);
+    BOOST_CHECK_EQUAL(v3.extractElement(9), 9);
+}
+
+//****************************************************************************
+// Copy assignment checks the size, move assignment replaces it
+BOOST_AUTO_TEST_CASE(vector_copy_vs_move_assignment_size)
+{
+    IndexArrayType      i = {1, 2, 3};
+    std::vector<double> v = {1, 2, 3};
+
+    Vector<double> answer(6);
+    answer.build(i, v);
+
+    Vector<double> v1(4);
+    v1.setElement(0, 7);
+    Vector<double> const v1_orig(v1);
+
+    // copy: a size mismatch throws and leaves the target untouched
+    BOOST_CHECK_THROW(v1 = answer, DimensionException);
+    BOOST_CHECK_EQUAL(v1, v1_orig);
+
+    // move: the target takes the source's size, the source the target's
+    // old contents
+    Vector<double> v2(answer);
+    v1 = std::move(v2);
+    BOOST_CHECK_EQUAL(v1, answer);
+    BOOST_CHECK_EQUAL(v2, v1_orig);
+
+    // a moved-from vector has size zero: it accepts move assignment, but
+    // copy assignment of a non-empty vector is a size mismatch
+    Vector<double> v3(std::move(v1));
+    BOOST_CHECK_EQUAL(v1.size(), 0);
+    BOOST_CHECK_THROW(v1 = answer, DimensionException);
+    v1 = std::move(v3);
+    BOOST_CHECK_EQUAL(v1, answer);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
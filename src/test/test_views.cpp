@@ -430,4 +430,243 @@ BOOST_AUTO_TEST_CASE(test_mxv_complemented_structure_mask)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// DiagonalView: compare against multiplying by the materialized diagonal
+//****************************************************************************
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_diagonal_left)
+{
+    std::vector<std::vector<double> > B = {{5, 8, 1, 2},
+                                           {6, 7, 3, 0},
+                                           {4, 5, 9, 1}};
+    Matrix<double, DirectedMatrixTag> mB(B, 0);
+
+    std::vector<double> d = {2, 0, -1};    // d(1) not stored
+    Vector<double> vd(d, 0);
+    auto mD(diag<Matrix<double, DirectedMatrixTag>>(vd));
+
+    Matrix<double, DirectedMatrixTag> answer(3, 4);
+    mxm(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        mD, mB);
+
+    Matrix<double, DirectedMatrixTag> result(3, 4);
+    mxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        diagonal(vd), mB);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // in place: B := diag(d) * B
+    mxm(mB, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        diagonal(vd), mB);
+    BOOST_CHECK_EQUAL(mB, answer);
+    BOOST_CHECK_EQUAL(mB.nvals(), 8);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_diagonal_right_transpose)
+{
+    std::vector<std::vector<double> > A = {{5, 8, 1, 2},
+                                           {6, 7, 3, 0},
+                                           {4, 5, 9, 1}};
+    Matrix<double, DirectedMatrixTag> mA(A, 0);
+
+    std::vector<double> d = {3, 0, 2};
+    Vector<double> vd(d, 0);
+    auto mD(diag<Matrix<double, DirectedMatrixTag>>(vd));
+
+    Matrix<double, DirectedMatrixTag> answer(4, 3);
+    mxm(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        transpose(mA), mD);
+
+    Matrix<double, DirectedMatrixTag> result(4, 3);
+    mxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        transpose(mA), diagonal(vd));
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_diagonal_masked_accum)
+{
+    std::vector<std::vector<double> > A = {{5, 8, 1},
+                                           {6, 7, 3},
+                                           {4, 5, 9}};
+    Matrix<double, DirectedMatrixTag> mA(A, 0);
+
+    std::vector<std::vector<bool> > M = {{1, 0, 1},
+                                         {0, 1, 0},
+                                         {1, 1, 0}};
+    Matrix<bool, DirectedMatrixTag> mM(M, false);
+
+    std::vector<double> d = {1, 2, 0};
+    Vector<double> vd(d, 0);
+    auto mD(diag<Matrix<double, DirectedMatrixTag>>(vd));
+
+    Matrix<double, DirectedMatrixTag> answer(mA);
+    mxm(answer, complement(mM), Plus<double>(), MinPlusSemiring<double>(),
+        mA, mD, REPLACE);
+
+    Matrix<double, DirectedMatrixTag> result(mA);
+    mxm(result, complement(mM), Plus<double>(), MinPlusSemiring<double>(),
+        mA, diagonal(vd), REPLACE);
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_diagonal_both)
+{
+    std::vector<double> a = {2, 0, 3, 4};
+    std::vector<double> b = {5, 6, 0, 2};
+    Vector<double> va(a, 0), vb(b, 0);
+    auto mDa(diag<Matrix<double, DirectedMatrixTag>>(va));
+    auto mDb(diag<Matrix<double, DirectedMatrixTag>>(vb));
+
+    Matrix<double, DirectedMatrixTag> answer(4, 4);
+    mxm(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        mDa, mDb);
+
+    Matrix<double, DirectedMatrixTag> result(4, 4);
+    mxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        diagonal(va), diagonal(vb));
+    BOOST_CHECK_EQUAL(result, answer);
+    BOOST_CHECK_EQUAL(result.nvals(), 2);
+
+    // masked and accumulated into a matrix with off-diagonal values
+    std::vector<std::vector<bool> > M = {{1, 1, 0, 0},
+                                         {0, 1, 0, 0},
+                                         {0, 0, 0, 0},
+                                         {1, 0, 0, 1}};
+    Matrix<bool, DirectedMatrixTag> mM(M, false);
+    std::vector<std::vector<double> > C = {{1, 2, 0, 0},
+                                           {0, 0, 3, 0},
+                                           {0, 0, 4, 0},
+                                           {5, 0, 0, 6}};
+    Matrix<double, DirectedMatrixTag> answer2(C, 0), result2(C, 0);
+    mxm(answer2, mM, Plus<double>(), ArithmeticSemiring<double>(),
+        mDa, mDb, REPLACE);
+    mxm(result2, mM, Plus<double>(), ArithmeticSemiring<double>(),
+        diagonal(va), diagonal(vb), REPLACE);
+    BOOST_CHECK_EQUAL(result2, answer2);
+
+    BOOST_CHECK_THROW(
+        mxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+            diagonal(va), diagonal(Vector<double>(3))),
+        DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxv_vxm_diagonal)
+{
+    std::vector<double> d = {2, 0, 3, 4};
+    std::vector<double> u = {1, 5, 0, 2};
+    Vector<double> vd(d, 0), vu(u, 0);
+    auto mD(diag<Matrix<double, DirectedMatrixTag>>(vd));
+
+    Vector<double> answer(4), result(4);
+    mxv(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        mD, vu);
+    mxv(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        diagonal(vd), vu);
+    BOOST_CHECK_EQUAL(result, answer);
+    BOOST_CHECK_EQUAL(result.nvals(), 2);
+
+    vxm(answer, NoMask(), Plus<double>(), ArithmeticSemiring<double>(),
+        vu, mD);
+    vxm(result, NoMask(), Plus<double>(), ArithmeticSemiring<double>(),
+        vu, diagonal(vd));
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_scale_rows_cols)
+{
+    std::vector<std::vector<double> > A = {{4, 8, 0},
+                                           {0, 0, 0},
+                                           {3, 0, 6}};
+    Matrix<double, DirectedMatrixTag> mA(A, 0);
+    std::vector<double> d = {2, 5, 3};
+    Vector<double> vd(d, 0);
+
+    Matrix<double, DirectedMatrixTag> rows(mA);
+    scale_rows(rows, vd, Second<double>());   // op(d(i), a) = a
+    BOOST_CHECK_EQUAL(rows, mA);
+    scale_rows(rows, vd);
+    std::vector<std::vector<double> > ans_rows = {{8, 16, 0},
+                                                  {0,  0, 0},
+                                                  {9,  0, 18}};
+    BOOST_CHECK_EQUAL(rows, (Matrix<double, DirectedMatrixTag>(ans_rows, 0)));
+
+    Matrix<double, DirectedMatrixTag> cols(mA);
+    scale_cols(cols, vd, Div<double>());      // op(a, d(j)) = a / d(j)
+    std::vector<std::vector<double> > ans_cols = {{2,   1.6, 0},
+                                                  {0,   0,   0},
+                                                  {1.5, 0,   2}};
+    BOOST_CHECK_EQUAL(cols, (Matrix<double, DirectedMatrixTag>(ans_cols, 0)));
+
+    // a missing d(j) removes column j
+    vd.removeElement(0);
+    scale_cols(cols, vd);
+    BOOST_CHECK_EQUAL(cols.nvals(), 2);
+    BOOST_CHECK(!cols.hasElement(0, 0));
+    BOOST_CHECK_EQUAL(cols.extractElement(0, 1), 8.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_scale_rows_cols_few_rows)
+{
+    // few non-empty rows in a large matrix (hypersparse in some backends)
+    IndexType const N = 1000000;
+    IndexArrayType i = {3, 3, 500000, 999999};
+    IndexArrayType j = {7, 500000, 3, 999999};
+    std::vector<double> v = {1, 2, 3, 4};
+    Matrix<double> mA(N, N);
+    mA.build(i, j, v);
+
+    Vector<double> vd(N);
+    vd.setElement(3, 10);
+    vd.setElement(7, 100);
+    vd.setElement(999999, 1000);
+
+    Matrix<double> rows(mA);
+    mxm(rows, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        diagonal(vd), rows);
+    BOOST_CHECK_EQUAL(rows.nvals(), 3);
+    BOOST_CHECK_EQUAL(rows.extractElement(3, 500000), 20.0);
+    BOOST_CHECK_EQUAL(rows.extractElement(999999, 999999), 4000.0);
+    BOOST_CHECK(!rows.hasElement(500000, 3));
+
+    Matrix<double> cols(mA);
+    scale_cols(cols, vd);
+    BOOST_CHECK_EQUAL(cols.nvals(), 3);
+    BOOST_CHECK_EQUAL(cols.extractElement(3, 7), 100.0);
+    BOOST_CHECK_EQUAL(cols.extractElement(500000, 3), 30.0);
+    BOOST_CHECK(!cols.hasElement(3, 500000));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_normalize_rows_cols)
+{
+    std::vector<std::vector<double> > A = {{1, 3, 0},
+                                           {0, 0, 0},
+                                           {2, 0, 2}};
+    Matrix<double, DirectedMatrixTag> mA(A, 0);
+
+    Matrix<double, DirectedMatrixTag> rows(mA);
+    normalize_rows(rows);
+    std::vector<std::vector<double> > ans_rows = {{0.25, 0.75, 0},
+                                                  {0,    0,    0},
+                                                  {0.5,  0,    0.5}};
+    BOOST_CHECK_EQUAL(rows, (Matrix<double, DirectedMatrixTag>(ans_rows, 0)));
+
+    Matrix<double, DirectedMatrixTag> cols(mA);
+    normalize_cols(cols);
+    std::vector<std::vector<double> > ans_cols = {{1./3., 1, 0},
+                                                  {0,     0, 0},
+                                                  {2./3., 0, 1}};
+    BOOST_CHECK_EQUAL(cols.nvals(), 4);
+    BOOST_CHECK_CLOSE(cols.extractElement(0, 0), ans_cols[0][0], 1e-12);
+    BOOST_CHECK_CLOSE(cols.extractElement(2, 0), ans_cols[2][0], 1e-12);
+    BOOST_CHECK_EQUAL(cols.extractElement(0, 1), 1.0);
+    BOOST_CHECK_EQUAL(cols.extractElement(2, 2), 1.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()